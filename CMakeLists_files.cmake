@@ -103,6 +103,7 @@ list (APPEND MAIN_SOURCE_FILES
   opm/simulators/flow/GenericTracerModel.cpp
   opm/simulators/flow/InterRegFlows.cpp
   opm/simulators/flow/KeywordValidation.cpp
+  opm/simulators/flow/LoadBalanceMonitor.cpp
   opm/simulators/flow/LogOutputHelper.cpp
   opm/simulators/flow/Main.cpp
   opm/simulators/flow/MixingRateControls.cpp
@@ -160,6 +161,7 @@ list (APPEND MAIN_SOURCE_FILES
   opm/simulators/utils/compressPartition.cpp
   opm/simulators/utils/gatherDeferredLogger.cpp
   opm/simulators/utils/phaseUsageFromDeck.cpp
+  opm/simulators/utils/readCellWeights.cpp
   opm/simulators/utils/readDeck.cpp
   opm/simulators/utils/satfunc/RelpermDiagnostics.cpp
   opm/simulators/wells/ALQState.cpp
@@ -372,10 +374,13 @@ endif()
 # originally generated with the command:
 # find tests -name '*.cpp' -a ! -wholename '*/not-unit/*' -printf '\t%p\n' | sort
 list (APPEND TEST_SOURCE_FILES
+  tests/models/test_coloredlinearization.cpp
   tests/models/test_quadrature.cpp
   tests/models/test_propertysystem.cpp
   tests/models/test_tasklets.cpp
   tests/models/test_tasklets_failure.cpp
+  tests/models/test_tasklets_submit.cpp
+  tests/models/test_threadedentityiterator.cpp
   tests/test_ALQState.cpp
   tests/test_aquifergridutils.cpp
   tests/test_blackoil_amg.cpp
@@ -383,18 +388,25 @@ list (APPEND TEST_SOURCE_FILES
   tests/test_convergencereport.cpp
   tests/test_deferredlogger.cpp
   tests/test_dilu.cpp
+  tests/test_eclwriterthreads.cpp
   tests/test_equil.cpp
   tests/test_extractMatrix.cpp
   tests/test_flexiblesolver.cpp
+  tests/test_galerkinproductplan.cpp
   tests/test_glift1.cpp
   tests/test_graphcoloring.cpp
   tests/test_GroupState.cpp
   tests/test_interregflows.cpp
   tests/test_invert.cpp
   tests/test_keyword_validator.cpp
+  tests/test_loadbalancemonitor.cpp
   tests/test_LogOutputHelper.cpp
   tests/test_milu.cpp
+  tests/test_mixedprecisionpreconditioner.cpp
+  tests/test_mswelltreesolver.cpp
+  tests/test_multisegmentwellequations.cpp
   tests/test_multmatrixtransposed.cpp
+  tests/test_nlddconcurrent.cpp
   tests/test_norne_pvt.cpp
   tests/test_outputdir.cpp
   tests/test_parametersystem.cpp
@@ -403,14 +415,20 @@ list (APPEND TEST_SOURCE_FILES
   tests/test_partitionCells.cpp
   tests/test_preconditionerfactory.cpp
   tests/test_privarspacking.cpp
+  tests/test_readcellweights.cpp
   tests/test_region_phase_pvaverage.cpp
   tests/test_relpermdiagnostics.cpp
   tests/test_RestartSerialization.cpp
   tests/test_rstconv.cpp
+  tests/test_sparsitypattern.cpp
   tests/test_stoppedwells.cpp
   tests/test_timer.cpp
+  tests/test_tpfalinearizer.cpp
+  tests/test_tracersweepsolver.cpp
   tests/test_vfpproperties.cpp
   tests/test_wellmodel.cpp
+  tests/test_wellmodelthreads.cpp
+  tests/test_welloperators.cpp
   tests/test_wellprodindexcalculator.cpp
   tests/test_wellstate.cpp
   )
@@ -432,6 +450,7 @@ endif()
 if(MPI_FOUND)
   list(APPEND TEST_SOURCE_FILES tests/test_ghostlastmatrixadapter.cpp
                                 tests/test_parallelistlinformation.cpp
+                                tests/test_parallelnlddpartitioningzoltan.cpp
                                 tests/test_ParallelSerialization.cpp)
 endif()
 
@@ -510,6 +529,9 @@ list (APPEND TEST_DATA_FILES
   tests/msw.data
   tests/TESTTIMER.DATA
   tests/TESTWELLMODEL.DATA
+  tests/TESTECLWRITERTHREADS.DATA
+  tests/TESTWELLMODELTHREADS.DATA
+  tests/TESTWELLMODELTHREADS_GROUP.DATA
   tests/liveoil.DATA
   tests/capillary.DATA
   tests/capillary_overlap.DATA
@@ -582,6 +604,7 @@ list (APPEND PUBLIC_HEADER_FILES
   opm/models/blackoil/blackoilboundaryratevector.hh
   opm/models/blackoil/blackoilbrinemodules.hh
   opm/models/blackoil/blackoilbrineparams.hpp
+  opm/models/blackoil/blackoilcompactintensivequantities.hh
   opm/models/blackoil/blackoildarcyfluxmodule.hh
   opm/models/blackoil/blackoildiffusionmodule.hh
   opm/models/blackoil/blackoildispersionmodule.hh
@@ -836,6 +859,7 @@ list (APPEND PUBLIC_HEADER_FILES
   opm/simulators/flow/GenericTracerModel_impl.hpp
   opm/simulators/flow/InterRegFlows.hpp
   opm/simulators/flow/KeywordValidation.hpp
+  opm/simulators/flow/LoadBalanceMonitor.hpp
   opm/simulators/flow/LogOutputHelper.hpp
   opm/simulators/flow/Main.hpp
   opm/simulators/flow/MixingRateControls.hpp
@@ -855,6 +879,7 @@ list (APPEND PUBLIC_HEADER_FILES
   opm/simulators/flow/SolutionContainers.hpp
   opm/simulators/flow/SubDomain.hpp
   opm/simulators/flow/TracerModel.hpp
+  opm/simulators/flow/TracerSweepSolver.hpp
   opm/simulators/flow/Transmissibility.hpp
   opm/simulators/flow/Transmissibility_impl.hpp
   opm/simulators/flow/ValidationFunctions.hpp
@@ -905,6 +930,7 @@ list (APPEND PUBLIC_HEADER_FILES
   opm/simulators/linalg/linearsolverreport.hh
   opm/simulators/linalg/matrixblock.hh
   opm/simulators/linalg/MatrixMarketSpecializations.hpp
+  opm/simulators/linalg/MixedPrecisionPreconditioner.hpp
   opm/simulators/linalg/nullborderlistmanager.hh
   opm/simulators/linalg/overlappingbcrsmatrix.hh
   opm/simulators/linalg/overlappingblockvector.hh
@@ -929,6 +955,7 @@ list (APPEND PUBLIC_HEADER_FILES
   opm/simulators/linalg/residreductioncriterion.hh
   opm/simulators/linalg/SmallDenseMatrixUtils.hpp
   opm/simulators/linalg/setupPropertyTree.hpp
+  opm/simulators/linalg/sparsitypattern.hh
   opm/simulators/linalg/superlubackend.hh
   opm/simulators/linalg/twolevelmethodcpr.hh
   opm/simulators/linalg/vertexborderlistfromgrid.hh
@@ -962,6 +989,7 @@ list (APPEND PUBLIC_HEADER_FILES
   opm/simulators/utils/gatherDeferredLogger.hpp
   opm/simulators/utils/moduleVersion.hpp
   opm/simulators/utils/phaseUsageFromDeck.hpp
+  opm/simulators/utils/readCellWeights.hpp
   opm/simulators/utils/readDeck.hpp
   opm/simulators/utils/satfunc/RelpermDiagnostics.hpp
   opm/simulators/wells/ALQState.hpp
@@ -988,9 +1016,11 @@ list (APPEND PUBLIC_HEADER_FILES
   opm/simulators/wells/GroupEconomicLimitsChecker.hpp
   opm/simulators/wells/GroupState.hpp
   opm/simulators/wells/MSWellHelpers.hpp
+  opm/simulators/wells/MSWellTreeSolver.hpp
   opm/simulators/wells/MultisegmentWell.hpp
   opm/simulators/wells/MultisegmentWell_impl.hpp
   opm/simulators/wells/MultisegmentWellAssemble.hpp
+  opm/simulators/wells/MultisegmentWellEquationAccess.hpp
   opm/simulators/wells/MultisegmentWellEquations.hpp
   opm/simulators/wells/MultisegmentWellEval.hpp
   opm/simulators/wells/MultisegmentWellGeneric.hpp
@@ -1011,6 +1041,7 @@ list (APPEND PUBLIC_HEADER_FILES
   opm/simulators/wells/StandardWell_impl.hpp
   opm/simulators/wells/StandardWellAssemble.hpp
   opm/simulators/wells/StandardWellConnections.hpp
+  opm/simulators/wells/StandardWellEquationAccess.hpp
   opm/simulators/wells/StandardWellEquations.hpp
   opm/simulators/wells/StandardWellEval.hpp
   opm/simulators/wells/StandardWellPrimaryVariables.hpp
@@ -21,6 +21,7 @@
 
 #include <opm/simulators/utils/HDF5Serializer.hpp>
 
+#include <opm/simulators/flow/SimulatorSerializer.hpp>
 #include <opm/simulators/timestepping/SimulatorTimer.hpp>
 #include <opm/simulators/utils/ParallelCommunication.hpp>
 
@@ -29,17 +30,80 @@
 #include <fmt/format.h>
 
 #include <array>
+#include <exception>
 #include <iostream>
 #include <string>
 
+namespace {
+
+// Rewrite a file with every report step stored in full, e.g., to allow
+// removing steps from a file saved with --save-deltas. The file has to be
+// compacted by as many processes as were used to save it.
+int compact(const std::string& inFile, const std::string& outFile)
+{
+#if HAVE_MPI
+    Opm::Parallel::Communication comm{MPI_COMM_WORLD};
+#else
+    Opm::Parallel::Communication comm{};
+#endif
+
+    int procs = 0;
+    try {
+        Opm::HDF5Serializer ser(inFile, Opm::HDF5File::OpenMode::READ, comm);
+        std::tuple<std::array<std::string,5>,int> header;
+        ser.read(header, "/", "simulator_info", Opm::HDF5File::DataSetMode::ROOT_ONLY);
+        procs = std::get<1>(header);
+    } catch(...) {
+        if (comm.rank() == 0) {
+            std::cerr << "Error reading data from file, is it really a .OPMRST file?\n";
+        }
+        return 2;
+    }
+    if (procs != comm.size()) {
+        if (comm.rank() == 0) {
+            std::cerr << fmt::format("{} was saved by {} processes, "
+                                     "it has to be compacted by as many\n",
+                                     inFile, procs);
+        }
+        return 1;
+    }
+
+    try {
+        Opm::SimulatorSerializer::compact(inFile, outFile, comm);
+    } catch (const std::exception& e) {
+        if (comm.rank() == 0) {
+            std::cerr << "Error compacting file: " << e.what() << '\n';
+        }
+        return 2;
+    }
+
+    if (comm.rank() == 0) {
+        std::cout << "Wrote compacted state to " << outFile << '\n';
+    }
+    return 0;
+}
+
+} // Anonymous namespace
+
 int main(int argc, char** argv)
 {
     if (argc < 2) {
-        std::cerr << "Need one parameter, the .OPMRST file to inspect\n";
+        std::cerr << "Usage: " << argv[0] << " <file.OPMRST> [--compact <output.OPMRST>]\n"
+                  << "\tPrints info on the .OPMRST file, or rewrites it with every\n"
+                  << "\treport step stored in full if --compact is given.\n";
         return 1;
     }
 
     Dune::MPIHelper::instance(argc, argv);
+
+    if (argc > 2) {
+        if (argc != 4 || std::string(argv[2]) != "--compact") {
+            std::cerr << "Unknown options, use " << argv[0] << " <file.OPMRST> --compact <output.OPMRST>\n";
+            return 1;
+        }
+        return compact(argv[1], argv[3]);
+    }
+
 #if HAVE_MPI
     Opm::Parallel::Communication comm{MPI_COMM_SELF};
 #else
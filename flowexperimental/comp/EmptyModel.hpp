@@ -48,10 +48,9 @@ public:
     template<class Something>
     void init(Something /*A*/){}
     void prepareTracerBatches(){};
-    using NeighborSet = std::set<unsigned>;
     void linearize(SparseMatrixAdapter& /*matrix*/, GlobalEqVector& /*residual*/) override {}
     unsigned numDofs() const override { return 0; }
-    void addNeighbors(std::vector<NeighborSet>& /*neighbors*/) const override {}
+    void addNeighbors(Linear::SparsityPattern& /*sparsityPattern*/) const override {}
     //void applyInitial(){};
     void initialSolutionApplied(){};
     //void initFromRestart(const data::Aquifers& aquiferSoln);
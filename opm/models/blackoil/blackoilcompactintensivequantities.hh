@@ -0,0 +1,273 @@
+// -*- mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-
+// vi: set et ts=4 sw=4 sts=4:
+/*
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 2 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+
+  Consult the COPYING file in the top-level source directory of this
+  module for the precise wording of the license and the list of
+  copyright holders.
+*/
+/*!
+ * \file
+ *
+ * \copydoc Opm::BlackOilCompactIntensiveQuantityArrays
+ */
+#ifndef EWOMS_BLACK_OIL_COMPACT_INTENSIVE_QUANTITIES_HH
+#define EWOMS_BLACK_OIL_COMPACT_INTENSIVE_QUANTITIES_HH
+
+#include "blackoilproperties.hh"
+
+#include <opm/input/eclipse/EclipseState/Grid/FaceDir.hpp>
+
+#include <array>
+#include <cstddef>
+#include <vector>
+
+namespace Opm {
+
+template <class TypeTag>
+class BlackOilCompactIntensiveQuantities;
+
+/*!
+ * \ingroup BlackOilModel
+ * \ingroup IntensiveQuantities
+ *
+ * \brief The subset of the black-oil intensive quantities that is needed by
+ *        the storage and flux terms of the TPFA local residual, for all
+ *        degrees of freedom.
+ *
+ * The full intensive quantities objects are large, and the linearization
+ * only reads a small part of them for each cell and face. Each of these
+ * quantities is copied into its own array, indexed by the global index of
+ * the degree of freedom. A loop over the cells or faces thus reads each
+ * quantity from a contiguous array instead of skipping over the
+ * quantities of the cell that it does not use.
+ *
+ * The quantities of a single degree of freedom are accessed through
+ * BlackOilCompactIntensiveQuantities.
+ *
+ * Only the plain black-oil model is supported, i.e., none of the extension
+ * modules may be enabled, and directional relative permeabilities are not
+ * supported.
+ */
+template <class TypeTag>
+class BlackOilCompactIntensiveQuantityArrays
+{
+    using IntensiveQuantities = GetPropType<TypeTag, Properties::IntensiveQuantities>;
+    using Evaluation = GetPropType<TypeTag, Properties::Evaluation>;
+    using FluidSystem = GetPropType<TypeTag, Properties::FluidSystem>;
+
+    enum { numPhases = getPropValue<TypeTag, Properties::NumPhases>() };
+
+    using PhaseArrays = std::array<std::vector<Evaluation>, numPhases>;
+
+public:
+    //! \brief Whether the compact intensive quantities can be used with the
+    //!        enabled model extensions.
+    static constexpr bool isSupported =
+        !getPropValue<TypeTag, Properties::EnableSolvent>() &&
+        !getPropValue<TypeTag, Properties::EnableExtbo>() &&
+        !getPropValue<TypeTag, Properties::EnablePolymer>() &&
+        !getPropValue<TypeTag, Properties::EnableEnergy>() &&
+        !getPropValue<TypeTag, Properties::EnableFoam>() &&
+        !getPropValue<TypeTag, Properties::EnableBrine>() &&
+        !getPropValue<TypeTag, Properties::EnableDiffusion>() &&
+        !getPropValue<TypeTag, Properties::EnableDispersion>() &&
+        !getPropValue<TypeTag, Properties::EnableConvectiveMixing>() &&
+        !getPropValue<TypeTag, Properties::EnableMICP>();
+
+    /*!
+     * \brief Allocate the arrays for a given number of degrees of freedom.
+     *
+     * Only the arrays of the active phases and of the enabled dissolution
+     * and vaporization mechanisms are allocated.
+     */
+    void resize(std::size_t numDof)
+    {
+        for (unsigned phaseIdx = 0; phaseIdx < numPhases; ++phaseIdx) {
+            if (!FluidSystem::phaseIsActive(phaseIdx)) {
+                continue;
+            }
+            pressure_[phaseIdx].resize(numDof);
+            saturation_[phaseIdx].resize(numDof);
+            density_[phaseIdx].resize(numDof);
+            invB_[phaseIdx].resize(numDof);
+            mobility_[phaseIdx].resize(numDof);
+        }
+        Rs_.resize(FluidSystem::enableDissolvedGas() ? numDof : 0);
+        Rv_.resize(FluidSystem::enableVaporizedOil() ? numDof : 0);
+        Rsw_.resize(FluidSystem::enableDissolvedGasInWater() ? numDof : 0);
+        Rvw_.resize(FluidSystem::enableVaporizedWater() ? numDof : 0);
+        porosity_.resize(numDof);
+        rockCompTransMultiplier_.resize(numDof);
+        pvtRegionIdx_.resize(numDof, 0);
+    }
+
+    /*!
+     * \brief Copy the quantities used by the local residual from the full
+     *        intensive quantities object of a degree of freedom.
+     */
+    void assign(unsigned globalIdx, const IntensiveQuantities& intQuants)
+    {
+        const auto& fs = intQuants.fluidState();
+        for (unsigned phaseIdx = 0; phaseIdx < numPhases; ++phaseIdx) {
+            if (!FluidSystem::phaseIsActive(phaseIdx)) {
+                continue;
+            }
+            pressure_[phaseIdx][globalIdx] = fs.pressure(phaseIdx);
+            saturation_[phaseIdx][globalIdx] = fs.saturation(phaseIdx);
+            density_[phaseIdx][globalIdx] = fs.density(phaseIdx);
+            invB_[phaseIdx][globalIdx] = fs.invB(phaseIdx);
+            mobility_[phaseIdx][globalIdx] = intQuants.mobility(phaseIdx);
+        }
+        if (FluidSystem::enableDissolvedGas()) {
+            Rs_[globalIdx] = fs.Rs();
+        }
+        if (FluidSystem::enableVaporizedOil()) {
+            Rv_[globalIdx] = fs.Rv();
+        }
+        if (FluidSystem::enableDissolvedGasInWater()) {
+            Rsw_[globalIdx] = fs.Rsw();
+        }
+        if (FluidSystem::enableVaporizedWater()) {
+            Rvw_[globalIdx] = fs.Rvw();
+        }
+        pvtRegionIdx_[globalIdx] = fs.pvtRegionIndex();
+        porosity_[globalIdx] = intQuants.porosity();
+        rockCompTransMultiplier_[globalIdx] = intQuants.rockCompTransMultiplier();
+    }
+
+    //! \brief Return the compact intensive quantities of a degree of freedom.
+    BlackOilCompactIntensiveQuantities<TypeTag> operator[](unsigned globalIdx) const
+    { return BlackOilCompactIntensiveQuantities<TypeTag>(*this, globalIdx); }
+
+private:
+    friend class BlackOilCompactIntensiveQuantities<TypeTag>;
+
+    PhaseArrays pressure_{};
+    PhaseArrays saturation_{};
+    PhaseArrays density_{};
+    PhaseArrays invB_{};
+    PhaseArrays mobility_{};
+    std::vector<Evaluation> Rs_{};
+    std::vector<Evaluation> Rv_{};
+    std::vector<Evaluation> Rsw_{};
+    std::vector<Evaluation> Rvw_{};
+    std::vector<Evaluation> porosity_{};
+    std::vector<Evaluation> rockCompTransMultiplier_{};
+    std::vector<unsigned short> pvtRegionIdx_{};
+};
+
+/*!
+ * \ingroup BlackOilModel
+ * \ingroup IntensiveQuantities
+ *
+ * \brief The compact intensive quantities of a single degree of freedom.
+ *
+ * This is a light-weight reference into BlackOilCompactIntensiveQuantityArrays
+ * which provides the subset of the interface of BlackOilIntensiveQuantities
+ * and of its fluid state that is used by BlackOilLocalResidualTPFA. Objects
+ * of this class are meant to be passed by value, and are only valid as long
+ * as the arrays they refer to are not resized.
+ */
+template <class TypeTag>
+class BlackOilCompactIntensiveQuantities
+{
+    using Arrays = BlackOilCompactIntensiveQuantityArrays<TypeTag>;
+    using Evaluation = GetPropType<TypeTag, Properties::Evaluation>;
+
+public:
+    //! \copydoc BlackOilCompactIntensiveQuantityArrays::isSupported
+    static constexpr bool isSupported = Arrays::isSupported;
+
+    /*!
+     * \brief The part of the fluid state used by the local residual.
+     */
+    class FluidState
+    {
+    public:
+        FluidState(const Arrays& arrays, unsigned globalIdx)
+            : arrays_(&arrays)
+            , globalIdx_(globalIdx)
+        {}
+
+        const Evaluation& pressure(unsigned phaseIdx) const
+        { return arrays_->pressure_[phaseIdx][globalIdx_]; }
+
+        const Evaluation& saturation(unsigned phaseIdx) const
+        { return arrays_->saturation_[phaseIdx][globalIdx_]; }
+
+        const Evaluation& density(unsigned phaseIdx) const
+        { return arrays_->density_[phaseIdx][globalIdx_]; }
+
+        const Evaluation& invB(unsigned phaseIdx) const
+        { return arrays_->invB_[phaseIdx][globalIdx_]; }
+
+        const Evaluation& Rs() const
+        { return arrays_->Rs_[globalIdx_]; }
+
+        const Evaluation& Rv() const
+        { return arrays_->Rv_[globalIdx_]; }
+
+        const Evaluation& Rsw() const
+        { return arrays_->Rsw_[globalIdx_]; }
+
+        const Evaluation& Rvw() const
+        { return arrays_->Rvw_[globalIdx_]; }
+
+        unsigned short pvtRegionIndex() const
+        { return arrays_->pvtRegionIdx_[globalIdx_]; }
+
+    private:
+        const Arrays* arrays_;
+        unsigned globalIdx_;
+    };
+
+    BlackOilCompactIntensiveQuantities(const Arrays& arrays, unsigned globalIdx)
+        : fluidState_(arrays, globalIdx)
+        , arrays_(&arrays)
+        , globalIdx_(globalIdx)
+    {}
+
+    const FluidState& fluidState() const
+    { return fluidState_; }
+
+    const Evaluation& mobility(unsigned phaseIdx) const
+    { return arrays_->mobility_[phaseIdx][globalIdx_]; }
+
+    //! \brief Directional mobilities are not supported, the face direction
+    //!        is ignored.
+    const Evaluation& mobility(unsigned phaseIdx, FaceDir::DirEnum) const
+    { return mobility(phaseIdx); }
+
+    const Evaluation& porosity() const
+    { return arrays_->porosity_[globalIdx_]; }
+
+    const Evaluation& rockCompTransMultiplier() const
+    { return arrays_->rockCompTransMultiplier_[globalIdx_]; }
+
+    unsigned short pvtRegionIndex() const
+    { return fluidState_.pvtRegionIndex(); }
+
+private:
+    FluidState fluidState_;
+    const Arrays* arrays_;
+    unsigned globalIdx_;
+};
+
+} // namespace Opm
+
+#endif
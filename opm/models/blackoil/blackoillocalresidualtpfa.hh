@@ -39,10 +39,15 @@
 #include "blackoilconvectivemixingmodule.hh"
 #include "blackoildispersionmodule.hh"
 #include "blackoilmicpmodules.hh"
+#include <opm/material/densead/Evaluation.hpp>
 #include <opm/material/fluidstates/BlackOilFluidState.hpp>
 #include <opm/input/eclipse/EclipseState/Grid/FaceDir.hpp>
 #include <opm/input/eclipse/Schedule/BCProp.hpp>
 
+#include <algorithm>
+#include <array>
+#include <type_traits>
+
 namespace Opm {
 /*!
  * \ingroup BlackOilModel
@@ -148,9 +153,17 @@ public:
                        intQuants);
     }
 
-    template <class LhsEval>
+    /*!
+     * \brief Compute the storage term from the intensive quantities of a cell.
+     *
+     * IntQuants is either the full IntensiveQuantities class or
+     * BlackOilCompactIntensiveQuantities, a view into the per-quantity
+     * arrays of BlackOilCompactIntensiveQuantityArrays which is only used if
+     * none of the extension modules are enabled.
+     */
+    template <class LhsEval, class IntQuants>
     static void computeStorage(Dune::FieldVector<LhsEval, numEq>& storage,
-                               const IntensiveQuantities& intQuants)
+                               const IntQuants& intQuants)
     {
         OPM_TIMEBLOCK_LOCAL(computeStorage);
         // retrieve the intensive quantities for the SCV at the specified point in time
@@ -204,39 +217,45 @@ public:
 
         adaptMassConservationQuantities_(storage, intQuants.pvtRegionIndex());
 
-        // deal with solvents (if present)
-        SolventModule::addStorage(storage, intQuants);
+        if constexpr (std::is_same_v<IntQuants, IntensiveQuantities>) {
+            // deal with solvents (if present)
+            SolventModule::addStorage(storage, intQuants);
 
-        // deal with zFracton (if present)
-        ExtboModule::addStorage(storage, intQuants);
+            // deal with zFracton (if present)
+            ExtboModule::addStorage(storage, intQuants);
 
-        // deal with polymer (if present)
-        PolymerModule::addStorage(storage, intQuants);
+            // deal with polymer (if present)
+            PolymerModule::addStorage(storage, intQuants);
 
-        // deal with energy (if present)
-        EnergyModule::addStorage(storage, intQuants);
+            // deal with energy (if present)
+            EnergyModule::addStorage(storage, intQuants);
 
-        // deal with foam (if present)
-        FoamModule::addStorage(storage, intQuants);
+            // deal with foam (if present)
+            FoamModule::addStorage(storage, intQuants);
 
-        // deal with salt (if present)
-        BrineModule::addStorage(storage, intQuants);
+            // deal with salt (if present)
+            BrineModule::addStorage(storage, intQuants);
 
-        // deal with micp (if present)
-        MICPModule::addStorage(storage, intQuants);
+            // deal with micp (if present)
+            MICPModule::addStorage(storage, intQuants);
+        }
     }
 
     /*!
      * This function works like the ElementContext-based version with
      * one main difference: The darcy flux is calculated here, not
      * read from the extensive quantities of the element context.
+     *
+     * IntQuants is either the full IntensiveQuantities class or
+     * BlackOilCompactIntensiveQuantities.
      */
+    template <class IntQuants>
     static void computeFlux(RateVector& flux,
                             RateVector& darcy,
                             const unsigned globalIndexIn,
                             const unsigned globalIndexEx,
-                            const IntensiveQuantities& intQuantsIn,
-                            const IntensiveQuantities& intQuantsEx,
+                            const IntQuants& intQuantsIn,
+                            const IntQuants& intQuantsEx,
                             const ResidualNBInfo& nbInfo,
                             const ModuleParams& moduleParams)
     {
@@ -254,6 +273,73 @@ public:
                          moduleParams);
     }
 
+    //! \brief Whether computeFaceFlux() supports the enabled modules.
+    static constexpr bool supportsFaceFlux = !enableEnergy && !enableDiffusion && !enableDispersion
+                                             && !enableExtbo;
+
+    /*!
+     * \brief Whether computeFaceFlux() applies for the current module parameters.
+     *
+     * Convective mixing is compiled in by default, but only contributes to the
+     * flux in regions where it is switched on by the schedule.
+     */
+    static bool faceFluxApplicable(const ModuleParams& moduleParams)
+    {
+        if constexpr (enableConvectiveMixing) {
+            const auto& active = moduleParams.convectiveMixingModuleParam.active_;
+            return std::none_of(active.begin(), active.end(), [](const bool a) { return a; });
+        }
+        return true;
+    }
+
+    //! \brief Evaluation with derivatives w.r.t. the cells on both sides of a face.
+    using FaceEvaluation = DenseAd::Evaluation<Scalar, 2 * numEq>;
+    using FaceRateVector = std::array<FaceEvaluation, numEq>;
+
+    /*!
+     * \brief Compute the flux over an interior face with a single evaluation.
+     *
+     * Unlike computeFlux(), the result carries the derivatives with respect
+     * to the primary variables of both cells: derivative i < numEq is w.r.t.
+     * primary variable i of the interior cell, derivative numEq + i w.r.t.
+     * primary variable i of the exterior cell. Both are evaluated by
+     * calculateFluxes_(), so the value and the derivatives w.r.t. the
+     * interior cell are bitwise identical to the ones of computeFlux().
+     *
+     * The flux of the exterior cell is the negated flux. It is not bitwise
+     * identical to computeFlux() called from the exterior cell: there, the
+     * pressure difference is evaluated as (p_in - rho*dZg) - p_ex, which in
+     * floating point is not the exact negation of (p_ex + rho*dZg) - p_in,
+     * and the derivatives w.r.t. the exterior cell are computed along a
+     * different sequence of operations. Keeping those bits requires the
+     * second evaluation that this function avoids.
+     */
+    template <class IntQuants>
+    static void computeFaceFlux(FaceRateVector& flux,
+                                const unsigned globalIndexIn,
+                                const unsigned globalIndexEx,
+                                const IntQuants& intQuantsIn,
+                                const IntQuants& intQuantsEx,
+                                const ResidualNBInfo& nbInfo,
+                                const ModuleParams& moduleParams)
+    {
+        OPM_TIMEBLOCK_LOCAL(computeFaceFlux);
+        static_assert(supportsFaceFlux, "computeFaceFlux() does not support the enabled modules.");
+        assert(faceFluxApplicable(moduleParams));
+
+        std::fill(flux.begin(), flux.end(), FaceEvaluation(0.0));
+        RateVector darcy = 0.0;
+
+        calculateFluxes_(flux,
+                         darcy,
+                         intQuantsIn,
+                         intQuantsEx,
+                         globalIndexIn,
+                         globalIndexEx,
+                         nbInfo,
+                         moduleParams);
+    }
+
     // This function demonstrates compatibility with the ElementContext-based interface.
     // Actually using it will lead to double work since the element context already contains
     // fluxes through its stored ExtensiveQuantities.
@@ -322,16 +408,31 @@ public:
                          problem.moduleParams());
     }
 
-    static void calculateFluxes_(RateVector& flux,
+    /*!
+     * \brief Compute the flux over a face.
+     *
+     * FluxVector is either RateVector, which only carries the derivatives
+     * w.r.t. the interior cell, or FaceRateVector, see computeFaceFlux().
+     */
+    template <class FluxVector, class IntQuants>
+    static void calculateFluxes_(FluxVector& flux,
                                  RateVector& darcy,
-                                 const IntensiveQuantities& intQuantsIn,
-                                 const IntensiveQuantities& intQuantsEx,
+                                 const IntQuants& intQuantsIn,
+                                 const IntQuants& intQuantsEx,
                                  const unsigned& globalIndexIn,
                                  const unsigned& globalIndexEx,
                                  const ResidualNBInfo& nbInfo,
                                  const ModuleParams& moduleParams)
     {
         OPM_TIMEBLOCK_LOCAL(calculateFluxes);
+        using IntQuantsFluidState = std::decay_t<decltype(intQuantsIn.fluidState())>;
+        using FluxEval = std::decay_t<decltype(flux[0])>;
+        constexpr bool isFaceFlux = std::is_same_v<FluxEval, FaceEvaluation>;
+        // Quantities of the exterior cell are only needed as values, unless
+        // the derivatives w.r.t. the exterior cell are computed as well.
+        using ExteriorEval = std::conditional_t<isFaceFlux, Evaluation, Scalar>;
+        const CellToFlux_<FluxEval, /*interior=*/true> interiorEval;
+        const CellToFlux_<FluxEval, /*interior=*/false> exteriorEval;
         const Scalar Vin = nbInfo.Vin;
         const Scalar Vex = nbInfo.Vex;
         const Scalar distZg = nbInfo.dZg;
@@ -350,7 +451,7 @@ public:
             // fake intices should only be used to get upwind anc compatibility with old functions
             short interiorDofIdx = 0; // NB
             short exteriorDofIdx = 1; // NB
-            Evaluation pressureDifference;
+            FluxEval pressureDifference;
             ExtensiveQuantities::calculatePhasePressureDiff_(upIdx,
                                                              dnIdx,
                                                              pressureDifference,
@@ -365,20 +466,22 @@ public:
                                                              globalIndexEx,
                                                              distZg,
                                                              thpres,
-                                                             moduleParams);
+                                                             moduleParams,
+                                                             interiorEval,
+                                                             exteriorEval);
 
 
 
-            const IntensiveQuantities& up = (upIdx == interiorDofIdx) ? intQuantsIn : intQuantsEx;
+            const IntQuants& up = (upIdx == interiorDofIdx) ? intQuantsIn : intQuantsEx;
             unsigned globalUpIndex = (upIdx == interiorDofIdx) ? globalIndexIn : globalIndexEx;
             // Use arithmetic average (more accurate with harmonic, but that requires recomputing the transmissbility)
-            const Evaluation transMult = (intQuantsIn.rockCompTransMultiplier() + Toolbox::value(intQuantsEx.rockCompTransMultiplier()))/2;
-            Evaluation darcyFlux;
+            const FluxEval transMult = (interiorEval(intQuantsIn.rockCompTransMultiplier()) + exteriorEval(intQuantsEx.rockCompTransMultiplier()))/2;
+            FluxEval darcyFlux;
             if (globalUpIndex == globalIndexIn) {
-                    darcyFlux = pressureDifference * up.mobility(phaseIdx, facedir) * transMult * (-trans / faceArea);
+                    darcyFlux = pressureDifference * interiorEval(up.mobility(phaseIdx, facedir)) * transMult * (-trans / faceArea);
             } else {
                 darcyFlux = pressureDifference *
-                    (Toolbox::value(up.mobility(phaseIdx, facedir)) * transMult * (-trans / faceArea));
+                    (exteriorEval(up.mobility(phaseIdx, facedir)) * transMult * (-trans / faceArea));
             }
 
             unsigned activeCompIdx = Indices::canonicalToActiveComponentIndex(FluidSystem::solventComponentIndex(phaseIdx));
@@ -388,22 +491,22 @@ public:
             // if (upIdx == globalFocusDofIdx){
             if (globalUpIndex == globalIndexIn) {
                 const auto& invB
-                    = getInvB_<FluidSystem, FluidState, Evaluation>(up.fluidState(), phaseIdx, pvtRegionIdx);
-                const auto& surfaceVolumeFlux = invB * darcyFlux;
-                evalPhaseFluxes_<Evaluation, Evaluation, FluidState>(
-                    flux, phaseIdx, pvtRegionIdx, surfaceVolumeFlux, up.fluidState());
+                    = getInvB_<FluidSystem, IntQuantsFluidState, Evaluation>(up.fluidState(), phaseIdx, pvtRegionIdx);
+                const auto& surfaceVolumeFlux = interiorEval(invB) * darcyFlux;
+                evalPhaseFluxes_<Evaluation, FluxEval, IntQuantsFluidState>(
+                    flux, phaseIdx, pvtRegionIdx, surfaceVolumeFlux, up.fluidState(), interiorEval);
                 if constexpr (enableEnergy) {
-                    EnergyModule::template addPhaseEnthalpyFluxes_<Evaluation, Evaluation, FluidState>(
+                    EnergyModule::template addPhaseEnthalpyFluxes_<Evaluation, Evaluation, IntQuantsFluidState>(
                         flux, phaseIdx, darcyFlux, up.fluidState());
                 }
             } else {
-                const auto& invB = getInvB_<FluidSystem, FluidState, Scalar>(up.fluidState(), phaseIdx, pvtRegionIdx);
-                const auto& surfaceVolumeFlux = invB * darcyFlux;
-                evalPhaseFluxes_<Scalar, Evaluation, FluidState>(
-                    flux, phaseIdx, pvtRegionIdx, surfaceVolumeFlux, up.fluidState());
+                const auto& invB = getInvB_<FluidSystem, IntQuantsFluidState, ExteriorEval>(up.fluidState(), phaseIdx, pvtRegionIdx);
+                const auto& surfaceVolumeFlux = exteriorEval(invB) * darcyFlux;
+                evalPhaseFluxes_<ExteriorEval, FluxEval, IntQuantsFluidState>(
+                    flux, phaseIdx, pvtRegionIdx, surfaceVolumeFlux, up.fluidState(), exteriorEval);
                 if constexpr (enableEnergy) {
                     EnergyModule::template
-                        addPhaseEnthalpyFluxes_<Scalar, Evaluation, FluidState>
+                        addPhaseEnthalpyFluxes_<Scalar, Evaluation, IntQuantsFluidState>
                         (flux,phaseIdx,darcyFlux, up.fluidState());
                 }
             }
@@ -422,8 +525,9 @@ public:
         static_assert(!enablePolymer, "Relevant computeFlux() method must be implemented for this module before enabling.");
         // PolymerModule::computeFlux(flux, elemCtx, scvfIdx, timeIdx);
 
-        // deal with convective mixing
-        if constexpr(enableConvectiveMixing) {
+        // deal with convective mixing. Face fluxes are only computed if it is
+        // not active, see faceFluxApplicable().
+        if constexpr(enableConvectiveMixing && !isFaceFlux) {
             ConvectiveMixingModule::addConvectiveMixingFlux(flux,
                                                             intQuantsIn,
                                                             intQuantsEx,
@@ -732,6 +836,45 @@ public:
                         source[Indices::contiEnergyEqIdx] *= getPropValue<TypeTag, Properties::BlackOilEnergyScalingFactor>();
     }
 
+    // Convert a quantity of one cell to a FaceEvaluation, placing its
+    // derivatives at the given offset.
+    template <class Eval>
+    static FaceEvaluation lift_(const Eval& eval, const unsigned offset)
+    {
+        if constexpr (std::is_arithmetic_v<Eval>) {
+            return FaceEvaluation(eval);
+        }
+        else {
+            FaceEvaluation result(eval.value());
+            for (unsigned pvIdx = 0; pvIdx < numEq; ++pvIdx) {
+                result.setDerivative(offset + pvIdx, eval.derivative(pvIdx));
+            }
+            return result;
+        }
+    }
+
+    // Convert a quantity of the interior or the exterior cell of a face to
+    // the evaluation type of the flux. For Evaluation, the derivatives w.r.t.
+    // the exterior cell are dropped; for FaceEvaluation, they are placed
+    // after the ones w.r.t. the interior cell.
+    template <class FluxEval, bool interior>
+    struct CellToFlux_
+    {
+        template <class Eval>
+        decltype(auto) operator()(const Eval& eval) const
+        {
+            if constexpr (std::is_same_v<FluxEval, FaceEvaluation>) {
+                return lift_(eval, interior ? 0 : numEq);
+            }
+            else if constexpr (interior) {
+                return eval;
+            }
+            else {
+                return Scalar{getValue(eval)};
+            }
+        }
+    };
+
     template <class UpEval, class FluidState>
     static void evalPhaseFluxes_(RateVector& flux,
                                  unsigned phaseIdx,
@@ -749,12 +892,14 @@ public:
      * \brief Helper function to calculate the flux of mass in terms of conservation
      *        quantities via specific fluid phase over a face.
      */
-    template <class UpEval, class Eval,class FluidState>
-    static void evalPhaseFluxes_(RateVector& flux,
+    template <class UpEval, class Eval, class FluidState, class FluxVector = RateVector,
+              class UpToFlux = CellToFlux_<Evaluation, /*interior=*/true>>
+    static void evalPhaseFluxes_(FluxVector& flux,
                                  unsigned phaseIdx,
                                  unsigned pvtRegionIdx,
                                  const Eval& surfaceVolumeFlux,
-                                 const FluidState& upFs)
+                                 const FluidState& upFs,
+                                 const UpToFlux& upToFlux = {})
     {
         unsigned activeCompIdx = Indices::canonicalToActiveComponentIndex(FluidSystem::solventComponentIndex(phaseIdx));
 
@@ -770,9 +915,9 @@ public:
 
                 unsigned activeGasCompIdx = Indices::canonicalToActiveComponentIndex(gasCompIdx);
                 if (blackoilConserveSurfaceVolume)
-                    flux[conti0EqIdx + activeGasCompIdx] += Rs*surfaceVolumeFlux;
+                    flux[conti0EqIdx + activeGasCompIdx] += upToFlux(Rs)*surfaceVolumeFlux;
                 else
-                    flux[conti0EqIdx + activeGasCompIdx] += Rs*surfaceVolumeFlux*FluidSystem::referenceDensity(gasPhaseIdx, pvtRegionIdx);
+                    flux[conti0EqIdx + activeGasCompIdx] += upToFlux(Rs)*surfaceVolumeFlux*FluidSystem::referenceDensity(gasPhaseIdx, pvtRegionIdx);
             }
         } else  if (phaseIdx == waterPhaseIdx) {
             // dissolved gas (in the water phase).
@@ -781,9 +926,9 @@ public:
 
                 unsigned activeGasCompIdx = Indices::canonicalToActiveComponentIndex(gasCompIdx);
                 if (blackoilConserveSurfaceVolume)
-                    flux[conti0EqIdx + activeGasCompIdx] += Rsw*surfaceVolumeFlux;
+                    flux[conti0EqIdx + activeGasCompIdx] += upToFlux(Rsw)*surfaceVolumeFlux;
                 else
-                    flux[conti0EqIdx + activeGasCompIdx] += Rsw*surfaceVolumeFlux*FluidSystem::referenceDensity(gasPhaseIdx, pvtRegionIdx);
+                    flux[conti0EqIdx + activeGasCompIdx] += upToFlux(Rsw)*surfaceVolumeFlux*FluidSystem::referenceDensity(gasPhaseIdx, pvtRegionIdx);
             }
         }
         else if (phaseIdx == gasPhaseIdx) {
@@ -793,9 +938,9 @@ public:
 
                 unsigned activeOilCompIdx = Indices::canonicalToActiveComponentIndex(oilCompIdx);
                 if (blackoilConserveSurfaceVolume)
-                    flux[conti0EqIdx + activeOilCompIdx] += Rv*surfaceVolumeFlux;
+                    flux[conti0EqIdx + activeOilCompIdx] += upToFlux(Rv)*surfaceVolumeFlux;
                 else
-                    flux[conti0EqIdx + activeOilCompIdx] += Rv*surfaceVolumeFlux*FluidSystem::referenceDensity(oilPhaseIdx, pvtRegionIdx);
+                    flux[conti0EqIdx + activeOilCompIdx] += upToFlux(Rv)*surfaceVolumeFlux*FluidSystem::referenceDensity(oilPhaseIdx, pvtRegionIdx);
             }
              // vaporized water (in the gas phase).
             if (FluidSystem::enableVaporizedWater()) {
@@ -803,9 +948,9 @@ public:
 
                 unsigned activeWaterCompIdx = Indices::canonicalToActiveComponentIndex(waterCompIdx);
                 if (blackoilConserveSurfaceVolume)
-                    flux[conti0EqIdx + activeWaterCompIdx] += Rvw*surfaceVolumeFlux;
+                    flux[conti0EqIdx + activeWaterCompIdx] += upToFlux(Rvw)*surfaceVolumeFlux;
                 else
-                    flux[conti0EqIdx + activeWaterCompIdx] += Rvw*surfaceVolumeFlux*FluidSystem::referenceDensity(waterPhaseIdx, pvtRegionIdx);
+                    flux[conti0EqIdx + activeWaterCompIdx] += upToFlux(Rvw)*surfaceVolumeFlux*FluidSystem::referenceDensity(waterPhaseIdx, pvtRegionIdx);
             }
         }
     }
@@ -413,6 +413,10 @@ protected:
         }
 
         if (wasSwitched_[globalDofIdx]) {
+            // subdomains may be updated concurrently
+#ifdef _OPENMP
+#pragma omp atomic
+#endif
             ++numPriVarsSwitched_;
         }
         if (bparams_.projectSaturations_) {
@@ -428,8 +432,9 @@ private:
     BlackoilNewtonParams<Scalar> bparams_{};
 
     // keep track of cells where the primary variable meaning has changed
-    // to detect and hinder oscillations
-    std::vector<bool> wasSwitched_{};
+    // to detect and hinder oscillations. Not using std::vector<bool> such
+    // that different cells can be updated concurrently.
+    std::vector<unsigned char> wasSwitched_{};
 };
 
 } // namespace Opm
@@ -206,7 +206,7 @@ public:
 
         storage = 0;
 
-        ThreadedEntityIterator<GridView, /*codim=*/0> threadedElemIt(this->gridView());
+        ThreadedEntityIterator<GridView, /*codim=*/0> threadedElemIt(this->gridView(), this->elementChunks());
         std::mutex mutex;
 #ifdef _OPENMP
 #pragma omp parallel
@@ -31,9 +31,7 @@
 
 #include <opm/models/discretization/common/fvbaseproperties.hh>
 #include <opm/simulators/linalg/linalgproperties.hh>
-
-#include <set>
-#include <vector>
+#include <opm/simulators/linalg/sparsitypattern.hh>
 
 namespace Opm::Properties::Tag {
 
@@ -59,9 +57,6 @@ class BaseAuxiliaryModule
     using GlobalEqVector = GetPropType<TypeTag, Properties::GlobalEqVector>;
     using SparseMatrixAdapter = GetPropType<TypeTag, Properties::SparseMatrixAdapter>;
 
-protected:
-    using NeighborSet = std::set<unsigned>;
-
 public:
     virtual ~BaseAuxiliaryModule()
     {}
@@ -99,8 +94,11 @@ public:
     /*!
      * \brief Specify the additional neighboring correlations caused by the auxiliary
      *        module.
+     *
+     * The connections are added to the sparsity pattern using
+     * Linear::SparsityPattern::insert().
      */
-    virtual void addNeighbors(std::vector<NeighborSet>& neighbors) const = 0;
+    virtual void addNeighbors(Linear::SparsityPattern& sparsityPattern) const = 0;
 
     /*!
      * \brief Set the initial condition of the auxiliary module in the solution vector.
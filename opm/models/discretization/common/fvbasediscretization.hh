@@ -56,6 +56,7 @@
 #include <opm/models/io/vtkprimaryvarsmodule.hpp>
 
 #include <opm/models/parallel/gridcommhandles.hh>
+#include <opm/models/parallel/threadedentityiterator.hh>
 #include <opm/models/parallel/threadmanager.hpp>
 
 #include <opm/models/utils/alignedallocator.hh>
@@ -331,6 +332,7 @@ class FvBaseDiscretization
 
     using Element = typename GridView::template Codim<0>::Entity;
     using ElementIterator = typename GridView::template Codim<0>::Iterator;
+    using ThreadedElementIterator = ThreadedEntityIterator<GridView, /*codim=*/0>;
 
     using Toolbox = MathToolbox<Evaluation>;
     using VectorBlock = Dune::FieldVector<Evaluation, numEq>;
@@ -471,6 +473,10 @@ public:
      */
     void finishInit()
     {
+        // the chunks consist of iterators of the grid view, so they are
+        // created again when the grid has changed
+        elementChunks_ = ThreadedElementIterator::createChunks(gridView_);
+
         // initialize the volume of the finite volumes to zero
         size_t numDof = asImp_().numGridDof();
         dofTotalVolume_.resize(numDof);
@@ -723,7 +729,7 @@ public:
         invalidateIntensiveQuantitiesCache(timeIdx);
 
         // loop over all elements...
-        ThreadedEntityIterator<GridView, /*codim=*/0> threadedElemIt(gridView_);
+        ThreadedElementIterator threadedElemIt(gridView_, elementChunks_);
 #ifdef _OPENMP
 #pragma omp parallel
 #endif
@@ -882,7 +888,7 @@ public:
         dest = 0;
 
         std::mutex mutex;
-        ThreadedEntityIterator<GridView, /*codim=*/0> threadedElemIt(gridView_);
+        ThreadedElementIterator threadedElemIt(gridView_, elementChunks_);
 #ifdef _OPENMP
 #pragma omp parallel
 #endif
@@ -943,7 +949,7 @@ public:
         storage = 0;
 
         std::mutex mutex;
-        ThreadedEntityIterator<GridView, /*codim=*/0> threadedElemIt(gridView());
+        ThreadedElementIterator threadedElemIt(gridView_, elementChunks_);
 #ifdef _OPENMP
 #pragma omp parallel
 #endif
@@ -1682,7 +1688,7 @@ public:
         }
 
         // iterate over grid
-        ThreadedEntityIterator<GridView, /*codim=*/0> threadedElemIt(gridView());
+        ThreadedElementIterator threadedElemIt(gridView_, elementChunks_);
 #ifdef _OPENMP
 #pragma omp parallel
 #endif
@@ -1730,6 +1736,13 @@ public:
     const GridView& gridView() const
     { return gridView_; }
 
+    /*!
+     * \brief The chunks of elements of the grid view which are handed out to
+     *        the threads by ThreadedEntityIterator.
+     */
+    const typename ThreadedElementIterator::ChunkBoundaries& elementChunks() const
+    { return elementChunks_; }
+
     /*!
      * \brief Add a module for an auxiliary equation.
      *
@@ -1893,6 +1906,9 @@ protected:
     // the representation of the spatial domain of the problem
     GridView gridView_;
 
+    // the chunks of elements for threaded loops over the grid view
+    typename ThreadedElementIterator::ChunkBoundaries elementChunks_;
+
     // the mappers for element and vertex entities to global indices
     ElementMapper elementMapper_;
     VertexMapper vertexMapper_;
@@ -38,20 +38,38 @@
 #include <opm/models/parallel/gridcommhandles.hh>
 #include <opm/models/parallel/threadmanager.hpp>
 #include <opm/models/parallel/threadedentityiterator.hh>
+#include <opm/models/utils/parametersystem.hpp>
 #include <opm/models/discretization/common/baseauxiliarymodule.hh>
 
+#include <opm/simulators/linalg/sparsitypattern.hh>
+
 #include <dune/common/version.hh>
 #include <dune/common/fvector.hh>
 #include <dune/common/fmatrix.hh>
 
+#include <cstddef>
 #include <type_traits>
 #include <iostream>
+#include <limits>
+#include <numeric>
 #include <vector>
 #include <thread>
-#include <set>
 #include <exception>   // current_exception, rethrow_exception
 #include <mutex>
 
+namespace Opm::Parameters {
+
+/*!
+ * \brief Linearize the elements in groups of elements which do not share any degrees of
+ *        freedom instead of locking the global system of equations.
+ *
+ * This only has an effect for discretizations which require the linearization lock,
+ * i.e. where the stencils of neighboring elements overlap.
+ */
+struct ColoredLinearization { static constexpr bool value = false; };
+
+} // namespace Opm::Parameters
+
 namespace Opm {
 // forward declarations
 template<class TypeTag>
@@ -95,6 +113,7 @@ class FvBaseLinearizer
 
     using Element = typename GridView::template Codim<0>::Entity;
     using ElementIterator = typename GridView::template Codim<0>::Iterator;
+    using ElementSeed = typename Element::EntitySeed;
 
     using Vector = GlobalEqVector;
 
@@ -131,7 +150,11 @@ public:
      * \brief Register all run-time parameters for the Jacobian linearizer.
      */
     static void registerParameters()
-    { }
+    {
+        Parameters::Register<Parameters::ColoredLinearization>
+            ("Linearize groups of elements with disjoint stencils concurrently instead "
+             "of locking the global system of equations for each element.");
+    }
 
     /*!
      * \brief Initialize the linearizer.
@@ -153,6 +176,8 @@ public:
         }
         elementCtx_.resize(0);
         fullDomain_ = std::make_unique<FullDomain>(simulator.gridView());
+        coloredLinearization_ = getPropValue<TypeTag, Properties::UseLinearizationLock>()
+            && Parameters::Get<Parameters::ColoredLinearization>();
     }
 
     /*!
@@ -421,10 +446,21 @@ private:
         Stencil stencil(gridView_(), model_().dofMapper());
 
         // for the main model, find out the global indices of the neighboring degrees of
-        // freedom of each primary degree of freedom
-        sparsityPattern_.clear();
-        sparsityPattern_.resize(model.numTotalDof());
+        // freedom of each primary degree of freedom. the first pass over the grid counts
+        // the (possibly duplicate) neighbors of each degree of freedom, the second one
+        // records them.
+        Linear::SparsityPattern sparsityPattern(model.numTotalDof());
 
+        for (const auto& elem : elements(gridView_())) {
+            stencil.update(elem);
+
+            for (unsigned primaryDofIdx = 0; primaryDofIdx < stencil.numPrimaryDof(); ++primaryDofIdx) {
+                unsigned myIdx = stencil.globalSpaceIndex(primaryDofIdx);
+                sparsityPattern.incrementRowSize(myIdx, stencil.numDof());
+            }
+        }
+
+        sparsityPattern.allocate();
         for (const auto& elem : elements(gridView_())) {
             stencil.update(elem);
 
@@ -433,7 +469,7 @@ private:
 
                 for (unsigned dofIdx = 0; dofIdx < stencil.numDof(); ++dofIdx) {
                     unsigned neighborIdx = stencil.globalSpaceIndex(dofIdx);
-                    sparsityPattern_[myIdx].insert(neighborIdx);
+                    sparsityPattern.addIndex(myIdx, neighborIdx);
                 }
             }
         }
@@ -442,13 +478,114 @@ private:
         // equations
         size_t numAuxMod = model.numAuxiliaryModules();
         for (unsigned auxModIdx = 0; auxModIdx < numAuxMod; ++auxModIdx)
-            model.auxiliaryModule(auxModIdx)->addNeighbors(sparsityPattern_);
+            model.auxiliaryModule(auxModIdx)->addNeighbors(sparsityPattern);
+        sparsityPattern.compress();
 
         // allocate raw matrix
         jacobian_.reset(new SparseMatrixAdapter(simulator_()));
 
         // create matrix structure based on sparsity pattern
-        jacobian_->reserve(sparsityPattern_);
+        jacobian_->reserve(sparsityPattern);
+
+        if (coloredLinearization_) {
+            createElementColors_();
+        }
+    }
+
+    // Group the elements into colors such that no two elements of a color share a
+    // degree of freedom, and record the addresses of the matrix blocks to which each
+    // element contributes. The elements of a color can thus be linearized
+    // concurrently without locking the global system of equations, and without
+    // searching the rows of the matrix for the blocks.
+    void createElementColors_()
+    {
+        OPM_TIMEBLOCK(createElementColors);
+        Stencil stencil(gridView_(), dofMapper_());
+
+        // the degrees of freedom of all elements which need to be linearized, the
+        // primary ones first
+        std::vector<ElementSeed> seeds;
+        std::vector<unsigned> numPrimaryDof;
+        SparseTable<unsigned> elementDofs;
+        std::vector<unsigned> dofs;
+        for (const auto& elem : elements(gridView_())) {
+            if (!linearizeNonLocalElements && elem.partitionType() != Dune::InteriorEntity)
+                continue;
+
+            stencil.update(elem);
+            dofs.resize(stencil.numDof());
+            for (unsigned dofIdx = 0; dofIdx < stencil.numDof(); ++dofIdx)
+                dofs[dofIdx] = stencil.globalSpaceIndex(dofIdx);
+
+            seeds.push_back(elem.seed());
+            numPrimaryDof.push_back(stencil.numPrimaryDof());
+            elementDofs.appendRow(dofs.begin(), dofs.end());
+        }
+        const std::size_t numElements = seeds.size();
+
+        // the elements which are adjacent to each degree of freedom
+        std::vector<std::size_t> dofElementStart(model_().numTotalDof() + 1, 0);
+        for (std::size_t elemIdx = 0; elemIdx < numElements; ++elemIdx) {
+            for (const unsigned globJ : elementDofs[elemIdx])
+                ++dofElementStart[globJ + 1];
+        }
+        std::partial_sum(dofElementStart.begin(), dofElementStart.end(), dofElementStart.begin());
+        std::vector<std::size_t> dofElements(dofElementStart.back());
+        std::vector<std::size_t> pos(dofElementStart.begin(), dofElementStart.end() - 1);
+        for (std::size_t elemIdx = 0; elemIdx < numElements; ++elemIdx) {
+            for (const unsigned globJ : elementDofs[elemIdx])
+                dofElements[pos[globJ]++] = elemIdx;
+        }
+
+        // greedy coloring in the order of the grid. usedBy[c] is the last element which
+        // found color c amongst its neighbors.
+        const unsigned noColor = std::numeric_limits<unsigned>::max();
+        std::vector<unsigned> color(numElements, noColor);
+        std::vector<std::size_t> usedBy;
+        for (std::size_t elemIdx = 0; elemIdx < numElements; ++elemIdx) {
+            for (const unsigned globJ : elementDofs[elemIdx]) {
+                for (std::size_t k = dofElementStart[globJ]; k < dofElementStart[globJ + 1]; ++k) {
+                    const unsigned neighborColor = color[dofElements[k]];
+                    if (neighborColor != noColor)
+                        usedBy[neighborColor] = elemIdx;
+                }
+            }
+
+            unsigned elemColor = 0;
+            while (elemColor < usedBy.size() && usedBy[elemColor] == elemIdx)
+                ++elemColor;
+            if (elemColor == usedBy.size())
+                usedBy.push_back(numElements);
+            color[elemIdx] = elemColor;
+        }
+
+        // sort the elements by color, but keep the order of the grid within each color
+        colorStart_.assign(usedBy.size() + 1, 0);
+        for (std::size_t elemIdx = 0; elemIdx < numElements; ++elemIdx)
+            ++colorStart_[color[elemIdx] + 1];
+        std::partial_sum(colorStart_.begin(), colorStart_.end(), colorStart_.begin());
+        std::vector<std::size_t> order(numElements);
+        pos.assign(colorStart_.begin(), colorStart_.end() - 1);
+        for (std::size_t elemIdx = 0; elemIdx < numElements; ++elemIdx)
+            order[pos[color[elemIdx]]++] = elemIdx;
+
+        // the matrix blocks in the order in which linearizeColoredElement_() visits them
+        coloredElements_.clear();
+        coloredElements_.reserve(numElements);
+        elementBlockAddress_.clear();
+        std::vector<MatrixBlock*> blockAddresses;
+        for (const std::size_t elemIdx : order) {
+            coloredElements_.push_back(seeds[elemIdx]);
+
+            const auto& elemDofs = elementDofs[elemIdx];
+            blockAddresses.clear();
+            for (unsigned primaryDofIdx = 0; primaryDofIdx < numPrimaryDof[elemIdx]; ++primaryDofIdx) {
+                const unsigned globI = elemDofs[primaryDofIdx];
+                for (const unsigned globJ : elemDofs)
+                    blockAddresses.push_back(jacobian_->blockAddress(globJ, globI));
+            }
+            elementBlockAddress_.appendRow(blockAddresses.begin(), blockAddresses.end());
+        }
     }
 
     // reset the global linear system of equations.
@@ -470,7 +607,7 @@ private:
         constraintsMap_.clear();
 
         // loop over all elements...
-        ThreadedEntityIterator<GridView, /*codim=*/0> threadedElemIt(gridView_());
+        ThreadedEntityIterator<GridView, /*codim=*/0> threadedElemIt(gridView_(), model_().elementChunks());
 #ifdef _OPENMP
 #pragma omp parallel
 #endif
@@ -523,6 +660,14 @@ private:
 
         applyConstraintsToSolution_();
 
+        if constexpr (std::is_same_v<SubDomainType, FullDomain>) {
+            if (!colorStart_.empty()) {
+                linearizeColored_();
+                applyConstraintsToLinearization_();
+                return;
+            }
+        }
+
         // to avoid a race condition if two threads handle an exception at the same time,
         // we use an explicit lock to control access to the exception storage object
         // amongst thread-local handlers
@@ -625,6 +770,71 @@ private:
             globalMatrixMutex_.unlock();
     }
 
+    // linearize the full domain one color of elements at a time
+    void linearizeColored_()
+    {
+        OPM_TIMEBLOCK(linearizeColored);
+        std::mutex exceptionLock;
+        std::exception_ptr exceptionPtr = nullptr;
+
+        for (std::size_t colorIdx = 0; colorIdx + 1 < colorStart_.size(); ++colorIdx) {
+            const std::size_t colorBegin = colorStart_[colorIdx];
+            const std::size_t colorEnd = colorStart_[colorIdx + 1];
+#ifdef _OPENMP
+#pragma omp parallel for
+#endif
+            for (std::size_t idx = colorBegin; idx < colorEnd; ++idx) {
+                try {
+                    // give the model and the problem a chance to prefetch the data
+                    // required to linearize the next element of the color. all
+                    // colored elements need to be linearized.
+                    if (idx + 1 < colorEnd) {
+                        const auto nextElem = gridView_().grid().entity(coloredElements_[idx + 1]);
+                        model_().prefetch(nextElem);
+                        problem_().prefetch(nextElem);
+                    }
+
+                    linearizeColoredElement_(idx);
+                }
+                // see linearize_() for why exceptions are bridged out of the
+                // parallel loop like this
+                catch(...) {
+                    std::lock_guard<std::mutex> take(exceptionLock);
+                    exceptionPtr = std::current_exception();
+                }
+            }
+
+            if (exceptionPtr) {
+                std::rethrow_exception(exceptionPtr);
+            }
+        }
+    }
+
+    // linearize an element of the current color. no other element of the color
+    // touches the degrees of freedom of its stencil, so the global system is updated
+    // without locking.
+    void linearizeColoredElement_(std::size_t idx)
+    {
+        unsigned threadId = ThreadManager::threadId();
+
+        ElementContext *elementCtx = elementCtx_[threadId];
+        auto& localLinearizer = model_().localLinearizer(threadId);
+
+        const auto elem = gridView_().grid().entity(coloredElements_[idx]);
+        localLinearizer.linearize(*elementCtx, elem);
+
+        auto blockAddressIt = elementBlockAddress_[idx].begin();
+        size_t numPrimaryDof = elementCtx->numPrimaryDof(/*timeIdx=*/0);
+        size_t numDof = elementCtx->numDof(/*timeIdx=*/0);
+        for (unsigned primaryDofIdx = 0; primaryDofIdx < numPrimaryDof; ++ primaryDofIdx) {
+            unsigned globI = elementCtx->globalSpaceIndex(/*spaceIdx=*/primaryDofIdx, /*timeIdx=*/0);
+            residual_[globI] += localLinearizer.residual(primaryDofIdx);
+
+            for (unsigned dofIdx = 0; dofIdx < numDof; ++ dofIdx, ++ blockAddressIt)
+                **blockAddressIt += localLinearizer.jacobian(dofIdx, primaryDofIdx);
+        }
+    }
+
     // apply the constraints to the solution. (i.e., the solution of constraint degrees
     // of freedom is set to the value of the constraint.)
     void applyConstraintsToSolution_()
@@ -695,7 +905,13 @@ private:
 
     std::mutex globalMatrixMutex_;
 
-    std::vector<std::set<unsigned int>> sparsityPattern_;
+    // the elements sorted by color for the lock-free linearization, and the
+    // addresses of the matrix blocks to which they contribute
+    bool coloredLinearization_ = false;
+    std::vector<ElementSeed> coloredElements_;
+    std::vector<std::size_t> colorStart_;
+    SparseTable<MatrixBlock*> elementBlockAddress_;
+
 
     struct FullDomain
     {
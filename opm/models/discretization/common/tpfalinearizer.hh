@@ -44,16 +44,23 @@
 #include <opm/models/discretization/common/fvbaseproperties.hh>
 #include <opm/models/discretization/common/linearizationtype.hh>
 
+#include <opm/simulators/linalg/sparsitypattern.hh>
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
 #include <exception>   // current_exception, rethrow_exception
 #include <iostream>
+#include <limits>
 #include <numeric>
-#include <set>
 #include <type_traits>
+#include <utility>
 #include <vector>
 
 namespace Opm::Parameters {
 
 struct SeparateSparseSourceTerms { static constexpr bool value = false; };
+struct FaceBasedLinearization { static constexpr bool value = false; };
 
 } // namespace Opm::Parameters
 
@@ -63,6 +70,19 @@ namespace Opm {
 template<class TypeTag>
 class EcfvDiscretization;
 
+namespace detail {
+
+//! \brief Whether a local residual can evaluate the flux over a face with
+//!        derivatives w.r.t. both cells, see TpfaLinearizer::addFaceFlux_().
+template <class LocalResidual, class = void>
+struct SupportsFaceFlux : std::false_type {};
+
+template <class LocalResidual>
+struct SupportsFaceFlux<LocalResidual, std::void_t<decltype(LocalResidual::supportsFaceFlux)>>
+    : std::bool_constant<LocalResidual::supportsFaceFlux> {};
+
+} // namespace detail
+
 /*!
  * \ingroup FiniteVolumeDiscretizations
  *
@@ -104,6 +124,7 @@ class TpfaLinearizer
     using MatrixBlock = typename SparseMatrixAdapter::MatrixBlock;
     using VectorBlock = Dune::FieldVector<Scalar, numEq>;
     using ADVectorBlock = GetPropType<TypeTag, Properties::RateVector>;
+    using Clock = std::chrono::steady_clock;
 
     static const bool linearizeNonLocalElements = getPropValue<TypeTag, Properties::LinearizeNonLocalElements>();
     static const bool enableEnergy = getPropValue<TypeTag, Properties::EnableEnergy>();
@@ -119,6 +140,7 @@ public:
     {
         simulatorPtr_ = 0;
         separateSparseSourceTerms_ = Parameters::Get<Parameters::SeparateSparseSourceTerms>();
+        faceBasedLinearization_ = Parameters::Get<Parameters::FaceBasedLinearization>();
     }
 
     ~TpfaLinearizer()
@@ -132,6 +154,9 @@ public:
     {
         Parameters::Register<Parameters::SeparateSparseSourceTerms>
             ("Treat well source terms all in one go, instead of on a cell by cell basis.");
+        Parameters::Register<Parameters::FaceBasedLinearization>
+            ("Assemble the interior fluxes by looping over the unique faces of the grid "
+             "instead of over the cells, evaluating the flux of each face once.");
     }
 
     /*!
@@ -225,6 +250,25 @@ public:
      */
     template <class SubDomainType>
     void linearizeDomain(const SubDomainType& domain)
+    {
+        linearizeDomain(domain, model_().newtonMethod().numIterations(),
+                        /*concurrent=*/false);
+    }
+
+    /*!
+     * \brief Linearize a subdomain within a non-linear solve of its own.
+     *
+     * \param iterationIdx The index of the Newton iteration of the subdomain
+     *                     solve, used instead of the one of the Newton method.
+     * \param concurrent If true, other subdomains may be linearized at the
+     *                   same time. The matrix rows of the cells outside of
+     *                   the domain are then left alone, they are neither
+     *                   reset nor used by the subdomain solve.
+     */
+    template <class SubDomainType>
+    void linearizeDomain(const SubDomainType& domain,
+                         const int iterationIdx,
+                         const bool concurrent)
     {
         OPM_TIMEBLOCK(linearizeDomain);
         // we defer the initialization of the Jacobian matrix until here because the
@@ -241,7 +285,7 @@ public:
             resetSystem_(domain);
         }
 
-        linearize_(domain);
+        linearize_(domain, iterationIdx, concurrent);
     }
 
     void finalize()
@@ -358,6 +402,31 @@ public:
         }
     }
 
+    /*!
+     * \brief Measure the time spent linearizing each cell from now on.
+     *
+     * The time of the flux terms is split evenly between the two cells of
+     * a face. The measured times are returned by cellTimes() and add up
+     * until resetCellTimes() is called.
+     */
+    void setMeasureCellTimes(bool measure)
+    {
+        measureCellTimes_ = measure;
+        resetCellTimes();
+    }
+
+    /*!
+     * \brief Return the time in seconds spent linearizing each cell since
+     *        the last call of resetCellTimes().
+     *
+     * (This object is only non-empty if the times are measured.)
+     */
+    const std::vector<double>& cellTimes() const
+    { return cellTimes_; }
+
+    void resetCellTimes()
+    { cellTimes_.assign(measureCellTimes_ ? model_().numTotalDof() : 0, 0.0); }
+
     /*!
      * \brief Returns the map of constraint degrees of freedom.
      *
@@ -424,8 +493,6 @@ private:
 
         // for the main model, find out the global indices of the neighboring degrees of
         // freedom of each primary degree of freedom
-        using NeighborSet = std::set< unsigned >;
-        std::vector<NeighborSet> sparsityPattern(model.numTotalDof());
         const Scalar gravity = problem_().gravity()[dimWorld - 1];
         unsigned numCells = model.numTotalDof();
         neighborInfo_.reserve(numCells, 6 * numCells);
@@ -439,7 +506,6 @@ private:
 
                 for (unsigned dofIdx = 0; dofIdx < stencil.numDof(); ++dofIdx) {
                     unsigned neighborIdx = stencil.globalSpaceIndex(dofIdx);
-                    sparsityPattern[myIdx].insert(neighborIdx);
                     if (dofIdx > 0) {
                         const Scalar trans = problem_().transmissibility(myIdx, neighborIdx);
                         const auto scvfIdx = dofIdx - 1;
@@ -500,17 +566,41 @@ private:
             }
         }
 
+        // create the sparsity pattern: every cell is connected to itself and to the
+        // neighbors found above. The rows are independent of each other.
+        Linear::SparsityPattern sparsityPattern(numCells);
+#ifdef _OPENMP
+#pragma omp parallel for
+#endif
+        for (unsigned globI = 0; globI < numCells; ++globI) {
+            sparsityPattern.incrementRowSize(globI, neighborInfo_[globI].size() + 1);
+        }
+        sparsityPattern.allocate();
+#ifdef _OPENMP
+#pragma omp parallel for
+#endif
+        for (unsigned globI = 0; globI < numCells; ++globI) {
+            sparsityPattern.addIndex(globI, globI);
+            for (const auto& nbInfo : neighborInfo_[globI]) {
+                sparsityPattern.addIndex(globI, nbInfo.neighbor);
+            }
+        }
+
         // add the additional neighbors and degrees of freedom caused by the auxiliary
         // equations
         size_t numAuxMod = model.numAuxiliaryModules();
         for (unsigned auxModIdx = 0; auxModIdx < numAuxMod; ++auxModIdx)
             model.auxiliaryModule(auxModIdx)->addNeighbors(sparsityPattern);
+        sparsityPattern.compress();
 
         // allocate raw matrix
         jacobian_.reset(new SparseMatrixAdapter(simulator_()));
         diagMatAddress_.resize(numCells);
         // create matrix structure based on sparsity pattern
         jacobian_->reserve(sparsityPattern);
+#ifdef _OPENMP
+#pragma omp parallel for
+#endif
         for (unsigned globI = 0; globI < numCells; globI++) {
             const auto& nbInfos = neighborInfo_[globI];
             diagMatAddress_[globI] = jacobian_->blockAddress(globI, globI);
@@ -522,6 +612,131 @@ private:
         // Create dummy full domain.
         fullDomain_.cells.resize(numCells);
         std::iota(fullDomain_.cells.begin(), fullDomain_.cells.end(), 0);
+
+        if (faceBasedLinearization_) {
+            createFaceLevels_();
+        }
+    }
+
+    // Set up the list of unique interior faces for the face-based assembly.
+    //
+    // The faces are grouped into levels such that no two faces of a level
+    // share a cell, and such that each cell encounters its faces in the same
+    // order as they are stored in neighborInfo_. The first property allows
+    // the faces of a level to be assembled concurrently without locking, the
+    // second one makes the accumulation order of every matrix row identical
+    // to the one of the cell-based loop and independent of the number of
+    // threads. If the local residual provides computeFaceFlux(), the flux of
+    // a face is evaluated once and its negation is added to the exterior
+    // cell. The interior rows are then bitwise identical to the ones of the
+    // cell-based loop, the exterior rows agree up to rounding because the
+    // cell-based loop evaluates the flux from the exterior side with its own
+    // rounding (see BlackOilLocalResidualTPFA::computeFaceFlux()). Otherwise
+    // both one-sided fluxes are evaluated and the results are bitwise
+    // identical to the ones of the cell-based loop.
+    void createFaceLevels_()
+    {
+        OPM_TIMEBLOCK(createFaceLevels);
+        const unsigned numCells = model_().numTotalDof();
+
+        // offsets of the per-cell neighbor entries in a flat array
+        std::vector<std::size_t> entryStart(numCells + 1, 0);
+        for (unsigned globI = 0; globI < numCells; ++globI) {
+            entryStart[globI + 1] = entryStart[globI] + neighborInfo_[globI].size();
+        }
+        const std::size_t numEntries = entryStart.back();
+        constexpr auto noFace = std::numeric_limits<unsigned>::max();
+        std::vector<unsigned> entryFace(numEntries, noFace);
+
+        // find the unique faces and both of their neighbor entries. Multiple
+        // connections between the same pair of cells are matched by their
+        // order of appearance.
+        std::vector<Face> faces;
+        faces.reserve(numEntries / 2);
+        for (unsigned globI = 0; globI < numCells; ++globI) {
+            const auto& nbInfos = neighborInfo_[globI];
+            for (unsigned locI = 0; locI < nbInfos.size(); ++locI) {
+                const unsigned globJ = nbInfos[locI].neighbor;
+                if (globJ < globI) {
+                    continue;
+                }
+                unsigned occurrence = 0;
+                for (unsigned l = 0; l < locI; ++l) {
+                    occurrence += (nbInfos[l].neighbor == globJ);
+                }
+                const auto& nbInfosJ = neighborInfo_[globJ];
+                unsigned locJ = 0;
+                for (; locJ < nbInfosJ.size(); ++locJ) {
+                    if (nbInfosJ[locJ].neighbor == globI && occurrence-- == 0) {
+                        break;
+                    }
+                }
+                if (locJ == nbInfosJ.size()) {
+                    // non-symmetric connectivity, use the cell-based loop
+                    return;
+                }
+                entryFace[entryStart[globI] + locI] = faces.size();
+                entryFace[entryStart[globJ] + locJ] = faces.size();
+                faces.push_back(Face{globI, locI, globJ, locJ});
+            }
+        }
+        if (std::find(entryFace.begin(), entryFace.end(), noFace) != entryFace.end()) {
+            return;
+        }
+
+        // Each face must be assembled after the preceding face of both its
+        // cells. Compute the levels as the longest paths in this dependency
+        // graph (Kahn's algorithm).
+        const std::size_t numFaces = faces.size();
+        std::vector<unsigned> numPredecessors(numFaces, 0);
+        std::vector<unsigned> level(numFaces, 0);
+        for (unsigned globI = 0; globI < numCells; ++globI) {
+            for (std::size_t e = entryStart[globI] + 1; e < entryStart[globI + 1]; ++e) {
+                ++numPredecessors[entryFace[e]];
+            }
+        }
+        std::vector<unsigned> ready;
+        for (unsigned faceIdx = 0; faceIdx < numFaces; ++faceIdx) {
+            if (numPredecessors[faceIdx] == 0) {
+                ready.push_back(faceIdx);
+            }
+        }
+        std::size_t numProcessed = 0;
+        unsigned numLevels = 0;
+        while (!ready.empty()) {
+            const unsigned faceIdx = ready.back();
+            ready.pop_back();
+            ++numProcessed;
+            numLevels = std::max(numLevels, level[faceIdx] + 1);
+            const auto& face = faces[faceIdx];
+            for (const auto& [cell, loc] : { std::pair{face.cellIn, face.locIn},
+                                             std::pair{face.cellEx, face.locEx} }) {
+                const std::size_t next = entryStart[cell] + loc + 1;
+                if (next < entryStart[cell + 1]) {
+                    const unsigned succ = entryFace[next];
+                    level[succ] = std::max(level[succ], level[faceIdx] + 1);
+                    if (--numPredecessors[succ] == 0) {
+                        ready.push_back(succ);
+                    }
+                }
+            }
+        }
+        if (numProcessed != numFaces) {
+            // the cells' face orderings are cyclic, use the cell-based loop
+            return;
+        }
+
+        // sort the faces by level
+        faceLevelStart_.assign(numLevels + 1, 0);
+        for (unsigned faceIdx = 0; faceIdx < numFaces; ++faceIdx) {
+            ++faceLevelStart_[level[faceIdx] + 1];
+        }
+        std::partial_sum(faceLevelStart_.begin(), faceLevelStart_.end(), faceLevelStart_.begin());
+        std::vector<std::size_t> pos(faceLevelStart_.begin(), faceLevelStart_.end() - 1);
+        faces_.resize(numFaces);
+        for (unsigned faceIdx = 0; faceIdx < numFaces; ++faceIdx) {
+            faces_[pos[level[faceIdx]]++] = faces[faceIdx];
+        }
     }
 
     // reset the global linear system of equations.
@@ -708,7 +923,31 @@ public:
 
 private:
     template <class SubDomainType>
-    void linearize_(const SubDomainType& domain)
+    void linearize_(const SubDomainType& domain,
+                    const int iterationIdx,
+                    const bool concurrent)
+    {
+        // Read the compact copies of the intensive quantities if the model
+        // provides them, they are cheaper to access. These are returned by
+        // value as light-weight references into per-quantity arrays.
+        if constexpr (Model::CompactIntensiveQuantities::isSupported) {
+            if (model_().useCompactIntensiveQuantities()) {
+                linearize_(domain, iterationIdx, concurrent,
+                           [this](unsigned globI)
+                           { return model_().compactIntensiveQuantities(globI); });
+                return;
+            }
+        }
+        linearize_(domain, iterationIdx, concurrent,
+                   [this](unsigned globI) -> decltype(auto)
+                   { return model_().intensiveQuantities(globI, /*timeIdx*/ 0); });
+    }
+
+    template <class SubDomainType, class IntensiveQuantitiesFunction>
+    void linearize_(const SubDomainType& domain,
+                    const int iterationIdx,
+                    const bool concurrent,
+                    const IntensiveQuantitiesFunction& intensiveQuantities)
     {
         // This check should be removed once this is addressed by
         // for example storing the previous timesteps' values for
@@ -728,48 +967,62 @@ private:
         const unsigned int numCells = domain.cells.size();
         const bool on_full_domain = (numCells == model_().numTotalDof());
 
+        const bool useFaceLevels = on_full_domain && !faceLevelStart_.empty();
+        bool useFaceFlux = false;
+        if constexpr (detail::SupportsFaceFlux<LocalResidual>::value) {
+            useFaceFlux = useFaceLevels && !enableDispersion
+                && LocalResidual::faceFluxApplicable(problem_().moduleParams());
+        }
+
+        if (useFaceLevels) {
+            // Flux terms, each face is visited once. Faces of the same level
+            // do not share any cells.
+            OPM_TIMEBLOCK(linearizeFaces);
+            for (std::size_t levelIdx = 0; levelIdx + 1 < faceLevelStart_.size(); ++levelIdx) {
+                const std::size_t levelBegin = faceLevelStart_[levelIdx];
+                const std::size_t levelEnd = faceLevelStart_[levelIdx + 1];
+#ifdef _OPENMP
+#pragma omp parallel for
+#endif
+                for (std::size_t faceIdx = levelBegin; faceIdx < levelEnd; ++faceIdx) {
+                    const auto& face = faces_[faceIdx];
+                    const auto faceStart = measureCellTimes_ ? Clock::now() : Clock::time_point{};
+                    linearizeFace_(faceIdx, intensiveQuantities, useFaceFlux, enableDispersion);
+                    if (measureCellTimes_) {
+                        const double halfTime =
+                            0.5 * std::chrono::duration<double>(Clock::now() - faceStart).count();
+                        cellTimes_[face.cellIn] += halfTime;
+                        cellTimes_[face.cellEx] += halfTime;
+                    }
+                }
+            }
+        }
+
 #ifdef _OPENMP
 #pragma omp parallel for
 #endif
         for (unsigned ii = 0; ii < numCells; ++ii) {
             OPM_TIMEBLOCK_LOCAL(linearizationForEachCell);
             const unsigned globI = domain.cells[ii];
-            const auto& nbInfos = neighborInfo_[globI];
+            const auto cellStart = measureCellTimes_ ? Clock::now() : Clock::time_point{};
             VectorBlock res(0.0);
             MatrixBlock bMat(0.0);
             ADVectorBlock adres(0.0);
-            ADVectorBlock darcyFlux(0.0);
-            const IntensiveQuantities& intQuantsIn = model_().intensiveQuantities(globI, /*timeIdx*/ 0);
+            const auto& intQuantsIn = intensiveQuantities(globI);
 
             // Flux term.
-            {
-            OPM_TIMEBLOCK_LOCAL(fluxCalculationForEachCell);
-            short loc = 0;
-            for (const auto& nbInfo : nbInfos) {
-                OPM_TIMEBLOCK_LOCAL(fluxCalculationForEachFace);
-                unsigned globJ = nbInfo.neighbor;
-                assert(globJ != globI);
-                res = 0.0;
-                bMat = 0.0;
-                adres = 0.0;
-                darcyFlux = 0.0;
-                const IntensiveQuantities& intQuantsEx = model_().intensiveQuantities(globJ, /*timeIdx*/ 0);
-                LocalResidual::computeFlux(adres,darcyFlux, globI, globJ, intQuantsIn, intQuantsEx, nbInfo.res_nbinfo,  problem_().moduleParams());
-                adres *= nbInfo.res_nbinfo.faceArea;
-                if (enableDispersion) {
-                    for (unsigned phaseIdx = 0; phaseIdx < numEq; ++ phaseIdx) {
-                        velocityInfo_[globI][loc].velocity[phaseIdx] = darcyFlux[phaseIdx].value() / nbInfo.res_nbinfo.faceArea;
-                    }
+            if (!useFaceLevels) {
+                OPM_TIMEBLOCK_LOCAL(fluxCalculationForEachCell);
+                const auto& nbInfos = neighborInfo_[globI];
+                for (unsigned loc = 0; loc < nbInfos.size(); ++loc) {
+                    const unsigned globJ = nbInfos[loc].neighbor;
+                    const auto& intQuantsEx = intensiveQuantities(globJ);
+                    // Rows of cells outside a subdomain may be assembled by
+                    // a concurrent solve of another subdomain. Leave them alone.
+                    const bool addToNeighbor = !concurrent ||
+                        (globJ < domain.interior.size() && domain.interior[globJ]);
+                    addFlux_(globI, loc, intQuantsIn, intQuantsEx, enableDispersion, addToNeighbor);
                 }
-                setResAndJacobi(res, bMat, adres);
-                residual_[globI] += res;
-                //SparseAdapter syntax:  jacobian_->addToBlock(globI, globI, bMat);
-                *diagMatAddress_[globI] += bMat;
-                bMat *= -1.0;
-                //SparseAdapter syntax: jacobian_->addToBlock(globJ, globI, bMat);
-                *nbInfo.matBlockAddress += bMat;
-                ++loc;
-            }
             }
 
             // Accumulation term.
@@ -788,7 +1041,7 @@ private:
                 // used, but after storage cache is shifted at the end of the
                 // timestep, it will become cached storage for timeIdx 1.
                 model_().updateCachedStorage(globI, /*timeIdx=*/0, res);
-                if (model_().newtonMethod().numIterations() == 0) {
+                if (iterationIdx == 0) {
                     // Need to update the storage cache.
                     if (problem_().recycleFirstIterationStorage()) {
                         // Assumes nothing have changed in the system which
@@ -839,6 +1092,10 @@ private:
             residual_[globI] += res;
             //SparseAdapter syntax: jacobian_->addToBlock(globI, globI, bMat);
             *diagMatAddress_[globI] += bMat;
+
+            if (measureCellTimes_) {
+                cellTimes_[globI] += std::chrono::duration<double>(Clock::now() - cellStart).count();
+            }
         } // end of loop for cell globI.
 
         // Add sparse source terms. For now only wells.
@@ -865,6 +1122,106 @@ private:
         }
     }
 
+    // Add the flux over a face to the residuals and Jacobian rows of both of
+    // its cells.
+    template <class IntensiveQuantitiesFunction>
+    void linearizeFace_(const std::size_t faceIdx,
+                        const IntensiveQuantitiesFunction& intensiveQuantities,
+                        const bool useFaceFlux,
+                        const bool enableDispersion)
+    {
+        const auto& face = faces_[faceIdx];
+        const auto& intQuantsIn = intensiveQuantities(face.cellIn);
+        const auto& intQuantsEx = intensiveQuantities(face.cellEx);
+        if constexpr (detail::SupportsFaceFlux<LocalResidual>::value) {
+            if (useFaceFlux) {
+                addFaceFlux_(face.cellIn, face.locIn, face.cellEx, face.locEx,
+                             intQuantsIn, intQuantsEx);
+                return;
+            }
+        }
+        addFlux_(face.cellIn, face.locIn, intQuantsIn, intQuantsEx, enableDispersion, true);
+        addFlux_(face.cellEx, face.locEx, intQuantsEx, intQuantsIn, enableDispersion, true);
+    }
+
+    // Add the flux over face 'loc' of cell globI to the residual of globI,
+    // and its derivatives w.r.t. the primary variables of globI to the
+    // Jacobian. Only the cell globI and, if addToNeighbor is true, its
+    // neighbor's off-diagonal block in column globI are touched.
+    template <class IntQuants>
+    void addFlux_(const unsigned globI,
+                  const unsigned loc,
+                  const IntQuants& intQuantsIn,
+                  const IntQuants& intQuantsEx,
+                  const bool enableDispersion,
+                  const bool addToNeighbor)
+    {
+        OPM_TIMEBLOCK_LOCAL(fluxCalculationForEachFace);
+        const auto& nbInfo = neighborInfo_[globI][loc];
+        const unsigned globJ = nbInfo.neighbor;
+        assert(globJ != globI);
+        VectorBlock res(0.0);
+        MatrixBlock bMat(0.0);
+        ADVectorBlock adres(0.0);
+        ADVectorBlock darcyFlux(0.0);
+        LocalResidual::computeFlux(adres,darcyFlux, globI, globJ, intQuantsIn, intQuantsEx, nbInfo.res_nbinfo,  problem_().moduleParams());
+        adres *= nbInfo.res_nbinfo.faceArea;
+        if (enableDispersion) {
+            for (unsigned phaseIdx = 0; phaseIdx < numEq; ++ phaseIdx) {
+                velocityInfo_[globI][loc].velocity[phaseIdx] = darcyFlux[phaseIdx].value() / nbInfo.res_nbinfo.faceArea;
+            }
+        }
+        setResAndJacobi(res, bMat, adres);
+        residual_[globI] += res;
+        //SparseAdapter syntax:  jacobian_->addToBlock(globI, globI, bMat);
+        *diagMatAddress_[globI] += bMat;
+        if (addToNeighbor) {
+            bMat *= -1.0;
+            //SparseAdapter syntax: jacobian_->addToBlock(globJ, globI, bMat);
+            *nbInfo.matBlockAddress += bMat;
+        }
+    }
+
+    // Add the flux over a face to the rows of both of its cells. The flux is
+    // evaluated once, with derivatives w.r.t. both cells, and the exterior
+    // cell receives the negated flux.
+    template <class IntQuants>
+    void addFaceFlux_(const unsigned cellIn,
+                      const unsigned locIn,
+                      const unsigned cellEx,
+                      const unsigned locEx,
+                      const IntQuants& intQuantsIn,
+                      const IntQuants& intQuantsEx)
+    {
+        OPM_TIMEBLOCK_LOCAL(fluxCalculationForEachFace);
+        const auto& nbInfoIn = neighborInfo_[cellIn][locIn];
+        const auto& nbInfoEx = neighborInfo_[cellEx][locEx];
+        typename LocalResidual::FaceRateVector flux;
+        LocalResidual::computeFaceFlux(flux, cellIn, cellEx,
+                                       intQuantsIn, intQuantsEx, nbInfoIn.res_nbinfo,
+                                       problem_().moduleParams());
+        VectorBlock res(0.0);
+        MatrixBlock bMatIn(0.0);
+        MatrixBlock bMatEx(0.0);
+        for (unsigned eqIdx = 0; eqIdx < numEq; ++eqIdx) {
+            flux[eqIdx] *= nbInfoIn.res_nbinfo.faceArea;
+            res[eqIdx] = flux[eqIdx].value();
+            for (unsigned pvIdx = 0; pvIdx < numEq; ++pvIdx) {
+                bMatIn[eqIdx][pvIdx] = flux[eqIdx].derivative(pvIdx);
+                bMatEx[eqIdx][pvIdx] = flux[eqIdx].derivative(numEq + pvIdx);
+            }
+        }
+        // Row of the interior cell. The matBlockAddress of a neighbor entry
+        // is the block in the neighbor's row and the entry's cell's column.
+        residual_[cellIn] += res;
+        *diagMatAddress_[cellIn] += bMatIn;
+        *nbInfoEx.matBlockAddress += bMatEx;
+        // Row of the exterior cell.
+        residual_[cellEx] -= res;
+        *diagMatAddress_[cellEx] -= bMatEx;
+        *nbInfoIn.matBlockAddress -= bMatIn;
+    }
+
     void updateStoredTransmissibilities()
     {
         if (neighborInfo_.empty()) {
@@ -907,6 +1264,18 @@ private:
     SparseTable<NeighborInfo> neighborInfo_;
     std::vector<MatrixBlock*> diagMatAddress_;
 
+    // A unique interior face, given by the two cells and the
+    // position of the face in their neighborInfo_ rows.
+    struct Face
+    {
+        unsigned int cellIn;
+        unsigned int locIn;
+        unsigned int cellEx;
+        unsigned int locEx;
+    };
+    std::vector<Face> faces_;
+    std::vector<std::size_t> faceLevelStart_;
+
     struct FlowInfo
     {
         int faceId;
@@ -942,6 +1311,9 @@ private:
     };
     std::vector<BoundaryInfo> boundaryInfo_;
     bool separateSparseSourceTerms_ = false;
+    bool measureCellTimes_ = false;
+    std::vector<double> cellTimes_;
+    bool faceBasedLinearization_ = false;
     struct FullDomain
     {
         std::vector<int> cells;
@@ -27,7 +27,6 @@
 #include <condition_variable>
 #include <iostream>
 #include <mutex>
-#include <queue>
 #include <stdexcept>
 #include <thread>
 
@@ -36,38 +35,56 @@ namespace Opm {
 thread_local TaskletRunner* TaskletRunner::taskletRunner_ = nullptr;
 thread_local int TaskletRunner::workerThreadIndex_ = -1;
 
-TaskletRunner::BarrierTasklet::BarrierTasklet(unsigned numWorkers)
-    : TaskletInterface(/*refCount=*/numWorkers)
+DependentTasklet::DependentTasklet(TaskletRunner& runner,
+                                   std::function<void()> fn,
+                                   TaskletPriority priority)
+    : runner_(runner)
+    , fn_(std::move(fn))
+    , priority_(priority)
+{}
+
+void DependentTasklet::run()
 {
-    numWorkers_ = numWorkers;
-    numWaiting_ = 0;
+    fn_();
+    // release whatever the function holds on to
+    fn_ = nullptr;
+
+    std::vector<std::shared_ptr<DependentTasklet> > successors;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        complete_ = true;
+        successors.swap(successors_);
+    }
+
+    for (const auto& successor : successors) {
+        if (successor->dependencyCompleted()) {
+            runner_.dispatch(successor, successor->priority());
+        }
+    }
 }
 
-void TaskletRunner::BarrierTasklet::run()
+bool DependentTasklet::isComplete() const
 {
-    wait();
+    std::lock_guard<std::mutex> lock(mutex_);
+    return complete_;
 }
 
-void TaskletRunner::BarrierTasklet::wait()
+bool DependentTasklet::addSuccessor(const std::shared_ptr<DependentTasklet>& successor)
 {
-    std::unique_lock<std::mutex> lock(barrierMutex_);
-
-    numWaiting_ += 1;
-    if (numWaiting_ >= numWorkers_ + 1) {
-        lock.unlock();
-        barrierCondition_.notify_all();
-    }
-    else {
-        const auto& areAllWaiting =
-            [this]() -> bool
-            { return this->numWaiting_ >= this->numWorkers_ + 1; };
-
-        barrierCondition_.wait(lock, /*predicate=*/areAllWaiting);
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (complete_) {
+        return false;
     }
+    successors_.push_back(successor);
+    return true;
 }
 
 TaskletRunner::TaskletRunner(unsigned numWorkers)
 {
+    queues_.resize(numWorkers);
+    for (auto& queue : queues_)
+        queue = std::make_unique<WorkerQueue>();
+
     threads_.resize(numWorkers);
     for (unsigned i = 0; i < numWorkers; ++i)
         // create a worker thread
@@ -77,8 +94,14 @@ TaskletRunner::TaskletRunner(unsigned numWorkers)
 TaskletRunner::~TaskletRunner()
 {
     if (threads_.size() > 0) {
-        // dispatch a tasklet which will terminate the worker thread
-        dispatch(std::make_shared<TerminateThreadTasklet>());
+        // run all scheduled tasklets before terminating the worker threads
+        barrier();
+
+        {
+            std::lock_guard<std::mutex> lock(taskletQueueMutex_);
+            stop_ = true;
+        }
+        workAvailableCondition_.notify_all();
 
         // wait until all worker threads have terminated
         for (auto& thread : threads_)
@@ -98,51 +121,80 @@ int TaskletRunner::workerThreadIndex() const
     return TaskletRunner::workerThreadIndex_;
 }
 
-void TaskletRunner::dispatch(std::shared_ptr<TaskletInterface> tasklet)
+void TaskletRunner::dispatch(std::shared_ptr<TaskletInterface> tasklet,
+                             TaskletPriority priority)
 {
     if (threads_.empty()) {
         // run the tasklet immediately in synchronous mode.
         while (tasklet->referenceCount() > 0) {
             tasklet->dereference();
-            try {
-                tasklet->run();
-            }
-            catch (const std::exception& e) {
-                std::cerr << "ERROR: Uncaught std::exception when running tasklet: " << e.what() << ". Trying to continue.\n";
-                failureFlag_.store(true, std::memory_order_relaxed);
-            }
-            catch (...) {
-                std::cerr << "ERROR: Uncaught exception (general type) when running tasklet. Trying to continue.\n";
-                failureFlag_.store(true, std::memory_order_relaxed);
-            }
+            runTasklet_(*tasklet);
         }
+        return;
     }
-    else {
-        // lock mutex for the tasklet queue to make sure that nobody messes with the
-        // task queue
-        taskletQueueMutex_.lock();
 
-        // add the tasklet to the queue
-        taskletQueue_.push(tasklet);
+    const int numInvocations = tasklet->referenceCount();
+    if (numInvocations <= 0)
+        return;
 
-        taskletQueueMutex_.unlock();
+    {
+        std::lock_guard<std::mutex> lock(pendingMutex_);
+        numPending_ += numInvocations;
+    }
 
-        workAvailableCondition_.notify_all();
+    // tasklets dispatched by a worker go to its own queue, the others are
+    // distributed round-robin. All invocations of a tasklet are put in the
+    // same queue, such that its reference count is only modified while
+    // holding the lock of that queue.
+    const int self = workerThreadIndex();
+    const std::size_t queueIdx = self >= 0
+        ? static_cast<std::size_t>(self)
+        : nextQueue_.fetch_add(1, std::memory_order_relaxed) % queues_.size();
+    auto& queue = *queues_[queueIdx];
+    {
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        auto& tasklets = queue.tasklets[static_cast<std::size_t>(priority)];
+        for (int i = 0; i < numInvocations; ++i)
+            tasklets.push_back(tasklet);
+        numQueued_ += numInvocations;
     }
+
+    // take the lock such that no worker can miss the notification between
+    // checking for work and going to sleep
+    { std::lock_guard<std::mutex> lock(taskletQueueMutex_); }
+    if (numInvocations > 1)
+        workAvailableCondition_.notify_all();
+    else
+        workAvailableCondition_.notify_one();
 }
 
 void TaskletRunner::barrier()
 {
-    unsigned numWorkers = threads_.size();
-    if (numWorkers == 0)
+    if (threads_.empty())
         // nothing needs to be done to implement a barrier in synchronous mode
         return;
 
-    // dispatch a barrier tasklet and wait until it has been run by the worker thread
-    auto barrierTasklet = std::make_shared<BarrierTasklet>(numWorkers);
-    dispatch(barrierTasklet);
+    std::unique_lock<std::mutex> lock(pendingMutex_);
+    allCompletedCondition_.wait(lock, [this]() { return numPending_ == 0; });
+}
 
-    barrierTasklet->wait();
+void TaskletRunner::dispatchAfter_(const std::shared_ptr<DependentTasklet>& tasklet,
+                                   const std::vector<TaskletDependency>& dependencies)
+{
+    for (const auto& dependency : dependencies) {
+        if (!dependency.tasklet_)
+            continue;
+
+        tasklet->addDependency();
+        if (!dependency.tasklet_->addSuccessor(tasklet))
+            // the dependency has already completed
+            tasklet->dependencyCompleted();
+    }
+
+    // release the initial count, dispatching the tasklet unless a dependency
+    // still has to complete
+    if (tasklet->dependencyCompleted())
+        dispatch(tasklet, tasklet->priority());
 }
 
 void TaskletRunner::startWorkerThread_(TaskletRunner* taskletRunner, int workerThreadIndex)
@@ -156,50 +208,83 @@ void TaskletRunner::startWorkerThread_(TaskletRunner* taskletRunner, int workerT
 void TaskletRunner::run_()
 {
     while (true) {
+        auto tasklet = pop_(workerThreadIndex_);
+        if (!tasklet) {
+            // wait until tasklets have been queued or the runner is destroyed
+            std::unique_lock<std::mutex> lock(taskletQueueMutex_);
+            workAvailableCondition_.wait(lock, [this]() { return stop_ || numQueued_ > 0; });
+            if (stop_ && numQueued_ == 0)
+                return;
+            continue;
+        }
 
-        // wait until tasklets have been pushed to the queue. first we need to lock
-        // mutex for access to taskletQueue_
-        std::unique_lock<std::mutex> lock(taskletQueueMutex_);
-
-        const auto& workIsAvailable =
-            [this]() -> bool
-            { return !taskletQueue_.empty(); };
+        runTasklet_(*tasklet);
+        tasklet.reset();
 
-        if (!workIsAvailable())
-            workAvailableCondition_.wait(lock, /*predicate=*/workIsAvailable);
+        std::lock_guard<std::mutex> lock(pendingMutex_);
+        if (--numPending_ == 0)
+            allCompletedCondition_.notify_all();
+    }
+}
 
-        // remove tasklet from queue
-        std::shared_ptr<TaskletInterface> tasklet = taskletQueue_.front();
+void TaskletRunner::runTasklet_(TaskletInterface& tasklet)
+{
+    try {
+        tasklet.run();
+    }
+    catch (const std::exception& e) {
+        std::cerr << "ERROR: Uncaught std::exception when running tasklet: " << e.what() << ".\n";
+        failureFlag_.store(true, std::memory_order_relaxed);
+    }
+    catch (...) {
+        std::cerr << "ERROR: Uncaught exception when running tasklet.\n";
+        failureFlag_.store(true, std::memory_order_relaxed);
+    }
+}
 
-        // if tasklet is an end marker, terminate the thread and DO NOT remove the
-        // tasklet.
-        if (tasklet->isEndMarker()) {
-            if(taskletQueue_.size() > 1)
-                throw std::logic_error("TaskletRunner: Not all queued tasklets were executed");
-            taskletQueueMutex_.unlock();
-            return;
+std::shared_ptr<TaskletInterface> TaskletRunner::pop_(int workerThreadIndex)
+{
+    const std::size_t numQueues = queues_.size();
+    for (std::size_t priority = 0; priority < numPriorities; ++priority) {
+        // own work in the order it was dispatched
+        auto tasklet = tryPop_(*queues_[workerThreadIndex], priority, /*front=*/true);
+        if (tasklet)
+            return tasklet;
+
+        // steal the most recently dispatched work of the other workers
+        for (std::size_t i = 1; i < numQueues; ++i) {
+            auto& victim = *queues_[(workerThreadIndex + i) % numQueues];
+            tasklet = tryPop_(victim, priority, /*front=*/false);
+            if (tasklet)
+                return tasklet;
         }
+    }
 
-        tasklet->dereference();
-        if (tasklet->referenceCount() == 0)
-            // remove tasklets from the queue as soon as their reference count
-            // reaches zero, i.e. the tasklet has been run often enough.
-            taskletQueue_.pop();
-        lock.unlock();
+    return nullptr;
+}
 
-        // execute tasklet
-        try {
-            tasklet->run();
-        }
-        catch (const std::exception& e) {
-            std::cerr << "ERROR: Uncaught std::exception when running tasklet: " << e.what() << ".\n";
-            failureFlag_.store(true, std::memory_order_relaxed);
-        }
-        catch (...) {
-            std::cerr << "ERROR: Uncaught exception when running tasklet.\n";
-            failureFlag_.store(true, std::memory_order_relaxed);
-        }
+std::shared_ptr<TaskletInterface> TaskletRunner::tryPop_(WorkerQueue& queue,
+                                                         std::size_t priority,
+                                                         bool front)
+{
+    std::lock_guard<std::mutex> lock(queue.mutex);
+    auto& tasklets = queue.tasklets[priority];
+    if (tasklets.empty())
+        return nullptr;
+
+    std::shared_ptr<TaskletInterface> tasklet;
+    if (front) {
+        tasklet = std::move(tasklets.front());
+        tasklets.pop_front();
     }
+    else {
+        tasklet = std::move(tasklets.back());
+        tasklets.pop_back();
+    }
+    tasklet->dereference();
+    --numQueued_;
+
+    return tasklet;
 }
 
 } // end namespace Opm
@@ -27,11 +27,19 @@
 #ifndef OPM_TASKLETS_HPP
 #define OPM_TASKLETS_HPP
 
+#include <array>
 #include <atomic>
-#include <thread>
-#include <queue>
-#include <mutex>
 #include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
 
 namespace Opm {
 
@@ -81,43 +89,154 @@ private:
 };
 
 /*!
- * \brief Handles where a given tasklet is run.
+ * \brief The priority of a tasklet.
  *
- * Depending on the number of worker threads, a tasklet can either be run in a separate
- * worker thread or by the main thread.
+ * Worker threads always pick the queued tasklet of the highest priority, taking work
+ * from their own queue before stealing from other workers.
  */
-class TaskletRunner
+enum class TaskletPriority
 {
-    /// \brief Implements a barrier. This class can only be used in the asynchronous case.
-    class BarrierTasklet : public TaskletInterface
-    {
-    public:
-        explicit BarrierTasklet(unsigned numWorkers);
+    high = 0,
+    normal = 1,
+    low = 2
+};
 
-        void run() override;
+class TaskletRunner;
 
-        void wait();
+/*!
+ * \brief A tasklet which runs a function once, as soon as a set of other such tasklets
+ *        have completed.
+ *
+ * This is the building block of TaskletRunner::submit().
+ */
+class DependentTasklet : public TaskletInterface
+{
+public:
+    DependentTasklet(TaskletRunner& runner,
+                     std::function<void()> fn,
+                     TaskletPriority priority);
 
-    private:
-        unsigned numWorkers_;
-        unsigned numWaiting_;
+    /*!
+     * \brief Runs the function and dispatches the tasklets which only waited for this
+     *        one to complete.
+     */
+    void run() override;
 
-        std::condition_variable barrierCondition_;
-        std::mutex barrierMutex_;
-    };
+    /*!
+     * \brief Returns whether the function has been run.
+     */
+    bool isComplete() const;
 
-    /// \brief TerminateThreadTasklet class
-    /// Empty tasklet marking thread termination.
-    class TerminateThreadTasklet : public TaskletInterface
-    {
-    public:
-        void run() override
-        { }
+    /*!
+     * \brief Registers a tasklet to be notified once this one has completed.
+     *
+     * Returns false if this tasklet has already completed.
+     */
+    bool addSuccessor(const std::shared_ptr<DependentTasklet>& successor);
 
-        bool isEndMarker() const override
-        { return true; }
-    };
+    /*!
+     * \brief Adds a dependency which needs to complete before the tasklet may run.
+     */
+    void addDependency()
+    { ++numPending_; }
+
+    /*!
+     * \brief Marks a dependency as completed, and returns whether the tasklet is ready.
+     */
+    bool dependencyCompleted()
+    { return --numPending_ == 0; }
+
+    TaskletPriority priority() const
+    { return priority_; }
+
+private:
+    TaskletRunner& runner_;
+    std::function<void()> fn_;
+    TaskletPriority priority_;
+
+    // the initial count prevents the tasklet from being dispatched while its
+    // dependencies are registered
+    std::atomic<int> numPending_{1};
+
+    mutable std::mutex mutex_;
+    bool complete_ = false;
+    std::vector<std::shared_ptr<DependentTasklet> > successors_;
+};
+
+/*!
+ * \brief A handle of a function submitted to a TaskletRunner which can be used as a
+ *        dependency of functions submitted later.
+ */
+class TaskletDependency
+{
+    friend class TaskletRunner;
+
+public:
+    TaskletDependency() = default;
+
+    /*!
+     * \brief Returns whether the function has been run.
+     */
+    bool isReady() const
+    { return !tasklet_ || tasklet_->isComplete(); }
+
+protected:
+    explicit TaskletDependency(std::shared_ptr<DependentTasklet> tasklet)
+        : tasklet_(std::move(tasklet))
+    {}
+
+    std::shared_ptr<DependentTasklet> tasklet_;
+};
+
+/*!
+ * \brief The result of a function submitted to a TaskletRunner.
+ *
+ * The result becomes available once the function has been run. Exceptions thrown by
+ * the function are rethrown by get(). Note that waiting for a result from a worker
+ * thread of the same runner may dead-lock.
+ */
+template <class R>
+class TaskletFuture : public TaskletDependency
+{
+    friend class TaskletRunner;
+
+public:
+    TaskletFuture() = default;
+
+    bool valid() const
+    { return future_.valid(); }
 
+    void wait() const
+    { future_.wait(); }
+
+    decltype(auto) get() const
+    { return future_.get(); }
+
+    const std::shared_future<R>& future() const
+    { return future_; }
+
+private:
+    TaskletFuture(std::shared_ptr<DependentTasklet> tasklet,
+                  std::shared_future<R> future)
+        : TaskletDependency(std::move(tasklet))
+        , future_(std::move(future))
+    {}
+
+    std::shared_future<R> future_;
+};
+
+/*!
+ * \brief Handles where a given tasklet is run.
+ *
+ * Depending on the number of worker threads, a tasklet can either be run in a separate
+ * worker thread or by the main thread.
+ *
+ * Each worker thread has its own queue of tasklets. Tasklets dispatched by a worker
+ * thread are added to its own queue, while the others are distributed round-robin.
+ * Worker threads steal from the queues of the others when their own queue is empty.
+ */
+class TaskletRunner
+{
 public:
     // prohibit copying of tasklet runners
     TaskletRunner(const TaskletRunner&) = delete;
@@ -159,7 +278,8 @@ public:
      *
      * The tasklet is either run immediately or deferred to a separate thread.
      */
-    void dispatch(std::shared_ptr<TaskletInterface> tasklet);
+    void dispatch(std::shared_ptr<TaskletInterface> tasklet,
+                  TaskletPriority priority = TaskletPriority::normal);
 
     /*!
      * \brief Convenience method to construct a new function runner tasklet and dispatch it immediately.
@@ -173,6 +293,29 @@ public:
         return tasklet;
     }
 
+    /*!
+     * \brief Run a function once, after the given dependencies have completed.
+     *
+     * Returns a future for the result of the function, which may itself be used as a
+     * dependency of other submitted functions. Exceptions thrown by the function are
+     * stored in the future and do not mark the runner as failed.
+     */
+    template <class Fn>
+    auto submit(Fn&& fn,
+                TaskletPriority priority = TaskletPriority::normal,
+                const std::vector<TaskletDependency>& dependencies = {})
+        -> TaskletFuture<std::invoke_result_t<std::decay_t<Fn>&> >
+    {
+        using Result = std::invoke_result_t<std::decay_t<Fn>&>;
+        auto task = std::make_shared<std::packaged_task<Result()> >(std::forward<Fn>(fn));
+        auto future = task->get_future().share();
+        auto tasklet = std::make_shared<DependentTasklet>(*this,
+                                                          [task]() { (*task)(); },
+                                                          priority);
+        this->dispatchAfter_(tasklet, dependencies);
+        return TaskletFuture<Result>(std::move(tasklet), std::move(future));
+    }
+
     /*!
      * \brief Make sure that all tasklets have been completed after this method has been called
      */
@@ -190,17 +333,52 @@ private:
     std::atomic<bool> failureFlag_ = false;
 
 protected:
+    static constexpr std::size_t numPriorities = 3;
+
+    //! The queues of a worker thread, one per priority
+    struct WorkerQueue
+    {
+        std::mutex mutex;
+        std::array<std::deque<std::shared_ptr<TaskletInterface> >, numPriorities> tasklets;
+    };
+
     // main function of the worker thread
     static void startWorkerThread_(TaskletRunner* taskletRunner, int workerThreadIndex);
 
-    //! do the work until the queue received an end tasklet
+    //! do the work until the runner is destroyed
     void run_();
 
+    //! run a tasklet once, and record the failure if it throws
+    void runTasklet_(TaskletInterface& tasklet);
+
+    //! dispatch a tasklet once all its dependencies have completed
+    void dispatchAfter_(const std::shared_ptr<DependentTasklet>& tasklet,
+                        const std::vector<TaskletDependency>& dependencies);
+
+    //! take the next tasklet to run by a worker thread, or nullptr if there is none
+    std::shared_ptr<TaskletInterface> pop_(int workerThreadIndex);
+
+    //! take a tasklet from the front or the back of a queue
+    std::shared_ptr<TaskletInterface> tryPop_(WorkerQueue& queue,
+                                              std::size_t priority,
+                                              bool front);
+
     std::vector<std::unique_ptr<std::thread> > threads_;
-    std::queue<std::shared_ptr<TaskletInterface> > taskletQueue_;
+    std::vector<std::unique_ptr<WorkerQueue> > queues_;
+    std::atomic<std::size_t> nextQueue_{0};
+
+    // number of queued tasklet invocations, and whether the workers should stop.
+    // Idle workers sleep on the condition variable.
+    std::atomic<std::size_t> numQueued_{0};
+    bool stop_ = false;
     std::mutex taskletQueueMutex_;
     std::condition_variable workAvailableCondition_;
 
+    // number of dispatched tasklet invocations which have not completed yet
+    std::size_t numPending_ = 0;
+    std::mutex pendingMutex_;
+    std::condition_variable allCompletedCondition_;
+
     static thread_local TaskletRunner* taskletRunner_;
     static thread_local int workerThreadIndex_;
 };
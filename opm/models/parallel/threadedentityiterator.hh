@@ -27,8 +27,16 @@
 #ifndef EWOMS_THREADED_ENTITY_ITERATOR_HH
 #define EWOMS_THREADED_ENTITY_ITERATOR_HH
 
-#include <thread>
-#include <mutex>
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
 
 namespace Opm {
 
@@ -36,7 +44,18 @@ namespace Opm {
  * \brief Provides an STL-iterator like interface to iterate over the enties of a
  *        GridView in OpenMP threaded applications
  *
- * ATTENTION: This class must be instantiated in a sequential context!
+ * The entities are split into chunks of consecutive entities. The threads take
+ * chunks using an atomic counter and iterate over the entities of each chunk on
+ * their own, so no lock is needed.
+ *
+ * Finding the chunk boundaries requires a walk over the grid view. Code which
+ * iterates over the same grid view repeatedly should create them once with
+ * createChunks(), keep them, and create them again when the grid changes, since
+ * that invalidates the iterators they consist of. Otherwise they are created
+ * by the constructor.
+ *
+ * The loop over the entities must be run by at most as many threads as
+ * omp_get_max_threads() returns when the object is created.
  */
 template <class GridView, int codim>
 class ThreadedEntityIterator
@@ -44,23 +63,63 @@ class ThreadedEntityIterator
     using Entity = typename GridView::template Codim<codim>::Entity;
     using EntityIterator = typename GridView::template Codim<codim>::Iterator;
 public:
+    //! \brief The first entity of each chunk, followed by the end of the grid view.
+    using ChunkBoundaries = std::vector<EntityIterator>;
+
     explicit ThreadedEntityIterator(const GridView& gridView)
-        : sequentialIt_(gridView.template begin<codim>())
-        , sequentialEnd_(gridView.template end<codim>())
-    { }
+        : ThreadedEntityIterator(gridView, nullptr)
+    {
+        ownChunkBegin_ = createChunks(gridView);
+        chunkBegin_ = &ownChunkBegin_;
+    }
 
-    ThreadedEntityIterator(const ThreadedEntityIterator& other) = default;
+    /*!
+     * \brief Iterate over the chunks of the grid view given by createChunks().
+     *
+     * The chunk boundaries are not copied and must outlive this object.
+     */
+    ThreadedEntityIterator(const GridView& gridView, const ChunkBoundaries& chunkBegin)
+        : ThreadedEntityIterator(gridView, &chunkBegin)
+    {
+        if (chunkBegin.empty())
+            throw std::logic_error("ThreadedEntityIterator created with empty chunk boundaries");
+    }
+
+    /*!
+     * \brief Split the entities of a grid view into chunks for the maximum
+     *        number of threads.
+     */
+    static ChunkBoundaries createChunks(const GridView& gridView)
+    {
+        std::size_t numThreads = 1;
+#ifdef _OPENMP
+        numThreads = omp_get_max_threads();
+#endif
+        const std::size_t numEntities = gridView.size(codim);
+
+        // use several chunks per thread to balance the load between them
+        const std::size_t chunkSize =
+            std::clamp(numEntities / (chunksPerThread * numThreads),
+                       std::size_t{1}, maxChunkSize);
+
+        ChunkBoundaries chunkBegin;
+        chunkBegin.reserve(numEntities / chunkSize + 2);
+        std::size_t entityIdx = 0;
+        const auto end = gridView.template end<codim>();
+        for (auto it = gridView.template begin<codim>(); it != end; ++it, ++entityIdx) {
+            if (entityIdx % chunkSize == 0)
+                chunkBegin.push_back(it);
+        }
+        chunkBegin.push_back(end);
+        return chunkBegin;
+    }
 
     // begin iterating over the grid in parallel
     EntityIterator beginParallel()
     {
-        mutex_.lock();
-        auto tmp = sequentialIt_;
-        if (sequentialIt_ != sequentialEnd_)
-            ++sequentialIt_; // make the next thread look at the next element
-        mutex_.unlock();
-
-        return tmp;
+        auto& state = threadState_();
+        takeChunk_(state);
+        return state.it;
     }
 
     // returns true if the last element was reached
@@ -69,30 +128,84 @@ public:
 
     // make sure that the loop over the grid is finished
     void setFinished()
-    {
-        mutex_.lock();
-        sequentialIt_ = sequentialEnd_;
-        mutex_.unlock();
-    }
+    { finished_.store(true, std::memory_order_relaxed); }
 
     // prefix increment: goes to the next element which is not yet worked on by any
     // thread
     EntityIterator increment()
     {
-        mutex_.lock();
-        auto tmp = sequentialIt_;
-        if (sequentialIt_ != sequentialEnd_)
-            ++sequentialIt_;
-        mutex_.unlock();
+        auto& state = threadState_();
+        if (state.it == state.end)
+            return sequentialEnd_;
 
-        return tmp;
+        ++state.it;
+        if (state.it == state.end || finished_.load(std::memory_order_relaxed))
+            takeChunk_(state);
+
+        return state.it;
     }
 
 private:
-    EntityIterator sequentialIt_;
+    // the number of chunks per thread and the maximum number of entities per chunk
+    static constexpr std::size_t chunksPerThread = 8;
+    static constexpr std::size_t maxChunkSize = 1000;
+
+    // the entities currently worked on by a thread. aligned to avoid false sharing
+    struct alignas(64) ThreadState
+    {
+        EntityIterator it;
+        EntityIterator end;
+    };
+
+    ThreadedEntityIterator(const GridView& gridView, const ChunkBoundaries* chunkBegin)
+        : sequentialEnd_(gridView.template end<codim>())
+        , chunkBegin_(chunkBegin)
+    {
+        std::size_t numThreads = 1;
+#ifdef _OPENMP
+        numThreads = omp_get_max_threads();
+#endif
+        threadStates_.resize(numThreads, ThreadState{sequentialEnd_, sequentialEnd_});
+    }
+
+    ThreadState& threadState_()
+    {
+        std::size_t threadIdx = 0;
+#ifdef _OPENMP
+        threadIdx = omp_get_thread_num();
+#endif
+        if (threadIdx >= threadStates_.size())
+            throw std::logic_error("ThreadedEntityIterator used by thread " + std::to_string(threadIdx) +
+                                   ", but created for " + std::to_string(threadStates_.size()) +
+                                   " threads");
+        return threadStates_[threadIdx];
+    }
+
+    void takeChunk_(ThreadState& state)
+    {
+        const auto& chunkBegin = *chunkBegin_;
+        const std::size_t numChunks = chunkBegin.size() - 1;
+        const std::size_t chunkIdx = finished_.load(std::memory_order_relaxed)
+            ? numChunks
+            : nextChunk_.fetch_add(1, std::memory_order_relaxed);
+
+        if (chunkIdx < numChunks) {
+            state.it = chunkBegin[chunkIdx];
+            state.end = chunkBegin[chunkIdx + 1];
+        }
+        else {
+            state.it = sequentialEnd_;
+            state.end = sequentialEnd_;
+        }
+    }
+
     EntityIterator sequentialEnd_;
+    ChunkBoundaries ownChunkBegin_;
+    const ChunkBoundaries* chunkBegin_;
+    std::vector<ThreadState> threadStates_;
 
-    std::mutex mutex_;
+    std::atomic<std::size_t> nextChunk_{0};
+    std::atomic<bool> finished_{false};
 };
 } // namespace Opm
 
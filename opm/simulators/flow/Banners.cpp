@@ -117,7 +117,8 @@ void printFlowTrailer(int nprocs,
                       const double total_setup_time,
                       const double deck_read_time,
                       const SimulatorReport& report,
-                      const SimulatorReportSingle& localsolves_report)
+                      const SimulatorReportSingle& localsolves_report,
+                      std::string_view localsolves_coloring)
 {
     std::ostringstream ss;
     ss << "\n\n================    End of simulation     ===============\n\n";
@@ -130,6 +131,7 @@ void printFlowTrailer(int nprocs,
     if (localsolves_report.total_linearizations > 0) {
         ss << "======  Accumulated local solve data  ======\n";
         localsolves_report.reportFullyImplicit(ss);
+        ss << localsolves_coloring;
     }
 
     OpmLog::info(ss.str());
@@ -45,7 +45,8 @@ void printFlowTrailer(int nprocs,
                       const double total_setup_time,
                       const double deck_read_time,
                       const SimulatorReport& report,
-                      const SimulatorReportSingle& localsolves_report);
+                      const SimulatorReportSingle& localsolves_report,
+                      std::string_view localsolves_coloring = {});
 
 } // namespace Opm
 
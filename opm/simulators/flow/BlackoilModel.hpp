@@ -262,6 +262,9 @@ public:
     /// return the statistics if the nonlinearIteration() method failed
     SimulatorReportSingle localAccumulatedReports() const;
 
+    /// print the accumulated statistics of the NLDD domain colouring, if any
+    void reportLocalColoring(std::ostream& os) const;
+
     const std::vector<StepReport>& stepReports() const
     { return convergence_reports_; }
 
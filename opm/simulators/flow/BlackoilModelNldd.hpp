@@ -30,6 +30,8 @@
 
 #include <opm/simulators/aquifers/AquiferGridUtils.hpp>
 
+#include <opm/models/discretization/common/tpfalinearizer.hh>
+
 #include <opm/simulators/flow/countGlobalCells.hpp>
 #include <opm/simulators/flow/partitionCells.hpp>
 #include <opm/simulators/flow/priVarsPacking.hpp>
@@ -52,16 +54,22 @@
 
 #include <fmt/format.h>
 
+#if HAVE_MPI
+#include <mpi.h>
+#endif
+
 #include <algorithm>
 #include <array>
 #include <cassert>
 #include <cmath>
 #include <cstddef>
+#include <exception>
 #include <filesystem>
 #include <fstream>
 #include <functional>
 #include <iomanip>
 #include <ios>
+#include <limits>
 #include <memory>
 #include <numeric>
 #include <sstream>
@@ -173,6 +181,53 @@ public:
         }
 
         assert(int(domains_.size()) == num_domains);
+
+        // Concurrent subdomain solves rely on the subdomain linearization
+        // of the TPFA linearizer only touching the domain's own rows.
+        using Linearizer = GetPropType<TypeTag, Properties::Linearizer>;
+        const auto approach = model_.param().local_solve_approach_;
+        num_threads_ = model_.param().nldd_num_threads_;
+        if (num_threads_ > 1) {
+            bool supported = approach == DomainSolveApproach::Jacobi ||
+                             approach == DomainSolveApproach::MultiColorGaussSeidel;
+            supported = supported && std::is_same_v<Linearizer, TpfaLinearizer<TypeTag>>;
+            supported = supported && !Parameters::Get<Parameters::SeparateSparseSourceTerms>();
+#ifndef _OPENMP
+            supported = false;
+#endif
+#if HAVE_MPI
+            // The well code of a domain solve calls MPI, also for wells whose
+            // perforations are all on this process. The threads must be allowed
+            // to call MPI, one at a time at least.
+            int mpi_initialized = 0;
+            MPI_Initialized(&mpi_initialized);
+            if (mpi_initialized) {
+                int thread_level = MPI_THREAD_SINGLE;
+                MPI_Query_thread(&thread_level);
+                supported = supported && thread_level >= MPI_THREAD_SERIALIZED;
+                serialize_well_model_ = thread_level < MPI_THREAD_MULTIPLE;
+            }
+            // Distributed wells communicate with other processes, which
+            // may solve the domains of these wells in a different order.
+            supported = supported &&
+                !(model_.simulator().vanguard().enableDistributedWells() &&
+                  model_.simulator().vanguard().grid().comm().size() > 1);
+#endif
+            if (!supported) {
+                if (rank_ == 0) {
+                    OpmLog::warning("Concurrent NLDD subdomain solves require the jacobi or multicolor-gs "
+                                    "local solve approach, the TPFA linearizer without separate sparse "
+                                    "source terms, OpenMP, MPI_THREAD_SERIALIZED support if MPI is used "
+                                    "and no distributed wells. Solving subdomains sequentially.");
+                }
+                num_threads_ = 1;
+            }
+        }
+
+        // Domains that are solved at the same time must not be adjacent.
+        if (num_threads_ > 1 || approach == DomainSolveApproach::MultiColorGaussSeidel) {
+            domain_neighbors_ = this->domainAdjacency(partition_vector, num_domains);
+        }
     }
 
     //! \brief Called before starting a time step.
@@ -204,40 +259,42 @@ public:
         auto initial_solution = solution;
         auto locally_solved = initial_solution;
 
-        // -----------   Decide on an ordering for the domains   -----------
-        const auto domain_order = this->getSubdomainOrder();
-
         // -----------   Solve each domain separately   -----------
         DeferredLogger logger;
         std::vector<SimulatorReportSingle> domain_reports(domains_.size());
-        for (const int domain_index : domain_order) {
-            const auto& domain = domains_[domain_index];
-            SimulatorReportSingle local_report;
-            try {
-                switch (model_.param().local_solve_approach_) {
-                case DomainSolveApproach::Jacobi:
-                    solveDomainJacobi(solution, locally_solved, local_report, logger,
-                                      iteration, timer, domain);
-                    break;
-                default:
-                case DomainSolveApproach::GaussSeidel:
-                    solveDomainGaussSeidel(solution, locally_solved, local_report, logger,
-                                           iteration, timer, domain);
-                    break;
+        std::vector<std::vector<int>> color_groups;
+
+        // -----------   Decide on an ordering for the domains   -----------
+        const auto domain_order = this->getSubdomainOrder();
+
+        if (!domain_neighbors_.empty()) {
+            color_groups = this->colorDomains(domain_order);
+        }
+
+        if (num_threads_ > 1) {
+            // Solve the domains colour by colour, the domains of a colour
+            // are not adjacent and are solved concurrently.
+            this->solveDomainsConcurrently(solution, locally_solved, domain_reports,
+                                           color_groups, logger, iteration, timer);
+        } else {
+            // Solve the domains one by one, colour by colour if coloured.
+            std::vector<int> solve_order;
+            if (color_groups.empty()) {
+                solve_order = domain_order;
+            } else {
+                for (const auto& group : color_groups) {
+                    solve_order.insert(solve_order.end(), group.begin(), group.end());
                 }
             }
-            catch (...) {
-                // Something went wrong during local solves.
-                local_report.converged = false;
-            }
-            // This should have updated the global matrix to be
-            // dR_i/du_j evaluated at new local solutions for
-            // i == j, at old solution for i != j.
-            if (!local_report.converged) {
-                // TODO: more proper treatment, including in parallel.
-                logger.debug(fmt::format("Convergence failure in domain {} on rank {}." , domain.index, rank_));
+            for (const int domain_index : solve_order) {
+                const auto& domain = domains_[domain_index];
+                domain_reports[domain.index] = this->solveSingleDomain(solution, locally_solved, logger,
+                                                                       iteration, timer, domain);
             }
-            domain_reports[domain.index] = local_report;
+        }
+
+        if (!color_groups.empty()) {
+            coloring_stats_.update(color_groups);
         }
 
         // Communicate and log all messages.
@@ -310,6 +367,19 @@ public:
         if (is_iorank) {
             OpmLog::debug(fmt::format("Local solves finished. Converged for {}/{} domains. {} domains did no work. {} total local Newton iterations.\n",
                                       num_converged, num_domains, num_converged_already, num_local_newtons));
+            if (!color_groups.empty()) {
+                // The coloring quality is measured as the fraction of the domain solves that
+                // can run concurrently: (domains - colours) / (domains - 1), 1 being ideal.
+                const auto [min_group, max_group] =
+                    std::minmax_element(color_groups.begin(), color_groups.end(),
+                                        [](const auto& g1, const auto& g2) { return g1.size() < g2.size(); });
+                const auto num_local = domains_.size();
+                const double quality = num_local > 1
+                    ? double(num_local - color_groups.size()) / double(num_local - 1) : 1.0;
+                OpmLog::debug(fmt::format("Domains on rank 0 solved in {} colours, {} to {} domains per colour, "
+                                          "coloring quality {:.2f}.\n",
+                                          color_groups.size(), min_group->size(), max_group->size(), quality));
+            }
         }
 
         // Finish with a Newton step.
@@ -331,6 +401,14 @@ public:
         return local_reports_accumulated_;
     }
 
+    //! \brief Print the accumulated statistics of the domain colouring.
+    //!
+    //! Nothing is printed if the domains have not been coloured.
+    void reportLocalColoring(std::ostream& os) const
+    {
+        coloring_stats_.report(os);
+    }
+
     void writePartitions(const std::filesystem::path& odir) const
     {
         const auto& elementMapper = this->model_.simulator().model().elementMapper();
@@ -353,6 +431,202 @@ public:
 
 private:
 
+    //! \brief Solve a single domain with the chosen local solve approach.
+    template<class GlobalEqVector>
+    SimulatorReportSingle solveSingleDomain(GlobalEqVector& solution,
+                                            GlobalEqVector& locally_solved,
+                                            DeferredLogger& logger,
+                                            const int iteration,
+                                            const SimulatorTimerInterface& timer,
+                                            const Domain& domain)
+    {
+        SimulatorReportSingle local_report;
+        try {
+            switch (model_.param().local_solve_approach_) {
+            case DomainSolveApproach::Jacobi:
+                solveDomainJacobi(solution, locally_solved, local_report, logger,
+                                  iteration, timer, domain);
+                break;
+            default:
+            case DomainSolveApproach::GaussSeidel:
+            case DomainSolveApproach::MultiColorGaussSeidel:
+                solveDomainGaussSeidel(solution, locally_solved, local_report, logger,
+                                       iteration, timer, domain);
+                break;
+            }
+        }
+        catch (...) {
+            // Something went wrong during local solves.
+            local_report.converged = false;
+        }
+        // This should have updated the global matrix to be
+        // dR_i/du_j evaluated at new local solutions for
+        // i == j, at old solution for i != j.
+        if (!local_report.converged) {
+            // TODO: more proper treatment, including in parallel.
+            logger.debug(fmt::format("Convergence failure in domain {} on rank {}." , domain.index, rank_));
+        }
+        return local_report;
+    }
+
+    //! \brief Find the neighbouring domains of each domain.
+    std::vector<std::vector<int>> domainAdjacency(const std::vector<int>& partition_vector,
+                                                  const int num_domains) const
+    {
+        const auto& gridView = model_.simulator().vanguard().grid().leafGridView();
+        const auto& elementMapper = model_.simulator().model().elementMapper();
+        const int num_interior = partition_vector.size();
+
+        std::vector<std::vector<int>> neighbors(num_domains);
+        for (const auto& elem : elements(gridView, Dune::Partitions::interior)) {
+            const int domain = partition_vector[elementMapper.index(elem)];
+            for (const auto& is : intersections(gridView, elem)) {
+                if (!is.neighbor()) {
+                    continue;
+                }
+                const int nb_cell = elementMapper.index(is.outside());
+                // Overlap cells are not part of any domain.
+                if (nb_cell >= num_interior) {
+                    continue;
+                }
+                const int nb_domain = partition_vector[nb_cell];
+                if (nb_domain != domain) {
+                    neighbors[domain].push_back(nb_domain);
+                }
+            }
+        }
+        for (auto& nb : neighbors) {
+            std::sort(nb.begin(), nb.end());
+            nb.erase(std::unique(nb.begin(), nb.end()), nb.end());
+        }
+        return neighbors;
+    }
+
+    //! \brief Greedily colour the domains in the given order, such that
+    //!        adjacent domains get different colours.
+    //!
+    //! Earlier domains in the order get the lower colours, i.e. they are
+    //! solved first when solving the colours in sequence.
+    //! \return The domains grouped by colour, each group in the given order.
+    std::vector<std::vector<int>> colorDomains(const std::vector<int>& domain_order) const
+    {
+        std::vector<int> color(domains_.size(), -1);
+        std::vector<std::vector<int>> color_groups;
+        std::vector<char> used;
+        for (const int domain : domain_order) {
+            used.assign(color_groups.size() + 1, false);
+            for (const int nb : domain_neighbors_[domain]) {
+                if (color[nb] >= 0) {
+                    used[color[nb]] = true;
+                }
+            }
+            const auto c = std::distance(used.begin(), std::find(used.begin(), used.end(), false));
+            if (c == static_cast<decltype(c)>(color_groups.size())) {
+                color_groups.emplace_back();
+            }
+            color[domain] = c;
+            color_groups[c].push_back(domain);
+        }
+        return color_groups;
+    }
+
+    //! \brief Solve the domains colour by colour, the domains of one
+    //!        colour concurrently.
+    //!
+    //! Domains of one colour are not adjacent, so a domain solve never
+    //! reads the state of cells that are modified concurrently. Within a
+    //! colour, domains are handed out to the threads dynamically, largest
+    //! domains first. The Newton iteration index of a domain solve is
+    //! passed to the well model, the linearizer and the linear solver of
+    //! the domain, the index of the Newton method is left untouched. Each
+    //! domain logs to its own logger, and the messages are appended to
+    //! \p logger in domain order, so that the output does not depend on
+    //! the thread schedule.
+    template<class GlobalEqVector>
+    void solveDomainsConcurrently(GlobalEqVector& solution,
+                                  GlobalEqVector& locally_solved,
+                                  std::vector<SimulatorReportSingle>& domain_reports,
+                                  const std::vector<std::vector<int>>& color_groups,
+                                  DeferredLogger& logger,
+                                  const int iteration,
+                                  const SimulatorTimerInterface& timer)
+    {
+        concurrent_solves_ = true;
+        Dune::Timer sweepTimer;
+        sweepTimer.start();
+
+        std::vector<DeferredLogger> domain_loggers(domains_.size());
+        for (auto group : color_groups) {
+            std::stable_sort(group.begin(), group.end(),
+                             [this](const int i1, const int i2)
+                             { return domains_[i1].cells.size() > domains_[i2].cells.size(); });
+            const int num_group_domains = group.size();
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic, 1) num_threads(num_threads_)
+#endif
+            for (int ii = 0; ii < num_group_domains; ++ii) {
+                const auto& domain = domains_[group[ii]];
+                domain_reports[domain.index] = this->solveSingleDomain(solution, locally_solved,
+                                                                       domain_loggers[domain.index],
+                                                                       iteration, timer, domain);
+            }
+        }
+
+        concurrent_solves_ = false;
+        coloring_stats_.concurrent_time += sweepTimer.stop();
+        for (const auto& group : color_groups) {
+            for (const int domain : group) {
+                coloring_stats_.domain_time += domain_reports[domain].total_time;
+            }
+        }
+        for (auto& domain_logger : domain_loggers) {
+            logger.append(domain_logger);
+        }
+    }
+
+    //! \brief Set the Newton iteration index of a domain solve.
+    //!
+    //! The index is passed explicitly to the well model, the linearizer and
+    //! the linear solver of the domain. It is also set on the Newton method
+    //! for the code that reads it from there, unless domains are solved
+    //! concurrently.
+    void setIterationIndex(const Domain& domain, const int iter)
+    {
+        domain_linsolvers_[domain.index].setNewtonIteration(iter);
+        if (!concurrent_solves_) {
+            model_.simulator().model().newtonMethod().setIterationIndex(iter);
+        }
+    }
+
+    //! \brief Call \p func, which uses the well model, from a domain solve.
+    //!
+    //! Unless MPI allows several threads to call it at once, the calls of
+    //! concurrent domain solves are serialised.
+    template <class Func>
+    void callWellModel(const Func& func)
+    {
+#ifdef _OPENMP
+        if (concurrent_solves_ && serialize_well_model_) {
+            // Exceptions must not leave the critical section.
+            std::exception_ptr exception;
+#pragma omp critical(nldd_well_model)
+            {
+                try {
+                    func();
+                }
+                catch (...) {
+                    exception = std::current_exception();
+                }
+            }
+            if (exception) {
+                std::rethrow_exception(exception);
+            }
+            return;
+        }
+#endif
+        func();
+    }
+
     //! \brief Solve the equation system for a single domain.
     std::pair<SimulatorReportSingle, ConvergenceReport>
     solveDomain(const Domain& domain,
@@ -368,7 +642,7 @@ private:
         solveTimer.start();
         Dune::Timer detailTimer;
 
-        modelSimulator.model().newtonMethod().setIterationIndex(0);
+        this->setIterationIndex(domain, 0);
 
         // When called, if assembly has already been performed
         // with the initial values, we only need to check
@@ -377,14 +651,17 @@ private:
         int iter = 0;
         if (initial_assembly_required) {
             detailTimer.start();
-            modelSimulator.model().newtonMethod().setIterationIndex(iter);
+            this->setIterationIndex(domain, iter);
             // TODO: we should have a beginIterationLocal function()
             // only handling the well model for now
-            modelSimulator.problem().wellModel().assembleDomain(modelSimulator.model().newtonMethod().numIterations(),
-                                                                modelSimulator.timeStepSize(),
-                                                               domain);
+            this->callWellModel([&] {
+                report += modelSimulator.problem().wellModel().assembleDomain(iter,
+                                                                              modelSimulator.timeStepSize(),
+                                                                              domain,
+                                                                              logger);
+            });
             // Assemble reservoir locally.
-            report += this->assembleReservoirDomain(domain);
+            this->assembleReservoirDomain(domain, iter);
             report.assemble_time += detailTimer.stop();
         }
         detailTimer.reset();
@@ -401,9 +678,11 @@ private:
         // but not done the Schur complement for the wells yet.
         detailTimer.reset();
         detailTimer.start();
-        model_.wellModel().linearizeDomain(domain,
-                                           modelSimulator.model().linearizer().jacobian(),
-                                           modelSimulator.model().linearizer().residual());
+        this->callWellModel([&] {
+            model_.wellModel().linearizeDomain(domain,
+                                               modelSimulator.model().linearizer().jacobian(),
+                                               modelSimulator.model().linearizer().residual());
+        });
         const double tt1 = detailTimer.stop();
         report.assemble_time += tt1;
         report.assemble_time_well += tt1;
@@ -422,14 +701,14 @@ private:
             BVector x(nc);
             detailTimer.reset();
             detailTimer.start();
-            this->solveJacobianSystemDomain(domain, x);
-            model_.wellModel().postSolveDomain(x, domain);
+            const double setup_time = this->solveJacobianSystemDomain(domain, x);
+            this->callWellModel([&] { model_.wellModel().postSolveDomain(x, domain, logger); });
             if (damping_factor != 1.0) {
                 x *= damping_factor;
             }
             report.linear_solve_time += detailTimer.stop();
-            report.linear_solve_setup_time += model_.linearSolveSetupTime();
-            report.total_linear_iterations = model_.linearIterationsLastSolve();
+            report.linear_solve_setup_time += setup_time;
+            report.total_linear_iterations = domain_linsolvers_[domain.index].iterations();
 
             // Update local solution. // TODO: x is still full size, should we optimize it?
             detailTimer.reset();
@@ -441,14 +720,17 @@ private:
             detailTimer.reset();
             detailTimer.start();
             ++iter;
-            modelSimulator.model().newtonMethod().setIterationIndex(iter);
+            this->setIterationIndex(domain, iter);
             // TODO: we should have a beginIterationLocal function()
             // only handling the well model for now
             // Assemble reservoir locally.
-            modelSimulator.problem().wellModel().assembleDomain(modelSimulator.model().newtonMethod().numIterations(),
-                                                                modelSimulator.timeStepSize(),
-                                                                domain);
-            report += this->assembleReservoirDomain(domain);
+            this->callWellModel([&] {
+                report += modelSimulator.problem().wellModel().assembleDomain(iter,
+                                                                              modelSimulator.timeStepSize(),
+                                                                              domain,
+                                                                              logger);
+            });
+            this->assembleReservoirDomain(domain, iter);
             report.assemble_time += detailTimer.stop();
 
             // Check for local convergence.
@@ -462,9 +744,11 @@ private:
             // reservoir linearized equations
             detailTimer.reset();
             detailTimer.start();
-            model_.wellModel().linearizeDomain(domain,
-                                               modelSimulator.model().linearizer().jacobian(),
-                                               modelSimulator.model().linearizer().residual());
+            this->callWellModel([&] {
+                model_.wellModel().linearizeDomain(domain,
+                                                   modelSimulator.model().linearizer().jacobian(),
+                                                   modelSimulator.model().linearizer().residual());
+            });
             const double tt2 = detailTimer.stop();
             report.assemble_time += tt2;
             report.assemble_time_well += tt2;
@@ -494,15 +778,23 @@ private:
     }
 
     /// Assemble the residual and Jacobian of the nonlinear system.
-    SimulatorReportSingle assembleReservoirDomain(const Domain& domain)
+    void assembleReservoirDomain(const Domain& domain, const int iterationIdx)
     {
         // -------- Mass balance equations --------
-        model_.simulator().model().linearizer().linearizeDomain(domain);
-        return model_.wellModel().lastReport();
+        using Linearizer = GetPropType<TypeTag, Properties::Linearizer>;
+        auto& linearizer = model_.simulator().model().linearizer();
+        if constexpr (std::is_same_v<Linearizer, TpfaLinearizer<TypeTag>>) {
+            linearizer.linearizeDomain(domain, iterationIdx, concurrent_solves_);
+        } else {
+            // Only solved sequentially, the linearizer reads the iteration
+            // index from the Newton method.
+            linearizer.linearizeDomain(domain);
+        }
     }
 
     //! \brief Solve the linearized system for a domain.
-    void solveJacobianSystemDomain(const Domain& domain, BVector& global_x)
+    //! \return The linear solver setup time.
+    double solveJacobianSystemDomain(const Domain& domain, BVector& global_x)
     {
         const auto& modelSimulator = model_.simulator();
 
@@ -527,11 +819,12 @@ private:
         auto& linsolver = domain_linsolvers_[domain.index];
 
         linsolver.prepare(jac, res);
-        model_.linearSolveSetupTime() = perfTimer.stop();
+        const double setup_time = perfTimer.stop();
         linsolver.setResidual(res);
         linsolver.solve(x);
 
         Details::setGlobal(x, domain.cells, global_x);
+        return setup_time;
     }
 
     /// Apply an update to the primary variables.
@@ -736,7 +1029,9 @@ private:
                                                           logger,
                                                           B_avg,
                                                           residual_norms);
-        report += model_.wellModel().getDomainWellConvergence(domain, B_avg, logger);
+        this->callWellModel([&] {
+            report += model_.wellModel().getDomainWellConvergence(domain, B_avg, iteration, logger);
+        });
         return report;
     }
 
@@ -749,10 +1044,12 @@ private:
         std::vector<int> domain_order(domains_.size());
         std::iota(domain_order.begin(), domain_order.end(), 0);
 
-        if (model_.param().local_solve_approach_ == DomainSolveApproach::Jacobi) {
+        const auto approach = model_.param().local_solve_approach_;
+        if (approach == DomainSolveApproach::Jacobi) {
             // Do nothing, 0..n-1 order is fine.
             return domain_order;
-        } else if (model_.param().local_solve_approach_ == DomainSolveApproach::GaussSeidel) {
+        } else if (approach == DomainSolveApproach::GaussSeidel ||
+                   approach == DomainSolveApproach::MultiColorGaussSeidel) {
             // Calculate the measure used to order the domains.
             std::vector<Scalar> measure_per_domain(domains_.size());
             switch (model_.param().local_domain_ordering_) {
@@ -802,7 +1099,7 @@ private:
                              [&m](const int i1, const int i2){ return m[i1] > m[i2]; });
             return domain_order;
         } else {
-            throw std::logic_error("Domain solve approach must be Jacobi or Gauss-Seidel");
+            throw std::logic_error("Domain solve approach must be Jacobi, Gauss-Seidel or multicolour Gauss-Seidel");
         }
     }
 
@@ -1001,6 +1298,56 @@ private:
     std::vector<ISTLSolverType> domain_linsolvers_; //!< Vector of linear solvers for each domain
     SimulatorReportSingle local_reports_accumulated_; //!< Accumulated convergence report for subdomain solvers
     int rank_ = 0; //!< MPI rank of this process
+    int num_threads_ = 1; //!< Number of threads solving domains concurrently
+    std::vector<std::vector<int>> domain_neighbors_; //!< Adjacent domains, for colouring
+    bool concurrent_solves_ = false; //!< Whether domains are currently being solved concurrently
+    bool serialize_well_model_ = false; //!< Whether concurrent solves call the well model one at a time
+
+    //! \brief Accumulated statistics of the domain colouring on this process.
+    struct ColoringStatistics
+    {
+        int num_sweeps = 0;             //!< NLDD iterations solved colour by colour
+        std::size_t num_colors = 0;     //!< Colours, summed over the sweeps
+        std::size_t num_domains = 0;    //!< Domain solves, summed over the sweeps
+        std::size_t min_colors = std::numeric_limits<std::size_t>::max();
+        std::size_t max_colors = 0;
+        std::size_t min_group = std::numeric_limits<std::size_t>::max(); //!< Fewest domains of a colour
+        std::size_t max_group = 0;      //!< Most domains of a colour
+        double concurrent_time = 0.0;   //!< Wall time of the concurrent sweeps
+        double domain_time = 0.0;       //!< Summed time of the domain solves of the concurrent sweeps
+
+        void update(const std::vector<std::vector<int>>& color_groups)
+        {
+            ++num_sweeps;
+            num_colors += color_groups.size();
+            min_colors = std::min(min_colors, color_groups.size());
+            max_colors = std::max(max_colors, color_groups.size());
+            for (const auto& group : color_groups) {
+                num_domains += group.size();
+                min_group = std::min(min_group, group.size());
+                max_group = std::max(max_group, group.size());
+            }
+        }
+
+        void report(std::ostream& os) const
+        {
+            if (num_sweeps == 0) {
+                return;
+            }
+            os << fmt::format("Coloured local solves:      {:9}\n", num_sweeps);
+            os << fmt::format("  Colours per solve:        {:9.2f} (min {}, max {})\n",
+                              double(num_colors) / num_sweeps, min_colors, max_colors);
+            os << fmt::format("  Domains per colour:       {:9.2f} (min {}, max {})\n",
+                              double(num_domains) / num_colors, min_group, max_group);
+            if (concurrent_time > 0.0) {
+                // Average number of domains being solved at any time.
+                os << fmt::format("  Concurrent solve time:    {:9.2f} s\n", concurrent_time);
+                os << fmt::format("  Summed domain solve time: {:9.2f} s (concurrency {:.2f})\n",
+                                  domain_time, domain_time / concurrent_time);
+            }
+        }
+    };
+    ColoringStatistics coloring_stats_; //!< Statistics of the domain colouring
 };
 
 } // namespace Opm
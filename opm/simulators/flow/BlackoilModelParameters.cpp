@@ -83,6 +83,8 @@ BlackoilModelParameters<Scalar>::BlackoilModelParameters()
         local_solve_approach_ = DomainSolveApproach::Jacobi;
     } else if (approach == "gauss-seidel") {
         local_solve_approach_ = DomainSolveApproach::GaussSeidel;
+    } else if (approach == "multicolor-gs") {
+        local_solve_approach_ = DomainSolveApproach::MultiColorGaussSeidel;
     } else {
         throw std::runtime_error("Invalid domain solver approach '" + approach + "' specified.");
     }
@@ -91,6 +93,7 @@ BlackoilModelParameters<Scalar>::BlackoilModelParameters()
     local_tolerance_scaling_mb_ = Parameters::Get<Parameters::LocalToleranceScalingMb<Scalar>>();
     local_tolerance_scaling_cnv_ = Parameters::Get<Parameters::LocalToleranceScalingCnv<Scalar>>();
     nldd_num_initial_newton_iter_ = Parameters::Get<Parameters::NlddNumInitialNewtonIter>();
+    nldd_num_threads_ = std::max(1, Parameters::Get<Parameters::NlddNumThreads>());
     num_local_domains_ = Parameters::Get<Parameters::NumLocalDomains>();
     local_domain_partition_imbalance_ = std::max(Scalar{1.0}, Parameters::Get<Parameters::LocalDomainsPartitioningImbalance<Scalar>>());
     local_domain_partition_method_ = Parameters::Get<Parameters::LocalDomainsPartitioningMethod>();
@@ -223,7 +226,7 @@ void BlackoilModelParameters<Scalar>::registerParameters()
     Parameters::Register<Parameters::NonlinearSolver>
         ("Choose nonlinear solver. Valid choices are newton or nldd.");
     Parameters::Register<Parameters::LocalSolveApproach>
-        ("Choose local solve approach. Valid choices are jacobi and gauss-seidel");
+        ("Choose local solve approach. Valid choices are jacobi, gauss-seidel and multicolor-gs");
     Parameters::Register<Parameters::MaxLocalSolveIterations>
         ("Max iterations for local solves with NLDD nonlinear solver.");
     Parameters::Register<Parameters::LocalToleranceScalingMb<Scalar>>
@@ -232,6 +235,9 @@ void BlackoilModelParameters<Scalar>::registerParameters()
         ("Set lower than 1.0 to use stricter convergence tolerance for local solves.");
     Parameters::Register<Parameters::NlddNumInitialNewtonIter>
         ("Number of initial global Newton iterations when running the NLDD nonlinear solver.");
+    Parameters::Register<Parameters::NlddNumThreads>
+        ("Number of threads solving subdomains concurrently when running the NLDD "
+         "nonlinear solver with the jacobi or multicolor-gs local solve approaches.");
     Parameters::Register<Parameters::NumLocalDomains>
         ("Number of local domains for NLDD nonlinear solver.");
     Parameters::Register<Parameters::LocalDomainsPartitioningImbalance<Scalar>>
@@ -140,6 +140,7 @@ struct LocalToleranceScalingMb { static constexpr Scalar value = 1.0; };
 template<class Scalar>
 struct LocalToleranceScalingCnv { static constexpr Scalar value = 0.1; };
 struct NlddNumInitialNewtonIter { static constexpr int value = 1; };
+struct NlddNumThreads { static constexpr int value = 1; };
 struct NumLocalDomains { static constexpr int value = 0; };
 
 template<class Scalar>
@@ -299,7 +300,7 @@ public:
 
     /// Nonlinear solver type: newton or nldd.
     std::string nonlinear_solver_;
-    /// 'jacobi' and 'gauss-seidel' supported.
+    /// 'jacobi', 'gauss-seidel' and 'multicolor-gs' supported.
     DomainSolveApproach local_solve_approach_{DomainSolveApproach::Jacobi};
 
     int max_local_solve_iterations_;
@@ -308,6 +309,8 @@ public:
     Scalar local_tolerance_scaling_cnv_;
 
     int nldd_num_initial_newton_iter_{1};
+    /// Number of threads solving subdomains concurrently (Jacobi and multicolour Gauss-Seidel only).
+    int nldd_num_threads_{1};
     int num_local_domains_{0};
     Scalar local_domain_partition_imbalance_{1.03};
     std::string local_domain_partition_method_;
@@ -986,6 +986,16 @@ localAccumulatedReports() const
                        : SimulatorReportSingle{};
 }
 
+template <class TypeTag>
+void
+BlackoilModel<TypeTag>::
+reportLocalColoring(std::ostream& os) const
+{
+    if (nlddSolver_) {
+        nlddSolver_->reportLocalColoring(os);
+    }
+}
+
 template <class TypeTag>
 void
 BlackoilModel<TypeTag>::
@@ -45,6 +45,10 @@
 #include <utility>
 #include <vector>
 
+#if HAVE_MPI
+#include <mpi.h>
+#endif
+
 namespace Dune {
 template<class Grid> class CartesianIndexMapper;
 }
@@ -74,7 +78,23 @@ public:
                         const Dune::CartesianIndexMapper<EquilGrid>* equilCartMapper,
                         const std::set<std::string>& fipRegionsInterregFlow = {});
 
+    ~CollectDataOnIORank();
+
+    // Select whether the ranks other than the I/O rank wait for the I/O
+    // rank to receive their output data.  Collective on the grid's
+    // communicator.
+    void setAsynchronous(bool asynchronous);
+
     // gather solution to rank 0 for EclipseWriter
+    //
+    // All kinds of output data are packed into a single message per rank.
+    // Rank 0 is the only aggregator, as the writers need the complete
+    // global arrays on one rank, and it always returns with the global
+    // data complete.  By default all ranks take part in a blocking
+    // exchange.  In asynchronous mode the other ranks post a non-blocking
+    // send of their message and return at once, and the send is completed
+    // at the next call, so they continue with the simulation while rank 0
+    // receives the data.
     void collect(const data::Solution&                                localCellData,
                  const std::map<std::pair<std::string, int>, double>& localBlockData,
                  const data::Wells&                                   localWellData,
@@ -147,6 +167,11 @@ public:
     bool isCartIdxOnThisRank(int cartIdx) const;
 
 protected:
+#if HAVE_MPI
+    void exchangeAsynchronous_(P2PCommunicatorType::DataHandleInterface& handle);
+    void waitForPendingSend_();
+#endif
+
     P2PCommunicatorType toIORankComm_;
     InterRegFlowMap globalInterRegFlows_;
     IndexMapType globalCartesianIndex_;
@@ -167,6 +192,15 @@ protected:
     ///
     /// non-empty only when running in parallel
     std::vector<int> sortedCartesianIdx_;
+    /// \brief ranks sending to the I/O rank, in the order of the links
+    std::vector<int> recvRanks_;
+#if HAVE_MPI
+    /// \brief duplicate of the grid's communicator used by the asynchronous
+    ///        gather, MPI_COMM_NULL when the gather is blocking
+    MPI_Comm asyncComm_ = MPI_COMM_NULL;
+    MPI_Request asyncSendRequest_ = MPI_REQUEST_NULL;
+    P2PCommunicatorType::MessageBufferType asyncSendBuffer_;
+#endif
 };
 
 } // end namespace Opm
@@ -35,8 +35,10 @@
 
 #include <algorithm>
 #include <cassert>
+#include <cstddef>
 #include <stdexcept>
 #include <string>
+#include <utility>
 #include <vector>
 
 namespace {
@@ -304,11 +306,17 @@ public:
                 assert(ret.second);
             }
 
-            MessageBufferType buffer;
-            pack(0, buffer);
-
-            // the last index map is the local one
-            doUnpack(indexMaps.back(), buffer);
+            // the last index map is the local one.  Copy the local data
+            // directly instead of going through a message buffer.
+            const auto& indexMap = indexMaps.back();
+            assert(indexMap.size() == localIndexMap_.size());
+            for (const auto& pair : localCellData_) {
+                const auto& data = pair.second.data<double>();
+                auto& globalData = globalCellData_.data<double>(pair.first);
+                for (std::size_t i = 0; i < indexMap.size(); ++i) {
+                    globalData[indexMap[i]] = data[localIndexMap_[i]];
+                }
+            }
         }
     }
 
@@ -319,6 +327,11 @@ public:
         if (link != 0)
             throw std::logic_error("link in method pack is not 0 as expected");
 
+        // size the buffer once for all fields, the cell data is by far the
+        // largest part of the message
+        buffer.reserve(buffer.size() + localCellData_.size() *
+                       (sizeof(unsigned int) + localIndexMap_.size() * sizeof(double)));
+
         // write all cell data registered in local state
         for (const auto& pair : localCellData_) {
             const auto& data = pair.second.data<double>();
@@ -841,6 +854,35 @@ public:
     }
 };
 
+/// Data handle packing several data handles into a single message per
+/// link, such that all output data is collected in one exchange.  The
+/// handles are packed and unpacked in the order they are given.
+class PackUnPackCollection : public P2PCommunicatorType::DataHandleInterface
+{
+    std::vector<P2PCommunicatorType::DataHandleInterface*> handles_;
+
+public:
+    explicit PackUnPackCollection(std::vector<P2PCommunicatorType::DataHandleInterface*> handles)
+        : handles_(std::move(handles))
+    {}
+
+    // pack all data associated with link
+    void pack(int link, MessageBufferType& buffer)
+    {
+        for (auto* handle : handles_) {
+            handle->pack(link, buffer);
+        }
+    }
+
+    // unpack all data associated with link
+    void unpack(int link, MessageBufferType& buffer)
+    {
+        for (auto* handle : handles_) {
+            handle->unpack(link, buffer);
+        }
+    }
+};
+
 template <class Grid, class EquilGrid, class GridView>
 CollectDataOnIORank<Grid,EquilGrid,GridView>::
 CollectDataOnIORank(const Grid& grid, const EquilGrid* equilGrid,
@@ -947,6 +989,7 @@ CollectDataOnIORank(const Grid& grid, const EquilGrid* equilGrid,
 
         // insert send and recv linkage to communicator
         toIORankComm_.insertRequest(send, recv);
+        recvRanks_.assign(recv.begin(), recv.end());
 
         // need an index map for each rank
         indexMaps_.clear();
@@ -964,6 +1007,41 @@ CollectDataOnIORank(const Grid& grid, const EquilGrid* equilGrid,
     }
 }
 
+template <class Grid, class EquilGrid, class GridView>
+CollectDataOnIORank<Grid,EquilGrid,GridView>::
+~CollectDataOnIORank()
+{
+#if HAVE_MPI
+    int finalized = 0;
+    MPI_Finalized(&finalized);
+    if (!finalized) {
+        setAsynchronous(false);
+    }
+#endif
+}
+
+template <class Grid, class EquilGrid, class GridView>
+void CollectDataOnIORank<Grid,EquilGrid,GridView>::
+setAsynchronous([[maybe_unused]] bool asynchronous)
+{
+#if HAVE_MPI
+    if (!isParallel() || asynchronous == (asyncComm_ != MPI_COMM_NULL)) {
+        return;
+    }
+
+    if (asynchronous) {
+        // use a communicator of our own, such that the output messages
+        // can not be matched by other communication on the grid
+        const MPI_Comm comm = toIORankComm_;
+        MPI_Comm_dup(comm, &asyncComm_);
+    }
+    else {
+        waitForPendingSend_();
+        MPI_Comm_free(&asyncComm_);
+    }
+#endif
+}
+
 template <class Grid, class EquilGrid, class GridView>
 void CollectDataOnIORank<Grid,EquilGrid,GridView>::
 collect(const data::Solution&                                localCellData,
@@ -1069,16 +1147,30 @@ collect(const data::Solution&                                localCellData,
         this->isIORank()
     };
 
-    toIORankComm_.exchange(packUnpackCellData);
-    toIORankComm_.exchange(packUnpackWellData);
-    toIORankComm_.exchange(packUnpackGroupAndNetworkData);
-    toIORankComm_.exchange(packUnpackBlockData);
-    toIORankComm_.exchange(packUnpackWBPData);
-    toIORankComm_.exchange(packUnpackAquiferData);
-    toIORankComm_.exchange(packUnpackWellTestState);
-    toIORankComm_.exchange(packUnpackInterRegFlows);
-    toIORankComm_.exchange(packUnpackFlowsn);
-    toIORankComm_.exchange(packUnpackFloresn);
+    // send everything in a single message per rank, rather than one
+    // round of point-to-point communication per kind of data.
+    PackUnPackCollection packUnpackAll {{
+        &packUnpackCellData,
+        &packUnpackWellData,
+        &packUnpackGroupAndNetworkData,
+        &packUnpackBlockData,
+        &packUnpackWBPData,
+        &packUnpackAquiferData,
+        &packUnpackWellTestState,
+        &packUnpackInterRegFlows,
+        &packUnpackFlowsn,
+        &packUnpackFloresn,
+    }};
+
+#if HAVE_MPI
+    if (asyncComm_ != MPI_COMM_NULL) {
+        exchangeAsynchronous_(packUnpackAll);
+    }
+    else
+#endif
+    {
+        toIORankComm_.exchange(packUnpackAll);
+    }
 
 #ifndef NDEBUG
     // make sure every process is on the same page
@@ -1086,6 +1178,61 @@ collect(const data::Solution&                                localCellData,
 #endif
 }
 
+#if HAVE_MPI
+template <class Grid, class EquilGrid, class GridView>
+void CollectDataOnIORank<Grid,EquilGrid,GridView>::
+exchangeAsynchronous_(P2PCommunicatorType::DataHandleInterface& handle)
+{
+    constexpr int tag = 1;
+
+    if (!isIORank()) {
+        // the previous message must have left the buffer before the
+        // buffer is reused.  The I/O rank receives all messages of a
+        // collect() call before it returns, so this does not wait for
+        // more than one gather.
+        waitForPendingSend_();
+        asyncSendBuffer_.clear();
+        handle.pack(0, asyncSendBuffer_);
+        const auto [data, size] = asyncSendBuffer_.buffer();
+        MPI_Isend(data, size, MPI_BYTE, ioRank, tag, asyncComm_, &asyncSendRequest_);
+        return;
+    }
+
+    // The messages from each rank are received in the order in which they
+    // were sent, so probing the ranks one by one can not pick up a message
+    // of the next gather from a rank that is already ahead.
+    const std::size_t numLinks = recvRanks_.size();
+    std::vector<MessageBufferType> buffers(numLinks);
+    std::vector<MPI_Request> requests(numLinks, MPI_REQUEST_NULL);
+    for (std::size_t link = 0; link < numLinks; ++link) {
+        MPI_Status status;
+        MPI_Probe(recvRanks_[link], tag, asyncComm_, &status);
+        int size = 0;
+        MPI_Get_count(&status, MPI_BYTE, &size);
+        buffers[link].resize(size);
+        MPI_Irecv(buffers[link].buffer().first, size, MPI_BYTE,
+                  recvRanks_[link], tag, asyncComm_, &requests[link]);
+    }
+    MPI_Waitall(static_cast<int>(numLinks), requests.data(), MPI_STATUSES_IGNORE);
+
+    // unpack in the order of the links, such that the result does not
+    // depend on the order in which the messages arrived
+    for (std::size_t link = 0; link < numLinks; ++link) {
+        buffers[link].resetReadPosition();
+        handle.unpack(static_cast<int>(link), buffers[link]);
+    }
+}
+
+template <class Grid, class EquilGrid, class GridView>
+void CollectDataOnIORank<Grid,EquilGrid,GridView>::
+waitForPendingSend_()
+{
+    if (asyncSendRequest_ != MPI_REQUEST_NULL) {
+        MPI_Wait(&asyncSendRequest_, MPI_STATUS_IGNORE);
+    }
+}
+#endif
+
 template <class Grid, class EquilGrid, class GridView>
 int CollectDataOnIORank<Grid,EquilGrid,GridView>::
 localIdxToGlobalIdx(unsigned localIdx) const
@@ -305,6 +305,10 @@ protected:
     {
         return this->metisParams_;
     }
+    const std::string& partitionCellWeights() const override
+    {
+        return this->partitionCellWeights_;
+    }
 #endif
 
     // removing some connection located in inactive grid cells
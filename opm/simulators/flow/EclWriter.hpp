@@ -32,6 +32,7 @@
 
 #include <opm/common/TimingMacros.hpp> // OPM_TIMEBLOCK
 #include <opm/common/OpmLog/OpmLog.hpp>
+#include <opm/grid/utility/createThreadIterators.hpp>
 #include <opm/input/eclipse/Schedule/RPTConfig.hpp>
 
 #include <opm/input/eclipse/Units/UnitSystem.hpp>
@@ -54,20 +55,30 @@
 
 #include <boost/date_time/posix_time/posix_time.hpp>
 
+#include <exception>
 #include <limits>
 #include <map>
 #include <memory>
+#include <mutex>
 #include <optional>
 #include <stdexcept>
 #include <string>
 #include <utility>
 #include <vector>
 
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
 namespace Opm::Parameters {
 
 // If available, write the ECL output in a non-blocking manner
 struct EnableAsyncEclOutput { static constexpr bool value = true; };
 
+// Let the ranks other than the I/O rank send their output data without
+// waiting for the I/O rank to receive it
+struct EnableAsyncOutputGather { static constexpr bool value = false; };
+
 // By default, use single precision for the ECL formated results
 struct EclOutputDoublePrecision { static constexpr bool value = false; };
 
@@ -141,6 +152,9 @@ public:
         Parameters::Register<Parameters::EnableAsyncEclOutput>
             ("Write the ECL-formated results in a non-blocking way "
              "(i.e., using a separate thread).");
+        Parameters::Register<Parameters::EnableAsyncOutputGather>
+            ("Send the output data to the I/O rank in a non-blocking way, "
+             "such that the other ranks do not wait for it to be received.");
         Parameters::Register<Parameters::EnableEsmry>
             ("Write ESMRY file for fast loading of summary data.");
     }
@@ -165,6 +179,8 @@ public:
                    Parameters::Get<Parameters::EnableEsmry>())
         , simulator_(simulator)
     {
+        this->collectOnIORank_.setAsynchronous(Parameters::Get<Parameters::EnableAsyncOutputGather>());
+
 #if HAVE_MPI
         if (this->simulator_.vanguard().grid().comm().size() > 1) {
             auto smryCfg = (this->simulator_.vanguard().grid().comm().rank() == 0)
@@ -661,43 +677,12 @@ public:
         }
     }
 
-    const OutputModule& outputModule() const
-    { return *outputModule_; }
-
-    OutputModule& mutableOutputModule() const
-    { return *outputModule_; }
-
-    Scalar restartTimeStepSize() const
-    { return restartTimeStepSize_; }
-
-    template <class Serializer>
-    void serializeOp(Serializer& serializer)
-    {
-        serializer(*outputModule_);
-    }
-
-private:
-    static bool enableEclOutput_()
-    {
-        static bool enable = Parameters::Get<Parameters::EnableEclOutput>();
-        return enable;
-    }
-
-    const EclipseState& eclState() const
-    { return simulator_.vanguard().eclState(); }
-
-    SummaryState& summaryState()
-    { return simulator_.vanguard().summaryState(); }
-
-    Action::State& actionState()
-    { return simulator_.vanguard().actionState(); }
-
-    UDQState& udqState()
-    { return simulator_.vanguard().udqState(); }
-
-    const Schedule& schedule() const
-    { return simulator_.vanguard().schedule(); }
-
+    /*!
+     * \brief Fill the output module's buffers for the interior cells of
+     *        this process, unless they are valid already.
+     *
+     * The result does not depend on the number of threads.
+     */
     void prepareLocalCellData(const bool isSubStep,
                               const int  reportStepNum)
     {
@@ -717,54 +702,54 @@ private:
                          isSubStep && !Parameters::Get<Parameters::EnableWriteAllSolutions>(),
                          log, /*isRestart*/ false);
 
-        ElementContext elemCtx(simulator_);
-
         OPM_BEGIN_PARALLEL_TRY_CATCH();
 
+        // The elements are processed in chunks which are distributed over
+        // the threads. Contributions shared between cells are collected per
+        // chunk and merged in chunk order, so the output does not depend on
+        // the number of threads.
+        const auto chunks = this->createElementChunks_(gridView);
+        const int numChunks = chunks.size() - 1;
+
         {
             OPM_TIMEBLOCK(prepareCellBasedData);
 
-            this->outputModule_->prepareDensityAccumulation();
-
-            for (const auto& elem : elements(gridView, Dune::Partitions::interior)) {
-                elemCtx.updatePrimaryStencil(elem);
-                elemCtx.updatePrimaryIntensiveQuantities(/*timeIdx=*/0);
+            const bool processMech = enableMech &&
+                simulator_.vanguard().eclState().runspec().mech();
+            const bool processFlows =
+                ! this->simulator_.model().linearizer().getFlowsInfo().empty();
 
-                this->outputModule_->processElement(elemCtx);
-            }
-
-            this->outputModule_->accumulateDensityParallel();
-        }
+            this->outputModule_->prepareDensityAccumulation();
 
-        if constexpr (enableMech) {
-            if (simulator_.vanguard().eclState().runspec().mech()) {
-                OPM_TIMEBLOCK(prepareMechData);
-                for (const auto& elem : elements(gridView, Dune::Partitions::interior)) {
-                    elemCtx.updatePrimaryStencil(elem);
-                    elemCtx.updatePrimaryIntensiveQuantities(/*timeIdx=*/0);
-                    outputModule_->processElementMech(elemCtx);
+            std::vector<typename OutputModule::ElementContributions> contributions(numChunks);
+            this->forEachInteriorElement_(chunks,
+                [this, processMech, processFlows, &contributions]
+                (const ElementContext& elemCtx, const int chunk)
+            {
+                this->outputModule_->processElement(elemCtx, &contributions[chunk]);
+                if constexpr (enableMech) {
+                    if (processMech) {
+                        this->outputModule_->processElementMech(elemCtx);
+                    }
                 }
-            }
-        }
-
-        if (! this->simulator_.model().linearizer().getFlowsInfo().empty()) {
-            OPM_TIMEBLOCK(prepareFlowsData);
-            for (const auto& elem : elements(gridView, Dune::Partitions::interior)) {
-                elemCtx.updatePrimaryStencil(elem);
-                elemCtx.updatePrimaryIntensiveQuantities(/*timeIdx=*/0);
+                if (processFlows) {
+                    this->outputModule_->processElementFlows(elemCtx);
+                }
+            });
 
-                this->outputModule_->processElementFlows(elemCtx);
-            }
+            this->outputModule_->mergeElementContributions(contributions);
+            this->outputModule_->accumulateDensityParallel();
         }
 
         {
+            // Block data needs the region averaged densities and the flows
+            // of all cells, so it is processed in a separate pass.
             OPM_TIMEBLOCK(prepareBlockData);
-            for (const auto& elem : elements(gridView, Dune::Partitions::interior)) {
-                elemCtx.updatePrimaryStencil(elem);
-                elemCtx.updatePrimaryIntensiveQuantities(/*timeIdx=*/0);
-
+            this->forEachInteriorElement_(chunks,
+                [this](const ElementContext& elemCtx, int /*chunk*/)
+            {
                 this->outputModule_->processElementBlockData(elemCtx);
-            }
+            });
         }
 
         {
@@ -787,6 +772,109 @@ private:
                                    this->simulator_.vanguard().grid().comm());
     }
 
+    const OutputModule& outputModule() const
+    { return *outputModule_; }
+
+    OutputModule& mutableOutputModule() const
+    { return *outputModule_; }
+
+    Scalar restartTimeStepSize() const
+    { return restartTimeStepSize_; }
+
+    template <class Serializer>
+    void serializeOp(Serializer& serializer)
+    {
+        serializer(*outputModule_);
+    }
+
+private:
+    static bool enableEclOutput_()
+    {
+        static bool enable = Parameters::Get<Parameters::EnableEclOutput>();
+        return enable;
+    }
+
+    const EclipseState& eclState() const
+    { return simulator_.vanguard().eclState(); }
+
+    SummaryState& summaryState()
+    { return simulator_.vanguard().summaryState(); }
+
+    Action::State& actionState()
+    { return simulator_.vanguard().actionState(); }
+
+    UDQState& udqState()
+    { return simulator_.vanguard().udqState(); }
+
+    const Schedule& schedule() const
+    { return simulator_.vanguard().schedule(); }
+
+    std::vector<ElementIterator> createElementChunks_(const GridView& gridView) const
+    {
+        int numThreads = 1;
+#ifdef _OPENMP
+        numThreads = omp_get_max_threads();
+#endif
+        constexpr int maxChunkSize = 1000;
+        int chunkSize = -1;
+        return createThreadIterators(gridView, numThreads, maxChunkSize, chunkSize);
+    }
+
+    /*!
+     * \brief Call a function for all interior elements of the given chunks.
+     *
+     * The chunks are distributed over the threads, each of which uses its
+     * own element context. The function is passed the element context,
+     * updated for the element, and the index of the element's chunk.
+     */
+    template <class Function>
+    void forEachInteriorElement_(const std::vector<ElementIterator>& chunks,
+                                 Function&& function)
+    {
+        const int numChunks = chunks.size() - 1;
+
+        // exceptions must not escape the parallel block, so we store the
+        // first one that occurs and rethrow it afterwards
+        std::mutex exceptionLock;
+        std::exception_ptr exceptionPtr = nullptr;
+
+#ifdef _OPENMP
+#pragma omp parallel
+#endif
+        {
+            ElementContext elemCtx(simulator_);
+
+#ifdef _OPENMP
+#pragma omp for schedule(dynamic)
+#endif
+            for (int chunk = 0; chunk < numChunks; ++chunk) {
+                try {
+                    for (auto it = chunks[chunk]; it != chunks[chunk + 1]; ++it) {
+                        const Element& elem = *it;
+                        if (elem.partitionType() != Dune::InteriorEntity) {
+                            continue;
+                        }
+
+                        elemCtx.updatePrimaryStencil(elem);
+                        elemCtx.updatePrimaryIntensiveQuantities(/*timeIdx=*/0);
+
+                        function(elemCtx, chunk);
+                    }
+                }
+                catch (...) {
+                    std::lock_guard<std::mutex> lock(exceptionLock);
+                    if (!exceptionPtr) {
+                        exceptionPtr = std::current_exception();
+                    }
+                }
+            }
+        }
+
+        if (exceptionPtr) {
+            std::rethrow_exception(exceptionPtr);
+        }
+    }
+
     void captureLocalFluxData()
     {
         OPM_TIMEBLOCK(captureLocalData);
@@ -28,15 +28,19 @@
 #ifndef FI_BLACK_OIL_MODEL_HPP
 #define FI_BLACK_OIL_MODEL_HPP
 
+#include <opm/models/blackoil/blackoilcompactintensivequantities.hh>
 #include <opm/models/blackoil/blackoilmodel.hh>
+#include <opm/models/utils/parametersystem.hpp>
 #include <opm/models/utils/propertysystem.hh>
 
 #include <opm/common/ErrorMacros.hpp>
+#include <opm/common/OpmLog/OpmLog.hpp>
 
 #include <opm/grid/utility/createThreadIterators.hpp>
 
 #include <opm/simulators/utils/DeferredLoggingErrorHelpers.hpp>
 
+#include <cassert>
 #include <cstddef>
 #include <stdexcept>
 #include <type_traits>
@@ -46,6 +50,19 @@
 #include <omp.h>
 #endif
 
+namespace Opm::Parameters {
+
+/*!
+ * \brief Specify whether the intensive quantities used by the linearization
+ *        should also be stored in a compact form.
+ *
+ * This reduces the memory traffic of the TPFA linearization, at the cost of
+ * storing a copy of the quantities that it reads.
+ */
+struct EnableCompactIntensiveQuantities { static constexpr bool value = false; };
+
+} // namespace Opm::Parameters
+
 namespace Opm
 {
 template <typename TypeTag>
@@ -70,6 +87,9 @@ class FIBlackOilModel : public BlackOilModel<TypeTag>
     static constexpr bool gridIsUnchanging = std::is_same_v<GetPropType<TypeTag, Properties::Grid>, Dune::CpGrid>;
 
 public:
+    using CompactIntensiveQuantities = BlackOilCompactIntensiveQuantities<TypeTag>;
+    using CompactIntensiveQuantityArrays = BlackOilCompactIntensiveQuantityArrays<TypeTag>;
+
     explicit FIBlackOilModel(Simulator& simulator)
         : BlackOilModel<TypeTag>(simulator)
     {
@@ -89,6 +109,39 @@ public:
         }
     }
 
+    static void registerParameters()
+    {
+        ParentType::registerParameters();
+
+        Parameters::Register<Parameters::EnableCompactIntensiveQuantities>
+            ("Store the intensive quantities used by the TPFA linearization in a compact form");
+    }
+
+    void finishInit()
+    {
+        ParentType::finishInit();
+
+        if constexpr (CompactIntensiveQuantities::isSupported) {
+            bool enable = Parameters::Get<Parameters::EnableCompactIntensiveQuantities>();
+            if (enable) {
+                const auto& materialLawManager = this->simulator_.problem().materialLawManager();
+                if (!this->enableIntensiveQuantityCache_ ||
+                    materialLawManager->hasDirectionalRelperms() ||
+                    materialLawManager->hasDirectionalImbnum())
+                {
+                    OpmLog::warning("Compact intensive quantities require the intensive quantity cache "
+                                    "and do not support directional relative permeabilities. "
+                                    "Using the full intensive quantities.");
+                    enable = false;
+                }
+            }
+            if (enable) {
+                compactIntQuants_.resize(this->numGridDof());
+                useCompactIntQuants_ = true;
+            }
+        }
+    }
+
     void invalidateAndUpdateIntensiveQuantities(unsigned timeIdx) const
     {
         this->invalidateIntensiveQuantitiesCache(timeIdx);
@@ -124,7 +177,7 @@ public:
     void invalidateAndUpdateIntensiveQuantitiesOverlap(unsigned timeIdx) const
     {
         // loop over all elements
-        ThreadedEntityIterator<GridView, /*codim=*/0> threadedElemIt(this->gridView_);
+        ThreadedEntityIterator<GridView, /*codim=*/0> threadedElemIt(this->gridView_, this->elementChunks());
         OPM_BEGIN_PARALLEL_TRY_CATCH()
 #ifdef _OPENMP
 #pragma omp parallel
@@ -154,11 +207,13 @@ public:
     template <class GridSubDomain>
     void invalidateAndUpdateIntensiveQuantities(unsigned timeIdx, const GridSubDomain& gridSubDomain) const
     {
-        // loop over all elements in the subdomain
+        // loop over all elements in the subdomain. Subdomains may be
+        // updated concurrently from within a parallel region, in which
+        // case the calling thread handles all the domain's elements.
         using GridViewType = decltype(gridSubDomain.view);
         ThreadedEntityIterator<GridViewType, /*codim=*/0> threadedElemIt(gridSubDomain.view);
 #ifdef _OPENMP
-#pragma omp parallel
+#pragma omp parallel if (!omp_in_parallel())
 #endif
         {
             ElementContext elemCtx(this->simulator_);
@@ -196,6 +251,33 @@ public:
         invalidateAndUpdateIntensiveQuantities(/*timeIdx=*/0);
     }
 
+    /*!
+     * \brief Update the intensive quantity cache for a degree of freedom, and
+     *        its compact copy if enabled.
+     */
+    void updateCachedIntensiveQuantities(const IntensiveQuantities& intQuants,
+                                         unsigned globalIdx,
+                                         unsigned timeIdx) const
+    {
+        ParentType::updateCachedIntensiveQuantities(intQuants, globalIdx, timeIdx);
+        if (useCompactIntQuants_ && timeIdx == 0) {
+            compactIntQuants_.assign(globalIdx, intQuants);
+        }
+    }
+
+    //! \brief Whether compact copies of the most recent intensive quantities
+    //!        are available.
+    bool useCompactIntensiveQuantities() const
+    { return useCompactIntQuants_; }
+
+    //! \brief Return the compact copy of the most recent intensive quantities
+    //!        of a degree of freedom.
+    CompactIntensiveQuantities compactIntensiveQuantities(unsigned globalIdx) const
+    {
+        assert(useCompactIntQuants_ && this->cachedIntensiveQuantities(globalIdx, /*timeIdx=*/0));
+        return compactIntQuants_[globalIdx];
+    }
+
     // standard flow
     const IntensiveQuantities& intensiveQuantities(unsigned globalIdx, unsigned timeIdx) const
     {
@@ -212,6 +294,8 @@ public:
 
 protected:
     std::vector<ElementIterator> grid_chunk_iterators_;
+    mutable CompactIntensiveQuantityArrays compactIntQuants_;
+    bool useCompactIntQuants_ = false;
 };
 } // namespace Opm
 #endif // FI_BLACK_OIL_MODEL_HPP
@@ -124,6 +124,7 @@ FlowGenericVanguard::FlowGenericVanguard(SimulationModelParams&& params)
         metisParams_ = Parameters::Get<Parameters::MetisParams>();
 
         externalPartitionFile_ = Parameters::Get<Parameters::ExternalPartition>();
+        partitionCellWeights_ = Parameters::Get<Parameters::PartitionCellWeights>();
 #endif
         enableDistributedWells_ = Parameters::Get<Parameters::AllowDistributedWells>();
         enableEclOutput_ = Parameters::Get<Parameters::EnableEclOutput>();
@@ -480,6 +481,14 @@ void FlowGenericVanguard::registerParameters_()
          "distribution purposes. If empty, the built-in partitioning "
          "method will be employed.");
     Parameters::Hide<Parameters::ExternalPartition>();
+    Parameters::Register<Parameters::PartitionCellWeights>
+        ("Weights of the cells for the load balancing. Options are "
+         "none (all cells are equally costly) [default], "
+         "model (estimate the cost of each cell from its number of neighbours "
+         "and well connections) or the name of a file containing, for each active "
+         "cell, either a line with its weight or a line with its Cartesian cell "
+         "index and weight, e.g. measured per-cell timings of a previous run. "
+         "Requires Zoltan.");
 
     Parameters::Hide<Parameters::ZoltanImbalanceTol<Scalar>>();
     Parameters::Hide<Parameters::ZoltanParams>();
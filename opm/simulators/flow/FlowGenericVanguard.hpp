@@ -76,6 +76,10 @@ struct ActionParsingStrictness { static constexpr auto value = "normal"; };
 /// represented by one vertex in the graph, see GridEnums.hpp
 struct PartitionMethod { static constexpr int value = 3; };
 
+/// "none": all cells are equally costly, "model": estimate the cost of each
+/// cell, otherwise the name of a file containing the cost of each cell
+struct PartitionCellWeights { static constexpr auto* value = "none"; };
+
 struct SchedRestart{ static constexpr bool value = false; };
 struct SerialPartitioning{ static constexpr bool value = false; };
 
@@ -368,6 +372,7 @@ protected:
     std::string metisParams_;
 
     std::string externalPartitionFile_{};
+    std::string partitionCellWeights_{};
 #endif
     bool enableDistributedWells_;
     bool enableEclOutput_;
@@ -48,6 +48,7 @@
 #include <charconv>
 #include <cstddef>
 #include <memory>
+#include <sstream>
 
 namespace Opm::Parameters {
 
@@ -402,7 +403,10 @@ namespace Opm {
                 = omp_get_max_threads();
 #endif
 
-            printFlowTrailer(mpi_size_, threads, total_setup_time_, deck_read_time_, report, simulator_->model().localAccumulatedReports());
+            std::ostringstream coloring;
+            simulator_->model().reportLocalColoring(coloring);
+            printFlowTrailer(mpi_size_, threads, total_setup_time_, deck_read_time_, report,
+                             simulator_->model().localAccumulatedReports(), coloring.str());
 
             detail::handleExtraConvergenceOutput(report,
                                                  Parameters::Get<Parameters::OutputExtraConvergenceInfo>(),
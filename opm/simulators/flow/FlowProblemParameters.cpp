@@ -62,6 +62,10 @@ void registerFlowProblemParameters()
     Parameters::Register<Parameters::ExplicitRockCompaction>
         ("Use pressure from end of the last time step when evaluating rock compaction");
     Parameters::Hide<Parameters::ExplicitRockCompaction>(); // Users will typically not need to modify this parameter..
+    Parameters::Register<Parameters::EnableTracerSweepSolver>
+        ("Solve the tracer equations by a single sweep over the cells in upwind "
+         "order instead of by BiCGStab when the tracer fluxes have no cycles. "
+         "Only used in sequential runs");
 
     Parameters::Register<Parameters::CheckSatfuncConsistency>
         ("Whether or not to check saturation function consistency requirements");
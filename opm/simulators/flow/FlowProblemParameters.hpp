@@ -39,6 +39,10 @@ struct EnableDriftCompensation { static constexpr bool value = false; };
 // implicit or explicit pressure in rock compaction
 struct ExplicitRockCompaction { static constexpr bool value = false; };
 
+// Solve the tracer equations by a sweep over the cells in upwind order
+// when the tracer fluxes have no cycles
+struct EnableTracerSweepSolver { static constexpr bool value = false; };
+
 // Whether or not to check saturation function consistency requirements.
 struct CheckSatfuncConsistency { static constexpr bool value = false; };
 
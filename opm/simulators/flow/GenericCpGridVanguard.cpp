@@ -28,6 +28,7 @@
 #include <dune/grid/common/partitionset.hh>
 #include <dune/common/version.hh>
 
+#include <opm/common/ErrorMacros.hpp>
 #include <opm/common/TimingMacros.hpp>
 #include <opm/common/utility/ActiveGridCells.hpp>
 
@@ -42,16 +43,23 @@
 #include <opm/simulators/utils/ParallelSerialization.hpp>
 #include <opm/simulators/utils/PropsDataHandle.hpp>
 #include <opm/simulators/utils/SetupPartitioningParams.hpp>
+#include <opm/simulators/utils/readCellWeights.hpp>
 
 #if HAVE_MPI
+#include <opm/simulators/utils/DeferredLoggingErrorHelpers.hpp>
 #include <opm/simulators/utils/MPISerializer.hpp>
 #endif
 
+#if HAVE_MPI && HAVE_ZOLTAN
+#include <opm/simulators/utils/ParallelNLDDPartitioningZoltan.hpp>
+#endif
+
 #if HAVE_DUNE_FEM
 #include <dune/fem/gridpart/adaptiveleafgridpart.hh>
 #include <opm/simulators/flow/FemCpGridCompat.hpp>
 #endif //HAVE_DUNE_FEM
 
+#include <algorithm>
 #include <cassert>
 #include <fstream>
 #include <iterator>
@@ -59,6 +67,7 @@
 #include <optional>
 #include <stdexcept>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 #include <fmt/format.h>
@@ -396,6 +405,14 @@ distributeGrid(const Dune::EdgeWeightMethod                          edgeWeights
             std::get<1>(this->grid_->loadBalance(handle, parts, &wells, possibleFutureConnections, ownersFirst,
                                                  addCornerCells, overlapLayers));
     }
+    else if (const auto& cellWeights = this->partitionCellWeights();
+             !cellWeights.empty() && (cellWeights != "none"))
+    {
+        auto parts = this->partitionWeightedCells_(wells, enableDistributedWells, imbalanceTol);
+        parallelWells =
+            std::get<1>(this->grid_->loadBalance(handle, parts, &wells, possibleFutureConnections, ownersFirst,
+                                                 addCornerCells, overlapLayers));
+    }
     else {
         parallelWells =
             std::get<1>(this->grid_->loadBalance(handle, edgeWeightsMethod,
@@ -406,6 +423,176 @@ distributeGrid(const Dune::EdgeWeightMethod                          edgeWeights
                                                  partitionMethod, imbalanceTol,
                                                  enableDistributedWells));
     }
+
+    handle.scatterProps();
+}
+
+template <class ElementMapper, class GridView, class Scalar>
+std::vector<int>
+GenericCpGridVanguard<ElementMapper, GridView, Scalar>::
+partitionWeightedCells_([[maybe_unused]] const std::vector<Well>& wells,
+                        [[maybe_unused]] const bool               enableDistributedWells,
+                        [[maybe_unused]] const double             imbalanceTol) const
+{
+#if HAVE_ZOLTAN
+    OPM_TIMEBLOCK(partitionWeightedCells);
+    const auto& grid = *this->grid_;
+    const auto isIORank = grid.comm().rank() == 0;
+    const auto nc = static_cast<std::size_t>(grid.size(0));
+
+    auto weights = std::vector<float>{};
+    OPM_BEGIN_PARALLEL_TRY_CATCH()
+    if (isIORank) {
+        weights = this->cellWeights_(wells);
+    }
+    OPM_END_PARALLEL_TRY_CATCH(std::string { "partitionWeightedCells_()/cellWeights" },
+                               grid.comm())
+
+    // The undistributed grid is held by the I/O rank, so the other ranks
+    // contribute no vertices to the graph.
+    const auto& globalCell = grid.globalCell();
+    auto partitioner = ParallelNLDDPartitioningZoltan {
+        grid.comm(), nc, [&globalCell](const int c) { return globalCell[c]; }
+    };
+
+    if (isIORank) {
+        const auto gridView = grid.leafGridView();
+        const auto elemMapper = Dune::MultipleCodimMultipleGeomTypeMapper<Dune::CpGrid::LeafGridView> {
+            gridView, Dune::mcmgElementLayout()
+        };
+
+        for (const auto& elem : elements(gridView)) {
+            for (const auto& is : intersections(gridView, elem)) {
+                if (is.neighbor()) {
+                    partitioner.registerConnection(elemMapper.index(is.inside()),
+                                                   elemMapper.index(is.outside()));
+                }
+            }
+        }
+
+        if (!enableDistributedWells) {
+            auto g2l = std::unordered_map<int, int>{};
+            auto locCell = 0;
+            for (const auto& globCell : globalCell) {
+                g2l.insert_or_assign(globCell, locCell++);
+            }
+
+            for (const auto& well : wells) {
+                auto cells = std::vector<int>{};
+                for (const auto& conn : well.getConnections()) {
+                    if (auto pos = g2l.find(conn.global_index()); pos != g2l.end()) {
+                        cells.push_back(pos->second);
+                    }
+                }
+                // Connect the cells of the well in a chain, which keeps them
+                // connected in the graph with a number of edges linear in
+                // the number of connections.
+                for (auto c = 1 + 0*cells.size(); c < cells.size(); ++c) {
+                    partitioner.registerConnection(cells[c - 1], cells[c]);
+                }
+                if (!cells.empty()) {
+                    partitioner.forceSameDomain(std::move(cells));
+                }
+            }
+        }
+
+        partitioner.setVertexWeights(std::vector<float>(weights));
+    }
+
+    auto params = setupZoltanParams(this->zoltanParams());
+    params.insert_or_assign("NUM_GLOBAL_PARTS", fmt::format("{}", grid.comm().size()));
+    params.insert_or_assign("IMBALANCE_TOL", fmt::format("{}", imbalanceTol));
+
+    auto parts = partitioner.partitionElements(params);
+
+    if (isIORank) {
+        // Cells without neighbours are not part of the graph. Put each of
+        // them on the least loaded process.
+        auto load = std::vector<double>(grid.comm().size(), 0.0);
+        for (auto c = 0*nc; c < nc; ++c) {
+            if (parts[c] >= 0) {
+                load[parts[c]] += weights[c];
+            }
+        }
+        for (auto c = 0*nc; c < nc; ++c) {
+            if (parts[c] < 0) {
+                parts[c] = std::distance(load.begin(), std::min_element(load.begin(), load.end()));
+                load[parts[c]] += weights[c];
+            }
+        }
+
+        const auto totalLoad = std::accumulate(load.begin(), load.end(), 0.0);
+        if (totalLoad > 0.0) {
+            OpmLog::info(fmt::format("Weighted load balancing: the largest part has "
+                                     "{:.3f} times the average cell weight",
+                                     *std::max_element(load.begin(), load.end()) * load.size() / totalLoad));
+        }
+    }
+
+    return parts;
+#else
+    OPM_THROW(std::runtime_error, "Weighted load balancing (--partition-cell-weights) "
+              "requires Zoltan, which is not available in the current build configuration.");
+#endif // HAVE_ZOLTAN
+}
+
+template <class ElementMapper, class GridView, class Scalar>
+std::vector<float>
+GenericCpGridVanguard<ElementMapper, GridView, Scalar>::
+cellWeights_(const std::vector<Well>& wells) const
+{
+    const auto& grid = *this->grid_;
+    const auto& method = this->partitionCellWeights();
+    if (method == "model") {
+        // Rough cost model: the work of the linearization and of the linear
+        // solver grows with the number of blocks in a cell's matrix row, and
+        // each well connection adds the well equations and their coupling to
+        // the reservoir, which are more expensive for multi-segment wells.
+        constexpr float connectionWeight = 5.0f;
+        constexpr float multiSegmentFactor = 2.0f;
+
+        auto weights = std::vector<float>(grid.size(0), 1.0f);
+        const auto gridView = grid.leafGridView();
+        const auto elemMapper = Dune::MultipleCodimMultipleGeomTypeMapper<Dune::CpGrid::LeafGridView> {
+            gridView, Dune::mcmgElementLayout()
+        };
+        for (const auto& elem : elements(gridView)) {
+            auto& weight = weights[elemMapper.index(elem)];
+            for (const auto& is : intersections(gridView, elem)) {
+                if (is.neighbor()) {
+                    weight += 1.0f;
+                }
+            }
+        }
+
+        auto g2l = std::unordered_map<int, int>{};
+        auto locCell = 0;
+        for (const auto& globCell : grid.globalCell()) {
+            g2l.insert_or_assign(globCell, locCell++);
+        }
+
+        for (const auto& well : wells) {
+            const auto weight = well.isMultiSegment()
+                ? connectionWeight * multiSegmentFactor
+                : connectionWeight;
+            for (const auto& conn : well.getConnections()) {
+                if (auto pos = g2l.find(conn.global_index()); pos != g2l.end()) {
+                    weights[pos->second] += weight;
+                }
+            }
+        }
+
+        return weights;
+    }
+
+    std::ifstream wfile { method };
+    if (!wfile) {
+        throw std::invalid_argument {
+            fmt::format("Unable to open cell weight file '{}'", method)
+        };
+    }
+
+    return util::readCellWeights(wfile, method, grid.globalCell());
 }
 
 #endif  // HAVE_MPI
@@ -201,9 +201,29 @@ private:
                         ParallelEclipseState*                                 eclState,
                         FlowGenericVanguard::ParallelWellStruct&              parallelWells);
 
+    /*!
+     * \brief Partition the cells of the undistributed grid into one part per
+     *        process such that the parts have approximately equal total cell
+     *        weights.
+     *
+     * The weights are selected by partitionCellWeights(). Must be called on
+     * all processes, the partition is only returned on the I/O rank.
+     */
+    std::vector<int> partitionWeightedCells_(const std::vector<Well>& wells,
+                                             const bool enableDistributedWells,
+                                             const double imbalanceTol) const;
+
+    /*!
+     * \brief The weight of each cell of the undistributed grid.
+     *
+     * Only called on the I/O rank.
+     */
+    std::vector<float> cellWeights_(const std::vector<Well>& wells) const;
+
 protected:
     virtual const std::string& zoltanParams() const = 0;
     virtual const std::string& metisParams() const = 0;
+    virtual const std::string& partitionCellWeights() const = 0;
 
 #endif  // HAVE_MPI
 
@@ -305,6 +305,26 @@ outputTimeStamp(const std::string& lbl,
     logOutput_.timeStamp(lbl, elapsed, rstep, currentDate);
 }
 
+template<class FluidSystem>
+void GenericOutputBlackoilModule<FluidSystem>::
+mergeElementContributions(const std::vector<ElementContributions>& contributions)
+{
+    for (const auto& contrib : contributions) {
+        this->failedCellsPb_.insert(this->failedCellsPb_.end(),
+                                    contrib.failedCellsPb.begin(),
+                                    contrib.failedCellsPb.end());
+        this->failedCellsPd_.insert(this->failedCellsPd_.end(),
+                                    contrib.failedCellsPd.begin(),
+                                    contrib.failedCellsPd.end());
+
+        for (const auto& density : contrib.density) {
+            this->regionAvgDensity_->addCell(density.globalDofIdx,
+                                             density.phase,
+                                             density.value);
+        }
+    }
+}
+
 template<class FluidSystem>
 void GenericOutputBlackoilModule<FluidSystem>::
 prepareDensityAccumulation()
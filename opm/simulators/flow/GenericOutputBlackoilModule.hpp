@@ -92,6 +92,29 @@ public:
                          int rstep,
                          boost::posix_time::ptime currentDate);
 
+    /// Contributions of a range of elements to output quantities which are
+    /// shared between cells.  These are collected separately for each range
+    /// when the elements are processed concurrently, and merged in the order
+    /// of the ranges by mergeElementContributions().  The result is thus
+    /// independent of the number of threads.
+    struct ElementContributions
+    {
+        struct DensityContribution
+        {
+            unsigned globalDofIdx;
+            RegionPhasePoreVolAverage::Phase phase;
+            RegionPhasePoreVolAverage::CellValue value;
+        };
+
+        std::vector<int> failedCellsPb;
+        std::vector<int> failedCellsPd;
+        std::vector<DensityContribution> density;
+    };
+
+    /// Merge contributions collected by concurrent calls of processElement()
+    /// into the internal arrays, in the order of the element ranges.
+    void mergeElementContributions(const std::vector<ElementContributions>& contributions);
+
     /// Clear internal arrays for parallel accumulation of per-region phase
     /// density averages.
     void prepareDensityAccumulation();
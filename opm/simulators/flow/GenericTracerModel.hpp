@@ -34,6 +34,8 @@
 
 #include <opm/models/blackoil/blackoilmodel.hh>
 
+#include <opm/simulators/flow/TracerSweepSolver.hpp>
+
 #include <opm/simulators/linalg/matrixblock.hh>
 
 #include <opm/input/eclipse/EclipseState/Phase.hpp>
@@ -155,6 +157,12 @@ protected:
 
     /// \brief Function returning the cell centers
     std::function<std::array<double,dimWorld>(int)> centroids_;
+
+    /// \brief Whether the sweep solver is tried before the iterative solver
+    bool enableSweepSolver_ = false;
+
+    /// \brief Direct solver used when the tracer fluxes have no cycles
+    TracerSweepSolver<TracerMatrix, TracerVector> sweepSolver_;
 };
 
 } // namespace Opm
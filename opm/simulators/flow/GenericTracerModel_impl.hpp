@@ -468,6 +468,16 @@ linearSolveBatchwise_(const TracerMatrix& M, std::vector<TracerVector>& x, std::
     else
     {
 #endif
+        // The fluxes are upwinded, so the matrix is block triangular in a
+        // topological ordering of the cells unless the fluxes have cycles.
+        // If enabled, all tracers of the batch are then solved exactly in a
+        // single sweep, unless a diagonal block is too ill-conditioned for
+        // the sweep.
+        if (enableSweepSolver_ && sweepSolver_.update(M)) {
+            sweepSolver_.apply(x, b);
+            return true;
+        }
+
         using TracerSolver = Dune::BiCGSTABSolver<TracerVector>;
         using TracerOperator = Dune::MatrixAdapter<TracerMatrix,TracerVector,TracerVector>;
         using TracerScalarProduct = Dune::SeqScalarProduct<TracerVector>;
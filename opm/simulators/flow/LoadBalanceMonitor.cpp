@@ -0,0 +1,117 @@
+/*
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <config.h>
+#include <opm/simulators/flow/LoadBalanceMonitor.hpp>
+
+#include <opm/common/ErrorMacros.hpp>
+#include <opm/common/OpmLog/OpmLog.hpp>
+
+#include <opm/grid/common/CommunicationUtils.hpp>
+
+#include <cstddef>
+#include <fstream>
+#include <limits>
+#include <numeric>
+#include <stdexcept>
+#include <tuple>
+#include <utility>
+
+#include <fmt/format.h>
+
+namespace Opm {
+
+LoadBalanceMonitor::LoadBalanceMonitor(const Parallel::Communication& comm,
+                                       std::vector<int>               cartesianCells,
+                                       const double                   threshold,
+                                       const std::filesystem::path&   weightFile)
+    : comm_(comm)
+    , cartesianCells_(std::move(cartesianCells))
+    , cellWeights_(cartesianCells_.size(), 0.0)
+    , threshold_(threshold)
+    , weightFile_(weightFile)
+{}
+
+double LoadBalanceMonitor::reportStep(const double time,
+                                      const std::vector<double>& cellCosts)
+{
+    if (!cellCosts.empty() && (cellCosts.size() != this->cellWeights_.size())) {
+        OPM_THROW(std::invalid_argument,
+                  fmt::format("Expected the costs of {} cells, got {}",
+                              this->cellWeights_.size(), cellCosts.size()));
+    }
+
+    // Split the time of the process between its cells in proportion to
+    // their measured costs.
+    const auto totalCost = std::accumulate(cellCosts.begin(), cellCosts.end(), 0.0);
+    for (std::size_t i = 0; i < this->cellWeights_.size(); ++i) {
+        this->cellWeights_[i] += (totalCost > 0.0)
+            ? time * cellCosts[i] / totalCost
+            : time / this->cellWeights_.size();
+    }
+
+    const auto maxTime = this->comm_.max(time);
+    const auto meanTime = this->comm_.sum(time) / this->comm_.size();
+    if (!(meanTime > 0.0)) {
+        return 1.0;
+    }
+
+    const auto imbalance = maxTime / meanTime;
+    if ((imbalance > this->threshold_) && !this->imbalanced_) {
+        this->imbalanced_ = true;
+
+        if (this->comm_.rank() == 0) {
+            OpmLog::warning(fmt::format("Load imbalance of {:.2f} between the processes "
+                                        "exceeds the threshold of {:.2f}. The measured cell "
+                                        "weights are written to '{}' at the end of the run. "
+                                        "Restart with --partition-cell-weights={} to rebalance.",
+                                        imbalance, this->threshold_,
+                                        this->weightFile_.generic_string(),
+                                        this->weightFile_.generic_string()));
+        }
+    }
+
+    return imbalance;
+}
+
+void LoadBalanceMonitor::finish()
+{
+    if (this->imbalanced_ && !this->weightsWritten_) {
+        this->writeWeights_();
+    }
+}
+
+void LoadBalanceMonitor::writeWeights_()
+{
+    const auto root = 0;
+    const auto cells = gatherv(this->cartesianCells_, this->comm_, root);
+    const auto weights = gatherv(this->cellWeights_, this->comm_, root);
+
+    if (this->comm_.rank() == root) {
+        std::ofstream os { this->weightFile_ };
+        os.precision(std::numeric_limits<double>::max_digits10);
+        const auto& allCells = std::get<0>(cells);
+        const auto& allWeights = std::get<0>(weights);
+        for (std::size_t i = 0; i < allCells.size(); ++i) {
+            os << allCells[i] << ' ' << allWeights[i] << '\n';
+        }
+    }
+
+    this->weightsWritten_ = true;
+}
+
+} // namespace Opm
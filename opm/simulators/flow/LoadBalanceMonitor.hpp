@@ -0,0 +1,107 @@
+/*
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef OPM_LOAD_BALANCE_MONITOR_HEADER_INCLUDED
+#define OPM_LOAD_BALANCE_MONITOR_HEADER_INCLUDED
+
+#include <opm/simulators/utils/ParallelCommunication.hpp>
+
+#include <filesystem>
+#include <vector>
+
+namespace Opm {
+
+/// Class monitoring the balance of the computational load across the
+/// processes of a parallel run.
+///
+/// At the end of each report step, the processes' times spent in assembly
+/// and linear solves are compared, and the time of each process is split
+/// between its cells in proportion to their measured costs.  If the slowest
+/// process exceeded the average by more than a given factor in any report
+/// step, the cell weights summed over the run are written once, at its end,
+/// to a file which can be passed to --partition-cell-weights.  The grid is
+/// then partitioned according to the measured load when the run is
+/// restarted.
+///
+/// The grid is not repartitioned during the run, since the well and
+/// tracer states, the linear solver's communication and the output's
+/// global index mappings do not support a change of the partition after
+/// the initialisation.
+class LoadBalanceMonitor
+{
+public:
+    /// Constructor.
+    ///
+    /// \param[in] comm Communication object of the grid.
+    ///
+    /// \param[in] cartesianCells Cartesian index of each interior cell of
+    ///   this process.
+    ///
+    /// \param[in] threshold Ratio of the maximum to the average time of
+    ///   the processes above which the cell weights are written.
+    ///
+    /// \param[in] weightFile Name of the cell weight file.
+    LoadBalanceMonitor(const Parallel::Communication& comm,
+                       std::vector<int>               cartesianCells,
+                       const double                   threshold,
+                       const std::filesystem::path&   weightFile);
+
+    /// Account for the time spent by this process in a report step.
+    ///
+    /// Collective operation.
+    ///
+    /// \param[in] time Time spent in assembly and linear solves.
+    ///
+    /// \param[in] cellCosts Measured cost of each interior cell of this
+    ///   process in the report step, in the order of the Cartesian indices
+    ///   passed to the constructor.  Only the ratios between the cells
+    ///   matter.  If empty or all zero, the time is split evenly between
+    ///   the cells.
+    ///
+    /// \return Ratio of the maximum to the average time of the processes.
+    double reportStep(const double time,
+                      const std::vector<double>& cellCosts = {});
+
+    /// Write the cell weights summed over all report steps if any of them
+    /// exceeded the threshold.
+    ///
+    /// Collective operation.  Called once at the end of the run.
+    void finish();
+
+    /// Whether any report step exceeded the threshold.
+    bool imbalanced() const
+    { return imbalanced_; }
+
+    /// Whether the cell weight file has been written.
+    bool weightsWritten() const
+    { return weightsWritten_; }
+
+private:
+    void writeWeights_();
+
+    Parallel::Communication comm_;
+    std::vector<int> cartesianCells_{};
+    std::vector<double> cellWeights_{};
+    double threshold_{};
+    std::filesystem::path weightFile_{};
+    bool imbalanced_{false};
+    bool weightsWritten_{false};
+};
+
+} // namespace Opm
+
+#endif // OPM_LOAD_BALANCE_MONITOR_HEADER_INCLUDED
@@ -215,7 +215,9 @@ void Main::initMPI()
     }
 #elif HAVE_MPI
     if (this->mpi_init_) {
-        MPI_Init(&argc_, &argv_);
+        // Threads solving NLDD subdomains concurrently call MPI one at a time.
+        int provided = MPI_THREAD_SINGLE;
+        MPI_Init_thread(&argc_, &argv_, MPI_THREAD_SERIALIZED, &provided);
     }
 #endif
     FlowGenericVanguard::setCommunication(std::make_unique<Parallel::Communication>());
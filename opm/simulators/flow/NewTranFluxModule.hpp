@@ -133,6 +133,20 @@ class NewTranExtensiveQuantities
 
     using ConvectiveMixingModule = BlackOilConvectiveMixingModule<TypeTag, enableConvectiveMixing>;
     using ModuleParams = typename BlackOilLocalResidualTPFA<TypeTag>::ModuleParams;
+
+    // Default conversions of the cell quantities in calculatePhasePressureDiff_()
+    struct InteriorEvaluation_
+    {
+        const Evaluation& operator()(const Evaluation& eval) const
+        { return eval; }
+    };
+
+    struct ExteriorValue_
+    {
+        Scalar operator()(const Evaluation& eval) const
+        { return Toolbox::value(eval); }
+    };
+
 public:
     /*!
      * \brief Return the intrinsic permeability tensor at a face [m^2]
@@ -306,12 +320,22 @@ public:
         }
     }
 
-    template<class EvalType>
+    /*!
+     * \brief Compute the pressure difference of a phase over a face and its
+     *        upstream direction.
+     *
+     * The quantities of the interior and the exterior cell are converted to
+     * EvalType by interiorEval and exteriorEval. By default, the derivatives
+     * w.r.t. the interior cell are kept and the ones w.r.t. the exterior cell
+     * are dropped.
+     */
+    template<class EvalType, class IntQuants,
+             class InteriorEval = InteriorEvaluation_, class ExteriorEval = ExteriorValue_>
     static void calculatePhasePressureDiff_(short& upIdx,
                                             short& dnIdx,
                                             EvalType& pressureDifference,
-                                            const IntensiveQuantities& intQuantsIn,
-                                            const IntensiveQuantities& intQuantsEx,
+                                            const IntQuants& intQuantsIn,
+                                            const IntQuants& intQuantsEx,
                                             const unsigned phaseIdx,
                                             const unsigned interiorDofIdx,
                                             const unsigned exteriorDofIdx,
@@ -321,7 +345,9 @@ public:
                                             const unsigned globalIndexEx,
                                             const Scalar distZg,
                                             const Scalar thpres,
-                                            const ModuleParams& moduleParams)
+                                            const ModuleParams& moduleParams,
+                                            const InteriorEval& interiorEval = {},
+                                            const ExteriorEval& exteriorEval = {})
     {
 
         // check shortcut: if the mobility of the phase is zero in the interior as
@@ -337,19 +363,21 @@ public:
 
         // do the gravity correction: compute the hydrostatic pressure for the
         // external at the depth of the internal one
-        const Evaluation& rhoIn = intQuantsIn.fluidState().density(phaseIdx);
-        Scalar rhoEx = Toolbox::value(intQuantsEx.fluidState().density(phaseIdx));
-        Evaluation rhoAvg = (rhoIn + rhoEx)/2;
+        const auto rhoIn = interiorEval(intQuantsIn.fluidState().density(phaseIdx));
+        const auto rhoEx = exteriorEval(intQuantsEx.fluidState().density(phaseIdx));
+        EvalType rhoAvg = (rhoIn + rhoEx)/2;
 
-        if constexpr(enableConvectiveMixing) {
+        // Only the default evaluation supports convective mixing, the
+        // BlackOilLocalResidualTPFA face fluxes are not used along with it.
+        if constexpr(enableConvectiveMixing && std::is_same_v<EvalType, Evaluation>) {
             ConvectiveMixingModule::modifyAvgDensity(rhoAvg, intQuantsIn, intQuantsEx, phaseIdx, moduleParams.convectiveMixingModuleParam);
         }
 
-        const Evaluation& pressureInterior = intQuantsIn.fluidState().pressure(phaseIdx);
-        Evaluation pressureExterior = Toolbox::value(intQuantsEx.fluidState().pressure(phaseIdx));
+        const auto pressureInterior = interiorEval(intQuantsIn.fluidState().pressure(phaseIdx));
+        EvalType pressureExterior = exteriorEval(intQuantsEx.fluidState().pressure(phaseIdx));
         if (enableExtbo) // added stability; particulary useful for solvent migrating in pure water
                          // where the solvent fraction displays a 0/1 behaviour ...
-            pressureExterior += Toolbox::value(rhoAvg)*(distZg);
+            pressureExterior += getValue(rhoAvg)*(distZg);
         else
             pressureExterior += rhoAvg*(distZg);
 
@@ -398,7 +426,7 @@ public:
         // datasets. (and even there, its physical justification is quite
         // questionable IMO.)
         if (thpres > 0.0) {
-            if (std::abs(Toolbox::value(pressureDifference)) > thpres) {
+            if (std::abs(getValue(pressureDifference)) > thpres) {
                 if (pressureDifference < 0.0)
                     pressureDifference += thpres;
                 else
@@ -107,6 +107,8 @@ class OutputBlackOilModule : public GenericOutputBlackoilModule<GetPropType<Type
     enum { enableEnergy = getPropValue<TypeTag, Properties::EnableEnergy>() };
 
 public:
+    using ElementContributions = typename BaseType::ElementContributions;
+
     template <class CollectDataToIORankType>
     OutputBlackOilModule(const Simulator& simulator,
                          const SummaryConfig& smryCfg,
@@ -241,13 +243,21 @@ public:
     /*!
      * \brief Modify the internal buffers according to the intensive
      *        quanties relevant for an element
+     *
+     * If \p contributions is given, the quantities which are shared between
+     * cells are added to it instead of the internal buffers. This allows to
+     * call the method concurrently for disjoint sets of elements.
      */
-    void processElement(const ElementContext& elemCtx)
+    void processElement(const ElementContext& elemCtx,
+                        ElementContributions* contributions = nullptr)
     {
         OPM_TIMEBLOCK_LOCAL(processElement);
         if (!std::is_same<Discretization, EcfvDiscretization<TypeTag>>::value)
             return;
 
+        auto& failedCellsPb = contributions != nullptr ? contributions->failedCellsPb : this->failedCellsPb_;
+        auto& failedCellsPd = contributions != nullptr ? contributions->failedCellsPd : this->failedCellsPd_;
+
         const auto& problem = elemCtx.simulator().problem();
         const auto& modelResid = elemCtx.simulator().model().linearizer().residual();
         for (unsigned dofIdx = 0; dofIdx < elemCtx.numPrimaryDof(/*timeIdx=*/0); ++dofIdx) {
@@ -274,7 +284,8 @@ public:
                     * elemCtx.simulator().model().dofTotalVolume(globalDofIdx);
 
                 this->aggregateAverageDensityContributions_(fs, globalDofIdx,
-                                                            static_cast<double>(porv));
+                                                            static_cast<double>(porv),
+                                                            contributions);
             }
 
             if (!this->fluidPressure_.empty()) {
@@ -506,7 +517,7 @@ public:
                         = getValue(FluidSystem::bubblePointPressure(fs, intQuants.pvtRegionIndex()));
                 } catch (const NumericalProblem&) {
                     const auto cartesianIdx = elemCtx.simulator().vanguard().cartesianIndex(globalDofIdx);
-                    this->failedCellsPb_.push_back(cartesianIdx);
+                    failedCellsPb.push_back(cartesianIdx);
                 }
             }
 
@@ -516,7 +527,7 @@ public:
                         = getValue(FluidSystem::dewPointPressure(fs, intQuants.pvtRegionIndex()));
                 } catch (const NumericalProblem&) {
                     const auto cartesianIdx = elemCtx.simulator().vanguard().cartesianIndex(globalDofIdx);
-                    this->failedCellsPd_.push_back(cartesianIdx);
+                    failedCellsPd.push_back(cartesianIdx);
                 }
             }
 
@@ -653,16 +664,23 @@ public:
                         = FluidSystem::viscosity(fsInitial, gasPhaseIdx, intQuants.pvtRegionIndex());
             }
 
-            // Adding Well RFT data
+            // Adding Well RFT data. Only existing entries are updated, using
+            // find() so that elements may be processed concurrently.
             const auto cartesianIdx = elemCtx.simulator().vanguard().cartesianIndex(globalDofIdx);
-            if (this->oilConnectionPressures_.count(cartesianIdx) > 0) {
-                this->oilConnectionPressures_[cartesianIdx] = getValue(fs.pressure(oilPhaseIdx));
+            if (auto it = this->oilConnectionPressures_.find(cartesianIdx);
+                it != this->oilConnectionPressures_.end())
+            {
+                it->second = getValue(fs.pressure(oilPhaseIdx));
             }
-            if (this->waterConnectionSaturations_.count(cartesianIdx) > 0) {
-                this->waterConnectionSaturations_[cartesianIdx] = getValue(fs.saturation(waterPhaseIdx));
+            if (auto it = this->waterConnectionSaturations_.find(cartesianIdx);
+                it != this->waterConnectionSaturations_.end())
+            {
+                it->second = getValue(fs.saturation(waterPhaseIdx));
             }
-            if (this->gasConnectionSaturations_.count(cartesianIdx) > 0) {
-                this->gasConnectionSaturations_[cartesianIdx] = getValue(fs.saturation(gasPhaseIdx));
+            if (auto it = this->gasConnectionSaturations_.find(cartesianIdx);
+                it != this->gasConnectionSaturations_.end())
+            {
+                it->second = getValue(fs.saturation(gasPhaseIdx));
             }
 
             // tracers
@@ -969,7 +987,7 @@ public:
 
                         // Subtract one to convert FIPNUM to region index.
                         const auto datum = this->eclState_.getSimulationConfig()
-                            .datumDepths()(this->regions_["FIPNUM"][dofIdx] - 1);
+                            .datumDepths()(this->regions_.at("FIPNUM")[dofIdx] - 1);
 
                         // Add one to convert region index to region ID.
                         const auto region = RegionPhasePoreVolAverage::Region {
@@ -1005,6 +1023,9 @@ public:
                         std::string logstring = "Keyword '";
                         logstring.append(key.first);
                         logstring.append("' is unhandled for output to summary file.");
+#ifdef _OPENMP
+#pragma omp critical
+#endif
                         OpmLog::warning("Unhandled output keyword", logstring);
                     }
                 }
@@ -1273,7 +1294,8 @@ private:
     template <typename FluidState>
     void aggregateAverageDensityContributions_(const FluidState&  fs,
                                                const unsigned int globalDofIdx,
-                                               const double       porv)
+                                               const double       porv,
+                                               ElementContributions* contributions)
     {
         auto pvCellValue = RegionPhasePoreVolAverage::CellValue{};
         pvCellValue.porv = porv;
@@ -1288,6 +1310,14 @@ private:
             pvCellValue.value = getValue(fs.density(phaseIdx));
             pvCellValue.sat   = getValue(fs.saturation(phaseIdx));
 
+            if (contributions != nullptr) {
+                contributions->density
+                    .push_back({globalDofIdx,
+                                RegionPhasePoreVolAverage::Phase { phaseIdx },
+                                pvCellValue});
+                continue;
+            }
+
             this->regionAvgDensity_
                 ->addCell(globalDofIdx,
                           RegionPhasePoreVolAverage::Phase { phaseIdx },
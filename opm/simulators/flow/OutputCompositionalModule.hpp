@@ -84,6 +84,8 @@ class OutputCompositionalModule : public GenericOutputBlackoilModule<GetPropType
     enum { waterPhaseIdx = FluidSystem::waterPhaseIdx };
 
 public:
+    using ElementContributions = typename BaseType::ElementContributions;
+
     template <class CollectDataToIORankType>
     OutputCompositionalModule(const Simulator& simulator,
                               const SummaryConfig& smryCfg,
@@ -172,8 +174,12 @@ public:
     /*!
      * \brief Modify the internal buffers according to the intensive
      *        quanties relevant for an element
+     *
+     * None of the quantities written here are shared between cells, so
+     * \p contributions is not used.
      */
-    void processElement(const ElementContext& elemCtx)
+    void processElement(const ElementContext& elemCtx,
+                        ElementContributions* /* contributions */ = nullptr)
     {
         OPM_TIMEBLOCK_LOCAL(processElement);
         if (!std::is_same<Discretization, EcfvDiscretization<TypeTag>>::value)
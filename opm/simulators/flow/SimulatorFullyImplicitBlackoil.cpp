@@ -58,6 +58,22 @@ void registerSimulatorParameters()
         ("FileName for .OPMRST file used to load serialized state. "
          "If empty, CASENAME.OPMRST is used.");
     Parameters::Hide<Parameters::LoadFile>();
+    Parameters::Register<Parameters::SaveCompression>
+        ("Deflate compression level (0-9) for the serialized state in "
+         "the .OPMRST file. 0 disables compression.");
+    Parameters::Register<Parameters::SaveDeltas>
+        ("Number of saved report steps stored as deltas against the last "
+         "full snapshot in the .OPMRST file, before a new full snapshot "
+         "is written. 0 stores every step in full. Keeps a copy of the "
+         "local state of the full snapshot in memory until its last delta "
+         "is written. Use opmrst_inspect --compact to store every step "
+         "in full afterwards.");
+    Parameters::Register<Parameters::LoadImbalanceThreshold>
+        ("Ratio of the maximum to the average time spent in assembly and "
+         "linear solves by the processes in a report step above which the "
+         "cell weights measured over the run are written to "
+         "CASENAME.CELLWEIGHTS at its end, for use with "
+         "--partition-cell-weights. 0 disables the monitoring.");
     Parameters::Register<Parameters::Slave>
         ("Specify if the simulation is a slave simulation in a master-slave simulation");
     Parameters::Hide<Parameters::Slave>();
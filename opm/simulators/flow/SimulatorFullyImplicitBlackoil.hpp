@@ -40,11 +40,14 @@
 
 #include <opm/grid/utility/StopWatch.hpp>
 
+#include <opm/models/discretization/common/tpfalinearizer.hh>
+
 #include <opm/simulators/aquifers/BlackoilAquiferModel.hpp>
 #include <opm/simulators/flow/BlackoilModel.hpp>
 #include <opm/simulators/flow/BlackoilModelParameters.hpp>
 #include <opm/simulators/flow/ConvergenceOutputConfiguration.hpp>
 #include <opm/simulators/flow/ExtraConvergenceOutputThread.hpp>
+#include <opm/simulators/flow/LoadBalanceMonitor.hpp>
 #include <opm/simulators/flow/NonlinearSolver.hpp>
 #include <opm/simulators/flow/SimulatorConvergenceOutput.hpp>
 #include <opm/simulators/flow/SimulatorReportBanners.hpp>
@@ -62,6 +65,7 @@
 #include <memory>
 #include <string>
 #include <string_view>
+#include <type_traits>
 #include <utility>
 #include <vector>
 
@@ -75,6 +79,9 @@ struct SaveStep { static constexpr auto* value = ""; };
 struct SaveFile { static constexpr auto* value = ""; };
 struct LoadFile { static constexpr auto* value = ""; };
 struct LoadStep { static constexpr int value = -1; };
+struct SaveCompression { static constexpr int value = 1; };
+struct SaveDeltas { static constexpr int value = 0; };
+struct LoadImbalanceThreshold { static constexpr double value = 0.0; };
 struct Slave { static constexpr bool value = false; };
 
 } // namespace Opm::Parameters
@@ -110,6 +117,7 @@ public:
     using MICPModule = BlackOilMICPModule<TypeTag>;
 
     using Model = BlackoilModel<TypeTag>;
+    using Linearizer = GetPropType<TypeTag, Properties::Linearizer>;
     using Solver = NonlinearSolver<TypeTag, Model>;
     using ModelParameters = typename Model::ModelParameters;
     using SolverParameters = typename Solver::SolverParameters;
@@ -145,7 +153,9 @@ public:
                       Parameters::Get<Parameters::SaveStep>(),
                       Parameters::Get<Parameters::LoadStep>(),
                       Parameters::Get<Parameters::SaveFile>(),
-                      Parameters::Get<Parameters::LoadFile>())
+                      Parameters::Get<Parameters::LoadFile>(),
+                      Parameters::Get<Parameters::SaveCompression>(),
+                      Parameters::Get<Parameters::SaveDeltas>())
     {
         phaseUsage_ = phaseUsageFromDeck(eclState());
 
@@ -308,6 +318,29 @@ public:
                 adaptiveTimeStepping_->setSuggestedNextStep(simulator_.timeStepSize());
             }
         }
+
+        const double imbalanceThreshold = Parameters::Get<Parameters::LoadImbalanceThreshold>();
+        if (imbalanceThreshold > 0.0 && this->grid().comm().size() > 1) {
+            const auto& elemMapper = simulator_.model().elementMapper();
+            const auto& cartMapper = simulator_.vanguard().cartesianIndexMapper();
+            std::vector<int> cartesianCells;
+            for (const auto& elem : elements(simulator_.gridView(), Dune::Partitions::interior)) {
+                loadBalanceCells_.push_back(elemMapper.index(elem));
+                cartesianCells.push_back(cartMapper.cartesianIndex(loadBalanceCells_.back()));
+            }
+
+            const auto& iocfg = this->eclState().cfg().io();
+            loadBalanceMonitor_ = std::make_unique<LoadBalanceMonitor>
+                (this->grid().comm(), std::move(cartesianCells), imbalanceThreshold,
+                 std::filesystem::path { iocfg.getOutputDir() } / (iocfg.getBaseName() + ".CELLWEIGHTS"));
+            lastAssemblyAndSolveTime_ = this->assemblyAndSolveTime_();
+
+            // The time of each process is split between its cells by their
+            // measured linearization times.
+            if constexpr (std::is_same_v<Linearizer, TpfaLinearizer<TypeTag>>) {
+                simulator_.model().linearizer().setMeasureCellTimes(true);
+            }
+        }
     }
 
     void updateTUNING(const Tuning& tuning)
@@ -500,6 +533,22 @@ public:
             convergence_output_.write(reps);
         }
 
+        if (loadBalanceMonitor_) {
+            std::vector<double> cellCosts;
+            if constexpr (std::is_same_v<Linearizer, TpfaLinearizer<TypeTag>>) {
+                auto& linearizer = simulator_.model().linearizer();
+                const auto& cellTimes = linearizer.cellTimes();
+                cellCosts.reserve(loadBalanceCells_.size());
+                for (const auto cellIdx : loadBalanceCells_) {
+                    cellCosts.push_back(cellTimes[cellIdx]);
+                }
+                linearizer.resetCellTimes();
+            }
+            const double time = this->assemblyAndSolveTime_();
+            loadBalanceMonitor_->reportStep(time - lastAssemblyAndSolveTime_, cellCosts);
+            lastAssemblyAndSolveTime_ = time;
+        }
+
         // Increment timer, remember well state.
         ++timer;
         
@@ -526,6 +575,10 @@ public:
             report_.success.output_write_time += finalOutputTimer.stop();
         }
 
+        if (loadBalanceMonitor_) {
+            loadBalanceMonitor_->finish();
+        }
+
         // Stop timer and create timing report
         totalTimer_->stop();
         report_.success.total_time = totalTimer_->secsSinceStart();
@@ -626,6 +679,18 @@ protected:
         return initconfig.restartRequested();
     }
 
+    // Total time spent in assembly and linear solves, including failed steps.
+    double assemblyAndSolveTime_() const
+    {
+        double time = 0.0;
+        for (const auto* report : { &report_.success, &report_.failure }) {
+            time += report->assemble_time
+                + report->linear_solve_setup_time
+                + report->linear_solve_time;
+        }
+        return time;
+    }
+
     WellModel& wellModel_()
     { return simulator_.problem().wellModel(); }
 
@@ -652,6 +717,10 @@ protected:
 
     SimulatorConvergenceOutput convergence_output_;
 
+    std::unique_ptr<LoadBalanceMonitor> loadBalanceMonitor_{};
+    std::vector<unsigned> loadBalanceCells_{};
+    double lastAssemblyAndSolveTime_{0.0};
+
 #ifdef RESERVOIR_COUPLING_ENABLED
     bool slaveMode_{false};
     std::unique_ptr<ReservoirCouplingMaster> reservoirCouplingMaster_{nullptr};
@@ -47,13 +47,22 @@ SimulatorSerializer::SimulatorSerializer(SerializableSim& simulator,
                                          const std::string& saveSpec,
                                          int loadStep,
                                          const std::string& saveFile,
-                                         const std::string& loadFile)
+                                         const std::string& loadFile,
+                                         int saveCompression,
+                                         int saveDeltas)
     : simulator_(simulator)
     , comm_(comm)
     , loadStep_(loadStep)
     , saveFile_(saveFile)
     , loadFile_(loadFile)
+    , saveCompression_(saveCompression)
+    , saveDeltas_(saveDeltas)
 {
+    if (saveCompression_ < 0 || saveCompression_ > 9) {
+        OPM_THROW(std::runtime_error, "Compression level for serialized state "
+                                      "must be between 0 and 9.");
+    }
+
     if (saveSpec == "all") {
         saveStride_ = 1;
     } else if (saveSpec == "last") {
@@ -102,11 +111,16 @@ void SimulatorSerializer::save(SimulatorTimer& timer)
         (saveStride_ != 0 && (nextStep % saveStride_) == 0)) {
 #if HAVE_HDF5
         const std::string groupName = "/report_step/" + std::to_string(nextStep);
-        if (saveStride_ < 0 || nextStep == saveStride_ || nextStep == saveStep_) {
+        const bool newFile = saveStride_ < 0 || nextStep == saveStride_ || nextStep == saveStep_;
+        if (newFile) {
             std::filesystem::remove(saveFile_);
+            baseGroup_.clear();
+            baseBuffer_.clear();
         }
-        HDF5Serializer writer(saveFile_, HDF5File::OpenMode::APPEND, comm_);
-        if (saveStride_ < 0 || nextStep == saveStride_ || nextStep == saveStep_) {
+        HDF5File::DataSetSettings settings;
+        settings.compressionLevel = saveCompression_;
+        HDF5Serializer writer(saveFile_, HDF5File::OpenMode::APPEND, comm_, settings);
+        if (newFile) {
             const auto data = simulator_.getHeader();
             writer.writeHeader(data[0], data[1], data[2], data[3], data[4], comm_.size());
 
@@ -116,7 +130,26 @@ void SimulatorSerializer::save(SimulatorTimer& timer)
                 writer.write(hash, "/", "grid_checksum");
             }
         }
+        // Store the state as a delta against the last full snapshot, if
+        // one was written by this run, until enough deltas have been saved.
+        const bool saveDelta = saveDeltas_ > 0 && !baseGroup_.empty() &&
+                               numDeltas_ < saveDeltas_;
+        if (saveDelta) {
+            writer.setDeltaBase("simulator_data", baseGroup_, baseBuffer_);
+        }
         simulator_.saveState(writer, groupName);
+        if (saveDelta) {
+            // The next step is saved in full, so release the copy of the
+            // base snapshot instead of holding it until then.
+            if (++numDeltas_ == saveDeltas_) {
+                baseGroup_.clear();
+                std::vector<char>().swap(baseBuffer_);
+            }
+        } else if (saveDeltas_ > 0 && saveStride_ >= 0) {
+            baseGroup_ = groupName;
+            baseBuffer_ = writer.buffer();
+            numDeltas_ = 0;
+        }
         writer.write(timer, groupName, "simulator_timer",
                      HDF5File::DataSetMode::ROOT_ONLY);
         OpmLog::info("Serialized state written for report step " + std::to_string(nextStep));
@@ -187,6 +220,39 @@ void SimulatorSerializer::loadState()
     loadStep_ = -1;
 }
 
+void SimulatorSerializer::compact([[maybe_unused]] const std::string& inFile,
+                                  [[maybe_unused]] const std::string& outFile,
+                                  [[maybe_unused]] Parallel::Communication comm)
+{
+#if HAVE_HDF5
+    OPM_BEGIN_PARALLEL_TRY_CATCH();
+
+    HDF5Serializer reader(inFile, HDF5File::OpenMode::READ, comm);
+    HDF5Serializer writer(outFile, HDF5File::OpenMode::OVERWRITE, comm);
+
+    reader.readRaw("/", "simulator_info", HDF5File::DataSetMode::ROOT_ONLY);
+    writer.writeRaw(reader.buffer(), "/", "simulator_info", HDF5File::DataSetMode::ROOT_ONLY);
+    if (comm.size() > 1) {
+        reader.readRaw("/", "grid_checksum");
+        writer.writeRaw(reader.buffer(), "/", "grid_checksum");
+    }
+
+    for (const int step : reader.reportSteps()) {
+        const std::string groupName = "/report_step/" + std::to_string(step);
+        reader.readRaw(groupName, "simulator_data");
+        writer.writeRaw(reader.buffer(), groupName, "simulator_data");
+        reader.readRaw(groupName, "simulator_timer", HDF5File::DataSetMode::ROOT_ONLY);
+        writer.writeRaw(reader.buffer(), groupName, "simulator_timer",
+                        HDF5File::DataSetMode::ROOT_ONLY);
+    }
+
+    OPM_END_PARALLEL_TRY_CATCH("Error compacting serialized state: ", comm);
+#else
+    OPM_THROW(std::runtime_error, "Compaction of serialized state requested, "
+                                  "but no HDF5 support available.");
+#endif
+}
+
 void SimulatorSerializer::checkSerializedCmdLine(const std::string& current,
                                                  const std::string& stored)
 {
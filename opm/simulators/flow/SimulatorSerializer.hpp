@@ -59,13 +59,31 @@ public:
     //! \param loadStep Step to load
     //! \paramn saveFile File to save to
     //! \param loadFile File to load from
+    //! \param saveCompression Deflate compression level for saved state
+    //! \param saveDeltas Number of steps saved as deltas between full snapshots
+    //! \details With saveDeltas > 0 an uncompressed copy of the local state
+    //!          of the last full snapshot is kept in memory until its last
+    //!          delta has been saved.
     SimulatorSerializer(SerializableSim& simulator,
                         Parallel::Communication& comm,
                         const IOConfig& ioconfig,
                         const std::string& saveSpec,
                         int loadStep,
                         const std::string& saveFile,
-                        const std::string& loadFile);
+                        const std::string& loadFile,
+                        int saveCompression = 1,
+                        int saveDeltas = 0);
+
+    //! \brief Rewrite a serialized state file with every step stored in full.
+    //! \param inFile File to compact
+    //! \param outFile File to write compacted state to
+    //! \param comm Communication to use, must match the one used for saving
+    //! \details Steps saved as deltas are reconstructed from their base
+    //!          snapshot, after which any step can be removed from the file.
+    //!          Available from the command line as opmrst_inspect --compact.
+    static void compact(const std::string& inFile,
+                        const std::string& outFile,
+                        Parallel::Communication comm);
 
     //! \brief Returns whether or not a state should be loaded.
     bool shouldLoad() const { return loadStep_ > -1; }
@@ -94,6 +112,15 @@ private:
     int loadStep_ = -1; //!< Step to load serialized state from
     std::string saveFile_; //!< File to save serialized state to
     std::string loadFile_; //!< File to load serialized state from
+    int saveCompression_ = 1; //!< Deflate compression level for saved state
+    int saveDeltas_ = 0; //!< Number of steps saved as deltas between full snapshots
+    int numDeltas_ = 0; //!< Number of deltas saved against current base
+    std::string baseGroup_; //!< Group holding current full snapshot, empty if none
+    //! \brief Serialized state of current full snapshot.
+    //! \details Only held while deltas are saved against it, i.e., one
+    //!          uncompressed copy of the local state of this process between
+    //!          a full snapshot and the last of its deltas.
+    std::vector<char> baseBuffer_;
 };
 
 } // namespace Opm
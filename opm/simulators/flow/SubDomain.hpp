@@ -32,7 +32,8 @@ namespace Opm
     //! \brief Solver approach for NLDD.
     enum class DomainSolveApproach {
         Jacobi,
-        GaussSeidel
+        GaussSeidel,
+        MultiColorGaussSeidel
     };
 
     //! \brief Measure to use for domain ordering.
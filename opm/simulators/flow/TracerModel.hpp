@@ -30,8 +30,10 @@
 
 #include <opm/common/OpmLog/OpmLog.hpp>
 
+#include <opm/models/utils/parametersystem.hpp>
 #include <opm/models/utils/propertysystem.hh>
 
+#include <opm/simulators/flow/FlowProblemParameters.hpp>
 #include <opm/simulators/flow/GenericTracerModel.hpp>
 #include <opm/simulators/utils/VectorVectorDataHandle.hpp>
 
@@ -105,7 +107,9 @@ public:
         , wat_(tbatch[0])
         , oil_(tbatch[1])
         , gas_(tbatch[2])
-    { }
+    {
+        this->enableSweepSolver_ = Parameters::Get<Parameters::EnableTracerSweepSolver>();
+    }
 
 
     /*
@@ -0,0 +1,226 @@
+// -*- mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-
+// vi: set et ts=4 sw=4 sts=4:
+/*
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 2 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+
+  Consult the COPYING file in the top-level source directory of this
+  module for the precise wording of the license and the list of
+  copyright holders.
+*/
+/**
+ * \file
+ *
+ * \copydoc Opm::TracerSweepSolver
+ */
+#ifndef OPM_TRACER_SWEEP_SOLVER_HPP
+#define OPM_TRACER_SWEEP_SOLVER_HPP
+
+#include <dune/common/fmatrix.hh>
+
+#include <cstddef>
+#include <vector>
+
+namespace Opm {
+
+/*!
+ * \brief Direct solver for block matrices which are triangular in some
+ *        ordering of their rows.
+ *
+ * The tracer equations are discretized with upwind fluxes, so the row of a
+ * cell only couples to the cells upstream of it. If the flux field has no
+ * cycles, the cells can be ordered topologically and the system is solved
+ * exactly by a single forward substitution in that order.
+ *
+ * update() computes the ordering, grouped into levels of rows which only
+ * depend on rows of lower levels, and inverts the diagonal blocks. The rows
+ * of a level are independent and are processed concurrently by apply(),
+ * which solves for any number of right-hand sides sharing the matrix in
+ * one sweep.
+ */
+template <class Matrix, class Vector>
+class TracerSweepSolver
+{
+    using Block = typename Matrix::block_type;
+    using Scalar = typename Block::field_type;
+    using InverseBlock = Dune::FieldMatrix<Scalar, Block::rows, Block::cols>;
+
+public:
+    /*!
+     * \brief Analyse the matrix and prepare the sweep.
+     *
+     * \return false if the rows of the matrix can not be ordered such that
+     *         it becomes block triangular, or if a diagonal block is
+     *         singular or nearly so. The solver must not be applied in
+     *         this case.
+     */
+    bool update(const Matrix& M)
+    {
+        const std::size_t numRows = M.N();
+
+        // dependencies of each row, i.e., the nonzero off-diagonal blocks
+        depStart_.assign(1, 0);
+        depCols_.clear();
+        depBlocks_.clear();
+        invDiag_.resize(numRows);
+        std::vector<unsigned> numDeps(numRows, 0);
+        for (auto row = M.begin(); row != M.end(); ++row) {
+            const std::size_t rowIdx = row.index();
+            bool hasDiagonal = false;
+            for (auto col = row->begin(); col != row->end(); ++col) {
+                if (col.index() == rowIdx) {
+                    invDiag_[rowIdx] = *col;
+                    hasDiagonal = true;
+                }
+                else if (!isZero_(*col)) {
+                    depCols_.push_back(col.index());
+                    depBlocks_.push_back(&*col);
+                    ++numDeps[rowIdx];
+                }
+            }
+            depStart_.push_back(depCols_.size());
+
+            if (!hasDiagonal || !invertDiagonal_(invDiag_[rowIdx])) {
+                return false;
+            }
+        }
+
+        // rows which depend on each row
+        std::vector<std::size_t> dependentStart(numRows + 1, 0);
+        for (const auto colIdx : depCols_) {
+            ++dependentStart[colIdx + 1];
+        }
+        for (std::size_t rowIdx = 0; rowIdx < numRows; ++rowIdx) {
+            dependentStart[rowIdx + 1] += dependentStart[rowIdx];
+        }
+        std::vector<std::size_t> dependents(depCols_.size());
+        std::vector<std::size_t> fill(dependentStart.begin(), dependentStart.end() - 1);
+        for (std::size_t rowIdx = 0; rowIdx < numRows; ++rowIdx) {
+            for (std::size_t k = depStart_[rowIdx]; k < depStart_[rowIdx + 1]; ++k) {
+                dependents[fill[depCols_[k]]++] = rowIdx;
+            }
+        }
+
+        // topological ordering by levels (Kahn's algorithm)
+        order_.clear();
+        levelStart_.assign(1, 0);
+        for (std::size_t rowIdx = 0; rowIdx < numRows; ++rowIdx) {
+            if (numDeps[rowIdx] == 0) {
+                order_.push_back(rowIdx);
+            }
+        }
+        std::size_t levelBegin = 0;
+        while (levelBegin < order_.size()) {
+            const std::size_t levelEnd = order_.size();
+            levelStart_.push_back(levelEnd);
+            for (std::size_t i = levelBegin; i < levelEnd; ++i) {
+                const std::size_t rowIdx = order_[i];
+                for (std::size_t k = dependentStart[rowIdx]; k < dependentStart[rowIdx + 1]; ++k) {
+                    if (--numDeps[dependents[k]] == 0) {
+                        order_.push_back(dependents[k]);
+                    }
+                }
+            }
+            levelBegin = levelEnd;
+        }
+
+        // rows which are part of a cycle are never released
+        return order_.size() == numRows;
+    }
+
+    /*!
+     * \brief Solve the system for all right-hand sides.
+     *
+     * Requires a successful call of update() for the matrix, whose values
+     * must not have been changed since.
+     */
+    void apply(std::vector<Vector>& x, const std::vector<Vector>& b) const
+    {
+        const std::size_t numRhs = b.size();
+        for (std::size_t rhsIdx = 0; rhsIdx < numRhs; ++rhsIdx) {
+            x[rhsIdx].resize(b[rhsIdx].size());
+        }
+
+        const int numLevels = static_cast<int>(levelStart_.size()) - 1;
+        for (int level = 0; level < numLevels; ++level) {
+            const int levelBegin = levelStart_[level];
+            const int levelEnd = levelStart_[level + 1];
+
+#ifdef _OPENMP
+#pragma omp parallel for if (levelEnd - levelBegin >= minParallelLevelSize)
+#endif
+            for (int i = levelBegin; i < levelEnd; ++i) {
+                const std::size_t rowIdx = order_[i];
+                for (std::size_t rhsIdx = 0; rhsIdx < numRhs; ++rhsIdx) {
+                    auto rhs = b[rhsIdx][rowIdx];
+                    for (std::size_t k = depStart_[rowIdx]; k < depStart_[rowIdx + 1]; ++k) {
+                        depBlocks_[k]->mmv(x[rhsIdx][depCols_[k]], rhs);
+                    }
+                    invDiag_[rowIdx].mv(rhs, x[rhsIdx][rowIdx]);
+                }
+            }
+        }
+    }
+
+    //! \brief Number of levels of the last successful update().
+    std::size_t numLevels() const
+    { return levelStart_.size() - 1; }
+
+private:
+    //! Levels with fewer rows are processed by a single thread.
+    static constexpr int minParallelLevelSize = 1024;
+
+    //! Diagonal blocks with a larger condition number are treated as
+    //! singular, leaving the system to the iterative solver.
+    static constexpr Scalar maxCondition = 1e10;
+
+    //! \brief Invert a diagonal block in place.
+    //! \return false if the block is singular or too ill-conditioned for
+    //!         the forward substitution to be accurate.
+    static bool invertDiagonal_(InverseBlock& block)
+    {
+        const Scalar norm = block.infinity_norm();
+        if (!(norm > 0.0) || block.determinant() == 0.0) {
+            return false;
+        }
+        block.invert();
+        // The condition number in the infinity norm, which is also false
+        // if the inverse has overflowed.
+        return norm * block.infinity_norm() <= maxCondition;
+    }
+
+    static bool isZero_(const Block& block)
+    {
+        for (const auto& row : block) {
+            for (const auto& value : row) {
+                if (value != 0.0) {
+                    return false;
+                }
+            }
+        }
+        return true;
+    }
+
+    std::vector<std::size_t> depStart_;
+    std::vector<std::size_t> depCols_;
+    std::vector<const Block*> depBlocks_;
+    std::vector<InverseBlock> invDiag_;
+    std::vector<std::size_t> order_;
+    std::vector<std::size_t> levelStart_;
+};
+
+} // namespace Opm
+
+#endif // OPM_TRACER_SWEEP_SOLVER_HPP
@@ -741,22 +741,26 @@ private:
                           const Comm& comm,
                           const Scalar grav);
 
-    template <class CellRange, class EquilibrationMethod>
+    /// Run an equilibration method on each cell of a range.  The cells
+    /// are processed concurrently when OpenMP is enabled, each thread
+    /// evaluating saturations using its own copy of \p psat.
+    template <class CellRange, class PhaseSat, class EquilibrationMethod>
     void cellLoop(const CellRange&      cells,
+                  const PhaseSat&       psat,
                   EquilibrationMethod&& eqmethod);
 
     template <class CellRange, class PressTable, class PhaseSat>
     void equilibrateCellCentres(const CellRange&        cells,
                                 const EquilReg<Scalar>& eqreg,
                                 const PressTable&       ptable,
-                                PhaseSat&               psat);
+                                const PhaseSat&         psat);
 
     template <class CellRange, class PressTable, class PhaseSat>
     void equilibrateHorizontal(const CellRange&        cells,
                                const EquilReg<Scalar>& eqreg,
                                const int               acc,
                                const PressTable&       ptable,
-                               PhaseSat&               psat);
+                               const PhaseSat&         psat);
 
     std::vector< std::shared_ptr<Miscibility::RsFunction<Scalar>> > rsFunc_;
     std::vector< std::shared_ptr<Miscibility::RsFunction<Scalar>> > rvFunc_;
@@ -52,6 +52,8 @@
 #include <algorithm>
 #include <cassert>
 #include <cstddef>
+#include <exception>
+#include <iterator>
 #include <limits>
 #include <stdexcept>
 
@@ -583,11 +585,10 @@ PhaseSaturations(const PhaseSaturations& rhs)
         , swatInit_ (rhs.swatInit_)
         , sat_      (rhs.sat_)
         , press_    (rhs.press_)
+        , evalPt_   (rhs.evalPt_)
 {
-    // Note: We don't need to do anything to the 'fluidState_' here.
-    this->setEvaluationPoint(*rhs.evalPt_.position,
-                             *rhs.evalPt_.region,
-                             *rhs.evalPt_.ptable);
+    // Note: We don't need to do anything to the 'fluidState_' here.  The
+    // evaluation point is empty if 'rhs' has not derived any saturations.
 }
 
 template <class MaterialLawManager, class FluidSystem, class Region, typename CellID>
@@ -1835,11 +1836,21 @@ calcPressSatRsRv(const RMap& reg,
         MaterialLawManager, FluidSystem, EquilReg<Scalar>, typename RMap::CellId
     >;
     
-    auto ptable = Details::PressureTable<FluidSystem, EquilReg<Scalar>>{ grav, this->num_pressure_points_ };
-    auto psat   = PhaseSat { materialLawManager, this->swatInit_ };
-    auto vspan  = std::array<Scalar, 2>{};
+    using PTable = Details::PressureTable<FluidSystem, EquilReg<Scalar>>;
 
+    const auto psat = PhaseSat { materialLawManager, this->swatInit_ };
+    auto vspan      = std::array<Scalar, 2>{};
+
+    // The vertical extent of each region is a collective operation and
+    // must be computed in the same order on all ranks.  Collect the
+    // regions with cells on this rank before doing any local work.
     std::vector<int> regionIsEmpty(rec.size(), 0);
+    std::vector<std::size_t> activeRegions;
+    std::vector<EquilReg<Scalar>> eqregs;
+    std::vector<std::array<Scalar, 2>> vspans;
+    activeRegions.reserve(rec.size());
+    eqregs.reserve(rec.size());
+    vspans.reserve(rec.size());
     for (std::size_t r = 0; r < rec.size(); ++r) {
         const auto& cells = reg.cells(r);
 
@@ -1858,25 +1869,67 @@ calcPressSatRsRv(const RMap& reg,
             continue;
         }
 
-        const auto eqreg = EquilReg {
+        const auto& eqreg = eqregs.emplace_back(
             rec[r], this->rsFunc_[r], this->rvFunc_[r], this->rvwFunc_[r], this->tempVdTable_[r], this->saltVdTable_[r], this->regionPvtIdx_[r]
-        };
+        );
 
         // Ensure gas/oil and oil/water contacts are within the span for the
         // phase pressure calculation.
         vspan[0] = std::min(vspan[0], std::min(eqreg.zgoc(), eqreg.zwoc()));
         vspan[1] = std::max(vspan[1], std::max(eqreg.zgoc(), eqreg.zwoc()));
 
-        ptable.equilibrate(eqreg, vspan);
+        activeRegions.push_back(r);
+        vspans.push_back(vspan);
+    }
+
+    // The phase pressure tables of the regions are independent.  Build
+    // each of them once, concurrently, and share them read-only between
+    // the threads equilibrating the region's cells below.
+    const int numActive = static_cast<int>(activeRegions.size());
+    std::vector<PTable> ptables;
+    ptables.reserve(numActive);
+    for (int i = 0; i < numActive; ++i) {
+        ptables.emplace_back(grav, this->num_pressure_points_);
+    }
+
+    // Rethrow the failure of the first region, as a sequential loop
+    // would, independently of the order in which the threads fail.
+    std::exception_ptr failure;
+    int failureIdx = numActive;
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic)
+#endif
+    for (int i = 0; i < numActive; ++i) {
+        try {
+            ptables[i].equilibrate(eqregs[i], vspans[i]);
+        }
+        catch (...) {
+#ifdef _OPENMP
+#pragma omp critical
+#endif
+            if (i < failureIdx) {
+                failure = std::current_exception();
+                failureIdx = i;
+            }
+        }
+    }
+    if (failure) {
+        std::rethrow_exception(failure);
+    }
+
+    for (int i = 0; i < numActive; ++i) {
+        const auto r      = activeRegions[i];
+        const auto& cells = reg.cells(r);
+        const auto acc    = rec[r].initializationTargetAccuracy();
 
         if (acc == 0) {
             // Centre-point method
-            this->equilibrateCellCentres(cells, eqreg, ptable, psat);
+            this->equilibrateCellCentres(cells, eqregs[i], ptables[i], psat);
         }
         else if (acc < 0) {
             // Horizontal subdivision
-            this->equilibrateHorizontal(cells, eqreg, -acc,
-                                        ptable, psat);
+            this->equilibrateHorizontal(cells, eqregs[i], -acc,
+                                        ptables[i], psat);
         } else {
             // Horizontal subdivision with titled fault blocks
             // the simulator throw a few line above for the acc > 0 case
@@ -1899,13 +1952,14 @@ template<class FluidSystem,
          class GridView,
          class ElementMapper,
          class CartesianIndexMapper>
-template<class CellRange, class EquilibrationMethod>
+template<class CellRange, class PhaseSat, class EquilibrationMethod>
 void InitialStateComputer<FluidSystem,
                           Grid,
                           GridView,
                           ElementMapper,
                           CartesianIndexMapper>::
 cellLoop(const CellRange&      cells,
+         const PhaseSat&       psat,
          EquilibrationMethod&& eqmethod)
 {
     const auto oilPos = FluidSystem::oilPhaseIdx;
@@ -1916,39 +1970,74 @@ cellLoop(const CellRange&      cells,
     const auto gasActive = FluidSystem::phaseIsActive(gasPos);
     const auto watActive = FluidSystem::phaseIsActive(watPos);
 
-    auto pressures   = Details::PhaseQuantityValue<Scalar>{};
-    auto saturations = Details::PhaseQuantityValue<Scalar>{};
-    Scalar Rs          = 0.0;
-    Scalar Rv          = 0.0;
-    Scalar Rvw         = 0.0;
+    const auto numCells = static_cast<int>(std::distance(std::begin(cells), std::end(cells)));
 
-    for (const auto& cell : cells) {
-        eqmethod(cell, pressures, saturations, Rs, Rv, Rvw);
+    // Rethrow the failure of the first cell, as a sequential loop would,
+    // independently of the order in which the threads fail.
+    std::exception_ptr failure;
+    int failureIdx = numCells;
+#ifdef _OPENMP
+#pragma omp parallel if (numCells > 1)
+#endif
+    {
+        // The saturation calculation keeps evaluation state, so every
+        // thread works on its own copy.
+        auto threadPsat  = psat;
+        auto pressures   = Details::PhaseQuantityValue<Scalar>{};
+        auto saturations = Details::PhaseQuantityValue<Scalar>{};
+        Scalar Rs          = 0.0;
+        Scalar Rv          = 0.0;
+        Scalar Rvw         = 0.0;
+
+#ifdef _OPENMP
+#pragma omp for schedule(dynamic, 64)
+#endif
+        for (int i = 0; i < numCells; ++i) {
+            const auto cell = *std::next(std::begin(cells), i);
+
+            try {
+                eqmethod(cell, threadPsat, pressures, saturations, Rs, Rv, Rvw);
+            }
+            catch (...) {
+#ifdef _OPENMP
+#pragma omp critical
+#endif
+                if (i < failureIdx) {
+                    failure = std::current_exception();
+                    failureIdx = i;
+                }
+                continue;
+            }
 
-        if (oilActive) {
-            this->pp_ [oilPos][cell] = pressures.oil;
-            this->sat_[oilPos][cell] = saturations.oil;
-        }
+            if (oilActive) {
+                this->pp_ [oilPos][cell] = pressures.oil;
+                this->sat_[oilPos][cell] = saturations.oil;
+            }
 
-        if (gasActive) {
-            this->pp_ [gasPos][cell] = pressures.gas;
-            this->sat_[gasPos][cell] = saturations.gas;
-        }
+            if (gasActive) {
+                this->pp_ [gasPos][cell] = pressures.gas;
+                this->sat_[gasPos][cell] = saturations.gas;
+            }
 
-        if (watActive) {
-            this->pp_ [watPos][cell] = pressures.water;
-            this->sat_[watPos][cell] = saturations.water;
-        }
+            if (watActive) {
+                this->pp_ [watPos][cell] = pressures.water;
+                this->sat_[watPos][cell] = saturations.water;
+            }
 
-        if (oilActive && gasActive) {
-            this->rs_[cell] = Rs;
-            this->rv_[cell] = Rv;
-        }
+            if (oilActive && gasActive) {
+                this->rs_[cell] = Rs;
+                this->rv_[cell] = Rv;
+            }
 
-        if (watActive && gasActive) {
-            this->rvw_[cell] = Rvw;
+            if (watActive && gasActive) {
+                this->rvw_[cell] = Rvw;
+            }
         }
     }
+
+    if (failure) {
+        std::rethrow_exception(failure);
+    }
 }
 
 template<class FluidSystem,
@@ -1965,13 +2054,14 @@ void InitialStateComputer<FluidSystem,
 equilibrateCellCentres(const CellRange&         cells,
                        const EquilReg<Scalar>&  eqreg,
                        const PressTable&        ptable,
-                       PhaseSat&                psat)
+                       const PhaseSat&          psat)
 {
     using CellPos = typename PhaseSat::Position;
     using CellID  = std::remove_cv_t<std::remove_reference_t<
         decltype(std::declval<CellPos>().cell)>>;
-    this->cellLoop(cells, [this, &eqreg,  &ptable, &psat]
+    this->cellLoop(cells, psat, [this, &eqreg, &ptable]
         (const CellID                 cell,
+         PhaseSat&                    cellPsat,
          Details::PhaseQuantityValue<Scalar>& pressures,
          Details::PhaseQuantityValue<Scalar>& saturations,
          Scalar&                      Rs,
@@ -1982,8 +2072,8 @@ equilibrateCellCentres(const CellRange&         cells,
             cell, cellCenterDepth_[cell]
         };
 
-        saturations = psat.deriveSaturations(pos, eqreg, ptable);
-        pressures   = psat.correctedPhasePressures();
+        saturations = cellPsat.deriveSaturations(pos, eqreg, ptable);
+        pressures   = cellPsat.correctedPhasePressures();
 
         const auto temp = this->temperature_[cell];
 
@@ -2013,14 +2103,15 @@ equilibrateHorizontal(const CellRange&        cells,
                       const EquilReg<Scalar>& eqreg,
                       const int               acc,
                       const PressTable&       ptable,
-                      PhaseSat&               psat)
+                      const PhaseSat&         psat)
 {
     using CellPos = typename PhaseSat::Position;
     using CellID  = std::remove_cv_t<std::remove_reference_t<
         decltype(std::declval<CellPos>().cell)>>;
 
-    this->cellLoop(cells, [this, acc, &eqreg, &ptable, &psat]
+    this->cellLoop(cells, psat, [this, acc, &eqreg, &ptable]
         (const CellID                 cell,
+         PhaseSat&                    cellPsat,
          Details::PhaseQuantityValue<Scalar>& pressures,
          Details::PhaseQuantityValue<Scalar>& saturations,
          Scalar&                      Rs,
@@ -2034,8 +2125,8 @@ equilibrateHorizontal(const CellRange&        cells,
         for (const auto& [depth, frac] : Details::horizontalSubdivision(cell, cellZSpan_[cell], acc)) {
             const auto pos = CellPos { cell, depth };
 
-            saturations.axpy(psat.deriveSaturations(pos, eqreg, ptable), frac);
-            pressures  .axpy(psat.correctedPhasePressures(), frac);
+            saturations.axpy(cellPsat.deriveSaturations(pos, eqreg, ptable), frac);
+            pressures  .axpy(cellPsat.correctedPhasePressures(), frac);
 
             totfrac += frac;
         }
@@ -2049,8 +2140,8 @@ equilibrateHorizontal(const CellRange&        cells,
                     cell, cellCenterDepth_[cell]
             };
 
-            saturations = psat.deriveSaturations(pos, eqreg, ptable);
-            pressures   = psat.correctedPhasePressures();
+            saturations = cellPsat.deriveSaturations(pos, eqreg, ptable);
+            pressures   = cellPsat.correctedPhasePressures();
         }
 
         const auto temp = this->temperature_[cell];
@@ -134,7 +134,9 @@ void FlowLinearSolverParameters::registerParameters()
          "1: recreate once every timestep, "
          "2: recreate if last linear solve took more than 10 iterations, "
          "3: never recreate, "
-         "4: recreated every CprReuseInterval");
+         "4: recreated every CprReuseInterval. "
+         "When not recreated, the AMG aggregates and coarse sparsity patterns "
+         "are kept and only the coarse matrix values and smoothers are updated");
     Parameters::Register<Parameters::CprReuseInterval>
         ("Reuse preconditioner interval. Used when CprReuseSetup is set to 4, "
          "then the preconditioner will be fully recreated instead of reused "
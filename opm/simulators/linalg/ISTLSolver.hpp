@@ -455,6 +455,14 @@ std::unique_ptr<Matrix> blockJacobiAdjacency(const Grid& grid,
             domainIndex_ = index;
         }
 
+        /// Set the Newton iteration used to decide whether the preconditioner
+        /// is recreated, instead of the one of the simulator's Newton method.
+        /// The NLDD domain solvers use this, their Newton iterations are their own.
+        void setNewtonIteration(const int iteration)
+        {
+            newtonIteration_ = iteration;
+        }
+
         bool isNlddLocalSolver() const
         {
             return parameters_[activeSolverNum_].is_nldd_local_solver_;
@@ -553,7 +561,9 @@ std::unique_ptr<Matrix> blockJacobiAdjacency(const Grid& grid,
             }
             if (this->parameters_[activeSolverNum_].cpr_reuse_setup_ == 1) {
                 // Recreate solver on the first iteration of every timestep.
-                const int newton_iteration = this->simulator_.model().newtonMethod().numIterations();
+                const int newton_iteration = newtonIteration_ >= 0
+                    ? newtonIteration_
+                    : this->simulator_.model().newtonMethod().numIterations();
                 return newton_iteration == 0;
             }
             if (this->parameters_[activeSolverNum_].cpr_reuse_setup_ == 2) {
@@ -669,6 +679,7 @@ std::unique_ptr<Matrix> blockJacobiAdjacency(const Grid& grid,
         std::vector<int> interiorRows_;
 
         int domainIndex_ = -1;
+        int newtonIteration_ = -1;
 
         bool useWellConn_;
 
@@ -0,0 +1,213 @@
+/*
+  Copyright 2025 Equinor ASA.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef OPM_MIXEDPRECISIONPRECONDITIONER_HEADER_INCLUDED
+#define OPM_MIXEDPRECISIONPRECONDITIONER_HEADER_INCLUDED
+
+#include <opm/common/TimingMacros.hpp>
+
+#include <opm/simulators/linalg/PreconditionerWithUpdate.hpp>
+#include <opm/simulators/linalg/matrixblock.hh>
+
+#include <dune/common/fmatrix.hh>
+#include <dune/istl/bcrsmatrix.hh>
+
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <utility>
+
+namespace Opm
+{
+
+namespace Detail
+{
+
+//! \brief The block type of a matrix with the field type replaced by Scalar.
+template <class Block, class Scalar>
+struct RebindBlockField;
+
+template <class T, int n, int m, class Scalar>
+struct RebindBlockField<Dune::FieldMatrix<T, n, m>, Scalar>
+{
+    using type = Dune::FieldMatrix<Scalar, n, m>;
+};
+
+template <class T, int n, int m, class Scalar>
+struct RebindBlockField<MatrixBlock<T, n, m>, Scalar>
+{
+    using type = MatrixBlock<Scalar, n, m>;
+};
+
+//! \brief Copy a block vector into one of another field type, resizing it if needed.
+template <class From, class To>
+void convertBlockVector(const From& from, To& to)
+{
+    if (to.size() != from.size()) {
+        to.resize(from.size());
+    }
+#ifdef _OPENMP
+#pragma omp parallel for
+#endif
+    for (std::size_t i = 0; i < from.size(); ++i) {
+        for (std::size_t j = 0; j < from[i].size(); ++j) {
+            to[i][j] = static_cast<typename To::field_type>(from[i][j]);
+        }
+    }
+}
+
+} // namespace Detail
+
+/// \brief A preconditioner for a system in one precision, typically double,
+///        which is set up and applied in another, typically float.
+///
+/// The matrix is copied into a matrix of the lower precision field type on
+/// construction and on every update(). The wrapped preconditioner is created
+/// for an operator on that copy, so any factorizations or AMG hierarchies are
+/// stored in the lower precision. Only the defect and the correction are
+/// converted when applying the preconditioner, the Krylov solver using it
+/// keeps working in the higher precision.
+///
+/// \tparam Matrix      The matrix type of the system.
+/// \tparam Vector      The vector type of the system.
+/// \tparam LowOperator The operator type the wrapped preconditioner is created
+///                     for. Its matrix and vectors must have the same block
+///                     structure as Matrix and Vector.
+template <class Matrix, class Vector, class LowOperator>
+class MixedPrecisionPreconditioner : public Dune::PreconditionerWithUpdate<Vector, Vector>
+{
+public:
+    using LowMatrix = typename LowOperator::matrix_type;
+    using LowVector = typename LowOperator::domain_type;
+    using LowPrecPtr = std::shared_ptr<Dune::PreconditionerWithUpdate<LowVector, LowVector>>;
+    using LowPrecCreator = std::function<LowPrecPtr(const LowOperator&)>;
+
+    /// \brief Constructor.
+    /// \param matrix  The matrix of the system, must be kept alive by the caller.
+    /// \param creator Creates the wrapped preconditioner for the lower precision operator.
+    /// \param opArgs  Arguments passed to the constructor of the lower precision
+    ///                operator after its matrix, e.g. a communication object.
+    template <class... OpArgs>
+    MixedPrecisionPreconditioner(const Matrix& matrix,
+                                 const LowPrecCreator& creator,
+                                 const OpArgs&... opArgs)
+        : matrix_(matrix)
+        , lowMatrix_(createLowMatrix(matrix))
+        , lowOperator_(lowMatrix_, opArgs...)
+        , lowPrec_(creator(lowOperator_))
+    {
+    }
+
+    /// \brief Prepare the wrapped preconditioner.
+    ///
+    /// The wrapped preconditioner works on lower precision copies of \p x
+    /// and \p b, which are not copied back. This keeps the initial guess and
+    /// the right hand side of the Krylov solver in the higher precision.
+    void pre(Vector& x, Vector& b) override
+    {
+        OPM_TIMEBLOCK(pre);
+        Detail::convertBlockVector(x, lowV_);
+        Detail::convertBlockVector(b, lowD_);
+        lowPrec_->pre(lowV_, lowD_);
+    }
+
+    void apply(Vector& v, const Vector& d) override
+    {
+        OPM_TIMEBLOCK(apply);
+        Detail::convertBlockVector(v, lowV_);
+        Detail::convertBlockVector(d, lowD_);
+        lowPrec_->apply(lowV_, lowD_);
+        Detail::convertBlockVector(lowV_, v);
+    }
+
+    /// \brief Clean up the wrapped preconditioner.
+    ///
+    /// As in pre(), the solution \p x is left unchanged.
+    void post(Vector& x) override
+    {
+        OPM_TIMEBLOCK(post);
+        Detail::convertBlockVector(x, lowV_);
+        lowPrec_->post(lowV_);
+    }
+
+    Dune::SolverCategory::Category category() const override
+    {
+        return lowPrec_->category();
+    }
+
+    void update() override
+    {
+        OPM_TIMEBLOCK(update);
+        copyValues();
+        lowPrec_->update();
+    }
+
+    bool hasPerfectUpdate() const override
+    {
+        return lowPrec_->hasPerfectUpdate();
+    }
+
+private:
+    static LowMatrix createLowMatrix(const Matrix& matrix)
+    {
+        LowMatrix lowMatrix(matrix.N(), matrix.M(), matrix.nonzeroes(), LowMatrix::row_wise);
+        auto row = matrix.begin();
+        for (auto lowRow = lowMatrix.createbegin(); lowRow != lowMatrix.createend(); ++lowRow, ++row) {
+            for (auto col = row->begin(); col != row->end(); ++col) {
+                lowRow.insert(col.index());
+            }
+        }
+        copyValues(matrix, lowMatrix);
+        return lowMatrix;
+    }
+
+    static void copyValues(const Matrix& matrix, LowMatrix& lowMatrix)
+    {
+        using LowField = typename LowMatrix::field_type;
+#ifdef _OPENMP
+#pragma omp parallel for
+#endif
+        for (std::size_t row = 0; row < matrix.N(); ++row) {
+            auto lowCol = lowMatrix[row].begin();
+            for (auto col = matrix[row].begin(); col != matrix[row].end(); ++col, ++lowCol) {
+                for (std::size_t i = 0; i < col->N(); ++i) {
+                    for (std::size_t j = 0; j < col->M(); ++j) {
+                        (*lowCol)[i][j] = static_cast<LowField>((*col)[i][j]);
+                    }
+                }
+            }
+        }
+    }
+
+    void copyValues()
+    {
+        copyValues(matrix_, lowMatrix_);
+    }
+
+    const Matrix& matrix_;
+    LowMatrix lowMatrix_;
+    LowOperator lowOperator_;
+    LowPrecPtr lowPrec_;
+    LowVector lowV_;
+    LowVector lowD_;
+};
+
+} // namespace Opm
+
+#endif // OPM_MIXEDPRECISIONPRECONDITIONER_HEADER_INCLUDED
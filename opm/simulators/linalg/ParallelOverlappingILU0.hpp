@@ -22,9 +22,11 @@
 #include <opm/common/TimingMacros.hpp>
 #include <opm/simulators/linalg/MILU.hpp>
 #include <opm/simulators/linalg/PreconditionerWithUpdate.hpp>
+#include <opm/grid/utility/SparseTable.hpp>
 #include <dune/istl/paamg/smoother.hh>
 
 #include <cstddef>
+#include <tuple>
 #include <vector>
 #include <type_traits>
 
@@ -42,7 +44,7 @@ class ParallelOverlappingILU0Args
 {
  public:
     explicit ParallelOverlappingILU0Args(MILU_VARIANT milu = MILU_VARIANT::ILU )
-        : milu_(milu), n_(0)
+        : milu_(milu), n_(0), threads_(false)
     {}
     void setMilu(MILU_VARIANT milu)
     {
@@ -60,9 +62,18 @@ class ParallelOverlappingILU0Args
     {
         return n_;
     }
+    void setThreads(bool threads)
+    {
+        threads_ = threads;
+    }
+    bool getThreads() const
+    {
+        return threads_;
+    }
  private:
     MILU_VARIANT milu_;
     int n_;
+    bool threads_;
 };
 } // end namespace Opm
 
@@ -100,7 +111,10 @@ struct ConstructionTraits<Opm::ParallelOverlappingILU0<Matrix,Domain,Range,Paral
                       args.getComm(),
                       args.getArgs().getN(),
                       args.getArgs().relaxationFactor,
-                      args.getArgs().getMilu()) );
+                      args.getArgs().getMilu(),
+                      /*redblack=*/false,
+                      /*reorder_sphere=*/true,
+                      args.getArgs().getThreads()) );
     }
 };
 
@@ -216,11 +230,14 @@ public:
                             The vertices on each layer aound it (same distance) are
                             ordered consecutivly. If false, we preserver the order of
                             the vertices with the same color.
+      \param threads Whether to use the multithreaded, level-scheduled
+                     decomposition and triangular solves.
     */
     ParallelOverlappingILU0 (const Matrix& A,
                              const int n, const field_type w,
                              MILU_VARIANT milu, bool redblack = false,
-                             bool reorder_sphere = true);
+                             bool reorder_sphere = true,
+                             bool threads = false);
 
     /*! \brief Constructor gets all parameters to operate the prec.
       \param A The matrix to operate on.
@@ -233,11 +250,14 @@ public:
                             The vertices on each layer aound it (same distance) are
                             ordered consecutivly. If false, we preserver the order of
                             the vertices with the same color.
+      \param threads Whether to use the multithreaded, level-scheduled
+                     decomposition and triangular solves.
     */
     ParallelOverlappingILU0 (const Matrix& A,
                              const ParallelInfo& comm, const int n, const field_type w,
                              MILU_VARIANT milu, bool redblack = false,
-                             bool reorder_sphere = true);
+                             bool reorder_sphere = true,
+                             bool threads = false);
 
     /*! \brief Constructor.
 
@@ -250,11 +270,14 @@ public:
                   The vertices on each layer aound it (same distance) are
                   ordered consecutivly. If false, we preserver the order of
                   the vertices with the same color.
+      \param threads Whether to use the multithreaded, level-scheduled
+                     decomposition and triangular solves.
     */
     ParallelOverlappingILU0 (const Matrix& A,
                              const field_type w, MILU_VARIANT milu,
                              bool redblack = false,
-                             bool reorder_sphere = true);
+                             bool reorder_sphere = true,
+                             bool threads = false);
 
     /*! \brief Constructor.
 
@@ -268,11 +291,14 @@ public:
                             The vertices on each layer aound it (same distance) are
                             ordered consecutivly. If false, we preserver the order of
                             the vertices with the same color.
+      \param threads Whether to use the multithreaded, level-scheduled
+                     decomposition and triangular solves.
     */
     ParallelOverlappingILU0 (const Matrix& A,
                              const ParallelInfo& comm, const field_type w,
                              MILU_VARIANT milu, bool redblack = false,
-                             bool reorder_sphere = true);
+                             bool reorder_sphere = true,
+                             bool threads = false);
 
     /*! \brief Constructor.
 
@@ -287,12 +313,15 @@ public:
                             The vertices on each layer aound it (same distance) are
                             ordered consecutivly. If false, we preserver the order of
                             the vertices with the same color.
+      \param threads Whether to use the multithreaded, level-scheduled
+                     decomposition and triangular solves.
     */
     ParallelOverlappingILU0 (const Matrix& A,
                              const ParallelInfo& comm,
                              const field_type w, MILU_VARIANT milu,
                              size_type interiorSize, bool redblack = false,
-                             bool reorder_sphere = true);
+                             bool reorder_sphere = true,
+                             bool threads = false);
 
     /*!
       \brief Prepare the preconditioner.
@@ -331,6 +360,14 @@ protected:
 
     void reorderBack(const Range& reorderedV, Range& v);
 
+    /// \brief Compute the level sets of the lower and upper triangular
+    ///        solves, unless the sparsity pattern is unchanged.
+    void updateLevelSets();
+
+    /// \brief The triangular solves, processing the rows of each level
+    ///        set concurrently.
+    void applyLevelScheduled(const Range& md, Domain& mv) const;
+
     //! \brief The ILU0 decomposition of the matrix.
     std::unique_ptr<Matrix> ILU_;
     CRS lower_;
@@ -353,6 +390,15 @@ protected:
     MILU_VARIANT milu_;
     bool redBlack_;
     bool reorderSphere_;
+    //! \brief Whether to use the level-scheduled, multithreaded variant.
+    bool threads_;
+    //! \brief The rows of the lower CRS matrix grouped by level.
+    Opm::SparseTable<size_type> lowerLevels_;
+    //! \brief The rows of the upper CRS matrix grouped by level.
+    Opm::SparseTable<size_type> upperLevels_;
+    //! \brief The number of rows, nonzeros and interior rows and the hash
+    //!        of the sparsity pattern the level sets have been computed for.
+    std::tuple<size_type, size_type, size_type, std::size_t> levelSetsPattern_{0, 0, 0, 0};
 };
 
 } // end namespace Opm
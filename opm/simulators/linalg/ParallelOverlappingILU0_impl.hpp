@@ -31,65 +31,108 @@
 #include <opm/simulators/linalg/GraphColoring.hpp>
 #include <opm/simulators/linalg/matrixblock.hh>
 
+#include <algorithm>
+#include <exception>
+#include <iterator>
+
 namespace Opm
 {
 namespace detail
 {
 
-//! Compute Blocked ILU0 decomposition, when we know junk ghost rows are located at the end of A
+//! Compute the Blocked ILU0 decomposition of row i, when the rows it depends on are decomposed
 template<class M>
-void ghost_last_bilu0_decomposition (M& A, std::size_t interiorSize)
+void bilu0_decompose_row (M& A, typename M::RowIterator i)
 {
     // iterator types
-    using rowiterator = typename M::RowIterator;
     using coliterator = typename M::ColIterator;
     using block = typename M::block_type;
 
     // implement left looking variant with stored inverse
-    for (rowiterator i = A.begin(); i.index() < interiorSize; ++i)
+    // coliterator is diagonal after the following loop
+    coliterator endij=(*i).end();           // end of row i
+    coliterator ij;
+
+    // eliminate entries left of diagonal; store L factor
+    for (ij=(*i).begin(); ij.index()<i.index(); ++ij)
     {
-        // coliterator is diagonal after the following loop
-        coliterator endij=(*i).end();           // end of row i
-        coliterator ij;
+        // find A_jj which eliminates A_ij
+        coliterator jj = A[ij.index()].find(ij.index());
+
+        // compute L_ij = A_jj^-1 * A_ij
+        (*ij).rightmultiply(*jj);
+
+        // modify row
+        coliterator endjk=A[ij.index()].end();    // end of row j
+        coliterator jk=jj; ++jk;
+        coliterator ik=ij; ++ik;
+        while (ik!=endij && jk!=endjk)
+            if (ik.index()==jk.index())
+            {
+                block B(*jk);
+                B.leftmultiply(*ij);
+                *ik -= B;
+                ++ik; ++jk;
+            }
+            else
+            {
+                if (ik.index()<jk.index())
+                    ++ik;
+                else
+                    ++jk;
+            }
+    }
 
-        // eliminate entries left of diagonal; store L factor
-        for (ij=(*i).begin(); ij.index()<i.index(); ++ij)
+    // invert pivot and store it in A
+    if (ij.index()!=i.index())
+        DUNE_THROW(Dune::ISTLError,"diagonal entry missing");
+    try {
+        (*ij).invert();   // compute inverse of diagonal block
+    }
+    catch (Dune::FMatrixError & e) {
+        DUNE_THROW(Dune::ISTLError,"ILU failed to invert matrix block");
+    }
+}
+
+//! Compute Blocked ILU0 decomposition, when we know junk ghost rows are located at the end of A
+template<class M>
+void ghost_last_bilu0_decomposition (M& A, std::size_t interiorSize)
+{
+    for (auto i = A.begin(); i.index() < interiorSize; ++i)
+    {
+        bilu0_decompose_row(A, i);
+    }
+}
+
+//! Compute Blocked ILU0 decomposition of the rows contained in the level sets.
+//! The rows of a level only depend on rows of previous levels and are decomposed concurrently.
+template<class M, class LevelSets>
+void level_scheduled_bilu0_decomposition (M& A, const LevelSets& levelSets)
+{
+    for (int level = 0; level < levelSets.size(); ++level)
+    {
+        const auto& rows = levelSets[level];
+        const int numRows = rows.size();
+        std::exception_ptr error;
+#ifdef _OPENMP
+#pragma omp parallel for
+#endif
+        for (int k = 0; k < numRows; ++k)
         {
-            // find A_jj which eliminates A_ij
-            coliterator jj = A[ij.index()].find(ij.index());
-
-            // compute L_ij = A_jj^-1 * A_ij
-            (*ij).rightmultiply(*jj);
-
-            // modify row
-            coliterator endjk=A[ij.index()].end();    // end of row j
-            coliterator jk=jj; ++jk;
-            coliterator ik=ij; ++ik;
-            while (ik!=endij && jk!=endjk)
-                if (ik.index()==jk.index())
-                {
-                    block B(*jk);
-                    B.leftmultiply(*ij);
-                    *ik -= B;
-                    ++ik; ++jk;
-                }
-                else
-                {
-                    if (ik.index()<jk.index())
-                        ++ik;
-                    else
-                        ++jk;
+            try {
+                bilu0_decompose_row(A, A.begin() + *(rows.begin() + k));
+            }
+            catch (...) {
+#ifdef _OPENMP
+#pragma omp critical
+#endif
+                if (!error) {
+                    error = std::current_exception();
                 }
+            }
         }
-
-        // invert pivot and store it in A
-        if (ij.index()!=i.index())
-            DUNE_THROW(Dune::ISTLError,"diagonal entry missing");
-        try {
-            (*ij).invert();   // compute inverse of diagonal block
-        }
-        catch (Dune::FMatrixError & e) {
-            DUNE_THROW(Dune::ISTLError,"ILU failed to invert matrix block");
+        if (error) {
+            std::rethrow_exception(error);
         }
     }
 }
@@ -230,14 +273,15 @@ ParallelOverlappingILU0<Matrix,Domain,Range,ParallelInfoT>::
 ParallelOverlappingILU0(const Matrix& A,
                         const int n, const field_type w,
                         MILU_VARIANT milu, bool redblack,
-                        bool reorder_sphere)
+                        bool reorder_sphere, bool threads)
     : lower_(),
       upper_(),
       inv_(),
       comm_(nullptr), w_(w),
       relaxation_( std::abs( w - 1.0 ) > 1e-15 ),
       A_(&reinterpret_cast<const Matrix&>(A)), iluIteration_(n),
-      milu_(milu), redBlack_(redblack), reorderSphere_(reorder_sphere)
+      milu_(milu), redBlack_(redblack), reorderSphere_(reorder_sphere),
+      threads_(threads)
 {
     interiorSize_ = A.N();
     // BlockMatrix is a Subclass of FieldMatrix that just adds
@@ -250,14 +294,15 @@ ParallelOverlappingILU0<Matrix,Domain,Range,ParallelInfoT>::
 ParallelOverlappingILU0(const Matrix& A,
                         const ParallelInfo& comm, const int n, const field_type w,
                         MILU_VARIANT milu, bool redblack,
-                        bool reorder_sphere)
+                        bool reorder_sphere, bool threads)
     : lower_(),
       upper_(),
       inv_(),
       comm_(&comm), w_(w),
       relaxation_( std::abs( w - 1.0 ) > 1e-15 ),
       A_(&reinterpret_cast<const Matrix&>(A)), iluIteration_(n),
-      milu_(milu), redBlack_(redblack), reorderSphere_(reorder_sphere)
+      milu_(milu), redBlack_(redblack), reorderSphere_(reorder_sphere),
+      threads_(threads)
 {
     interiorSize_ = A.N();
     // BlockMatrix is a Subclass of FieldMatrix that just adds
@@ -269,8 +314,8 @@ template<class Matrix, class Domain, class Range, class ParallelInfoT>
 ParallelOverlappingILU0<Matrix,Domain,Range,ParallelInfoT>::
 ParallelOverlappingILU0(const Matrix& A,
                         const field_type w, MILU_VARIANT milu, bool redblack,
-                        bool reorder_sphere)
-    : ParallelOverlappingILU0( A, 0, w, milu, redblack, reorder_sphere )
+                        bool reorder_sphere, bool threads)
+    : ParallelOverlappingILU0( A, 0, w, milu, redblack, reorder_sphere, threads )
 {}
 
 template<class Matrix, class Domain, class Range, class ParallelInfoT>
@@ -278,14 +323,15 @@ ParallelOverlappingILU0<Matrix,Domain,Range,ParallelInfoT>::
 ParallelOverlappingILU0(const Matrix& A,
                         const ParallelInfo& comm, const field_type w,
                         MILU_VARIANT milu, bool redblack,
-                        bool reorder_sphere)
+                        bool reorder_sphere, bool threads)
     : lower_(),
       upper_(),
       inv_(),
       comm_(&comm), w_(w),
       relaxation_( std::abs( w - 1.0 ) > 1e-15 ),
       A_(&reinterpret_cast<const Matrix&>(A)), iluIteration_(0),
-      milu_(milu), redBlack_(redblack), reorderSphere_(reorder_sphere)
+      milu_(milu), redBlack_(redblack), reorderSphere_(reorder_sphere),
+      threads_(threads)
 {
     interiorSize_ = A.N();
     // BlockMatrix is a Subclass of FieldMatrix that just adds
@@ -299,7 +345,7 @@ ParallelOverlappingILU0(const Matrix& A,
                         const ParallelInfo& comm,
                         const field_type w, MILU_VARIANT milu,
                         size_type interiorSize, bool redblack,
-                        bool reorder_sphere)
+                        bool reorder_sphere, bool threads)
     : lower_(),
       upper_(),
       inv_(),
@@ -307,7 +353,8 @@ ParallelOverlappingILU0(const Matrix& A,
       relaxation_( std::abs( w - 1.0 ) > 1e-15 ),
       interiorSize_(interiorSize),
       A_(&reinterpret_cast<const Matrix&>(A)), iluIteration_(0),
-      milu_(milu), redBlack_(redblack), reorderSphere_(reorder_sphere)
+      milu_(milu), redBlack_(redblack), reorderSphere_(reorder_sphere),
+      threads_(threads)
 {
     // BlockMatrix is a Subclass of FieldMatrix that just adds
     // methods. Therefore this cast should be safe.
@@ -335,35 +382,42 @@ apply (Domain& v, const Range& d)
         OPM_THROW(std::logic_error,"ILU: number of lower and upper rows must be the same");
     }
 
-    // lower triangular solve
-    for (size_type i = 0; i < lowerLoopEnd; ++i)
+    if (threads_)
     {
-        dblock rhs( md[ i ] );
-        const size_type rowI     = lower_.rows_[ i ];
-        const size_type rowINext = lower_.rows_[ i+1 ];
-
-        for (size_type col = rowI; col < rowINext; ++col)
+        applyLevelScheduled(md, mv);
+    }
+    else
+    {
+        // lower triangular solve
+        for (size_type i = 0; i < lowerLoopEnd; ++i)
         {
-            lower_.values_[ col ].mmv( mv[ lower_.cols_[ col ] ], rhs );
-        }
+            dblock rhs( md[ i ] );
+            const size_type rowI     = lower_.rows_[ i ];
+            const size_type rowINext = lower_.rows_[ i+1 ];
 
-        mv[ i ] = rhs;  // Lii = I
-    }
+            for (size_type col = rowI; col < rowINext; ++col)
+            {
+                lower_.values_[ col ].mmv( mv[ lower_.cols_[ col ] ], rhs );
+            }
 
-    for (size_type i = upperLoopStart; i < iEnd; ++i)
-    {
-        vblock& vBlock = mv[ lastRow - i ];
-        vblock rhs ( vBlock );
-        const size_type rowI     = upper_.rows_[ i ];
-        const size_type rowINext = upper_.rows_[ i+1 ];
+            mv[ i ] = rhs;  // Lii = I
+        }
 
-        for (size_type col = rowI; col < rowINext; ++col)
+        for (size_type i = upperLoopStart; i < iEnd; ++i)
         {
-            upper_.values_[ col ].mmv( mv[ upper_.cols_[ col ] ], rhs );
-        }
+            vblock& vBlock = mv[ lastRow - i ];
+            vblock rhs ( vBlock );
+            const size_type rowI     = upper_.rows_[ i ];
+            const size_type rowINext = upper_.rows_[ i+1 ];
 
-        // apply inverse and store result
-        inv_[ i ].mv( rhs, vBlock);
+            for (size_type col = rowI; col < rowINext; ++col)
+            {
+                upper_.values_[ col ].mmv( mv[ upper_.cols_[ col ] ], rhs );
+            }
+
+            // apply inverse and store result
+            inv_[ i ].mv( rhs, vBlock);
+        }
     }
 
     copyOwnerToAll( mv );
@@ -374,6 +428,129 @@ apply (Domain& v, const Range& d)
     reorderBack(mv, v);
 }
 
+template<class Matrix, class Domain, class Range, class ParallelInfoT>
+void ParallelOverlappingILU0<Matrix,Domain,Range,ParallelInfoT>::
+applyLevelScheduled(const Range& md, Domain& mv) const
+{
+    using dblock = typename Range ::block_type;
+    using vblock = typename Domain::block_type;
+
+    const size_type lastRow = lower_.rows() - 1;
+
+    // lower triangular solve, the rows of a level only depend on rows of
+    // previous levels
+    for (int level = 0; level < lowerLevels_.size(); ++level)
+    {
+        const auto& rows = lowerLevels_[level];
+        const int numRows = rows.size();
+#ifdef _OPENMP
+#pragma omp parallel for
+#endif
+        for (int k = 0; k < numRows; ++k)
+        {
+            const size_type i = *(rows.begin() + k);
+            dblock rhs( md[ i ] );
+            const size_type rowI     = lower_.rows_[ i ];
+            const size_type rowINext = lower_.rows_[ i+1 ];
+
+            for (size_type col = rowI; col < rowINext; ++col)
+            {
+                lower_.values_[ col ].mmv( mv[ lower_.cols_[ col ] ], rhs );
+            }
+
+            mv[ i ] = rhs;  // Lii = I
+        }
+    }
+
+    // upper triangular solve
+    for (int level = 0; level < upperLevels_.size(); ++level)
+    {
+        const auto& rows = upperLevels_[level];
+        const int numRows = rows.size();
+#ifdef _OPENMP
+#pragma omp parallel for
+#endif
+        for (int k = 0; k < numRows; ++k)
+        {
+            const size_type i = *(rows.begin() + k);
+            vblock& vBlock = mv[ lastRow - i ];
+            vblock rhs ( vBlock );
+            const size_type rowI     = upper_.rows_[ i ];
+            const size_type rowINext = upper_.rows_[ i+1 ];
+
+            for (size_type col = rowI; col < rowINext; ++col)
+            {
+                upper_.values_[ col ].mmv( mv[ upper_.cols_[ col ] ], rhs );
+            }
+
+            // apply inverse and store result
+            inv_[ i ].mv( rhs, vBlock);
+        }
+    }
+}
+
+template<class Matrix, class Domain, class Range, class ParallelInfoT>
+void ParallelOverlappingILU0<Matrix,Domain,Range,ParallelInfoT>::
+updateLevelSets()
+{
+    // The level sets only depend on the sparsity pattern of the
+    // decomposition, which usually does not change between updates. The
+    // pattern is identified by a hash of the column indices of all rows,
+    // so that a different pattern with the same number of nonzeros is
+    // detected.
+    std::size_t hash = 0;
+    const auto combine = [&hash](const std::size_t value)
+    { hash ^= value + 0x9e3779b97f4a7c15ULL + (hash << 6) + (hash >> 2); };
+    for (auto row = ILU_->begin(); row != ILU_->end(); ++row)
+    {
+        combine(row->size());
+        for (auto col = row->begin(); col != row->end(); ++col)
+        {
+            combine(col.index());
+        }
+    }
+    const auto pattern = std::make_tuple(ILU_->N(), ILU_->nonzeroes(), interiorSize_, hash);
+    if (pattern == levelSetsPattern_)
+    {
+        return;
+    }
+    OPM_TIMEBLOCK(iluLevelSets);
+    levelSetsPattern_ = pattern;
+
+    // Only the interior rows take part in the triangular solves. The
+    // rows of the upper CRS matrix are stored in reverse order.
+    const size_type lastRow = ILU_->N() - 1;
+    std::vector<size_type> rows;
+    lowerLevels_.clear();
+    for (const auto& level : getMatrixRowColoring(*ILU_, ColoringType::LOWER))
+    {
+        rows.clear();
+        std::copy_if(level.begin(), level.end(), std::back_inserter(rows),
+                     [this](const auto row) { return row < interiorSize_; });
+        if (!rows.empty())
+        {
+            lowerLevels_.appendRow(rows.begin(), rows.end());
+        }
+    }
+    upperLevels_.clear();
+    for (const auto& level : getMatrixRowColoring(*ILU_, ColoringType::UPPER))
+    {
+        rows.clear();
+        for (auto row = level.end(); row != level.begin(); )
+        {
+            --row;
+            if (*row < interiorSize_)
+            {
+                rows.push_back(lastRow - *row);
+            }
+        }
+        if (!rows.empty())
+        {
+            upperLevels_.appendRow(rows.begin(), rows.end());
+        }
+    }
+}
+
 template<class Matrix, class Domain, class Range, class ParallelInfoT>
 template<class V>
 void ParallelOverlappingILU0<Matrix,Domain,Range,ParallelInfoT>::
@@ -492,6 +669,11 @@ update()
                 }
             }
 
+            if (threads_)
+            {
+                updateLevelSets();
+            }
+
             switch (milu_)
             {
             case MILU_VARIANT::MILU_1:
@@ -510,7 +692,9 @@ update()
                                               detail::isPositiveFunctor<typename Matrix::field_type> );
                 break;
             default:
-                if (interiorSize_ == A_->N())
+                if (threads_)
+                    detail::level_scheduled_bilu0_decomposition(*ILU_, lowerLevels_);
+                else if (interiorSize_ == A_->N())
                     Dune::ILU::blockILU0Decomposition( *ILU_ );
                 else
                     detail::ghost_last_bilu0_decomposition(*ILU_, interiorSize_);
@@ -554,6 +738,12 @@ update()
 
     // store ILU in simple CRS format
     detail::convertToCRS(*ILU_, lower_, upper_, inv_);
+
+    // the pattern of ILU-n is only known after the decomposition
+    if (threads_)
+    {
+        updateLevelSets();
+    }
 }
 
 template<class Matrix, class Domain, class Range, class ParallelInfoT>
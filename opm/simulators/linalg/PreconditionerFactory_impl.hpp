@@ -29,6 +29,7 @@
 #include <opm/simulators/linalg/ExtraSmoothers.hpp>
 #include <opm/simulators/linalg/FlexibleSolver.hpp>
 #include <opm/simulators/linalg/FlowLinearSolverParameters.hpp>
+#include <opm/simulators/linalg/MixedPrecisionPreconditioner.hpp>
 #include <opm/simulators/linalg/OwningBlockPreconditioner.hpp>
 #include <opm/simulators/linalg/OwningTwoLevelPreconditioner.hpp>
 #include <opm/simulators/linalg/ParallelOverlappingILU0.hpp>
@@ -89,6 +90,7 @@ struct AMGSmootherArgsHelper<ParallelOverlappingILU0<M, V, V, C>>
         smootherArgs.setN(iluwitdh);
         const MILU_VARIANT milu = convertString2Milu(prm.get<std::string>("milutype", std::string("ilu")));
         smootherArgs.setMilu(milu);
+        smootherArgs.setThreads(prm.get<bool>("threads", false));
         // smootherArgs.overlap=SmootherArgs::vertex;
         // smootherArgs.overlap=SmootherArgs::none;
         // smootherArgs.overlap=SmootherArgs::aggregate;
@@ -393,14 +395,15 @@ struct StandardPreconditioners {
         const double w = prm.get<double>("relaxation", 1.0);
         const bool redblack = prm.get<bool>("redblack", false);
         const bool reorder_spheres = prm.get<bool>("reorder_spheres", false);
+        const bool threads = prm.get<bool>("threads", false);
         // Already a parallel preconditioner. Need to pass comm, but no need to wrap it in a BlockPreconditioner.
         if (ilulevel == 0) {
             const std::size_t num_interior = interiorIfGhostLast(comm);
             return std::make_shared<ParallelOverlappingILU0<M, V, V, Comm>>(
-                op.getmat(), comm, w, MILU_VARIANT::ILU, num_interior, redblack, reorder_spheres);
+                op.getmat(), comm, w, MILU_VARIANT::ILU, num_interior, redblack, reorder_spheres, threads);
         } else {
             return std::make_shared<ParallelOverlappingILU0<M, V, V, Comm>>(
-                op.getmat(), comm, ilulevel, w, MILU_VARIANT::ILU, redblack, reorder_spheres);
+                op.getmat(), comm, ilulevel, w, MILU_VARIANT::ILU, redblack, reorder_spheres, threads);
         }
     }
 
@@ -440,8 +443,9 @@ struct StandardPreconditioners<Operator, Dune::Amg::SequentialInformation> {
         using P = PropertyTree;
         F::addCreator("ILU0", [](const O& op, const P& prm, const std::function<V()>&, std::size_t) {
             const double w = prm.get<double>("relaxation", 1.0);
+            const bool threads = prm.get<bool>("threads", false);
             return std::make_shared<ParallelOverlappingILU0<M, V, V, C>>(
-                op.getmat(), 0, w, MILU_VARIANT::ILU);
+                op.getmat(), 0, w, MILU_VARIANT::ILU, false, true, threads);
         });
         F::addCreator("DuneILU", [](const O& op, const P& prm, const std::function<V()>&, std::size_t) {
             const double w = prm.get<double>("relaxation", 1.0);
@@ -452,14 +456,16 @@ struct StandardPreconditioners<Operator, Dune::Amg::SequentialInformation> {
         F::addCreator("ParOverILU0", [](const O& op, const P& prm, const std::function<V()>&, std::size_t) {
             const double w = prm.get<double>("relaxation", 1.0);
             const int n = prm.get<int>("ilulevel", 0);
+            const bool threads = prm.get<bool>("threads", false);
             return std::make_shared<ParallelOverlappingILU0<M, V, V, C>>(
-                op.getmat(), n, w, MILU_VARIANT::ILU);
+                op.getmat(), n, w, MILU_VARIANT::ILU, false, true, threads);
         });
         F::addCreator("ILUn", [](const O& op, const P& prm, const std::function<V()>&, std::size_t) {
             const int n = prm.get<int>("ilulevel", 0);
             const double w = prm.get<double>("relaxation", 1.0);
+            const bool threads = prm.get<bool>("threads", false);
             return std::make_shared<ParallelOverlappingILU0<M, V, V, C>>(
-                op.getmat(), n, w, MILU_VARIANT::ILU);
+                op.getmat(), n, w, MILU_VARIANT::ILU, false, true, threads);
         });
         F::addCreator("DILU", [](const O& op, const P& prm, const std::function<V()>&, std::size_t) {
             DUNE_UNUSED_PARAMETER(prm);
@@ -687,6 +693,75 @@ struct StandardPreconditioners<Operator, Dune::Amg::SequentialInformation> {
     }
 };
 
+/// Creates a preconditioner which is set up and applied in single precision
+/// for an operator in double precision, see MixedPrecisionPreconditioner.
+/// The single precision preconditioner only sees the matrix of the operator.
+template <class Operator, class Comm>
+struct SinglePrecisionPreconditioners
+{
+    using F = PreconditionerFactory<Operator, Comm>;
+    using M = typename F::Matrix;
+    using V = typename F::Vector;
+    using PrecPtr = typename F::PrecPtr;
+
+    using LowMatrix = Dune::BCRSMatrix<typename Detail::RebindBlockField<typename M::block_type, float>::type>;
+    using LowVector = Dune::BlockVector<Dune::FieldVector<float, V::block_type::dimension>>;
+
+    static constexpr bool isSequential = std::is_same_v<Comm, Dune::Amg::SequentialInformation>;
+    static constexpr bool isGhostLast = std::is_same_v<Operator, GhostLastMatrixAdapter<M, V, V, Comm>> ||
+                                        std::is_same_v<Operator, WellModelGhostLastMatrixAdapter<M, V, V, true>>;
+    using LowOperator =
+        std::conditional_t<isSequential,
+                           Dune::MatrixAdapter<LowMatrix, LowVector, LowVector>,
+                           std::conditional_t<isGhostLast,
+                                              GhostLastMatrixAdapter<LowMatrix, LowVector, LowVector, Comm>,
+                                              Dune::OverlappingSchwarzOperator<LowMatrix, LowVector, LowVector, Comm>>>;
+    using Prec = MixedPrecisionPreconditioner<M, V, LowOperator>;
+
+    static PrecPtr create(const Operator& op,
+                          const PropertyTree& prm,
+                          const std::function<V()>& weightsCalculator,
+                          std::size_t pressureIndex)
+    {
+        const auto lowWeights = convertWeights(weightsCalculator);
+        return std::make_shared<Prec>(op.getmat(),
+                                      [&prm, &lowWeights, pressureIndex](const LowOperator& lowOp) {
+                                          return PreconditionerFactory<LowOperator, Comm>::create(
+                                              lowOp, prm, lowWeights, pressureIndex);
+                                      });
+    }
+
+    static PrecPtr create(const Operator& op,
+                          const PropertyTree& prm,
+                          const std::function<V()>& weightsCalculator,
+                          std::size_t pressureIndex,
+                          const Comm& comm)
+    {
+        const auto lowWeights = convertWeights(weightsCalculator);
+        const auto creator = [&prm, &lowWeights, pressureIndex, &comm](const LowOperator& lowOp) {
+            return PreconditionerFactory<LowOperator, Comm>::create(lowOp, prm, lowWeights, comm, pressureIndex);
+        };
+        if constexpr (isSequential) {
+            return std::make_shared<Prec>(op.getmat(), creator);
+        } else {
+            return std::make_shared<Prec>(op.getmat(), creator, comm);
+        }
+    }
+
+private:
+    static std::function<LowVector()> convertWeights(const std::function<V()>& weightsCalculator)
+    {
+        if (!weightsCalculator) {
+            return {};
+        }
+        return [weightsCalculator]() {
+            LowVector weights;
+            Detail::convertBlockVector(weightsCalculator(), weights);
+            return weights;
+        };
+    }
+};
+
 template <class Operator, class Comm>
 PreconditionerFactory<Operator, Comm>::PreconditionerFactory()
 {
@@ -712,6 +787,17 @@ PreconditionerFactory<Operator, Comm>::doCreate(const Operator& op,
         StandardPreconditioners<Operator, Comm>::add();
         defAdded_ = true;
     }
+    // A preconditioner which is already in single precision is created as is.
+    if constexpr (std::is_same_v<typename Vector::field_type, double>) {
+        if (prm.get<bool>("single_precision", false)) {
+#if FLOW_INSTANTIATE_FLOAT
+            return SinglePrecisionPreconditioners<Operator, Comm>::create(op, prm, weightsCalculator, pressureIndex);
+#else
+            OPM_THROW(std::invalid_argument,
+                      "Single precision preconditioners need a build with BUILD_FLOW_FLOAT_VARIANTS enabled.");
+#endif
+        }
+    }
     const std::string& type = prm.get<std::string>("type", "ParOverILU0");
     auto it = creators_.find(type);
     if (it == creators_.end()) {
@@ -738,6 +824,18 @@ PreconditionerFactory<Operator, Comm>::doCreate(const Operator& op,
         StandardPreconditioners<Operator, Comm>::add();
         defAdded_ = true;
     }
+    // A preconditioner which is already in single precision is created as is.
+    if constexpr (std::is_same_v<typename Vector::field_type, double>) {
+        if (prm.get<bool>("single_precision", false)) {
+#if FLOW_INSTANTIATE_FLOAT
+            return SinglePrecisionPreconditioners<Operator, Comm>::create(op, prm, weightsCalculator,
+                                                                          pressureIndex, comm);
+#else
+            OPM_THROW(std::invalid_argument,
+                      "Single precision preconditioners need a build with BUILD_FLOW_FLOAT_VARIANTS enabled.");
+#endif
+        }
+    }
     const std::string& type = prm.get<std::string>("type", "ParOverILU0");
     auto it = parallel_creators_.find(type);
     if (it == parallel_creators_.end()) {
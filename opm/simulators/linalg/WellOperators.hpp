@@ -32,10 +32,37 @@
 #include <dune/common/shared_ptr.hh>
 #include <dune/istl/paamg/smoother.hh>
 
+#include <algorithm>
 #include <cstddef>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
 
 namespace Opm {
 
+namespace detail {
+
+//! \brief Whether a well is distributed across processes. Wells without
+//!        parallel well info, as in the tests, are never distributed.
+template <class Well, class = void>
+struct IsDistributedWell
+{
+    static bool value(const Well&) { return false; }
+};
+
+template <class Well>
+struct IsDistributedWell<Well, std::void_t<decltype(std::declval<const Well&>().parallelWellInfo())>>
+{
+    static bool value(const Well& well)
+    { return well.parallelWellInfo().communication().size() > 1; }
+};
+
+} // namespace detail
+
 //=====================================================================
 // Implementation for ISTL-matrix based operators
 // Note: the classes WellModelMatrixAdapter and
@@ -65,9 +92,29 @@ public:
     virtual int getNumberOfExtraEquations() const = 0;
 };
 
+/// Linear operator applying the Schur complement of the well equations.
+///
+/// The wells are applied concurrently if OpenMP is available. To avoid
+/// conflicting writes, the wells are grouped into levels such that the
+/// wells of one level perforate disjoint sets of cells. A well is put on
+/// the level after the highest level of the wells before it which share a
+/// cell with it, so the contributions to each cell are added in the order
+/// of the well container, as in a sequential loop. Wells distributed
+/// across processes communicate when applied, so they are not put on the
+/// levels but applied afterwards by the calling thread, in the order of
+/// the well container, which is the same on all processes.
+///
+/// Applying a well uses scratch vectors of its equations, e.g., Bx_ and
+/// umfRhs_ of the multisegment wells, so a well must not be applied by two
+/// threads at once. Each well is on exactly one level, so this holds
+/// within one call to apply(), but the calls of several operators sharing
+/// the wells must not overlap.
 template <class WellModel, class X, class Y>
 class WellModelAsLinearOperator : public LinearOperatorExtra<X, Y>
 {
+    using WellPtr = std::decay_t<decltype(*std::declval<const WellModel&>().begin())>;
+    using Well = std::remove_reference_t<decltype(*std::declval<const WellPtr&>())>;
+
 public:
     using Base = LinearOperatorExtra<X, Y>;
     using field_type = typename Base::field_type;
@@ -84,8 +131,38 @@ public:
     void apply(const X& x, Y& y) const override
     {
         OPM_TIMEBLOCK(apply);
-        for (const auto& well : this->wellMod_) {
-            this->applySingleWell(x, y, well, well->cells());
+        updateWellLevels(y.size());
+#ifdef _OPENMP
+        const std::size_t numThreads = omp_get_max_threads();
+#else
+        const std::size_t numThreads = 1;
+#endif
+        if (x_local_.size() < numThreads) {
+            x_local_.resize(numThreads);
+            Ax_local_.resize(numThreads);
+        }
+        // The wells are not assigned to the same thread in every call, so
+        // all local vectors must be able to hold the largest well.
+        for (std::size_t t = 0; t < numThreads; ++t) {
+            x_local_[t].reserve(maxWellCells_);
+            Ax_local_[t].reserve(maxWellCells_);
+        }
+        for (const auto& wells : wellLevels_) {
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic)
+#endif
+            for (std::size_t i = 0; i < wells.size(); ++i) {
+#ifdef _OPENMP
+                const std::size_t thread = omp_get_thread_num();
+#else
+                const std::size_t thread = 0;
+#endif
+                this->applySingleWell(x, y, wells[i], wells[i]->cells(),
+                                      x_local_[thread], Ax_local_[thread]);
+            }
+        }
+        for (const auto* well : distributedWells_) {
+            this->applySingleWell(x, y, well, well->cells(), x_local_[0], Ax_local_[0]);
         }
     }
 
@@ -143,32 +220,89 @@ protected:
     template<class WellType, class ArrayType>
     void applySingleWell(const X& x, Y& y,
                          const WellType& well,
-                         const ArrayType& cells) const
+                         const ArrayType& cells,
+                         X& x_local,
+                         Y& Ax_local) const
     {
         // Well equations B and C uses only the perforated cells, so need to apply on local vectors
-        x_local_.resize(cells.size());
-        Ax_local_.resize(cells.size());
+        x_local.resize(cells.size());
+        Ax_local.resize(cells.size());
 
         for (size_t i = 0; i < cells.size(); ++i) {
-            x_local_[i] = x[cells[i]];
-            Ax_local_[i] = y[cells[i]];
+            x_local[i] = x[cells[i]];
+            Ax_local[i] = y[cells[i]];
         }
 
-        well->apply(x_local_, Ax_local_);
+        well->apply(x_local, Ax_local);
 
         for (size_t i = 0; i < cells.size(); ++i) {
             // only need to update Ax
-            y[cells[i]] = Ax_local_[i];
+            y[cells[i]] = Ax_local[i];
         }
 
     }
 
+    // Group the wells into levels of wells with disjoint cells, unless
+    // the wells and their cells are the same as in the last call. The
+    // cells are compared rather than only their number, since the wells
+    // may be recreated at the same address with different perforations.
+    void updateWellLevels(const std::size_t numCells) const
+    {
+        std::size_t w = 0;
+        bool unchanged = true;
+        for (const auto& well : this->wellMod_) {
+            unchanged = unchanged && w < wellSignature_.size()
+                && wellSignature_[w].first == &*well
+                && std::equal(wellSignature_[w].second.begin(),
+                              wellSignature_[w].second.end(),
+                              well->cells().begin(), well->cells().end());
+            ++w;
+        }
+        if (unchanged && w == wellSignature_.size()) {
+            return;
+        }
+
+        wellSignature_.clear();
+        wellLevels_.clear();
+        distributedWells_.clear();
+        maxWellCells_ = 0;
+        std::vector<int> cellLevel(numCells, -1);
+        for (const auto& well : this->wellMod_) {
+            const auto& cells = well->cells();
+            wellSignature_.emplace_back(&*well, std::vector<int>(cells.begin(), cells.end()));
+            maxWellCells_ = std::max(maxWellCells_, cells.size());
+            if (detail::IsDistributedWell<Well>::value(*well)) {
+                distributedWells_.push_back(&*well);
+                continue;
+            }
+            int level = 0;
+            for (const auto cell : cells) {
+                level = std::max(level, cellLevel[cell] + 1);
+            }
+            for (const auto cell : cells) {
+                cellLevel[cell] = level;
+            }
+            if (wellLevels_.size() <= static_cast<std::size_t>(level)) {
+                wellLevels_.resize(level + 1);
+            }
+            wellLevels_[level].push_back(&*well);
+        }
+    }
+
     // These members are used to avoid reallocation.
     // Their state is not relevant between function calls, so they can
     // (and must) be mutable, as the functions using them are const.
-    mutable X x_local_{};
-    mutable Y Ax_local_{};
+    // There is one pair of local vectors per thread.
+    mutable std::vector<X> x_local_{};
+    mutable std::vector<Y> Ax_local_{};
     mutable Y scaleAddRes_{};
+
+    // The wells of each level, and the wells and their cells the levels
+    // were computed for.
+    mutable std::vector<std::vector<const Well*>> wellLevels_{};
+    mutable std::vector<const Well*> distributedWells_{};
+    mutable std::vector<std::pair<const Well*, std::vector<int>>> wellSignature_{};
+    mutable std::size_t maxWellCells_{0};
 };
 
 template <class WellModel, class X, class Y>
@@ -185,10 +319,17 @@ public:
     void apply(const X& x, Y& y) const override
     {
         OPM_TIMEBLOCK(apply);
+        // The domains may be solved concurrently, so the wells of a
+        // domain are applied sequentially.
+        if (this->x_local_.empty()) {
+            this->x_local_.resize(1);
+            this->Ax_local_.resize(1);
+        }
         std::size_t well_index = 0;
         for (const auto& well : this->wellMod_) {
             if (this->wellMod_.well_domain().at(well->name()) == domainIndex_) {
-                this->applySingleWell(x, y, well, this->wellMod_.well_local_cells()[well_index]);
+                this->applySingleWell(x, y, well, this->wellMod_.well_local_cells()[well_index],
+                                      this->x_local_[0], this->Ax_local_[0]);
             }
             ++well_index;
         }
@@ -7,6 +7,7 @@
 // dune-istl release 2.6.0. Modifications have been kept as minimal as possible.
 
 #include <opm/simulators/linalg/PreconditionerWithUpdate.hpp>
+#include <opm/common/OpmLog/OpmLog.hpp>
 #include <opm/common/TimingMacros.hpp>
 #include <dune/common/exceptions.hh>
 #include <dune/common/version.hh>
@@ -22,13 +23,117 @@
 #include <dune/common/typetraits.hh>
 #include <dune/common/exceptions.hh>
 
+#include <cassert>
+#include <cstddef>
 #include <memory>
+#include <sstream>
+#include <vector>
 
 namespace Dune
 {
   namespace Amg
   {
 
+    /**
+     * @brief A precomputed plan for recalculating a Galerkin product
+     * with fixed aggregates and a fixed coarse sparsity pattern.
+     *
+     * BaseGalerkinProduct::calculate looks up the coarse entry of every
+     * fine matrix entry with a binary search in the coarse row. When only
+     * the values of the fine matrix change these lookups always give the
+     * same result, so the plan stores the coarse block for each fine entry
+     * in the order of iteration, and the numeric product is a plain
+     * scatter-add.
+     *
+     * The plan refers to the blocks of the coarse matrix, which must not
+     * be reallocated while the plan is in use.
+     */
+    template<class M>
+    class GalerkinProductPlan
+    {
+    public:
+      typedef typename M::block_type Block;
+
+      /**
+       * @brief Build the plan for the product of a fine matrix and its aggregates.
+       * @param fine The fine matrix.
+       * @param aggregates The mapping of the fine unknowns onto the aggregates.
+       * @param coarse The coarse matrix, whose sparsity pattern has been set up.
+       */
+      template<class V>
+      void build(const M& fine, const AggregatesMap<V>& aggregates, M& coarse)
+      {
+        targets_.clear();
+        targets_.reserve(fine.nonzeroes());
+        for(auto row = fine.begin(); row != fine.end(); ++row) {
+          const V rowAgg = aggregates[row.index()];
+          for(auto col = row->begin(); col != row->end(); ++col) {
+            const V colAgg = aggregates[col.index()];
+            if(rowAgg != AggregatesMap<V>::ISOLATED && colAgg != AggregatesMap<V>::ISOLATED) {
+              assert(rowAgg != AggregatesMap<V>::UNAGGREGATED);
+              auto entry = coarse[rowAgg].find(colAgg);
+              assert(entry != coarse[rowAgg].end());
+              targets_.push_back(&*entry);
+            }
+            else
+              targets_.push_back(nullptr);
+          }
+        }
+        diagonals_.clear();
+        diagonals_.reserve(coarse.N());
+        for(auto row = coarse.begin(); row != coarse.end(); ++row)
+          diagonals_.push_back(&coarse[row.index()][row.index()]);
+        diagonalValues_.resize(coarse.N());
+        built_ = true;
+      }
+
+      /**
+       * @brief Whether the plan has been built.
+       */
+      bool isBuilt() const
+      {
+        return built_;
+      }
+
+      /**
+       * @brief Recalculate the values of the coarse matrix.
+       *
+       * Does the same as BaseGalerkinProduct::calculate for the matrices the
+       * plan was built for, including taking the diagonal of the copy rows
+       * from their owners.
+       * @param fine The fine matrix, with the same sparsity pattern as on build().
+       * @param coarse The coarse matrix the plan was built for.
+       * @param pinfo The parallel information of the coarse level.
+       */
+      template<class I>
+      void calculate(const M& fine, M& coarse, const I& pinfo)
+      {
+        assert(targets_.size() == fine.nonzeroes());
+        coarse = static_cast<typename M::field_type>(0);
+        auto target = targets_.begin();
+        for(auto row = fine.begin(); row != fine.end(); ++row)
+          for(auto col = row->begin(); col != row->end(); ++col, ++target)
+            if(*target)
+              **target += *col;
+
+        for(std::size_t i = 0; i < diagonals_.size(); ++i)
+          diagonalValues_[i] = *diagonals_[i];
+        pinfo.copyOwnerToAll(diagonalValues_, diagonalValues_);
+        for(std::size_t i = 0; i < diagonals_.size(); ++i)
+          *diagonals_[i] = diagonalValues_[i];
+      }
+
+    private:
+      /** @brief The coarse block of each fine entry, nullptr for isolated unknowns. */
+      std::vector<Block*> targets_;
+      /** @brief The diagonal block of each coarse row. */
+      std::vector<Block*> diagonals_;
+      /** @brief Buffer for communicating the coarse diagonal. */
+      std::vector<Block> diagonalValues_;
+      /** @brief Whether build() has been called. */
+      bool built_ = false;
+    };
+
 
 #if HAVE_MPI
   template<class M, class T>
@@ -194,17 +299,17 @@ namespace Dune
        * It is assumed that the coarsening for the changed fine level
        * matrix would yield the same aggregates. In this case it suffices
        * to recalculate all the Galerkin products for the matrices of the
-       * coarser levels.
+       * coarser levels. As the sparsity patterns are kept too, only the
+       * numeric values are computed, using a plan per level that is set up
+       * on the first call.
        */
       void recalculateHierarchy()
       {
         OPM_TIMEBLOCK(recalculateHierarch);
-        auto copyFlags = NegateSet<typename PI::OwnerSet>();
         const auto& matrices =  matrices_->matrices();
         const auto& aggregatesMapHierarchy = matrices_->aggregatesMaps();
         const auto& infoHierarchy = matrices_->parallelInformation();
         const auto& redistInfoHierarchy = matrices_->redistributeInformation();
-        BaseGalerkinProduct productBuilder;
         auto aggregatesMap = aggregatesMapHierarchy.begin();
         auto info = infoHierarchy.finest();
         auto redistInfo = redistInfoHierarchy.begin();
@@ -222,12 +327,19 @@ namespace Dune
         }
 #endif
 
-        for(; matrix!=coarsestMatrix; ++aggregatesMap) {
+        galerkinPlans_.resize(matrices_->levels());
+        galerkinTimes_.assign(matrices_->levels(), 0.0);
+        for(std::size_t level = 1; matrix!=coarsestMatrix; ++aggregatesMap, ++level) {
+          OPM_TIMEBLOCK_LOCAL(galerkinProduct);
+          Timer watch;
           const Matrix& fine = (matrix.isRedistributed() ? matrix.getRedistributed() : *matrix).getmat();
           ++matrix;
           ++info;
           ++redistInfo;
-          productBuilder.calculate(fine, *(*aggregatesMap), const_cast<Matrix&>(matrix->getmat()), *info, copyFlags);
+          Matrix& coarse = const_cast<Matrix&>(matrix->getmat());
+          if(!galerkinPlans_[level].isBuilt())
+            galerkinPlans_[level].build(fine, *(*aggregatesMap), coarse);
+          galerkinPlans_[level].calculate(fine, coarse, *info);
 #if HAVE_MPI
           if(matrix.isRedistributed()) {
             redistributeMatrixAmg(const_cast<Matrix&>(matrix->getmat()),
@@ -236,6 +348,7 @@ namespace Dune
                                   const_cast<Dune::RedistributeInformation<PI>&>(*redistInfo));
           }
 #endif
+          galerkinTimes_[level] = watch.elapsed();
         }
       }
 
@@ -250,6 +363,24 @@ namespace Dune
        */
       void update() override;
 
+      /**
+       * @brief The time in seconds spent on the Galerkin product of each
+       * level in the last update, zero for the finest level.
+       */
+      const std::vector<double>& galerkinTimes() const
+      {
+        return galerkinTimes_;
+      }
+
+      /**
+       * @brief The time in seconds spent on setting up the smoothers of all
+       * levels in the last update or construction.
+       */
+      double smootherTime() const
+      {
+        return smootherTime_;
+      }
+
       /**
        * @brief Check whether the coarse solver used is a direct solver.
        * @return True if the coarse level solver is a direct solver.
@@ -280,6 +411,21 @@ namespace Dune
 
       void setupCoarseSolver();
 
+      /**
+       * @brief Create the smoothers of all levels, recording the time
+       * needed.
+       */
+      void coarsenSmoother();
+
+      /**
+       * @brief Report the setup times of the smoothers and of the Galerkin
+       * products of the levels.
+       *
+       * They are printed together with the hierarchy setup time if
+       * verbosity > 0, and also written to the debug log if verbosity > 1.
+       */
+      void reportSetupTimes() const;
+
       /**
        * @brief A struct that holds the context of the current level.
        *
@@ -388,6 +534,12 @@ namespace Dune
       SolverCategory::Category category_;
       /** @brief The verbosity level. */
       std::size_t verbosity_;
+      /** @brief The plans for the Galerkin products, indexed by the coarse level. */
+      std::vector<GalerkinProductPlan<typename M::matrix_type>> galerkinPlans_;
+      /** @brief The time of the last Galerkin product of each level. */
+      std::vector<double> galerkinTimes_;
+      /** @brief The time of the last smoother setup of all levels. */
+      double smootherTime_ = 0.0;
     };
 
     template<class M, class X, class S, class PI, class A>
@@ -401,7 +553,12 @@ namespace Dune
       additive(amg.additive), coarsesolverconverged(amg.coarsesolverconverged),
       coarseSmoother_(amg.coarseSmoother_),
       category_(amg.category_),
-      verbosity_(amg.verbosity_)
+      verbosity_(amg.verbosity_),
+      // The plans hold pointers into the coarse matrices of amg. They are
+      // built again for this copy on its first recalculation.
+      galerkinPlans_(),
+      galerkinTimes_(amg.galerkinTimes_),
+      smootherTime_(amg.smootherTime_)
     {
       if(amg.rhs_)
         rhs_.reset( new Hierarchy<Range,A>(*amg.rhs_) );
@@ -429,7 +586,7 @@ namespace Dune
       assert(matrices_->isBuilt());
 
       // build the necessary smoother hierarchies
-      matrices_->coarsenSmoother(*smoothers_, smootherArgs_);
+      coarsenSmoother();
     }
 
     template<class M, class X, class S, class PI, class A>
@@ -484,12 +641,36 @@ namespace Dune
       coarsesolverconverged = true;
       smoothers_.reset(new Hierarchy<Smoother,A>);
       recalculateHierarchy();
-      matrices_->coarsenSmoother(*smoothers_, smootherArgs_);
+      coarsenSmoother();
       setupCoarseSolver();
       if (verbosity_>0 && matrices_->parallelInformation().finest()->communicator().rank()==0) {
         std::cout << "Recalculating galerkin and coarse smoothers "<< matrices_->maxlevels() << " levels "
                   << watch.elapsed() << " seconds." << std::endl;
       }
+      reportSetupTimes();
+    }
+
+    template<class M, class X, class S, class PI, class A>
+    void AMGCPR<M,X,S,PI,A>::coarsenSmoother()
+    {
+      OPM_TIMEBLOCK(coarsenSmoother);
+      Timer watch;
+      matrices_->coarsenSmoother(*smoothers_, smootherArgs_);
+      smootherTime_ = watch.elapsed();
+    }
+
+    template<class M, class X, class S, class PI, class A>
+    void AMGCPR<M,X,S,PI,A>::reportSetupTimes() const
+    {
+      if (verbosity_>0 && matrices_->parallelInformation().finest()->communicator().rank()==0) {
+        std::ostringstream os;
+        os << "AMG setup: smoothers " << smootherTime_ << " seconds";
+        for (std::size_t level = 1; level < galerkinTimes_.size(); ++level)
+          os << ", galerkin product level " << level << " " << galerkinTimes_[level] << " seconds";
+        std::cout << os.str() << std::endl;
+        if (verbosity_>1)
+          Opm::OpmLog::debug(os.str());
+      }
     }
 
     template<class M, class X, class S, class PI, class A>
@@ -502,13 +683,17 @@ namespace Dune
       matrices_.reset(new OperatorHierarchy(matrix, pinfo));
 
       matrices_->template build<NegateSet<typename PI::OwnerSet> >(criterion);
+      // the plans refer to the coarse matrices of the previous hierarchy
+      galerkinPlans_.clear();
+      galerkinTimes_.clear();
 
       // build the necessary smoother hierarchies
-      matrices_->coarsenSmoother(*smoothers_, smootherArgs_);
+      coarsenSmoother();
       setupCoarseSolver();
       if(verbosity_>0 && matrices_->parallelInformation().finest()->communicator().rank()==0)
         std::cout<<"Building hierarchy of "<<matrices_->maxlevels()<<" levels "
                  <<"(inclusive coarse solver) took "<<watch.elapsed()<<" seconds."<<std::endl;
+      reportSetupTimes();
     }
 
     template<class M, class X, class S, class PI, class A>
@@ -31,6 +31,8 @@
 #include <dune/common/fmatrix.hh>
 #include <dune/common/version.hh>
 
+#include <opm/simulators/linalg/sparsitypattern.hh>
+
 namespace Opm {
 namespace Linear {
 
@@ -100,6 +102,35 @@ public:
         istlMatrix_->endindices();
     }
 
+    /*!
+     * \brief Allocate matrix structure given a compressed sparsity pattern.
+     */
+    void reserve(const SparsityPattern& sparsityPattern)
+    {
+        // allocate raw matrix
+        istlMatrix_.reset(new IstlMatrix(rows_, columns_, IstlMatrix::random));
+
+        // make sure sparsityPattern is consistent with number of rows
+        assert(rows_ == sparsityPattern.rows());
+
+        // allocate space for the rows of the matrix
+        for (size_t dofIdx = 0; dofIdx < rows_; ++ dofIdx)
+            istlMatrix_->setrowsize(dofIdx, sparsityPattern.rowSize(dofIdx));
+
+        istlMatrix_->endrowsizes();
+
+        // copy the column indices row by row. the rows are independent of
+        // each other, so they can be filled concurrently.
+#ifdef _OPENMP
+#pragma omp parallel for
+#endif
+        for (size_t dofIdx = 0; dofIdx < rows_; ++ dofIdx)
+            istlMatrix_->setIndices(dofIdx,
+                                    sparsityPattern.rowBegin(dofIdx),
+                                    sparsityPattern.rowEnd(dofIdx));
+        istlMatrix_->endindices();
+    }
+
     /*!
      * \brief Return constant reference to matrix implementation.
      */
@@ -0,0 +1,252 @@
+// -*- mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-
+// vi: set et ts=4 sw=4 sts=4:
+/*
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 2 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+
+  Consult the COPYING file in the top-level source directory of this
+  module for the precise wording of the license and the list of
+  copyright holders.
+*/
+/*!
+ * \file
+ * \copydoc Opm::Linear::SparsityPattern
+ */
+#ifndef EWOMS_SPARSITY_PATTERN_HH
+#define EWOMS_SPARSITY_PATTERN_HH
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <numeric>
+#include <utility>
+#include <vector>
+
+namespace Opm {
+namespace Linear {
+
+/*!
+ * \ingroup Linear
+ * \brief The sparsity pattern of a matrix in compressed row storage.
+ *
+ * The pattern is built in two passes: First, an upper bound for the
+ * number of entries of each row is counted using incrementRowSize().
+ * After calling allocate(), the column indices are added using
+ * addIndex(). Column indices may be added more than once. Finally,
+ * compress() sorts the column indices of each row and removes the
+ * duplicates.
+ *
+ * Entries which have not been counted in the first pass can be added
+ * using insert() at any time before compress(). This is intended for the
+ * comparatively few connections that are added by auxiliary modules, e.g.,
+ * wells.
+ */
+class SparsityPattern
+{
+public:
+    using Index = unsigned;
+
+    explicit SparsityPattern(std::size_t numRows = 0)
+    { resize(numRows); }
+
+    /*!
+     * \brief Discard all entries and set the number of rows.
+     */
+    void resize(std::size_t numRows)
+    {
+        rowStart_.assign(numRows + 1, 0);
+        rowSize_.clear();
+        indices_.clear();
+        extraEntries_.clear();
+        allocated_ = false;
+    }
+
+    /*!
+     * \brief Return the number of rows.
+     */
+    std::size_t rows() const
+    { return rowStart_.size() - 1; }
+
+    /*!
+     * \brief Increase the number of entries reserved for a row.
+     *
+     * Different rows may be incremented concurrently.
+     */
+    void incrementRowSize(std::size_t row, std::size_t n = 1)
+    {
+        assert(!allocated_);
+        rowStart_[row + 1] += n;
+    }
+
+    /*!
+     * \brief Allocate the space reserved by incrementRowSize().
+     */
+    void allocate()
+    {
+        assert(!allocated_);
+        std::partial_sum(rowStart_.begin(), rowStart_.end(), rowStart_.begin());
+        indices_.resize(rowStart_.back());
+        rowSize_.assign(rows(), 0);
+        allocated_ = true;
+    }
+
+    /*!
+     * \brief Add a column index to a row for which space has been reserved.
+     *
+     * Different rows may be filled concurrently.
+     */
+    void addIndex(std::size_t row, Index col)
+    {
+        assert(allocated_);
+        assert(rowStart_[row] + rowSize_[row] < rowStart_[row + 1]);
+        indices_[rowStart_[row] + rowSize_[row]++] = col;
+    }
+
+    /*!
+     * \brief Add a range of column indices to a row for which space has
+     *        been reserved.
+     */
+    template <class It>
+    void addIndices(std::size_t row, It begin, It end)
+    {
+        for (; begin != end; ++begin)
+            addIndex(row, *begin);
+    }
+
+    /*!
+     * \brief Add a column index to a row without having reserved space.
+     */
+    void insert(std::size_t row, Index col)
+    { extraEntries_.emplace_back(row, col); }
+
+    /*!
+     * \brief Add a range of column indices to a row without having reserved
+     *        space.
+     */
+    template <class It>
+    void insert(std::size_t row, It begin, It end)
+    {
+        for (; begin != end; ++begin)
+            insert(row, *begin);
+    }
+
+    /*!
+     * \brief Sort the column indices of each row and remove the duplicates.
+     *
+     * The rows are processed concurrently if OpenMP is available.
+     */
+    void compress()
+    {
+        if (!allocated_)
+            allocate();
+
+        const std::size_t numRows = rows();
+
+        // group the entries added by insert() by row
+        std::sort(extraEntries_.begin(), extraEntries_.end());
+        std::vector<std::size_t> extraStart(numRows + 1, 0);
+        for (const auto& entry : extraEntries_)
+            ++extraStart[entry.first + 1];
+        std::partial_sum(extraStart.begin(), extraStart.end(), extraStart.begin());
+
+        // gather both kinds of entries of each row into a temporary array,
+        // sort them and remove the duplicates
+        std::vector<std::size_t> tmpStart(numRows + 1, 0);
+        for (std::size_t row = 0; row < numRows; ++row)
+            tmpStart[row + 1] = tmpStart[row] + rowSize_[row] + extraStart[row + 1] - extraStart[row];
+        std::vector<Index> tmpIndices(tmpStart.back());
+
+#ifdef _OPENMP
+#pragma omp parallel for
+#endif
+        for (std::size_t row = 0; row < numRows; ++row) {
+            const auto rowBegin = tmpIndices.begin() + tmpStart[row];
+            auto rowEnd = std::copy_n(indices_.begin() + rowStart_[row], rowSize_[row], rowBegin);
+            for (std::size_t i = extraStart[row]; i < extraStart[row + 1]; ++i)
+                *rowEnd++ = extraEntries_[i].second;
+            std::sort(rowBegin, rowEnd);
+            rowSize_[row] = static_cast<std::size_t>(std::unique(rowBegin, rowEnd) - rowBegin);
+        }
+
+        // copy the unique entries into the final, dense layout
+        rowStart_[0] = 0;
+        for (std::size_t row = 0; row < numRows; ++row)
+            rowStart_[row + 1] = rowStart_[row] + rowSize_[row];
+        indices_.resize(rowStart_.back());
+        indices_.shrink_to_fit();
+
+#ifdef _OPENMP
+#pragma omp parallel for
+#endif
+        for (std::size_t row = 0; row < numRows; ++row)
+            std::copy_n(tmpIndices.begin() + tmpStart[row], rowSize_[row],
+                        indices_.begin() + rowStart_[row]);
+
+        extraEntries_.clear();
+        extraEntries_.shrink_to_fit();
+    }
+
+    /*!
+     * \brief Return the number of entries of a row.
+     *
+     * Only valid after compress() has been called.
+     */
+    std::size_t rowSize(std::size_t row) const
+    { return rowStart_[row + 1] - rowStart_[row]; }
+
+    /*!
+     * \brief Return a pointer to the first column index of a row.
+     *
+     * Only valid after compress() has been called.
+     */
+    const Index* rowBegin(std::size_t row) const
+    { return indices_.data() + rowStart_[row]; }
+
+    /*!
+     * \brief Return a pointer past the last column index of a row.
+     *
+     * Only valid after compress() has been called.
+     */
+    const Index* rowEnd(std::size_t row) const
+    { return indices_.data() + rowStart_[row + 1]; }
+
+    /*!
+     * \brief Return the total number of entries.
+     */
+    std::size_t nonZeros() const
+    { return rowStart_.back(); }
+
+    /*!
+     * \brief Return the number of bytes allocated for the pattern.
+     */
+    std::size_t memoryUsage() const
+    {
+        return rowStart_.capacity()*sizeof(std::size_t)
+            + rowSize_.capacity()*sizeof(std::size_t)
+            + indices_.capacity()*sizeof(Index)
+            + extraEntries_.capacity()*sizeof(std::pair<std::size_t, Index>);
+    }
+
+private:
+    std::vector<std::size_t> rowStart_;
+    std::vector<std::size_t> rowSize_;
+    std::vector<Index> indices_;
+    std::vector<std::pair<std::size_t, Index>> extraEntries_;
+    bool allocated_;
+};
+
+}} // namespace Linear, Opm
+
+#endif
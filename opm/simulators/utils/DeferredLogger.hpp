@@ -87,6 +87,10 @@ enum ExcEnum {
         /// Clear the message container without logging them.
         void clearMessages();
 
+        /// Move all messages of another logger to the end of
+        /// this one, leaving the other logger empty.
+        void append(DeferredLogger& other);
+
     private:
         std::vector<Message> messages_;
         friend DeferredLogger gatherDeferredLogger(const DeferredLogger& local_deferredlogger,
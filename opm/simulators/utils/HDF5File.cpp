@@ -26,10 +26,12 @@
 
 #include <opm/simulators/utils/DeferredLoggingErrorHelpers.hpp>
 
+#include <algorithm>
 #include <cassert>
 #include <cstddef>
 #include <filesystem>
 #include <stdexcept>
+#include <string>
 
 namespace {
 
@@ -53,8 +55,25 @@ namespace Opm {
 HDF5File::HDF5File(const std::string& fileName,
                    OpenMode mode,
                    Parallel::Communication comm)
+    : HDF5File(fileName, mode, comm, DataSetSettings{})
+{
+}
+
+HDF5File::HDF5File(const std::string& fileName,
+                   OpenMode mode,
+                   Parallel::Communication comm,
+                   const DataSetSettings& settings)
     : comm_(comm)
+    , settings_(settings)
 {
+    if (settings_.compressionLevel < 0 || settings_.compressionLevel > 9) {
+        throw std::invalid_argument("HDF5File: Compression level must be between 0 and 9, got " +
+                                    std::to_string(settings_.compressionLevel));
+    }
+    if (settings_.maxChunkSize == 0) {
+        throw std::invalid_argument("HDF5File: Maximum chunk size must be positive");
+    }
+
     bool exists = std::filesystem::exists(fileName);
     hid_t acc_tpl = H5P_DEFAULT;
     if (comm.size() > 1) {
@@ -264,7 +283,12 @@ void HDF5File::writeRootOnly(hid_t grp,
                                   H5P_DEFAULT, dcpl, H5P_DEFAULT);
     if (dataset_id == H5I_INVALID_HID) {
         H5Sclose(space);
-        H5Pclose(dcpl);
+        if (dcpl != H5P_DEFAULT) {
+            H5Pclose(dcpl);
+        }
+        if (dxpl != H5P_DEFAULT) {
+            H5Pclose(dxpl);
+        }
         throw std::runtime_error("Trying to write already existing dataset '" +
                                  group + '/' + dset + "'");
     }
@@ -272,6 +296,9 @@ void HDF5File::writeRootOnly(hid_t grp,
     writeDset(0, dataset_id, dxpl, size, buffer.data());
     H5Dclose(dataset_id);
     H5Sclose(space);
+    if (dcpl != H5P_DEFAULT) {
+        H5Pclose(dcpl);
+    }
     if (dxpl != H5P_DEFAULT) {
         H5Pclose(dxpl);
     }
@@ -281,10 +308,17 @@ hid_t HDF5File::getCompression([[maybe_unused]] hsize_t size) const
 {
     hid_t dcpl = H5P_DEFAULT;
 #if H5_VERS_MINOR > 8
-    if (H5Zfilter_avail(H5Z_FILTER_DEFLATE)) {
+    // Empty datasets cannot be chunked, and uncompressed data is best
+    // stored contiguously.
+    if (settings_.compressionLevel > 0 && size > 0 &&
+        H5Zfilter_avail(H5Z_FILTER_DEFLATE))
+    {
+        // Bounded chunks are compressed and written piecewise, and stay
+        // below the HDF5 limit of 4 GiB per chunk for large partitions.
+        const hsize_t chunk = std::min(size, settings_.maxChunkSize);
         dcpl = H5Pcreate(H5P_DATASET_CREATE);
-        H5Pset_deflate(dcpl, 1);
-        H5Pset_chunk(dcpl, 1, &size);
+        H5Pset_deflate(dcpl, settings_.compressionLevel);
+        H5Pset_chunk(dcpl, 1, &chunk);
     }
 #endif
     return dcpl;
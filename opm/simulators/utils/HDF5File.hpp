@@ -46,6 +46,14 @@ public:
         PROCESS_SPLIT  //!< One separate data set for each parallel process
     };
 
+    //! \brief Storage settings for datasets created in the file.
+    struct DataSetSettings {
+        //! \brief Deflate compression level (0-9), 0 disables compression.
+        int compressionLevel = 1;
+        //! \brief Maximum size of a chunk in a compressed dataset (bytes).
+        hsize_t maxChunkSize = 1024 * 1024;
+    };
+
     //! \brief Opens HDF5 file for I/O.
     //! \param fileName Name of file to open
     //! \param mode Open mode for file
@@ -53,6 +61,15 @@ public:
              OpenMode mode,
              Parallel::Communication comm);
 
+    //! \brief Opens HDF5 file for I/O.
+    //! \param fileName Name of file to open
+    //! \param mode Open mode for file
+    //! \param settings Storage settings for datasets written to the file
+    HDF5File(const std::string& fileName,
+             OpenMode mode,
+             Parallel::Communication comm,
+             const DataSetSettings& settings);
+
     //! \brief Destructor clears up any opened files.
     ~HDF5File();
 
@@ -100,6 +117,8 @@ private:
 
     //! \brief Return a dataset creation properly list with compression settings.
     //! \param size Size of dataset
+    //! \details Compressed datasets are split in chunks of at most
+    //!          DataSetSettings::maxChunkSize bytes.
     hid_t getCompression(hsize_t size) const;
 
     //! \brief Helper function to write a dataset.
@@ -112,6 +131,7 @@ private:
                    hid_t dxpl, hsize_t size, const void* data) const;
     hid_t m_file = H5I_INVALID_HID; //!< File handle
     Parallel::Communication comm_;
+    DataSetSettings settings_; //!< Storage settings for new datasets
 };
 
 }
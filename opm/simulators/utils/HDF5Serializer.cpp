@@ -22,7 +22,35 @@
 #include <opm/simulators/utils/HDF5Serializer.hpp>
 
 #include <algorithm>
+#include <cstdint>
 #include <cstdlib>
+#include <cstring>
+#include <stdexcept>
+
+namespace {
+
+//! \brief Suffix of the name of datasets stored as deltas.
+const std::string deltaSuffix = "_delta";
+
+void appendValue(std::vector<char>& buffer, std::uint64_t value)
+{
+    const auto pos = buffer.size();
+    buffer.resize(pos + sizeof(value));
+    std::memcpy(buffer.data() + pos, &value, sizeof(value));
+}
+
+std::uint64_t extractValue(const std::vector<char>& buffer, std::size_t& pos)
+{
+    std::uint64_t value;
+    if (pos + sizeof(value) > buffer.size()) {
+        throw std::runtime_error("Truncated delta dataset in serialized state");
+    }
+    std::memcpy(&value, buffer.data() + pos, sizeof(value));
+    pos += sizeof(value);
+    return value;
+}
+
+}
 
 namespace Opm {
 
@@ -68,4 +96,128 @@ std::vector<int> HDF5Serializer::reportSteps() const
     return result;
 }
 
+void HDF5Serializer::setDeltaBase(const std::string& dset,
+                                  const std::string& baseGroup,
+                                  const std::vector<char>& base)
+{
+    m_deltaDset = dset;
+    m_deltaBaseGroup = baseGroup;
+    m_deltaBase = &base;
+}
+
+void HDF5Serializer::readRaw(const std::string& group,
+                             const std::string& dset,
+                             HDF5File::DataSetMode mode)
+{
+    if (mode == HDF5File::DataSetMode::PROCESS_SPLIT) {
+        const auto entries = m_h5file.list(group);
+        const bool isDelta =
+            std::find(entries.begin(), entries.end(), dset) == entries.end() &&
+            std::find(entries.begin(), entries.end(), dset + deltaSuffix) != entries.end();
+        if (isDelta) {
+            this->readDelta(group, dset);
+            return;
+        }
+    }
+
+    m_h5file.read(group, dset, m_buffer, mode);
+}
+
+void HDF5Serializer::writeRaw(const std::vector<char>& buffer,
+                              const std::string& group,
+                              const std::string& dset,
+                              HDF5File::DataSetMode mode)
+{
+    m_h5file.write(group, dset, buffer, mode);
+}
+
+void HDF5Serializer::writePacked(const std::string& group,
+                                 const std::string& dset,
+                                 HDF5File::DataSetMode mode)
+{
+    if (mode == HDF5File::DataSetMode::PROCESS_SPLIT &&
+        m_deltaBase != nullptr && dset == m_deltaDset)
+    {
+        this->writeDelta(group, dset);
+    } else {
+        m_h5file.write(group, dset, m_buffer, mode);
+    }
+}
+
+void HDF5Serializer::writeDelta(const std::string& group,
+                                const std::string& dset)
+{
+    // Layout: base group name, total size, block size, indices of the
+    // changed blocks and finally the data of the changed blocks.
+    const auto& base = *m_deltaBase;
+    const std::size_t size = m_buffer.size();
+    std::vector<std::uint64_t> changed;
+    for (std::size_t begin = 0; begin < size; begin += deltaBlockSize) {
+        const std::size_t end = std::min(begin + deltaBlockSize, size);
+        if (end > base.size() ||
+            !std::equal(m_buffer.begin() + begin, m_buffer.begin() + end,
+                        base.begin() + begin))
+        {
+            changed.push_back(begin / deltaBlockSize);
+        }
+    }
+
+    std::vector<char> delta;
+    delta.reserve(m_deltaBaseGroup.size() + (4 + changed.size()) * sizeof(std::uint64_t) +
+                  changed.size() * deltaBlockSize);
+    appendValue(delta, m_deltaBaseGroup.size());
+    delta.insert(delta.end(), m_deltaBaseGroup.begin(), m_deltaBaseGroup.end());
+    appendValue(delta, size);
+    appendValue(delta, deltaBlockSize);
+    appendValue(delta, changed.size());
+    for (const auto block : changed) {
+        appendValue(delta, block);
+    }
+    for (const auto block : changed) {
+        const std::size_t begin = block * deltaBlockSize;
+        const std::size_t end = std::min(begin + deltaBlockSize, size);
+        delta.insert(delta.end(), m_buffer.begin() + begin, m_buffer.begin() + end);
+    }
+
+    m_h5file.write(group, dset + deltaSuffix, delta);
+}
+
+void HDF5Serializer::readDelta(const std::string& group,
+                               const std::string& dset)
+{
+    std::vector<char> delta;
+    m_h5file.read(group, dset + deltaSuffix, delta);
+
+    std::size_t pos = 0;
+    const std::size_t nameSize = extractValue(delta, pos);
+    if (pos + nameSize > delta.size()) {
+        throw std::runtime_error("Truncated delta dataset in serialized state");
+    }
+    const std::string baseGroup(delta.data() + pos, nameSize);
+    pos += nameSize;
+    const std::size_t size = extractValue(delta, pos);
+    const std::size_t blockSize = extractValue(delta, pos);
+    const std::size_t numChanged = extractValue(delta, pos);
+    std::vector<std::size_t> changed(numChanged);
+    for (auto& block : changed) {
+        block = extractValue(delta, pos);
+    }
+
+    m_h5file.read(baseGroup, dset, m_buffer);
+    m_buffer.resize(size);
+    for (const auto block : changed) {
+        const std::size_t begin = block * blockSize;
+        if (begin >= size) {
+            throw std::runtime_error("Invalid block in delta dataset " +
+                                     group + '/' + dset + deltaSuffix);
+        }
+        const std::size_t len = std::min(blockSize, size - begin);
+        if (pos + len > delta.size()) {
+            throw std::runtime_error("Truncated delta dataset in serialized state");
+        }
+        std::copy_n(delta.begin() + pos, len, m_buffer.begin() + begin);
+        pos += len;
+    }
+}
+
 }
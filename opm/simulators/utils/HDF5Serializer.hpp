@@ -30,6 +30,7 @@
 #include <cstddef>
 #include <limits>
 #include <string>
+#include <vector>
 
 namespace Opm {
 
@@ -38,9 +39,10 @@ class HDF5Serializer : public Serializer<Serialization::MemPacker> {
 public:
     HDF5Serializer(const std::string& fileName,
                    HDF5File::OpenMode mode,
-                   Parallel::Communication comm)
+                   Parallel::Communication comm,
+                   const HDF5File::DataSetSettings& settings = {})
         : Serializer<Serialization::MemPacker>(m_packer_priv)
-        , m_h5file(fileName, mode, comm)
+        , m_h5file(fileName, mode, comm, settings)
     {}
 
     //! \brief Serialize and write data to restart file.
@@ -59,9 +61,36 @@ public:
             throw;
         }
 
-        m_h5file.write(group, dset, m_buffer, mode);
+        this->writePacked(group, dset, mode);
     }
 
+    //! \brief Store later writes of a dataset as deltas against a base.
+    //! \param dset Name of dataset to store as delta
+    //! \param baseGroup Group the base of the dataset is stored in
+    //! \param base Serialized base data, as written to \p baseGroup
+    //! \details Only the blocks of the serialized data which differ from
+    //!          \p base are written.  Deltas are only used for datasets
+    //!          split across processes.  \p base must outlive the writes.
+    void setDeltaBase(const std::string& dset,
+                      const std::string& baseGroup,
+                      const std::vector<char>& base);
+
+    //! \brief Returns the serialized data last written or read.
+    const std::vector<char>& buffer() const
+    { return m_buffer; }
+
+    //! \brief Read serialized data from restart file without deserializing it.
+    //! \details Datasets stored as deltas are reconstructed from their base.
+    void readRaw(const std::string& group,
+                 const std::string& dset,
+                 HDF5File::DataSetMode mode = HDF5File::DataSetMode::PROCESS_SPLIT);
+
+    //! \brief Write serialized data to restart file as is.
+    void writeRaw(const std::vector<char>& buffer,
+                  const std::string& group,
+                  const std::string& dset,
+                  HDF5File::DataSetMode mode = HDF5File::DataSetMode::PROCESS_SPLIT);
+
     //! \brief Writes a header to the file.
     //! \param simulator_name Name of simulator used
     //! \param module_version Version of simulator used
@@ -85,7 +114,7 @@ public:
               const std::string& dset,
               HDF5File::DataSetMode mode = HDF5File::DataSetMode::PROCESS_SPLIT)
     {
-        m_h5file.read(group, dset, m_buffer, mode);
+        this->readRaw(group, dset, mode);
         this->unpack(data);
     }
 
@@ -95,9 +124,28 @@ public:
     //! \brief Returns a list of report steps stored in restart file.
     std::vector<int> reportSteps() const;
 
+    //! \brief Size of the blocks compared when writing deltas.
+    static constexpr std::size_t deltaBlockSize = 4096;
+
 private:
+    //! \brief Write the packed buffer, as a delta if requested for \p dset.
+    void writePacked(const std::string& group,
+                     const std::string& dset,
+                     HDF5File::DataSetMode mode);
+
+    //! \brief Write the packed buffer as a delta against the base.
+    void writeDelta(const std::string& group,
+                    const std::string& dset);
+
+    //! \brief Reconstruct a dataset stored as a delta into the buffer.
+    void readDelta(const std::string& group,
+                   const std::string& dset);
+
     const Serialization::MemPacker m_packer_priv{}; //!< Packer instance
     HDF5File m_h5file; //!< HDF5 backend for the serializer
+    std::string m_deltaDset; //!< Dataset to store as delta
+    std::string m_deltaBaseGroup; //!< Group holding base of delta dataset
+    const std::vector<char>* m_deltaBase = nullptr; //!< Base of delta dataset
 };
 
 }
@@ -157,12 +157,16 @@ namespace {
         ///
         /// \param[in] globalCell Callback for mapping (local) vertex IDs to
         ///   globally unique vertex IDs.
+        ///
+        /// \param[in] weights Weight of each vertex.  Empty if vertices
+        ///   are not weighted.
         template <typename Edge, typename GlobalCellID>
         explicit VertexGraph(const int                    myRank,
                              const std::size_t            numVertices,
                              const std::vector<Edge>&     edges,
                              const EnumerateSeenVertices& vertexId,
-                             GlobalCellID&&               globalCell)
+                             GlobalCellID&&               globalCell,
+                             const std::vector<float>&    weights)
             : myRank_ { myRank }
         {
             // Form undirected connectivity graph.
@@ -180,6 +184,16 @@ namespace {
                     this->globalCell_[localIx] = globalCell(vertex);
                 }
             }
+
+            // Weights of reachable vertices.
+            if (! weights.empty()) {
+                this->weights_.resize(vertexId.numVertices());
+                for (auto vertex = 0*numVertices; vertex < numVertices; ++vertex) {
+                    if (const auto localIx = vertexId[vertex]; localIx >= 0) {
+                        this->weights_[localIx] = weights[vertex];
+                    }
+                }
+            }
         }
 
         /// Retrive my rank in current MPI communicator.
@@ -204,6 +218,17 @@ namespace {
             return this->globalCell_[localCell];
         }
 
+        /// Retrieve weight of reachable vertex.
+        ///
+        /// \param[in] localCell Index of locally reachable cell/vertex.
+        ///
+        /// \return Weight of \p localCell.  One (1) if vertices are not
+        ///   weighted.
+        float weight(const int localCell) const
+        {
+            return this->weights_.empty() ? 1.0f : this->weights_[localCell];
+        }
+
         /// Get read-only access to start pointers of graph's CSR representation.
         ///
         /// \return Reference to start pointers (IA array).
@@ -232,6 +257,10 @@ namespace {
 
         /// Vertex connectivity graph.
         Backend graph_{};
+
+        /// Weight of each locally reachable vertex.  Empty if vertices are
+        /// not weighted.
+        std::vector<float> weights_{};
     };
 
 // Use C linkage for Zoltan interface/query functions.  Ensures maximum compatibility.
@@ -310,14 +339,21 @@ extern "C" {
     ///   \code numElmsPerLid * numVertices(graphPtr) \endcode.  Populated
     ///   by this function.  Allocated by Zoltan.
     ///
+    /// \param[in] wgtDim Number of weights per object/vertex.  Zero (0)
+    ///   or one (1) in this implementation.
+    ///
+    /// \param[in,out] objWgts Object/vertex weights.  Size equal to \code
+    ///   wgtDim * numVertices(graphPtr) \endcode.  Populated by this
+    ///   function.  Allocated by Zoltan.
+    ///
     /// \param[out] ierr Error code for Zoltan consumption.  Single \c int.
     void vertexList(void*            graphPtr,
                     const int        numElmsPerGid,
                     const int        numElmsPerLid,
                     ZOLTAN_ID_PTR    globalIds,
                     ZOLTAN_ID_PTR    localIds,
-                    const int     /* wgtDim */,
-                    float*        /* objWgts */,
+                    const int        wgtDim,
+                    float*           objWgts,
                     int*             ierr)
     {
         if ((numElmsPerGid != numElmsPerLid) || (numElmsPerLid != 1)) {
@@ -340,6 +376,12 @@ extern "C" {
                            return graph->globalId(localCell);
                        });
 
+        if (wgtDim == 1) {
+            for (auto localCell = 0; localCell < graph->numVertices(); ++localCell) {
+                objWgts[localCell] = graph->weight(localCell);
+            }
+        }
+
         *ierr = ZOLTAN_OK;
     }
 
@@ -556,11 +598,18 @@ Opm::ParallelNLDDPartitioningZoltan::partitionElements(const ZoltanParamMap& par
 
     auto graph = VertexGraph {
         this->comm_.rank(), this->numElements_,
-        this->conns_, vertexId, this->globalCell_
+        this->conns_, vertexId, this->globalCell_,
+        this->weights_
     };
 
+    // Zoltan requires the same number of weights per vertex on all ranks.
+    auto zoltanParams = params;
+    if (this->comm_.max(static_cast<int>(! this->weights_.empty())) > 0) {
+        zoltanParams.insert_or_assign("OBJ_WEIGHT_DIM", "1");
+    }
+
     const auto partsForReachableCells = Partitioner {
-        this->comm_, params
+        this->comm_, zoltanParams
     }(static_cast<void*>(&graph), graph.numVertices());
 
     // Map reachable cells back to full cell numbering.
@@ -84,6 +84,20 @@ namespace Opm {
             this->sameDomain_.emplace_back(std::move(cells));
         }
 
+        /// Assign a computational cost to each vertex.
+        ///
+        /// The partitioning then balances the total vertex weight, rather
+        /// than the number of vertices, of the domains/blocks.  Must be
+        /// called either on all or on none of the ranks which have
+        /// vertices, but may be omitted on ranks without vertices.
+        ///
+        /// \param[in] weights Non-negative weight of each of the \p
+        ///   numElements potential vertices.
+        void setVertexWeights(std::vector<float>&& weights)
+        {
+            this->weights_ = std::move(weights);
+        }
+
         /// Partition connectivity graph using Zoltan graph partitioning
         /// package.
         ///
@@ -122,6 +136,10 @@ namespace Opm {
         /// be placed on the same domain, but cells from different
         /// collections may be placed on different domains.
         std::vector<std::vector<int>> sameDomain_{};
+
+        /// Computational cost of each vertex.  Empty if all vertices are
+        /// equally costly.
+        std::vector<float> weights_{};
     };
 
 } // namespace Opm
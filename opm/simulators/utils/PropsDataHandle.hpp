@@ -37,14 +37,35 @@
 #include <dune/grid/common/mcmgmapper.hh>
 #include <dune/grid/common/partitionset.hh>
 #include <dune/common/parallel/mpihelper.hh>
-#include <unordered_map>
-#include <iostream>
+#include <dune/common/parallel/mpitraits.hh>
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cstddef>
+#include <string>
+#include <vector>
 
 namespace Opm
 {
 
 /*!
  * \brief A Data handle to communicate the field properties during load balance.
+ *
+ * The field properties are not migrated together with the cells, as that
+ * would require the root process to hold a copy of the properties of all
+ * cells in the send buffers. Instead, scatterProps() is called once the grid
+ * has been distributed, and the root process streams the properties of each
+ * process' cells in chunks of bounded size. The global indices of the cells
+ * are sent to the root process in chunks of the same number of cells.
+ *
+ * Besides the distributed properties and the global indices of its own
+ * cells, scatterProps() needs one chunk on each process other than the root,
+ * which is thus proportional to its number of cells. On the root process,
+ * which holds the global input anyway, it needs at most three chunks and the
+ * indices of one chunk, independent of the number of cells of the other
+ * processes.
+ *
  * \tparam Grid The type of grid where the load balancing is happening.
  * \todo Maybe specialize this for CpGrid to save some space, later.
  */
@@ -56,13 +77,22 @@ public:
     //! \brief the data type we send (ints are converted to double)
     using DataType = std::pair<double, unsigned char>;
 
+    //! \brief Default upper bound of the size of the messages sent by scatterProps().
+    static constexpr std::size_t defaultChunkBytes = std::size_t{16} << 20;
+
     //! \brief Constructor
+    //! \details Has to be called before the grid is load balanced.
     //! \param grid The grid where the loadbalancing is happening.
-    //! \param globalProps The field properties of the global grid
-    //! \param distributedProps The distributed field properties
-    PropsDataHandle(const Grid& grid, ParallelEclipseState& eclState)
+    //! \param eclState The eclipse state holding the global field properties
+    //!                 on the root process and receiving the distributed ones.
+    //! \param chunkBytes Upper bound of the size of the messages sent by
+    //!                   scatterProps().
+    PropsDataHandle(const Grid& grid, ParallelEclipseState& eclState,
+                    std::size_t chunkBytes = defaultChunkBytes)
         : m_grid(grid),
-          m_distributed_fieldProps(eclState.m_fieldProps)
+          m_eclState(eclState),
+          m_distributed_fieldProps(eclState.m_fieldProps),
+          m_chunkBytes(chunkBytes)
     {
         // Scatter the keys
         const Parallel::Communication comm = m_grid.comm();
@@ -72,97 +102,158 @@ public:
             m_intKeys = globalProps.keys<int>();
             m_doubleKeys = globalProps.keys<double>();
             m_distributed_fieldProps.copyTran(globalProps);
-        }
 
-        Parallel::MpiSerializer ser(comm);
-        ser.broadcast(*this);
-
-        m_no_data = m_intKeys.size() + m_doubleKeys.size();
-
-        if (comm.rank() == 0) {
-            const FieldPropsManager& globalProps = eclState.globalFieldProps();
+#ifndef NDEBUG
+            // scatterProps() reads the properties of a cell at its id. The
+            // ids of CpGrid are the indices of the cells in the undistributed
+            // grid, which is still present here.
             const auto& idSet = m_grid.localIdSet();
             const auto& gridView = m_grid.levelGridView(0);
             using ElementMapper =
                 Dune::MultipleCodimMultipleGeomTypeMapper<typename Grid::LevelGridView>;
             ElementMapper elemMapper(gridView, Dune::mcmgElementLayout());
-
-            for (const auto &element : elements(gridView, Dune::Partitions::interiorBorder))
+            for (const auto &element : elements(gridView))
             {
-                const auto& id = idSet.id(element);
-                auto index = elemMapper.index(element);
-                auto& data = elementData_[id];
-                data.reserve(m_no_data);
-
-                for (const auto& intKey : m_intKeys)
-                {
-                    const auto& fieldData = globalProps.get_int_field_data(intKey);
-                    data.emplace_back(fieldData.data[index],
-                                      static_cast<unsigned char>(fieldData.value_status[index]));
-                }
-
-                for (const auto& doubleKey : m_doubleKeys)
-                {
-                    // We need to allow unsupported keywords to get the data
-                    // for TranCalculator, too.
-                    const auto& fieldData = globalProps.get_double_field_data(doubleKey,
-                                                                              /* allow_unsupported = */ true);
-                    data.emplace_back(fieldData.data[index],
-                                      static_cast<unsigned char>(fieldData.value_status[index]));
-                }
+                assert(static_cast<std::size_t>(idSet.id(element)) ==
+                       static_cast<std::size_t>(elemMapper.index(element)));
             }
+#endif
         }
+
+        Parallel::MpiSerializer ser(comm);
+        ser.broadcast(*this);
+
+        m_no_data = m_intKeys.size() + m_doubleKeys.size();
     }
 
-    ~PropsDataHandle()
+    //! \brief Send the field properties of the distributed cells from the root
+    //!        process to their owners.
+    //! \details Collective operation which has to be called after the grid has
+    //!          been load balanced.
+    void scatterProps()
     {
-        // distributed grid is now correctly set up.
+        const Parallel::Communication comm = m_grid.comm();
+        const auto numCells = static_cast<std::size_t>(m_grid.size(0));
+
         for (const auto& intKey : m_intKeys)
         {
-            m_distributed_fieldProps.m_intProps[intKey].data.resize(m_grid.size(0));
-            m_distributed_fieldProps.m_intProps[intKey].value_status.resize(m_grid.size(0));
+            m_distributed_fieldProps.m_intProps[intKey].data.resize(numCells);
+            m_distributed_fieldProps.m_intProps[intKey].value_status.resize(numCells);
         }
 
         for (const auto& doubleKey : m_doubleKeys)
         {
-            m_distributed_fieldProps.m_doubleProps[doubleKey].data.resize(m_grid.size(0));
-            m_distributed_fieldProps.m_doubleProps[doubleKey].value_status.resize(m_grid.size(0));
+            m_distributed_fieldProps.m_doubleProps[doubleKey].data.resize(numCells);
+            m_distributed_fieldProps.m_doubleProps[doubleKey].value_status.resize(numCells);
+        }
+
+        if (m_no_data == 0)
+        {
+            return;
         }
 
-        // copy data for the persistent mao to the field properties
+        // index of the distributed cells in the global grid, which is the id
+        // of the cells, see the constructor
         const auto& idSet = m_grid.localIdSet();
         const auto& gridView = m_grid.levelGridView(0);
         using ElementMapper =
             Dune::MultipleCodimMultipleGeomTypeMapper<typename Grid::LevelGridView>;
         ElementMapper elemMapper(gridView, Dune::mcmgElementLayout());
 
-        for (const auto &element : elements( gridView, Dune::Partitions::all))
+        std::vector<int> globalIndex(numCells);
+        for (const auto &element : elements(gridView, Dune::Partitions::all))
         {
-            std::size_t counter{};
-            const auto& id = idSet.id(element);
-            auto index = elemMapper.index(element);
-            auto data = elementData_.find(id);
-            assert(data != elementData_.end());
+            globalIndex[elemMapper.index(element)] = idSet.id(element);
+        }
+
+        const auto chunkCells = std::max(std::size_t{1},
+                                         m_chunkBytes / (m_no_data * (sizeof(double) + 1)));
 
+        if (comm.rank() == 0)
+        {
+            const FieldPropsManager& globalProps = m_eclState.globalFieldProps();
+            std::vector<const Fieldprops::FieldData<int>*> intData;
             for (const auto& intKey : m_intKeys)
             {
-                const auto& pair = data->second[counter++];
-                m_distributed_fieldProps.m_intProps[intKey].data[index] = static_cast<int>(pair.first);
-                m_distributed_fieldProps.m_intProps[intKey].value_status[index] = static_cast<value::status>(pair.second);
+                intData.push_back(&globalProps.get_int_field_data(intKey));
             }
-
+            std::vector<const Fieldprops::FieldData<double>*> doubleData;
             for (const auto& doubleKey : m_doubleKeys)
             {
-                const auto& pair = data->second[counter++];
-                m_distributed_fieldProps.m_doubleProps[doubleKey].data[index] = pair.first;
-                m_distributed_fieldProps.m_doubleProps[doubleKey].value_status[index] = static_cast<value::status>(pair.second);
+                // We need to allow unsupported keywords to get the data
+                // for TranCalculator, too.
+                doubleData.push_back(&globalProps.get_double_field_data(doubleKey,
+                                                                        /* allow_unsupported = */ true));
+            }
+
+            // the cells of the root process are copied directly
+            Chunk localChunk;
+            for (std::size_t begin = 0; begin < numCells; begin += chunkCells)
+            {
+                const auto end = std::min(begin + chunkCells, numCells);
+                packChunk_(localChunk, intData, doubleData, globalIndex, begin, end);
+                unpackChunk_(localChunk, begin, end);
+            }
+
+            // two chunks are used, such that the next one is packed while
+            // the previous one is being sent
+            std::array<Chunk, 2> chunks;
+            std::vector<int> remoteIndex;
+            for (int rank = 1; rank < comm.size(); ++rank)
+            {
+                std::size_t remoteCells{};
+                MPI_Recv(&remoteCells, 1, Dune::MPITraits<std::size_t>::getType(),
+                         rank, sizeTag, comm, MPI_STATUS_IGNORE);
+
+                std::size_t chunkIdx = 0;
+                for (std::size_t begin = 0; begin < remoteCells; begin += chunkCells, ++chunkIdx)
+                {
+                    const auto end = std::min(begin + chunkCells, remoteCells);
+                    remoteIndex.resize(end - begin);
+                    MPI_Recv(remoteIndex.data(), static_cast<int>(end - begin), MPI_INT,
+                             rank, indexTag, comm, MPI_STATUS_IGNORE);
+                    auto& chunk = chunks[chunkIdx % 2];
+                    chunk.wait();
+                    packChunk_(chunk, intData, doubleData, remoteIndex, 0, end - begin);
+                    chunk.send(rank, comm);
+                }
+                for (auto& chunk : chunks)
+                {
+                    chunk.wait();
+                }
             }
         }
+        else
+        {
+            MPI_Send(&numCells, 1, Dune::MPITraits<std::size_t>::getType(),
+                     0, sizeTag, comm);
+
+            // the indices of all chunks are sent ahead, such that the root
+            // process can pack the next chunk while this one is received
+            std::vector<MPI_Request> indexRequests;
+            for (std::size_t begin = 0; begin < numCells; begin += chunkCells)
+            {
+                const auto end = std::min(begin + chunkCells, numCells);
+                MPI_Isend(globalIndex.data() + begin, static_cast<int>(end - begin), MPI_INT,
+                          0, indexTag, comm, &indexRequests.emplace_back());
+            }
+
+            Chunk chunk;
+            for (std::size_t begin = 0; begin < numCells; begin += chunkCells)
+            {
+                const auto end = std::min(begin + chunkCells, numCells);
+                chunk.receive(end - begin, m_no_data, comm);
+                unpackChunk_(chunk, begin, end);
+            }
+            MPI_Waitall(static_cast<int>(indexRequests.size()), indexRequests.data(),
+                        MPI_STATUSES_IGNORE);
+        }
     }
 
-    bool contains(int /* dim */, int codim)
+    bool contains(int /* dim */, int /* codim */)
     {
-        return codim == 0;
+        // nothing is migrated together with the cells, see scatterProps()
+        return false;
     }
 
     bool fixedsize(int /* dim */, int /* codim */)
@@ -177,31 +268,16 @@ public:
     template<class EntityType>
     std::size_t size(const EntityType /* entity */)
     {
-        return m_no_data;
+        return 0;
     }
 
     template<class BufferType, class EntityType>
-    void gather(BufferType& buffer, const EntityType& e) const
-    {
-        auto iter = elementData_.find(m_grid.localIdSet().id(e));
-        assert(iter != elementData_.end());
-        for (const auto& data : iter->second)
-        {
-            buffer.write(data);
-        }
-    }
+    void gather(BufferType& /* buffer */, const EntityType& /* e */) const
+    {}
 
     template<class BufferType, class EntityType>
-    void scatter(BufferType& buffer, const EntityType& e, std::size_t n)
-    {
-        assert(n == m_no_data);
-        auto& array = elementData_[m_grid.localIdSet().id(e)];
-        array.resize(n);
-        for (auto& data : array)
-        {
-            buffer.read(data);
-        }
-    }
+    void scatter(BufferType& /* buffer */, const EntityType& /* e */, std::size_t /* n */)
+    {}
 
     template<class Serializer>
     void serializeOp(Serializer& serializer)
@@ -212,20 +288,106 @@ public:
     }
 
 private:
-    using LocalIdSet = typename Grid::LocalIdSet;
+    static constexpr int sizeTag = 2891;
+    static constexpr int indexTag = 2892;
+    static constexpr int valueTag = 2893;
+    static constexpr int statusTag = 2894;
+
+    /// \brief The values and value status of a range of cells, stored by
+    ///        key and then by cell.
+    struct Chunk
+    {
+        std::vector<double> values;
+        std::vector<unsigned char> status;
+        std::array<MPI_Request, 2> requests{MPI_REQUEST_NULL, MPI_REQUEST_NULL};
+
+        void send(int rank, MPI_Comm comm)
+        {
+            MPI_Isend(values.data(), static_cast<int>(values.size()), MPI_DOUBLE,
+                      rank, valueTag, comm, &requests[0]);
+            MPI_Isend(status.data(), static_cast<int>(status.size()), MPI_UNSIGNED_CHAR,
+                      rank, statusTag, comm, &requests[1]);
+        }
+
+        void receive(std::size_t numCells, std::size_t numKeys, MPI_Comm comm)
+        {
+            values.resize(numCells * numKeys);
+            status.resize(numCells * numKeys);
+            MPI_Recv(values.data(), static_cast<int>(values.size()), MPI_DOUBLE,
+                     0, valueTag, comm, MPI_STATUS_IGNORE);
+            MPI_Recv(status.data(), static_cast<int>(status.size()), MPI_UNSIGNED_CHAR,
+                     0, statusTag, comm, MPI_STATUS_IGNORE);
+        }
+
+        void wait()
+        {
+            MPI_Waitall(static_cast<int>(requests.size()), requests.data(), MPI_STATUSES_IGNORE);
+        }
+    };
+
+    void packChunk_(Chunk& chunk,
+                    const std::vector<const Fieldprops::FieldData<int>*>& intData,
+                    const std::vector<const Fieldprops::FieldData<double>*>& doubleData,
+                    const std::vector<int>& globalIndex,
+                    std::size_t begin, std::size_t end) const
+    {
+        chunk.values.clear();
+        chunk.status.clear();
+        for (const auto* fieldData : intData)
+        {
+            for (auto cell = begin; cell < end; ++cell)
+            {
+                chunk.values.push_back(fieldData->data[globalIndex[cell]]);
+                chunk.status.push_back(static_cast<unsigned char>(fieldData->value_status[globalIndex[cell]]));
+            }
+        }
+        for (const auto* fieldData : doubleData)
+        {
+            for (auto cell = begin; cell < end; ++cell)
+            {
+                chunk.values.push_back(fieldData->data[globalIndex[cell]]);
+                chunk.status.push_back(static_cast<unsigned char>(fieldData->value_status[globalIndex[cell]]));
+            }
+        }
+    }
+
+    void unpackChunk_(const Chunk& chunk, std::size_t begin, std::size_t end)
+    {
+        std::size_t counter{};
+        for (const auto& intKey : m_intKeys)
+        {
+            auto& fieldData = m_distributed_fieldProps.m_intProps[intKey];
+            for (auto cell = begin; cell < end; ++cell, ++counter)
+            {
+                fieldData.data[cell] = static_cast<int>(chunk.values[counter]);
+                fieldData.value_status[cell] = static_cast<value::status>(chunk.status[counter]);
+            }
+        }
+
+        for (const auto& doubleKey : m_doubleKeys)
+        {
+            auto& fieldData = m_distributed_fieldProps.m_doubleProps[doubleKey];
+            for (auto cell = begin; cell < end; ++cell, ++counter)
+            {
+                fieldData.data[cell] = chunk.values[counter];
+                fieldData.value_status[cell] = static_cast<value::status>(chunk.status[counter]);
+            }
+        }
+    }
+
     const Grid& m_grid;
+    //! \brief The eclipse state holding the global field properties on the root process.
+    ParallelEclipseState& m_eclState;
     //! \brief The distributed field properties for receiving
     ParallelFieldPropsManager& m_distributed_fieldProps;
     //! \brief The names of the keys of the integer fields.
     std::vector<std::string> m_intKeys;
     //! \brief The names of the keys of the double fields.
     std::vector<std::string> m_doubleKeys;
-    /// \brief The data per element as a vector mapped from the local id.
-    ///
-    /// each entry is a pair of data and value_status.
-    std::unordered_map<typename LocalIdSet::IdType, std::vector<std::pair<double,unsigned char> > > elementData_;
     /// \brief The amount of data to send for each element
     std::size_t m_no_data;
+    //! \brief Upper bound of the size of the messages sent by scatterProps().
+    std::size_t m_chunkBytes;
 };
 
 } // end namespace Opm
@@ -0,0 +1,167 @@
+/*
+  This file is part of the Open Porous Media Project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <opm/simulators/utils/readCellWeights.hpp>
+
+#include <cmath>
+#include <cstddef>
+#include <istream>
+#include <limits>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <fmt/format.h>
+
+namespace {
+
+    std::invalid_argument
+    weightError(const std::string& name, const std::string& msg)
+    {
+        return std::invalid_argument {
+            fmt::format("Cell weight file '{}': {}", name, msg)
+        };
+    }
+
+    // Values on each non-empty line of the input, with the line number.
+    struct WeightLine
+    {
+        std::size_t lineNo{};
+        std::vector<double> values{};
+    };
+
+    std::vector<WeightLine>
+    readLines(std::istream& is, const std::string& name)
+    {
+        auto lines = std::vector<WeightLine>{};
+
+        auto line = std::string{};
+        auto lineNo = std::size_t{0};
+        while (std::getline(is, line)) {
+            ++lineNo;
+
+            auto values = std::vector<double>{};
+            auto ls = std::istringstream { line };
+            auto value = 0.0;
+            while (ls >> value) {
+                values.push_back(value);
+            }
+            if (! ls.eof()) {
+                throw weightError(name, fmt::format("line {} is not a list "
+                                                    "of numbers", lineNo));
+            }
+
+            if (! values.empty()) {
+                lines.push_back({ lineNo, std::move(values) });
+            }
+        }
+
+        return lines;
+    }
+
+} // Anonymous namespace
+
+std::vector<float>
+Opm::util::readCellWeights(std::istream&           is,
+                           const std::string&      name,
+                           const std::vector<int>& globalCell)
+{
+    const auto nc = globalCell.size();
+    const auto lines = readLines(is, name);
+    if (lines.empty()) {
+        throw weightError(name, "no weights given");
+    }
+
+    const auto numColumns = lines.front().values.size();
+    if ((numColumns != 1) && (numColumns != 2)) {
+        throw weightError(name, fmt::format("line {} has {} values, expected "
+                                            "a weight or a Cartesian index and "
+                                            "a weight", lines.front().lineNo,
+                                            numColumns));
+    }
+    for (const auto& line : lines) {
+        if (line.values.size() != numColumns) {
+            throw weightError(name, fmt::format("line {} has {} values, but "
+                                                "line {} has {}", line.lineNo,
+                                                line.values.size(),
+                                                lines.front().lineNo,
+                                                numColumns));
+        }
+    }
+
+    auto weights = std::vector<float>(nc, 0.0f);
+    if (numColumns == 1) {
+        // One weight for each active cell
+        if (lines.size() != nc) {
+            throw weightError(name, fmt::format("{} weights do not match "
+                                                "the {} active cells",
+                                                lines.size(), nc));
+        }
+        for (auto c = 0*nc; c < nc; ++c) {
+            weights[c] = static_cast<float>(lines[c].values[0]);
+        }
+    }
+    else {
+        // Pairs of Cartesian index and weight, one for each active cell
+        auto g2l = std::unordered_map<int, std::size_t>{};
+        for (auto c = 0*nc; c < nc; ++c) {
+            g2l.insert_or_assign(globalCell[c], c);
+        }
+
+        auto seen = std::vector<bool>(nc, false);
+        for (const auto& line : lines) {
+            const auto index = line.values[0];
+            const auto isIndex = (std::floor(index) == index) && (index >= 0.0) &&
+                (index <= std::numeric_limits<int>::max());
+            const auto pos = isIndex
+                ? g2l.find(static_cast<int>(index)) : g2l.end();
+            if (pos == g2l.end()) {
+                throw weightError(name, fmt::format("line {}: {} is not the "
+                                                    "Cartesian index of an "
+                                                    "active cell",
+                                                    line.lineNo, index));
+            }
+            if (seen[pos->second]) {
+                throw weightError(name, fmt::format("line {}: cell {} is given "
+                                                    "more than once",
+                                                    line.lineNo, pos->first));
+            }
+            seen[pos->second] = true;
+            weights[pos->second] = static_cast<float>(line.values[1]);
+        }
+
+        if (lines.size() != nc) {
+            auto c = 0*nc;
+            while (seen[c]) { ++c; }
+            throw weightError(name, fmt::format("{} of the {} active cells have "
+                                                "no weight, e.g., cell {}",
+                                                nc - lines.size(), nc,
+                                                globalCell[c]));
+        }
+    }
+
+    for (auto c = 0*nc; c < nc; ++c) {
+        if (! (std::isfinite(weights[c]) && (weights[c] >= 0.0f))) {
+            throw weightError(name, fmt::format("cell {} has the invalid weight {}",
+                                                globalCell[c], weights[c]));
+        }
+    }
+
+    return weights;
+}
@@ -0,0 +1,58 @@
+/*
+  This file is part of the Open Porous Media Project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef OPM_UTIL_READ_CELL_WEIGHTS_HPP_INCLUDED
+#define OPM_UTIL_READ_CELL_WEIGHTS_HPP_INCLUDED
+
+#include <iosfwd>
+#include <string>
+#include <vector>
+
+namespace Opm { namespace util {
+
+    /// Read the load balancing weight of each active cell.
+    ///
+    /// The input has one of two layouts, told apart by the number of
+    /// values on each non-empty line:
+    ///
+    ///   - one weight per line, one line for each active cell in the
+    ///     order of \p globalCell,
+    ///   - a Cartesian cell index and a weight per line, exactly one line
+    ///     for each active cell in any order.  This is the layout written
+    ///     by the LoadBalanceMonitor.
+    ///
+    /// \param[in,out] is Stream to read the weights from.
+    ///
+    /// \param[in] name Name of the input, used in error messages.
+    ///
+    /// \param[in] globalCell Cartesian index of each active cell.
+    ///
+    /// \return Weight of each active cell.
+    ///
+    /// Throws std::invalid_argument if the lines mix the layouts, if the
+    /// number of weights does not match the number of active cells, if a
+    /// Cartesian index is not an active cell or is given more than once,
+    /// if an active cell has no weight, or if a weight is negative or not
+    /// finite.
+    std::vector<float>
+    readCellWeights(std::istream&           is,
+                    const std::string&      name,
+                    const std::vector<int>& globalCell);
+
+}} // namespace Opm::util
+
+#endif // OPM_UTIL_READ_CELL_WEIGHTS_HPP_INCLUDED
@@ -251,6 +251,7 @@ template<class Scalar> class WellContributions;
             // Check if well equations are converged locally.
             ConvergenceReport getDomainWellConvergence(const Domain& domain,
                                                        const std::vector<Scalar>& B_avg,
+                                                       const int iterationIdx,
                                                        DeferredLogger& local_deferredLogger) const;
 
             const SimulatorReportSingle& lastReport() const;
@@ -309,11 +310,17 @@ template<class Scalar> class WellContributions;
             }
 
             // prototype for assemble function for ASPIN solveLocal()
-            // will try to merge back to assemble() when done prototyping
-            void assembleDomain(const int iterationIdx,
-                                const double dt,
-                                const Domain& domain);
-            void updateWellControlsDomain(DeferredLogger& deferred_logger, const Domain& domain);
+            // will try to merge back to assemble() when done prototyping.
+            // Only touches the wells of the domain, so that different domains
+            // may be assembled concurrently. The wells see iterationIdx, the
+            // iteration of the domain solve, as their Newton iteration.
+            SimulatorReportSingle assembleDomain(const int iterationIdx,
+                                                 const double dt,
+                                                 const Domain& domain,
+                                                 DeferredLogger& deferred_logger);
+            void updateWellControlsDomain(DeferredLogger& deferred_logger,
+                                          const Domain& domain,
+                                          const int iterationIdx);
 
             void setupDomains(const std::vector<Domain>& domains);
 
@@ -339,7 +346,8 @@ template<class Scalar> class WellContributions;
             // using the solution x to recover the solution xw for wells and applying
             // xw to update Well State
             void recoverWellSolutionAndUpdateWellStateDomain(const BVector& x,
-                                                             const Domain& domain);
+                                                             const Domain& domain,
+                                                             DeferredLogger& deferred_logger);
 
         protected:
             Simulator& simulator_;
@@ -349,6 +357,9 @@ template<class Scalar> class WellContributions;
 
             std::vector<bool> is_cell_perforated_{};
 
+            // The indices in well_container_ of the wells perforating each cell.
+            SparseTable<int> cell_wells_{};
+
             void initializeWellState(const int timeStepIdx);
 
             // create the well container
@@ -464,13 +475,41 @@ template<class Scalar> class WellContributions;
             int reportStepIndex() const;
 
             void assembleWellEq(const double dt, DeferredLogger& deferred_logger);
-            void assembleWellEqDomain(const double dt, const Domain& domain, DeferredLogger& deferred_logger);
+            void assembleWellEqDomain(const double dt,
+                                      const Domain& domain,
+                                      const int iterationIdx,
+                                      DeferredLogger& deferred_logger);
 
             void prepareWellsBeforeAssembling(const double dt, DeferredLogger& deferred_logger);
 
             // TODO: finding a better naming
             void assembleWellEqWithoutIteration(const double dt, DeferredLogger& deferred_logger);
 
+            // Whether a well only reads and writes its own part of the well state
+            // when solving its equations, so that it can be processed concurrently
+            // with other wells. This excludes wells that are distributed across
+            // processes, as they communicate. Wells that may be under group control
+            // are excluded unless controls_fixed is true, i.e. unless no well
+            // switches its control, as their targets depend on the control modes
+            // of the other wells of their groups.
+            bool isIndependentWell(const WellInterface<TypeTag>& well,
+                                   bool controls_fixed) const;
+
+            // Call func(well, deferred_logger) for all wells. The other wells are
+            // processed in the order of the well container, and each consecutive
+            // run of independent wells between them is processed concurrently,
+            // each well with its own logger. This gives the same result as
+            // processing all wells in order. The messages of the loggers are
+            // collected in the order of the well container, and the first
+            // exception thrown is rethrown. controls_fixed tells whether func
+            // keeps the controls of the wells unchanged, see isIndependentWell().
+            template <class Func>
+            void forEachWell(Func&& func, DeferredLogger& deferred_logger,
+                             bool controls_fixed = false);
+
+            // Update the wells perforating each cell.
+            void updateCellWells();
+
             void extractLegacyCellPvtRegionIndex_();
 
             void extractLegacyDepth_();
@@ -500,7 +539,10 @@ template<class Scalar> class WellContributions;
             // instead of using local variables.
             // Their state is not relevant between function calls, so they can
             // (and must) be mutable, as the functions using them are const.
-            mutable BVector x_local_;
+            // There is one buffer per thread, sized on construction for the
+            // number of threads of the thread manager, which forEachWell()
+            // does not exceed.
+            mutable std::vector<BVector> x_local_;
         };
 
 
@@ -40,6 +40,8 @@
 
 #include <opm/input/eclipse/Units/UnitSystem.hpp>
 
+#include <opm/models/parallel/threadmanager.hpp>
+
 #include <opm/simulators/wells/BlackoilWellModelConstraints.hpp>
 #include <opm/simulators/wells/ParallelPAvgDynamicSourceData.hpp>
 #include <opm/simulators/wells/ParallelWBPCalculation.hpp>
@@ -59,6 +61,7 @@
 
 #include <algorithm>
 #include <cassert>
+#include <exception>
 #include <iomanip>
 #include <utility>
 #include <optional>
@@ -77,6 +80,7 @@ namespace Opm {
                                             simulator.gridView().comm())
         , simulator_(simulator)
         , gaslift_(this->terminal_output_, this->phase_usage_)
+        , x_local_(ThreadManager::maxThreads())
     {
         local_num_cells_ = simulator_.gridView().size(0);
 
@@ -397,6 +401,7 @@ namespace Opm {
             for (auto& well : well_container_) {
                 well->updatePerforatedCell(is_cell_perforated_);
             }
+            this->updateCellWells();
 
             // calculate the efficiency factors for each well
             this->calculateEfficiencyFactors(reportStepIdx);
@@ -704,8 +709,8 @@ namespace Opm {
             return;
         }
 
-        for (const auto& well : well_container_)
-            well->addCellRates(rate, elemIdx);
+        for (const int wellIdx : cell_wells_[elemIdx])
+            well_container_[wellIdx]->addCellRates(rate, elemIdx);
     }
 
 
@@ -725,8 +730,8 @@ namespace Opm {
             return;
         }
 
-        for (const auto& well : well_container_)
-            well->addCellRates(rate, elemIdx);
+        for (const int wellIdx : cell_wells_[elemIdx])
+            well_container_[wellIdx]->addCellRates(rate, elemIdx);
     }
 
 
@@ -1450,13 +1455,14 @@ namespace Opm {
     }
 
     template<typename TypeTag>
-    void
+    SimulatorReportSingle
     BlackoilWellModel<TypeTag>::
-    assembleDomain([[maybe_unused]] const int iterationIdx,
+    assembleDomain(const int iterationIdx,
                    const double dt,
-                   const Domain& domain)
+                   const Domain& domain,
+                   DeferredLogger& deferred_logger)
     {
-        last_report_ = SimulatorReportSingle();
+        SimulatorReportSingle report;
         Dune::Timer perfTimer;
         perfTimer.start();
 
@@ -1464,7 +1470,7 @@ namespace Opm {
             const int episodeIdx = simulator_.episodeIndex();
             const auto& network = this->schedule()[episodeIdx].network();
             if (!this->wellsActive() && !network.active()) {
-                return;
+                return report;
             }
         }
 
@@ -1473,19 +1479,14 @@ namespace Opm {
         // well model, so we do not need to do it here (when
         // iterationIdx is 0).
 
-        DeferredLogger local_deferredLogger;
-        updateWellControlsDomain(local_deferredLogger, domain);
-        initPrimaryVariablesEvaluationDomain(domain);
-        assembleWellEqDomain(dt, domain, local_deferredLogger);
-
         // TODO: errors here must be caught higher up, as this method is not called in parallel.
-        // We will log errors on rank 0, but not other ranks for now.
-        if (this->terminal_output_) {
-            local_deferredLogger.logMessages();
-        }
+        updateWellControlsDomain(deferred_logger, domain, iterationIdx);
+        initPrimaryVariablesEvaluationDomain(domain);
+        assembleWellEqDomain(dt, domain, iterationIdx, deferred_logger);
 
-        last_report_.converged = true;
-        last_report_.assemble_time_well += perfTimer.stop();
+        report.converged = true;
+        report.assemble_time_well += perfTimer.stop();
+        return report;
     }
 
 
@@ -1494,20 +1495,25 @@ namespace Opm {
     BlackoilWellModel<TypeTag>::
     assembleWellEq(const double dt, DeferredLogger& deferred_logger)
     {
-        for (auto& well : well_container_) {
-            well->assembleWellEq(simulator_, dt, this->wellState(), this->groupState(), deferred_logger);
-        }
+        const int iterationIdx = simulator_.model().newtonMethod().numIterations();
+        forEachWell([this, dt, iterationIdx](auto& well, DeferredLogger& logger)
+                    {
+                        well.assembleWellEq(simulator_, dt, iterationIdx, this->wellState(), this->groupState(), logger);
+                    }, deferred_logger);
     }
 
 
     template<typename TypeTag>
     void
     BlackoilWellModel<TypeTag>::
-    assembleWellEqDomain(const double dt, const Domain& domain, DeferredLogger& deferred_logger)
+    assembleWellEqDomain(const double dt,
+                         const Domain& domain,
+                         const int iterationIdx,
+                         DeferredLogger& deferred_logger)
     {
         for (auto& well : well_container_) {
             if (this->well_domain_.at(well->name()) == domain.index) {
-                well->assembleWellEq(simulator_, dt, this->wellState(), this->groupState(), deferred_logger);
+                well->assembleWellEq(simulator_, dt, iterationIdx, this->wellState(), this->groupState(), deferred_logger);
             }
         }
     }
@@ -1518,9 +1524,11 @@ namespace Opm {
     BlackoilWellModel<TypeTag>::
     prepareWellsBeforeAssembling(const double dt, DeferredLogger& deferred_logger)
     {
-        for (auto& well : well_container_) {
-            well->prepareWellBeforeAssembling(simulator_, dt, this->wellState(), this->groupState(), deferred_logger);
-        }
+        const int iterationIdx = simulator_.model().newtonMethod().numIterations();
+        forEachWell([this, dt, iterationIdx](auto& well, DeferredLogger& logger)
+                    {
+                        well.prepareWellBeforeAssembling(simulator_, dt, iterationIdx, this->wellState(), this->groupState(), logger);
+                    }, deferred_logger);
     }
 
 
@@ -1533,10 +1541,12 @@ namespace Opm {
         // on one of them (WetGasPvt::saturationPressure might throw if not converged)
         OPM_BEGIN_PARALLEL_TRY_CATCH();
 
-        for (auto& well: well_container_) {
-            well->assembleWellEqWithoutIteration(simulator_, dt, this->wellState(), this->groupState(),
-                                                 deferred_logger);
-        }
+        // The wells keep their controls, so the group targets do not change.
+        forEachWell([this, dt](auto& well, DeferredLogger& logger)
+                    {
+                        well.assembleWellEqWithoutIteration(simulator_, dt, this->wellState(),
+                                                            this->groupState(), logger);
+                    }, deferred_logger, /*controls_fixed=*/true);
         OPM_END_PARALLEL_TRY_CATCH_LOG(deferred_logger, "BlackoilWellModel::assembleWellEqWithoutIteration failed: ",
                                        this->terminal_output_, grid().comm());
 
@@ -1690,6 +1700,104 @@ namespace Opm {
     }
 
 
+    template<typename TypeTag>
+    bool
+    BlackoilWellModel<TypeTag>::
+    isIndependentWell(const WellInterface<TypeTag>& well,
+                      const bool controls_fixed) const
+    {
+        // A well under group control reads the control modes of the other
+        // wells of its groups through the guide rate fractions. These only
+        // change if the wells may switch controls.
+        return well.parallelWellInfo().communication().size() == 1
+            && (controls_fixed || !well.wellEcl().isAvailableForGroupControl())
+            && !well.hasNegativePotentials();
+    }
+
+
+    template<typename TypeTag>
+    template<class Func>
+    void
+    BlackoilWellModel<TypeTag>::
+    forEachWell(Func&& func, DeferredLogger& deferred_logger, const bool controls_fixed)
+    {
+        std::vector<WellInterface<TypeTag>*> independent_wells;
+        std::vector<DeferredLogger> loggers;
+        std::vector<std::exception_ptr> exceptions;
+        // The per-thread buffers are sized for the number of threads fixed by
+        // the thread manager before the well model is created, so do not let
+        // the loop use more threads than that.
+        [[maybe_unused]] const int num_threads = ThreadManager::maxThreads();
+
+        // The independent wells do not read any part of the well state that
+        // is written by the other wells, so the result does not depend on the
+        // order in which they are processed.
+        auto processIndependentWells = [&]()
+        {
+            loggers.assign(independent_wells.size(), DeferredLogger{});
+            exceptions.assign(independent_wells.size(), nullptr);
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic) num_threads(num_threads)
+#endif
+            for (std::size_t i = 0; i < independent_wells.size(); ++i) {
+                try {
+                    func(*independent_wells[i], loggers[i]);
+                } catch (...) {
+                    exceptions[i] = std::current_exception();
+                }
+            }
+            for (auto& logger : loggers) {
+                deferred_logger.append(logger);
+            }
+            for (const auto& exception : exceptions) {
+                if (exception) {
+                    std::rethrow_exception(exception);
+                }
+            }
+            independent_wells.clear();
+        };
+
+        // The other wells may read the state written by any well, so they
+        // are processed at their position in the well container, after the
+        // independent wells in front of them.
+        for (auto& well : well_container_) {
+            if (isIndependentWell(*well, controls_fixed)) {
+                independent_wells.push_back(well.get());
+            } else {
+                processIndependentWells();
+                func(*well, deferred_logger);
+            }
+        }
+        processIndependentWells();
+    }
+
+
+    template<typename TypeTag>
+    void
+    BlackoilWellModel<TypeTag>::
+    updateCellWells()
+    {
+        std::vector<std::pair<int, int>> cell_well;
+        for (std::size_t w = 0; w < well_container_.size(); ++w) {
+            for (const int cell : well_container_[w]->cells()) {
+                cell_well.emplace_back(cell, static_cast<int>(w));
+            }
+        }
+        std::sort(cell_well.begin(), cell_well.end());
+        cell_well.erase(std::unique(cell_well.begin(), cell_well.end()), cell_well.end());
+
+        std::vector<int> row_sizes(local_num_cells_, 0);
+        std::vector<int> wells;
+        wells.reserve(cell_well.size());
+        for (const auto& [cell, w] : cell_well) {
+            ++row_sizes[cell];
+            wells.push_back(w);
+        }
+        cell_wells_ = SparseTable<int>(wells.begin(), wells.end(),
+                                       row_sizes.begin(), row_sizes.end());
+    }
+
+
     template<typename TypeTag>
     void
     BlackoilWellModel<TypeTag>::
@@ -1698,16 +1806,19 @@ namespace Opm {
         DeferredLogger local_deferredLogger;
         OPM_BEGIN_PARALLEL_TRY_CATCH();
         {
-            for (const auto& well : well_container_) {
-                const auto& cells = well->cells();
-                x_local_.resize(cells.size());
-
-                for (size_t i = 0; i < cells.size(); ++i) {
-                    x_local_[i] = x[cells[i]];
-                }
-                well->recoverWellSolutionAndUpdateWellState(simulator_, x_local_,
-                                                            this->wellState(), local_deferredLogger);
-            }
+            // Updating the well state does not switch any controls.
+            forEachWell([this, &x](auto& well, DeferredLogger& logger)
+                        {
+                            const auto& cells = well.cells();
+                            auto& x_local = x_local_[ThreadManager::threadId()];
+                            x_local.resize(cells.size());
+
+                            for (size_t i = 0; i < cells.size(); ++i) {
+                                x_local[i] = x[cells[i]];
+                            }
+                            well.recoverWellSolutionAndUpdateWellState(simulator_, x_local,
+                                                                       this->wellState(), logger);
+                        }, local_deferredLogger, /*controls_fixed=*/true);
         }
         OPM_END_PARALLEL_TRY_CATCH_LOG(local_deferredLogger,
                                        "recoverWellSolutionAndUpdateWellState() failed: ",
@@ -1718,30 +1829,29 @@ namespace Opm {
     template<typename TypeTag>
     void
     BlackoilWellModel<TypeTag>::
-    recoverWellSolutionAndUpdateWellStateDomain(const BVector& x, const Domain& domain)
+    recoverWellSolutionAndUpdateWellStateDomain(const BVector& x,
+                                                const Domain& domain,
+                                                DeferredLogger& deferred_logger)
     {
         // Note: no point in trying to do a parallel gathering
         // try/catch here, as this function is not called in
         // parallel but for each individual domain of each rank.
-        DeferredLogger local_deferredLogger;
+        // Domains may be solved concurrently, so use a local
+        // buffer instead of x_local_.
+        BVector x_local;
         for (auto& well : well_container_) {
             if (this->well_domain_.at(well->name()) == domain.index) {
                 const auto& cells = well->cells();
-                x_local_.resize(cells.size());
+                x_local.resize(cells.size());
 
                 for (size_t i = 0; i < cells.size(); ++i) {
-                    x_local_[i] = x[cells[i]];
+                    x_local[i] = x[cells[i]];
                 }
-                well->recoverWellSolutionAndUpdateWellState(simulator_, x_local_,
+                well->recoverWellSolutionAndUpdateWellState(simulator_, x_local,
                                                             this->wellState(),
-                                                            local_deferredLogger);
+                                                            deferred_logger);
             }
         }
-        // TODO: avoid losing the logging information that could
-        // be stored in the local_deferredlogger in a parallel case.
-        if (this->terminal_output_) {
-            local_deferredLogger.logMessages();
-        }
     }
 
 
@@ -1778,9 +1888,9 @@ namespace Opm {
     BlackoilWellModel<TypeTag>::
     getDomainWellConvergence(const Domain& domain,
                              const std::vector<Scalar>& B_avg,
+                             const int iterationIdx,
                              DeferredLogger& local_deferredLogger) const
     {
-        const int iterationIdx = simulator_.model().newtonMethod().numIterations();
         const bool relax_tolerance = iterationIdx > param_.strict_outer_iter_wells_;
 
         ConvergenceReport report;
@@ -1935,13 +2045,14 @@ namespace Opm {
             // For MS Wells a linear solve is performed below and the matrix might be singular.
             // We need to communicate the exception thrown to the others and rethrow.
             OPM_BEGIN_PARALLEL_TRY_CATCH()
-                for (const auto& well : well_container_) {
-                    const auto mode = WellInterface<TypeTag>::IndividualOrGroup::Group;
-                    const bool changed_well = well->updateWellControl(simulator_, mode, this->wellState(), this->groupState(), deferred_logger);
-                    if (changed_well) {
-                        changed_well_to_group = changed_well || changed_well_to_group;
-                    }
-                }
+                std::vector<char> changed(this->wellState().size(), 0);
+                forEachWell([this, &changed, iterationIdx](auto& well, DeferredLogger& logger)
+                            {
+                                const auto mode = WellInterface<TypeTag>::IndividualOrGroup::Group;
+                                changed[well.indexOfWell()] = well.updateWellControl(simulator_, mode, iterationIdx, this->wellState(), this->groupState(), logger);
+                            }, deferred_logger);
+                changed_well_to_group = std::any_of(changed.begin(), changed.end(),
+                                    [](const char c) { return c != 0; });
             OPM_END_PARALLEL_TRY_CATCH("BlackoilWellModel: updating well controls failed: ",
                                        simulator_.gridView().comm());
         }
@@ -1958,13 +2069,14 @@ namespace Opm {
             // For MS Wells a linear solve is performed below and the matrix might be singular.
             // We need to communicate the exception thrown to the others and rethrow.
             OPM_BEGIN_PARALLEL_TRY_CATCH()
-                for (const auto& well : well_container_) {
-                    const auto mode = WellInterface<TypeTag>::IndividualOrGroup::Individual;
-                    const bool changed_well = well->updateWellControl(simulator_, mode, this->wellState(), this->groupState(), deferred_logger);
-                    if (changed_well) {
-                        changed_well_individual = changed_well || changed_well_individual;
-                    }
-                }
+                std::vector<char> changed(this->wellState().size(), 0);
+                forEachWell([this, &changed, iterationIdx](auto& well, DeferredLogger& logger)
+                            {
+                                const auto mode = WellInterface<TypeTag>::IndividualOrGroup::Individual;
+                                changed[well.indexOfWell()] = well.updateWellControl(simulator_, mode, iterationIdx, this->wellState(), this->groupState(), logger);
+                            }, deferred_logger);
+                changed_well_individual = std::any_of(changed.begin(), changed.end(),
+                                    [](const char c) { return c != 0; });
             OPM_END_PARALLEL_TRY_CATCH("BlackoilWellModel: updating well controls failed: ",
                                        simulator_.gridView().comm());
         }
@@ -1984,7 +2096,9 @@ namespace Opm {
     template<typename TypeTag>
     void
     BlackoilWellModel<TypeTag>::
-    updateWellControlsDomain(DeferredLogger& deferred_logger, const Domain& domain)
+    updateWellControlsDomain(DeferredLogger& deferred_logger,
+                             const Domain& domain,
+                             const int iterationIdx)
     {
         if ( !this->wellsActive() ) return ;
 
@@ -1995,7 +2109,7 @@ namespace Opm {
         for (const auto& well : well_container_) {
             if (this->well_domain_.at(well->name()) == domain.index) {
                 const auto mode = WellInterface<TypeTag>::IndividualOrGroup::Individual;
-                well->updateWellControl(simulator_, mode, this->wellState(), this->groupState(), deferred_logger);
+                well->updateWellControl(simulator_, mode, iterationIdx, this->wellState(), this->groupState(), deferred_logger);
             }
         }
     }
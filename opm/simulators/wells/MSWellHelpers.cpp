@@ -144,10 +144,23 @@ VectorType
 applyUMFPack(Dune::UMFPack<MatrixType>& linsolver,
              VectorType x)
 {
-#if HAVE_UMFPACK
     // The copy of x seems mandatory for calling UMFPack!
     VectorType y(x.size());
-    y = 0.;
+    applyUMFPack(linsolver, x, y);
+    return y;
+}
+
+template <typename MatrixType, typename VectorType>
+void
+applyUMFPack(Dune::UMFPack<MatrixType>& linsolver,
+             VectorType& rhs,
+             VectorType& x)
+{
+#if HAVE_UMFPACK
+    if (x.size() != rhs.size()) {
+        x.resize(rhs.size());
+    }
+    x = 0.;
 
     // Object storing some statistics about the solving process
     Dune::InverseOperatorResult res;
@@ -155,13 +168,13 @@ applyUMFPack(Dune::UMFPack<MatrixType>& linsolver,
         OPM_THROW(std::runtime_error, "Cannot use applyUMFPack() with floats.");
     } else {
         // Solve
-        linsolver.apply(y, x, res);
+        linsolver.apply(x, rhs, res);
 
-        // Checking if there is any inf or nan in y
+        // Checking if there is any inf or nan in x
         // it will be the solution before we find a way to catch the singularity of the matrix
-        for (std::size_t i_block = 0; i_block < y.size(); ++i_block) {
-            for (std::size_t i_elem = 0; i_elem < y[i_block].size(); ++i_elem) {
-                if (std::isinf(y[i_block][i_elem]) || std::isnan(y[i_block][i_elem]) ) {
+        for (std::size_t i_block = 0; i_block < x.size(); ++i_block) {
+            for (std::size_t i_elem = 0; i_elem < x[i_block].size(); ++i_elem) {
+                if (std::isinf(x[i_block][i_elem]) || std::isnan(x[i_block][i_elem]) ) {
                     const std::string msg{"nan or inf value found after UMFPack solve due to singular matrix"};
                     OpmLog::debug(msg);
                     OPM_THROW_NOLOG(NumericalProblem, msg);
@@ -169,7 +182,6 @@ applyUMFPack(Dune::UMFPack<MatrixType>& linsolver,
             }
         }
     }
-    return y;
 #else
     // this is not thread safe
     OPM_THROW(std::runtime_error, "Cannot use applyUMFPack() without UMFPACK. "
@@ -371,6 +383,8 @@ using Mat = Dune::BCRSMatrix<Dune::FieldMatrix<Scalar,M,N>>;
 #define INSTANTIATE_UMF(T,Dim)                                             \
     template Vec<T,Dim> applyUMFPack(Dune::UMFPack<Mat<T,Dim>>&,           \
                                      Vec<T,Dim>);                          \
+    template void applyUMFPack(Dune::UMFPack<Mat<T,Dim>>&,                 \
+                               Vec<T,Dim>&, Vec<T,Dim>&);                  \
     template Dune::Matrix<typename Mat<T,Dim>::block_type>                 \
     invertWithUMFPack<Vec<T,Dim>,Mat<T,Dim>>(const int, const int,         \
                                              Dune::UMFPack<Mat<T,Dim>>&);
@@ -76,6 +76,14 @@ namespace mswellhelpers
     applyUMFPack(Dune::UMFPack<MatrixType>& linsolver,
                  VectorType x);
 
+    /// Applies umfpack and checks for singularity, without allocating.
+    /// The solution is stored in x, rhs is overwritten.
+    template <typename MatrixType, typename VectorType>
+    void
+    applyUMFPack(Dune::UMFPack<MatrixType>& linsolver,
+                 VectorType& rhs,
+                 VectorType& x);
+
 
 
     /// Applies umfpack and checks for singularity
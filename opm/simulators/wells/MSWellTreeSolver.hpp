@@ -0,0 +1,228 @@
+/*
+  Copyright 2025 Equinor ASA.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef OPM_MSWELL_TREE_SOLVER_HEADER_INCLUDED
+#define OPM_MSWELL_TREE_SOLVER_HEADER_INCLUDED
+
+#include <opm/common/ErrorMacros.hpp>
+#include <opm/common/Exceptions.hpp>
+
+#include <dune/common/fmatrix.hh>
+#include <dune/istl/bcrsmatrix.hh>
+#include <dune/istl/bvector.hh>
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <vector>
+
+namespace Opm::mswellhelpers {
+
+/// \brief Direct solver for block matrices whose graph is a forest.
+///
+/// The segment matrix of a multisegment well couples each segment to its
+/// outlet and its inlets only, so its graph is a tree. Eliminating the
+/// segments from the leaves towards the top segment causes no fill-in:
+/// eliminating a segment only updates the diagonal block of its outlet.
+/// Both the factorization and a solve therefore take time proportional to
+/// the number of segments.
+///
+/// analyse() checks the sparsity pattern and finds the elimination order,
+/// factorize() computes the factors from the matrix values, and solve()
+/// applies the inverse. Matrices whose graph is not a forest, or whose
+/// pattern is not symmetric, are rejected by analyse(), and must be
+/// solved by other means.
+template <class Scalar, int n>
+class TreeBlockSolver
+{
+public:
+    using Block = Dune::FieldMatrix<Scalar, n, n>;
+    using Matrix = Dune::BCRSMatrix<Block>;
+    using Vector = Dune::BlockVector<Dune::FieldVector<Scalar, n>>;
+
+    /// \brief Find the elimination order of a matrix.
+    /// \return Whether the graph of the matrix is a forest.
+    bool analyse(const Matrix& matrix)
+    {
+        const std::size_t size = matrix.N();
+        parent_.assign(size, -1);
+        order_.clear();
+        order_.reserve(size);
+        isTree_ = false;
+        isFactorized_ = false;
+
+        // breadth first search from each unvisited row, which gives an
+        // order with every row before the rows connected below it
+        std::vector<bool> visited(size, false);
+        for (std::size_t root = 0; root < size; ++root) {
+            if (visited[root]) {
+                continue;
+            }
+            visited[root] = true;
+            std::size_t head = order_.size();
+            order_.push_back(root);
+            for (; head < order_.size(); ++head) {
+                const std::size_t row = order_[head];
+                for (auto col = matrix[row].begin(); col != matrix[row].end(); ++col) {
+                    const std::size_t j = col.index();
+                    if (j == row || static_cast<int>(j) == parent_[row]) {
+                        continue;
+                    }
+                    if (visited[j] || !matrix.exists(j, row)) {
+                        // a loop, or a non-symmetric pattern
+                        return false;
+                    }
+                    visited[j] = true;
+                    parent_[j] = static_cast<int>(row);
+                    order_.push_back(j);
+                }
+                if (!matrix.exists(row, row)) {
+                    return false;
+                }
+            }
+        }
+
+        // eliminate the leaves first
+        std::reverse(order_.begin(), order_.end());
+        diagInv_.resize(size);
+        lower_.resize(size);
+        upper_.resize(size);
+        isTree_ = true;
+        return true;
+    }
+
+    /// \brief Whether the last matrix passed to analyse() is a forest.
+    bool isTree() const
+    {
+        return isTree_;
+    }
+
+    /// \brief Whether factorize() has been called since the last analyse()
+    ///        or reset().
+    bool isFactorized() const
+    {
+        return isFactorized_;
+    }
+
+    /// \brief Forget the factors, e.g., because the matrix values changed.
+    void reset()
+    {
+        isFactorized_ = false;
+    }
+
+    /// \brief Compute the factors of a matrix with the pattern passed to analyse().
+    ///
+    /// Throws NumericalProblem if an eliminated diagonal block is singular.
+    void factorize(const Matrix& matrix)
+    {
+        if (!tryFactorize(matrix)) {
+            OPM_THROW_NOLOG(NumericalProblem,
+                            "Singular diagonal block found in the tree "
+                            "factorization of the segment matrix");
+        }
+    }
+
+    /// \brief Compute the factors like factorize(), but return whether it
+    ///        succeeded instead of throwing.
+    ///
+    /// The elimination does not pivot across blocks, so it fails on a zero
+    /// pivot block even if the matrix is not singular. The matrix must
+    /// then be solved by a pivoting solver instead.
+    bool tryFactorize(const Matrix& matrix)
+    {
+        isFactorized_ = false;
+        for (std::size_t row = 0; row < matrix.N(); ++row) {
+            diagInv_[row] = matrix[row][row];
+        }
+        for (const std::size_t row : order_) {
+            try {
+                diagInv_[row].invert();
+            } catch (const Dune::FMatrixError&) {
+                return false;
+            }
+            const int p = parent_[row];
+            if (p < 0) {
+                continue;
+            }
+            // the Schur complement only changes the diagonal of the parent
+            upper_[row] = matrix[row][p];
+            lower_[row] = matrix[p][row];
+            lower_[row].rightmultiply(diagInv_[row]);
+            Block update = lower_[row];
+            update.rightmultiply(upper_[row]);
+            diagInv_[p] -= update;
+        }
+        isFactorized_ = true;
+        return true;
+    }
+
+    /// \brief Solve matrix * x = rhs.
+    Vector solve(const Vector& rhs) const
+    {
+        Vector x(rhs);
+        solveInPlace(x);
+        return x;
+    }
+
+    /// \brief Solve matrix * x = v and store x in v, without allocating.
+    void solveInPlace(Vector& v) const
+    {
+        // forward elimination, from the leaves towards the roots
+        for (const std::size_t row : order_) {
+            const int p = parent_[row];
+            if (p >= 0) {
+                lower_[row].mmv(v[row], v[p]);
+            }
+        }
+        // back substitution, from the roots towards the leaves, the
+        // solution of the parent is final when a row is reached
+        for (auto it = order_.rbegin(); it != order_.rend(); ++it) {
+            const std::size_t row = *it;
+            const int p = parent_[row];
+            auto y = v[row];
+            if (p >= 0) {
+                upper_[row].mmv(v[p], y);
+            }
+            diagInv_[row].mv(y, v[row]);
+        }
+
+        for (const auto& block : v) {
+            for (const auto& value : block) {
+                if (!std::isfinite(value)) {
+                    OPM_THROW_NOLOG(NumericalProblem,
+                                    "nan or inf value found after tree solve "
+                                    "due to singular matrix");
+                }
+            }
+        }
+    }
+
+private:
+    std::vector<int> parent_;          //!< The row connected above each row, -1 for roots.
+    std::vector<std::size_t> order_;   //!< The rows in elimination order.
+    std::vector<Block> diagInv_;       //!< Inverses of the eliminated diagonal blocks.
+    std::vector<Block> lower_;         //!< A(parent, row) * diagInv(row) for each row.
+    std::vector<Block> upper_;         //!< A(row, parent) for each row.
+    bool isTree_ = false;
+    bool isFactorized_ = false;
+};
+
+} // namespace Opm::mswellhelpers
+
+#endif // OPM_MSWELL_TREE_SOLVER_HEADER_INCLUDED
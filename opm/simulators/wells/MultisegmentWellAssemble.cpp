@@ -31,6 +31,7 @@
 
 #include <opm/simulators/utils/BlackoilPhases.hpp>
 
+#include <opm/simulators/wells/MultisegmentWellEquationAccess.hpp>
 #include <opm/simulators/wells/MultisegmentWellEquations.hpp>
 #include <opm/simulators/wells/MultisegmentWellPrimaryVariables.hpp>
 #include <opm/simulators/wells/WellAssemble.hpp>
@@ -41,47 +42,6 @@
 
 namespace Opm {
 
-//! \brief Class administering assembler access to equation system.
-template<class Scalar, int numWellEq, int numEq>
-class MultisegmentWellEquationAccess {
-public:
-    //! \brief Constructor initializes reference to the equation system.
-    explicit MultisegmentWellEquationAccess(MultisegmentWellEquations<Scalar,numWellEq,numEq>& eqns)
-        : eqns_(eqns)
-    {}
-
-    using BVectorWell = typename MultisegmentWellEquations<Scalar,numWellEq,numEq>::BVectorWell;
-    using DiagMatWell = typename MultisegmentWellEquations<Scalar,numWellEq,numEq>::DiagMatWell;
-    using OffDiatMatWell = typename MultisegmentWellEquations<Scalar,numWellEq,numEq>::OffDiagMatWell;
-
-    //! \brief Returns a reference to residual vector.
-    BVectorWell& residual()
-    {
-        return eqns_.resWell_;
-    }
-
-    //! \brief Returns a reference to B matrix.
-    OffDiatMatWell& B()
-    {
-        return eqns_.duneB_;
-    }
-
-    //! \brief Returns a reference to C matrix.
-    OffDiatMatWell& C()
-    {
-        return eqns_.duneC_;
-    }
-
-    //! \brief Returns a reference to D matrix.
-    DiagMatWell& D()
-    {
-        return eqns_.duneD_;
-    }
-
-private:
-    MultisegmentWellEquations<Scalar,numWellEq,numEq>& eqns_; //!< Reference to equation system
-};
-
 template<class FluidSystem, class Indices>
 void MultisegmentWellAssemble<FluidSystem,Indices>::
 assembleControlEq(const WellState<Scalar>& well_state,
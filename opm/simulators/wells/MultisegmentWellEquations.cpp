@@ -41,6 +41,7 @@
 #include <opm/simulators/wells/MultisegmentWellGeneric.hpp>
 #include <opm/simulators/wells/WellInterfaceGeneric.hpp>
 
+#include <cassert>
 #include <cstddef>
 #include <stdexcept>
 
@@ -130,6 +131,14 @@ init(const int numPerfs,
 
     resWell_.resize(well_.numberOfSegments());
 
+    // resize temporary class variables
+    Bx_.resize(duneB_.N());
+    umfRhs_.resize(duneB_.N());
+
+    // The segments normally form a tree, which allows solving with D
+    // without a general sparse factorization.
+    treeDSolver_.analyse(duneD_);
+
     // Store the global index of well perforated cells
     cells_ = cells;
 }
@@ -142,21 +151,24 @@ void MultisegmentWellEquations<Scalar,numWellEq,numEq>::clear()
     duneD_ = 0.0;
     resWell_ = 0.0;
     duneDSolver_.reset();
+    treeDSolver_.reset();
 }
 
 template<class Scalar, int numWellEq, int numEq>
 void MultisegmentWellEquations<Scalar,numWellEq,numEq>::
 apply(const BVector& x, BVector& Ax) const
 {
-    BVectorWell Bx(duneB_.N());
+    assert(Bx_.size() == duneB_.N());
 
-    parallelB_.mv(x, Bx);
+    // Bx_ = duneB_ * x
+    parallelB_.mv(x, Bx_);
 
     // It is ok to do this on each process instead of only on one,
     // because the other processes would remain idle while waiting for
     // the single process to complete the computation.
-    // invDBx = duneD^-1 * Bx_
-    const BVectorWell invDBx = mswellhelpers::applyUMFPack(*duneDSolver_, Bx);
+    // invDBx = duneD^-1 * Bx_, reusing the storage of Bx_
+    auto& invDBx = Bx_;
+    solveDInPlace(invDBx);
 
     // Ax = Ax - duneC_^T * invDBx
     duneC_.mmtv(invDBx,Ax);
@@ -169,8 +181,10 @@ apply(BVector& r) const
     // It is ok to do this on each process instead of only on one,
     // because the other processes would remain idle while waiting for
     // the single process to complete the computation.
-    // invDrw_ = duneD^-1 * resWell_
-    const BVectorWell invDrw = mswellhelpers::applyUMFPack(*duneDSolver_, resWell_);
+    // invDrw = duneD^-1 * resWell_
+    auto& invDrw = Bx_;
+    invDrw = resWell_;
+    solveDInPlace(invDrw);
     // r = r - duneC_^T * invDrw
     duneC_.mmtv(invDrw, r);
 }
@@ -178,11 +192,18 @@ apply(BVector& r) const
 template<class Scalar, int numWellEq, int numEq>
 void MultisegmentWellEquations<Scalar,numWellEq,numEq>::createSolver()
 {
-#if HAVE_UMFPACK
-    if (duneDSolver_) {
+    if (treeDSolver_.isFactorized() || duneDSolver_) {
         return;
     }
 
+    // The tree elimination does not pivot, so a zero pivot block makes it
+    // fail even if D is not singular. Let UMFPACK factorize D in that case.
+    if (treeDSolver_.isTree() && treeDSolver_.tryFactorize(duneD_)) {
+        return;
+    }
+
+#if HAVE_UMFPACK
+
     if constexpr (std::is_same_v<Scalar,float>) {
         OPM_THROW(std::runtime_error, "MultisegmentWell support requires UMFPACK, "
                                       "and UMFPACK does not support float");
@@ -202,7 +223,7 @@ MultisegmentWellEquations<Scalar,numWellEq,numEq>::solve() const
     // It is ok to do this on each process instead of only on one,
     // because the other processes would remain idle while waiting for
     // the single process to complete the computation.
-    return mswellhelpers::applyUMFPack(*duneDSolver_, resWell_);
+    return solveD(resWell_);
 }
 
 template<class Scalar, int numWellEq, int numEq>
@@ -212,7 +233,7 @@ MultisegmentWellEquations<Scalar,numWellEq,numEq>::solve(const BVectorWell& rhs)
     // It is ok to do this on each process instead of only on one,
     // because the other processes would remain idle while waiting for
     // the single process to complete the computation.
-    return mswellhelpers::applyUMFPack(*duneDSolver_, rhs);
+    return solveD(rhs);
 }
 
 template<class Scalar, int numWellEq, int numEq>
@@ -227,7 +248,62 @@ recoverSolutionWell(const BVector& x, BVectorWell& xw) const
     // It is ok to do this on each process instead of only on one,
     // because the other processes would remain idle while waiting for
     // the single process to complete the computation.
-    xw = mswellhelpers::applyUMFPack(*duneDSolver_, resWell);
+    xw = solveD(resWell);
+}
+
+template<class Scalar, int numWellEq, int numEq>
+typename MultisegmentWellEquations<Scalar,numWellEq,numEq>::BVectorWell
+MultisegmentWellEquations<Scalar,numWellEq,numEq>::
+solveD(const BVectorWell& rhs) const
+{
+    if (treeDSolver_.isFactorized()) {
+        return treeDSolver_.solve(rhs);
+    }
+    return mswellhelpers::applyUMFPack(*duneDSolver_, rhs);
+}
+
+template<class Scalar, int numWellEq, int numEq>
+void MultisegmentWellEquations<Scalar,numWellEq,numEq>::
+solveDInPlace(BVectorWell& v) const
+{
+    if (treeDSolver_.isFactorized()) {
+        treeDSolver_.solveInPlace(v);
+        return;
+    }
+    // The right hand side is copied into preallocated storage, but
+    // Dune::UMFPack and UMFPACK allocate their work space in each solve.
+    umfRhs_ = v;
+    mswellhelpers::applyUMFPack(*duneDSolver_, umfRhs_, v);
+}
+
+template<class Scalar, int numWellEq, int numEq>
+Dune::Matrix<typename MultisegmentWellEquations<Scalar,numWellEq,numEq>::DiagMatrixBlockWellType>
+MultisegmentWellEquations<Scalar,numWellEq,numEq>::invertD() const
+{
+    if (!treeDSolver_.isFactorized()) {
+        return mswellhelpers::invertWithUMFPack<BVectorWell>(duneD_.M(),
+                                                             numWellEq,
+                                                             *duneDSolver_);
+    }
+
+    // Create inverse by passing basis vectors to the solver.
+    const int size = duneD_.M();
+    BVectorWell e(size);
+    e = 0.0;
+    Dune::Matrix<DiagMatrixBlockWellType> inv(size, size);
+    for (int ii = 0; ii < size; ++ii) {
+        for (int jj = 0; jj < numWellEq; ++jj) {
+            e[ii][jj] = 1.0;
+            const auto col = treeDSolver_.solve(e);
+            for (int cc = 0; cc < size; ++cc) {
+                for (int dd = 0; dd < numWellEq; ++dd) {
+                    inv[cc][ii][dd][jj] = col[cc][dd];
+                }
+            }
+            e[ii][jj] = 0.0;
+        }
+    }
+    return inv;
 }
 
 #if COMPILE_GPU_BRIDGE
@@ -308,9 +384,7 @@ template<class SparseMatrixAdapter>
 void MultisegmentWellEquations<Scalar,numWellEq,numEq>::
 extract(SparseMatrixAdapter& jacobian) const
 {
-    const auto invDuneD = mswellhelpers::invertWithUMFPack<BVectorWell>(duneD_.M(),
-                                                                        numWellEq,
-                                                                        *duneDSolver_);
+    const auto invDuneD = invertD();
 
     // We need to change matrix A as follows
     // A -= C^T D^-1 B
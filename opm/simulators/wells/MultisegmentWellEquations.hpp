@@ -25,6 +25,7 @@
 #include <opm/simulators/utils/ParallelCommunication.hpp>
 #include <opm/simulators/wells/ParallelWellInfo.hpp>
 #include <opm/simulators/wells/MSWellHelpers.hpp>
+#include <opm/simulators/wells/MSWellTreeSolver.hpp>
 #include <dune/common/fmatrix.hh>
 #include <dune/common/fvector.hh>
 #include <dune/istl/bcrsmatrix.hh>
@@ -86,12 +87,20 @@ public:
     void clear();
 
     //! \brief Apply linear operator to vector.
+    //! \details Uses the scratch vectors of the object, so it must not be
+    //!          called concurrently for the same well. Does not allocate if
+    //!          the segments form a tree and D is factorized by the tree
+    //!          solver. In the UMFPACK fallback of createSolver(), each solve
+    //!          with D allocates the work space of Dune::UMFPack and UMFPACK.
     void apply(const BVector& x, BVector& Ax) const;
 
     //! \brief Apply linear operator to vector.
+    //! \details Not reentrant, see apply(const BVector&, BVector&).
     void apply(BVector& r) const;
 
     //! \brief Compute the LU-decomposition of D matrix.
+    //! \details The tree structured block LU is used if the segments form
+    //!          a tree, UMFPACK otherwise.
     void createSolver();
 
     //! \brief Apply inverted D matrix to residual and return result.
@@ -134,6 +143,17 @@ public:
 
   private:
     friend class MultisegmentWellEquationAccess<Scalar,numWellEq,numEq>;
+
+    //! \brief Apply inverted D matrix to a vector, with the solver created by createSolver().
+    BVectorWell solveD(const BVectorWell& rhs) const;
+
+    //! \brief Apply inverted D matrix to a vector in place.
+    //! \details Only the tree solver avoids allocating, see apply().
+    void solveDInPlace(BVectorWell& v) const;
+
+    //! \brief The inverse of the D matrix as a full block matrix.
+    Dune::Matrix<DiagMatrixBlockWellType> invertD() const;
+
     // two off-diagonal matrices
     OffDiagMatWell duneB_;
     OffDiagMatWell duneC_;
@@ -145,9 +165,18 @@ public:
     /// This is a shared_ptr as MultisegmentWell is copied in computeWellPotentials...
     mutable std::shared_ptr<Dune::UMFPack<DiagMatWell>> duneDSolver_;
 
+    /// \brief Block LU solver for D, used if the segments form a tree.
+    mswellhelpers::TreeBlockSolver<Scalar,numWellEq> treeDSolver_;
+
     // residuals of the well equations
     BVectorWell resWell_;
 
+    // Several vectors used in apply() to avoid reallocation. Their
+    // content is not relevant between function calls, but they make
+    // apply() non-reentrant.
+    mutable BVectorWell Bx_;
+    mutable BVectorWell umfRhs_;
+
     const MultisegmentWellGeneric<Scalar>& well_; //!< Reference to well
 
     // Store the global index of well perforated cells
@@ -29,6 +29,7 @@
 #include <opm/models/blackoil/blackoilonephaseindices.hh>
 #include <opm/models/blackoil/blackoiltwophaseindices.hh>
 
+#include <opm/simulators/wells/StandardWellEquationAccess.hpp>
 #include <opm/simulators/wells/StandardWellEquations.hpp>
 #include <opm/simulators/wells/StandardWellPrimaryVariables.hpp>
 #include <opm/simulators/wells/WellAssemble.hpp>
@@ -40,47 +41,6 @@
 
 namespace Opm {
 
-//! \brief Class administering assembler access to equation system.
-template<class Scalar, int numEq>
-class StandardWellEquationAccess {
-public:
-    //! \brief Constructor initializes reference to the equation system.
-    explicit StandardWellEquationAccess(StandardWellEquations<Scalar,numEq>& eqns)
-        : eqns_(eqns)
-    {}
-
-    using BVectorWell = typename StandardWellEquations<Scalar,numEq>::BVectorWell;
-    using DiagMatWell = typename StandardWellEquations<Scalar,numEq>::DiagMatWell;
-    using OffDiatMatWell = typename StandardWellEquations<Scalar,numEq>::OffDiagMatWell;
-
-    //! \brief Returns a reference to residual vector.
-    BVectorWell& residual()
-    {
-        return eqns_.resWell_;
-    }
-
-    //! \brief Returns a reference to B matrix.
-    OffDiatMatWell& B()
-    {
-        return eqns_.duneB_;
-    }
-
-    //! \brief Returns a reference to C matrix.
-    OffDiatMatWell& C()
-    {
-        return eqns_.duneC_;
-    }
-
-    //! \brief Returns a reference to D matrix.
-    DiagMatWell& D()
-    {
-        return eqns_.duneD_;
-    }
-
-private:
-    StandardWellEquations<Scalar,numEq>& eqns_; //!< Reference to equation system
-};
-
 template<class FluidSystem, class Indices>
 void
 StandardWellAssemble<FluidSystem,Indices>::
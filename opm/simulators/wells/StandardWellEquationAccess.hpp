@@ -0,0 +1,73 @@
+/*
+  Copyright 2017 SINTEF Digital, Mathematics and Cybernetics.
+  Copyright 2017 Statoil ASA.
+  Copyright 2016 - 2017 IRIS AS.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef OPM_STANDARDWELL_EQUATION_ACCESS_HEADER_INCLUDED
+#define OPM_STANDARDWELL_EQUATION_ACCESS_HEADER_INCLUDED
+
+#include <opm/simulators/wells/StandardWellEquations.hpp>
+
+namespace Opm
+{
+
+//! \brief Class administering assembler access to equation system.
+template<class Scalar, int numEq>
+class StandardWellEquationAccess {
+public:
+    //! \brief Constructor initializes reference to the equation system.
+    explicit StandardWellEquationAccess(StandardWellEquations<Scalar,numEq>& eqns)
+        : eqns_(eqns)
+    {}
+
+    using BVectorWell = typename StandardWellEquations<Scalar,numEq>::BVectorWell;
+    using DiagMatWell = typename StandardWellEquations<Scalar,numEq>::DiagMatWell;
+    using OffDiatMatWell = typename StandardWellEquations<Scalar,numEq>::OffDiagMatWell;
+
+    //! \brief Returns a reference to residual vector.
+    BVectorWell& residual()
+    {
+        return eqns_.resWell_;
+    }
+
+    //! \brief Returns a reference to B matrix.
+    OffDiatMatWell& B()
+    {
+        return eqns_.duneB_;
+    }
+
+    //! \brief Returns a reference to C matrix.
+    OffDiatMatWell& C()
+    {
+        return eqns_.duneC_;
+    }
+
+    //! \brief Returns a reference to D matrix.
+    DiagMatWell& D()
+    {
+        return eqns_.duneD_;
+    }
+
+private:
+    StandardWellEquations<Scalar,numEq>& eqns_; //!< Reference to equation system
+};
+
+}
+
+#endif // OPM_STANDARDWELL_EQUATION_ACCESS_HEADER_INCLUDED
@@ -79,9 +79,12 @@ public:
     void clear();
 
     //! \brief Apply linear operator to vector.
+    //! \details Uses the scratch vectors of the object, so it must not be
+    //!          called concurrently for the same well.
     void apply(const BVector& x, BVector& Ax) const;
 
     //! \brief Apply linear operator to vector.
+    //! \details Not reentrant, see apply(const BVector&, BVector&).
     void apply(BVector& r) const;
 
     //! \brief Apply inverted D matrix to residual and store in vector.
@@ -145,7 +148,8 @@ private:
     // residuals of the well equations
     BVectorWell resWell_;
 
-    // several vector used in the matrix calculation
+    // several vector used in the matrix calculation, which make apply()
+    // non-reentrant
     mutable BVectorWell Bx_;
     mutable BVectorWell invDrw_;
 
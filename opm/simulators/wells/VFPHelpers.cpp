@@ -28,6 +28,7 @@
 #include <opm/input/eclipse/Schedule/VFPInjTable.hpp>
 #include <opm/input/eclipse/Schedule/VFPProdTable.hpp>
 
+#include <algorithm>
 #include <cassert>
 #include <cmath>
 #include <stdexcept>
@@ -75,6 +76,115 @@ static T chopNegativeValues(const T& value) {
     return Opm::max(0.0, value);
 }
 
+/**
+ * Sets the interpolation factor of an interval found for value
+ */
+template<class Scalar>
+void setInterpFactor(Opm::detail::InterpData<Scalar>& data,
+                     const Scalar value,
+                     const std::vector<double>& values)
+{
+    const Scalar start = values[data.ind_[0]];
+    const Scalar end   = values[data.ind_[1]];
+
+    //Find interpolation ratio
+    if (end > start) {
+        //FIXME: Possible source for floating point error here if value and floor are large,
+        //but very close to each other
+        data.inv_dist_ = 1.0 / (end-start);
+        data.factor_ = (value-start) * data.inv_dist_;
+    }
+    else {
+        data.inv_dist_ = 0.0;
+        data.factor_ = 0.0;
+    }
+}
+
+/**
+ * Computes the derivatives in the corners of a 5D hypercube of table values,
+ * and interpolates the values and derivatives to the evaluation point.
+ */
+template<class Scalar>
+Opm::detail::VFPEvaluation<Scalar>
+interpolateHypercube(Opm::detail::VFPEvaluation<Scalar> (&nn)[2][2][2][2][2],
+                     const Opm::detail::InterpData<Scalar>& flo_i,
+                     const Opm::detail::InterpData<Scalar>& thp_i,
+                     const Opm::detail::InterpData<Scalar>& wfr_i,
+                     const Opm::detail::InterpData<Scalar>& gfr_i,
+                     const Opm::detail::InterpData<Scalar>& alq_i)
+{
+    //Calculate derivatives
+    //Note that the derivative of the two end points of a line aligned with the
+    //"axis of the derivative" are equal
+    for (int i=0; i<=1; ++i) {
+        for (int j=0; j<=1; ++j) {
+            for (int k=0; k<=1; ++k) {
+                for (int l=0; l<=1; ++l) {
+                    nn[0][i][j][k][l].dthp = (nn[1][i][j][k][l].value - nn[0][i][j][k][l].value) * thp_i.inv_dist_;
+                    nn[i][0][j][k][l].dwfr = (nn[i][1][j][k][l].value - nn[i][0][j][k][l].value) * wfr_i.inv_dist_;
+                    nn[i][j][0][k][l].dgfr = (nn[i][j][1][k][l].value - nn[i][j][0][k][l].value) * gfr_i.inv_dist_;
+                    nn[i][j][k][0][l].dalq = (nn[i][j][k][1][l].value - nn[i][j][k][0][l].value) * alq_i.inv_dist_;
+                    nn[i][j][k][l][0].dflo = (nn[i][j][k][l][1].value - nn[i][j][k][l][0].value) * flo_i.inv_dist_;
+
+                    nn[1][i][j][k][l].dthp = nn[0][i][j][k][l].dthp;
+                    nn[i][1][j][k][l].dwfr = nn[i][0][j][k][l].dwfr;
+                    nn[i][j][1][k][l].dgfr = nn[i][j][0][k][l].dgfr;
+                    nn[i][j][k][1][l].dalq = nn[i][j][k][0][l].dalq;
+                    nn[i][j][k][l][1].dflo = nn[i][j][k][l][0].dflo;
+                }
+            }
+        }
+    }
+
+    Scalar t1, t2; //interpolation variables, so that t1 = (1-t) and t2 = t.
+
+    // Remove dimensions one by one
+    // Example: going from 3D to 2D to 1D, we start by interpolating along
+    // the z axis first, leaving a 2D problem. Then interpolating along the y
+    // axis, leaving a 1D, problem, etc.
+    t2 = flo_i.factor_;
+    t1 = (1.0-t2);
+    for (int t=0; t<=1; ++t) {
+        for (int w=0; w<=1; ++w) {
+            for (int g=0; g<=1; ++g) {
+                for (int a=0; a<=1; ++a) {
+                    nn[t][w][g][a][0] = t1*nn[t][w][g][a][0] + t2*nn[t][w][g][a][1];
+                }
+            }
+        }
+    }
+
+    t2 = alq_i.factor_;
+    t1 = (1.0-t2);
+    for (int t=0; t<=1; ++t) {
+        for (int w=0; w<=1; ++w) {
+            for (int g=0; g<=1; ++g) {
+                nn[t][w][g][0][0] = t1*nn[t][w][g][0][0] + t2*nn[t][w][g][1][0];
+            }
+        }
+    }
+
+    t2 = gfr_i.factor_;
+    t1 = (1.0-t2);
+    for (int t=0; t<=1; ++t) {
+        for (int w=0; w<=1; ++w) {
+            nn[t][w][0][0][0] = t1*nn[t][w][0][0][0] + t2*nn[t][w][1][0][0];
+        }
+    }
+
+    t2 = wfr_i.factor_;
+    t1 = (1.0-t2);
+    for (int t=0; t<=1; ++t) {
+        nn[t][0][0][0][0] = t1*nn[t][0][0][0][0] + t2*nn[t][1][0][0][0];
+    }
+
+    t2 = thp_i.factor_;
+    t1 = (1.0-t2);
+    nn[0][0][0][0][0] = t1*nn[0][0][0][0][0] + t2*nn[1][0][0][0][0];
+
+    return nn[0][0][0][0][0];
+}
+
 }
 
 namespace Opm {
@@ -111,35 +221,44 @@ detail::InterpData<Scalar> VFPHelpers<Scalar>::findInterpData(const Scalar value
             retval.ind_[1] = nvalues-1;
         }
         else {
-            //Search internal intervals
-            for (int i=1; i<nvalues; ++i) {
-                if (values[i] >= value) {
-                    retval.ind_[0] = i-1;
-                    retval.ind_[1] = i;
-                    break;
-                }
-            }
+            //Search internal intervals for the first element greater than or
+            //equal to value, a value equal to the first element uses the first interval
+            const auto it = std::lower_bound(values.begin() + 1, values.end(), value);
+            const int i = it - values.begin();
+            retval.ind_[0] = i-1;
+            retval.ind_[1] = i;
         }
 
-        const Scalar start = values[retval.ind_[0]];
-        const Scalar end   = values[retval.ind_[1]];
-
-        //Find interpolation ratio
-        if (end > start) {
-            //FIXME: Possible source for floating point error here if value and floor are large,
-            //but very close to each other
-            retval.inv_dist_ = 1.0 / (end-start);
-            retval.factor_ = (value-start) * retval.inv_dist_;
-        }
-        else {
-            retval.inv_dist_ = 0.0;
-            retval.factor_ = 0.0;
-        }
+        setInterpFactor(retval, value, values);
     }
 
     return retval;
 }
 
+template<class Scalar>
+detail::InterpData<Scalar> VFPHelpers<Scalar>::findInterpData(const Scalar value_in,
+                                                              const std::vector<double>& values,
+                                                              const detail::InterpData<Scalar>& hint)
+{
+    const Scalar value = value_in < 0.? 0. : value_in;
+    const int i = hint.ind_[1];
+
+    // The interval (values[i-1], values[i]] is the one the search would
+    // find for value, the end intervals also hold values outside the axis
+    // but those are rare, so let the search handle them.
+    if (i > 0 && i < static_cast<int>(values.size()) &&
+        values[i-1] < value && value <= values[i])
+    {
+        detail::InterpData<Scalar> retval;
+        retval.ind_[0] = i-1;
+        retval.ind_[1] = i;
+        setInterpFactor(retval, value, values);
+        return retval;
+    }
+
+    return findInterpData(value_in, values);
+}
+
 template<class Scalar>
 detail::VFPEvaluation<Scalar> VFPHelpers<Scalar>::
 interpolate(const VFPProdTable& table,
@@ -177,76 +296,7 @@ interpolate(const VFPProdTable& table,
         }
     }
 
-    //Calculate derivatives
-    //Note that the derivative of the two end points of a line aligned with the
-    //"axis of the derivative" are equal
-    for (int i=0; i<=1; ++i) {
-        for (int j=0; j<=1; ++j) {
-            for (int k=0; k<=1; ++k) {
-                for (int l=0; l<=1; ++l) {
-                    nn[0][i][j][k][l].dthp = (nn[1][i][j][k][l].value - nn[0][i][j][k][l].value) * thp_i.inv_dist_;
-                    nn[i][0][j][k][l].dwfr = (nn[i][1][j][k][l].value - nn[i][0][j][k][l].value) * wfr_i.inv_dist_;
-                    nn[i][j][0][k][l].dgfr = (nn[i][j][1][k][l].value - nn[i][j][0][k][l].value) * gfr_i.inv_dist_;
-                    nn[i][j][k][0][l].dalq = (nn[i][j][k][1][l].value - nn[i][j][k][0][l].value) * alq_i.inv_dist_;
-                    nn[i][j][k][l][0].dflo = (nn[i][j][k][l][1].value - nn[i][j][k][l][0].value) * flo_i.inv_dist_;
-
-                    nn[1][i][j][k][l].dthp = nn[0][i][j][k][l].dthp;
-                    nn[i][1][j][k][l].dwfr = nn[i][0][j][k][l].dwfr;
-                    nn[i][j][1][k][l].dgfr = nn[i][j][0][k][l].dgfr;
-                    nn[i][j][k][1][l].dalq = nn[i][j][k][0][l].dalq;
-                    nn[i][j][k][l][1].dflo = nn[i][j][k][l][0].dflo;
-                }
-            }
-        }
-    }
-
-    Scalar t1, t2; //interpolation variables, so that t1 = (1-t) and t2 = t.
-
-    // Remove dimensions one by one
-    // Example: going from 3D to 2D to 1D, we start by interpolating along
-    // the z axis first, leaving a 2D problem. Then interpolating along the y
-    // axis, leaving a 1D, problem, etc.
-    t2 = flo_i.factor_;
-    t1 = (1.0-t2);
-    for (int t=0; t<=1; ++t) {
-        for (int w=0; w<=1; ++w) {
-            for (int g=0; g<=1; ++g) {
-                for (int a=0; a<=1; ++a) {
-                    nn[t][w][g][a][0] = t1*nn[t][w][g][a][0] + t2*nn[t][w][g][a][1];
-                }
-            }
-        }
-    }
-
-    t2 = alq_i.factor_;
-    t1 = (1.0-t2);
-    for (int t=0; t<=1; ++t) {
-        for (int w=0; w<=1; ++w) {
-            for (int g=0; g<=1; ++g) {
-                nn[t][w][g][0][0] = t1*nn[t][w][g][0][0] + t2*nn[t][w][g][1][0];
-            }
-        }
-    }
-
-    t2 = gfr_i.factor_;
-    t1 = (1.0-t2);
-    for (int t=0; t<=1; ++t) {
-        for (int w=0; w<=1; ++w) {
-            nn[t][w][0][0][0] = t1*nn[t][w][0][0][0] + t2*nn[t][w][1][0][0];
-        }
-    }
-
-    t2 = wfr_i.factor_;
-    t1 = (1.0-t2);
-    for (int t=0; t<=1; ++t) {
-        nn[t][0][0][0][0] = t1*nn[t][0][0][0][0] + t2*nn[t][1][0][0][0];
-    }
-
-    t2 = thp_i.factor_;
-    t1 = (1.0-t2);
-    nn[0][0][0][0][0] = t1*nn[0][0][0][0][0] + t2*nn[1][0][0][0][0];
-
-    return nn[0][0][0][0][0];
+    return interpolateHypercube(nn, flo_i, thp_i, wfr_i, gfr_i, alq_i);
 }
 
 template<class Scalar>
@@ -338,6 +388,99 @@ bhp(const VFPProdTable& table,
     return retval;
 }
 
+template<class Scalar>
+detail::VFPEvaluation<Scalar> VFPHelpers<Scalar>::
+bhp(const VFPProdTable& table,
+    const Scalar aqua,
+    const Scalar liquid,
+    const Scalar vapour,
+    const Scalar thp,
+    const Scalar alq,
+    const Scalar explicit_wfr,
+    const Scalar explicit_gfr,
+    const bool   use_vfpexplicit,
+    detail::VFPInterpCache<Scalar>& cache)
+{
+    //Find interpolation variables
+    Scalar flo = detail::getFlo(table, aqua, liquid, vapour);
+    Scalar wfr = detail::getWFR(table, aqua, liquid, vapour);
+    Scalar gfr = detail::getGFR(table, aqua, liquid, vapour);
+    if (use_vfpexplicit || -flo < table.getFloAxis().front()) {
+        wfr = explicit_wfr;
+        gfr = explicit_gfr;
+    }
+
+    //The intervals of another table are of no use
+    if (cache.table != &table) {
+        cache = detail::VFPInterpCache<Scalar>{};
+        cache.table = &table;
+    }
+
+    //Recall that flo is negative in Opm, so switch sign.
+    cache.flo = findInterpData(-flo, table.getFloAxis(), cache.flo);
+    cache.thp = findInterpData( thp, table.getTHPAxis(), cache.thp);
+    cache.wfr = findInterpData( wfr, table.getWFRAxis(), cache.wfr);
+    cache.gfr = findInterpData( gfr, table.getGFRAxis(), cache.gfr);
+    cache.alq = findInterpData( alq, table.getALQAxis(), cache.alq);
+
+    return interpolate(table, cache.flo, cache.thp, cache.wfr, cache.gfr, cache.alq);
+}
+
+template<class Scalar>
+void VFPHelpers<Scalar>::
+bhpAtFlos(const VFPProdTable& table,
+          const std::vector<Scalar>& flos,
+          const Scalar thp,
+          const Scalar wfr,
+          const Scalar gfr,
+          const Scalar alq,
+          std::vector<detail::VFPEvaluation<Scalar>>& result)
+{
+    const auto thp_i = findInterpData(thp, table.getTHPAxis());
+    const auto wfr_i = findInterpData(wfr, table.getWFRAxis());
+    const auto gfr_i = findInterpData(gfr, table.getGFRAxis());
+    const auto alq_i = findInterpData(alq, table.getALQAxis());
+
+    //Gather the 16 corners of the fixed axes for every point of the flo
+    //axis, so that the lookups below read contiguous memory
+    const std::vector<double>& flo_axis = table.getFloAxis();
+    const std::size_t nflo = flo_axis.size();
+    std::vector<Scalar> corners(16 * nflo);
+    for (std::size_t fi = 0; fi < nflo; ++fi) {
+        for (int t=0; t<=1; ++t) {
+            for (int w=0; w<=1; ++w) {
+                for (int g=0; g<=1; ++g) {
+                    for (int a=0; a<=1; ++a) {
+                        corners[16*fi + 8*t + 4*w + 2*g + a] =
+                            table(thp_i.ind_[t], wfr_i.ind_[w], gfr_i.ind_[g], alq_i.ind_[a], fi);
+                    }
+                }
+            }
+        }
+    }
+
+    result.resize(flos.size());
+    detail::InterpData<Scalar> flo_i;
+    for (std::size_t i = 0; i < flos.size(); ++i) {
+        flo_i = findInterpData(flos[i], flo_axis, flo_i);
+
+        detail::VFPEvaluation<Scalar> nn[2][2][2][2][2];
+        for (int t=0; t<=1; ++t) {
+            for (int w=0; w<=1; ++w) {
+                for (int g=0; g<=1; ++g) {
+                    for (int a=0; a<=1; ++a) {
+                        for (int f=0; f<=1; ++f) {
+                            nn[t][w][g][a][f].value =
+                                corners[16*flo_i.ind_[f] + 8*t + 4*w + 2*g + a];
+                        }
+                    }
+                }
+            }
+        }
+        result[i] = interpolateHypercube(nn, flo_i, thp_i, wfr_i, gfr_i, alq_i);
+    }
+}
+
 template<class Scalar>
 detail::VFPEvaluation<Scalar> VFPHelpers<Scalar>::
 bhp(const VFPInjTable& table,
@@ -518,20 +661,16 @@ getMinimumBHPCoordinate(const VFPProdTable& table,
     // the corresponding pair (-flo_at_bhp_min, bhp_min). No assumption is taken on the
     // shape of the function bhp(flo), so all points in the flo-axis is checked.
     Scalar flo_at_bhp_min = 0.0; // start by checking flo=0
-    auto flo_i = findInterpData(flo_at_bhp_min, table.getFloAxis());
-    auto thp_i = findInterpData( thp, table.getTHPAxis());
-    auto wfr_i = findInterpData( wfr, table.getWFRAxis());
-    auto gfr_i = findInterpData( gfr, table.getGFRAxis());
-    auto alq_i = findInterpData( alq, table.getALQAxis());
-
-    detail::VFPEvaluation bhp_i = interpolate(table, flo_i, thp_i, wfr_i, gfr_i, alq_i);
-    Scalar bhp_min = bhp_i.value;
     const std::vector<double>& flos = table.getFloAxis();
+    std::vector<Scalar> points(flos.size() + 1, flo_at_bhp_min);
+    std::copy(flos.begin(), flos.end(), points.begin() + 1);
+    std::vector<detail::VFPEvaluation<Scalar>> bhps;
+    bhpAtFlos(table, points, thp, wfr, gfr, alq, bhps);
+
+    Scalar bhp_min = bhps[0].value;
     for (size_t i = 0; i < flos.size(); ++i) {
-        flo_i = findInterpData(flos[i], flos);
-        bhp_i = interpolate(table, flo_i, thp_i, wfr_i, gfr_i, alq_i);
-        if (bhp_i.value < bhp_min){
-            bhp_min = bhp_i.value;
+        if (bhps[i+1].value < bhp_min){
+            bhp_min = bhps[i+1].value;
             flo_at_bhp_min = flos[i];
         }
     }
@@ -559,13 +698,12 @@ intersectWithIPR(const VFPProdTable& table,
     // NOTE: ipr-line is q=b*bhp - a!
     // ipr is given for negative flo, so
     // flo = -b*bhp + a, i.e., bhp = -(flo-a)/b
-    auto thp_i = findInterpData( thp, table.getTHPAxis());
-    auto wfr_i = findInterpData( wfr, table.getWFRAxis());
-    auto gfr_i = findInterpData( gfr, table.getGFRAxis());
-    auto alq_i = findInterpData( alq, table.getALQAxis());
-
     if (ipr_b == 0.0) {
         // this shouldn't happen, but deal with it to be safe
+        auto thp_i = findInterpData( thp, table.getTHPAxis());
+        auto wfr_i = findInterpData( wfr, table.getWFRAxis());
+        auto gfr_i = findInterpData( gfr, table.getGFRAxis());
+        auto alq_i = findInterpData( alq, table.getALQAxis());
         auto flo_i = findInterpData(ipr_a, table.getFloAxis());
         detail::VFPEvaluation bhp_i = interpolate(table, flo_i, thp_i, wfr_i, gfr_i, alq_i);
         return std::make_pair(-ipr_a, adjust_bhp(bhp_i.value));
@@ -575,16 +713,16 @@ intersectWithIPR(const VFPProdTable& table,
     Scalar flo0, flo1;
     Scalar y0, y1;
     flo0 = 0.0; // start by checking flo=0
-    auto flo_i = findInterpData(flo0, table.getFloAxis());
-    detail::VFPEvaluation bhp_i = interpolate(table, flo_i, thp_i, wfr_i, gfr_i, alq_i);
-    y0 = adjust_bhp(bhp_i.value) - ipr_a/ipr_b; // +0.0/ipr_b
-
     const std::vector<double>& flos = table.getFloAxis();
+    std::vector<Scalar> points(flos.size() + 1, flo0);
+    std::copy(flos.begin(), flos.end(), points.begin() + 1);
+    std::vector<detail::VFPEvaluation<Scalar>> bhps;
+    bhpAtFlos(table, points, thp, wfr, gfr, alq, bhps);
+    y0 = adjust_bhp(bhps[0].value) - ipr_a/ipr_b; // +0.0/ipr_b
+
     for (size_t i = 0; i < flos.size(); ++i) {
         flo1 = flos[i];
-        flo_i = findInterpData(flo1, flos);
-        bhp_i = interpolate(table, flo_i, thp_i, wfr_i, gfr_i, alq_i);
-        y1 = adjust_bhp(bhp_i.value) + (flo1 - ipr_a)/ipr_b;
+        y1 = adjust_bhp(bhps[i+1].value) + (flo1 - ipr_a)/ipr_b;
         if (y0 < 0 && y1 >= 0){
             // crossing with positive slope
             Scalar w = -y0/(y1-y0);
@@ -70,6 +70,23 @@ struct InterpData
     Scalar factor_; // Interpolation factor
 };
 
+/**
+ * The interpolation intervals of the last lookup in a production table.
+ * Successive lookups for one well, e.g., while solving for the bhp at the
+ * thp limit, mostly fall in the same hypercube of the table, so the
+ * intervals are tried first in the next lookup.
+ */
+template<class Scalar>
+struct VFPInterpCache
+{
+    const VFPProdTable* table = nullptr;
+    InterpData<Scalar> flo;
+    InterpData<Scalar> thp;
+    InterpData<Scalar> wfr;
+    InterpData<Scalar> gfr;
+    InterpData<Scalar> alq;
+};
+
 /**
  * Computes the flo parameter according to the flo_type_
  * for production tables
@@ -147,6 +164,14 @@ public:
     static detail::InterpData<Scalar> findInterpData(const Scalar value_in,
                                                      const std::vector<double>& values);
 
+    /**
+     * As findInterpData() above, but tries the interval of hint before
+     * searching, the result is the same.
+     */
+    static detail::InterpData<Scalar> findInterpData(const Scalar value_in,
+                                                     const std::vector<double>& values,
+                                                     const detail::InterpData<Scalar>& hint);
+
     /**
      * Helper function which interpolates data using the indices etc. given in the inputs.
      */
@@ -175,6 +200,37 @@ public:
                                              const Scalar explicit_gfr,
                                              const bool   use_vfpexplicit);
 
+    /**
+     * As bhp() above, but starts the lookups from the intervals of the
+     * last lookup stored in cache, and updates the cache.
+     */
+    static detail::VFPEvaluation<Scalar> bhp(const VFPProdTable& table,
+                                             const Scalar aqua,
+                                             const Scalar liquid,
+                                             const Scalar vapour,
+                                             const Scalar thp,
+                                             const Scalar alq,
+                                             const Scalar explicit_wfr,
+                                             const Scalar explicit_gfr,
+                                             const bool   use_vfpexplicit,
+                                             detail::VFPInterpCache<Scalar>& cache);
+
+    /**
+     * Interpolates the bhp and its derivatives at a batch of flo values,
+     * given as in the table, i.e. positive, for fixed thp, wfr, gfr and alq.
+     * The table values along the flo axis are gathered once, and each
+     * lookup starts from the interval of the previous flo value, so the
+     * points cost little more than the interpolation itself.
+     * The results are identical to calling interpolate() for each point.
+     */
+    static void bhpAtFlos(const VFPProdTable& table,
+                          const std::vector<Scalar>& flos,
+                          const Scalar thp,
+                          const Scalar wfr,
+                          const Scalar gfr,
+                          const Scalar alq,
+                          std::vector<detail::VFPEvaluation<Scalar>>& result);
+
     static detail::VFPEvaluation<Scalar> bhp(const VFPInjTable& table,
                                              const Scalar aqua,
                                              const Scalar liquid,
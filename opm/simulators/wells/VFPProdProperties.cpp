@@ -94,6 +94,27 @@ bhp(const int     table_id,
     return retval.value;
 }
 
+template<class Scalar>
+Scalar VFPProdProperties<Scalar>::
+bhp(const int     table_id,
+     const Scalar aqua,
+     const Scalar liquid,
+     const Scalar vapour,
+     const Scalar thp_arg,
+     const Scalar alq,
+     const Scalar explicit_wfr,
+     const Scalar explicit_gfr,
+     const bool   use_expvfp,
+     detail::VFPInterpCache<Scalar>& cache) const
+{
+    const VFPProdTable& table = detail::getTable(m_tables, table_id);
+
+    detail::VFPEvaluation retval = VFPHelpers<Scalar>::bhp(table, aqua, liquid, vapour,
+                                                           thp_arg, alq, explicit_wfr,
+                                                           explicit_gfr, use_expvfp, cache);
+    return retval.value;
+}
+
 template<class Scalar>
 const VFPProdTable&
 VFPProdProperties<Scalar>::getTable(const int table_id) const
@@ -120,19 +141,19 @@ bhpwithflo(const std::vector<Scalar>& flos,
 {
     // Get the table
     const VFPProdTable& table = detail::getTable(m_tables, table_id);
-    const auto thp_i = VFPHelpers<Scalar>::findInterpData( thp, table.getTHPAxis()); // assume constant
-    const auto wfr_i = VFPHelpers<Scalar>::findInterpData( wfr, table.getWFRAxis());
-    const auto gfr_i = VFPHelpers<Scalar>::findInterpData( gfr, table.getGFRAxis());
-    const auto alq_i = VFPHelpers<Scalar>::findInterpData( alq, table.getALQAxis()); //assume constant
 
-    std::vector<Scalar> bhps(flos.size(), 0.);
+    // Value of FLO is negative in OPM for producers, but positive in VFP table
+    std::vector<Scalar> table_flos(flos.size());
     for (std::size_t i = 0; i < flos.size(); ++i) {
-        // Value of FLO is negative in OPM for producers, but positive in VFP table
-        const auto flo_i = VFPHelpers<Scalar>::findInterpData(-flos[i], table.getFloAxis());
-        const detail::VFPEvaluation bhp_val = VFPHelpers<Scalar>::interpolate(table, flo_i, thp_i, wfr_i, gfr_i, alq_i);
+        table_flos[i] = -flos[i];
+    }
+    std::vector<detail::VFPEvaluation<Scalar>> bhp_vals;
+    VFPHelpers<Scalar>::bhpAtFlos(table, table_flos, thp, wfr, gfr, alq, bhp_vals);
 
+    std::vector<Scalar> bhps(flos.size(), 0.);
+    for (std::size_t i = 0; i < flos.size(); ++i) {
         // TODO: this kind of breaks the conventions for the functions here by putting dp within the function
-        bhps[i] = bhp_val.value - dp;
+        bhps[i] = bhp_vals[i].value - dp;
     }
 
     return bhps;
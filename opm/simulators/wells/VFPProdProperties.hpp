@@ -29,6 +29,10 @@ namespace Opm {
 
 class VFPProdTable;
 
+namespace detail {
+template<class Scalar> struct VFPInterpCache;
+}
+
 /**
  * Class which linearly interpolates BHP as a function of rate, tubing head pressure,
  * water fraction, gas fraction, and artificial lift for production VFP tables, and similarly
@@ -92,6 +96,22 @@ public:
                const Scalar explicit_gfr,
                const bool   use_expvfp) const;
 
+    /**
+     * As bhp() above, but starts the table lookups from the intervals of
+     * the last lookup stored in cache, and updates the cache. Use one cache
+     * for a sequence of evaluations for the same well.
+     */
+    Scalar bhp(const int    table_id,
+               const Scalar aqua,
+               const Scalar liquid,
+               const Scalar vapour,
+               const Scalar thp,
+               const Scalar alq,
+               const Scalar explicit_wfr,
+               const Scalar explicit_gfr,
+               const bool   use_expvfp,
+               detail::VFPInterpCache<Scalar>& cache) const;
+
     /**
      * Linear interpolation of thp as a function of the input parameters
      * @param table_id Table number to use
@@ -236,7 +236,10 @@ computeBhpAtThpLimitProd(const std::function<std::vector<Scalar>(const Scalar)>&
                                                                 rho,
                                                                 well_.gravity());
 
-    auto fbhp = [this, &controls, thp_limit, dp, alq_value](const std::vector<Scalar>& rates) {
+    // The rates change little between the evaluations while solving, so
+    // the table lookups mostly hit the hypercube of the previous one.
+    detail::VFPInterpCache<Scalar> vfp_cache;
+    auto fbhp = [this, &controls, thp_limit, dp, alq_value, &vfp_cache](const std::vector<Scalar>& rates) {
         assert(rates.size() == 3);
         const auto& wfr =  well_.vfpProperties()->getExplicitWFR(controls.vfp_table_number,
                                                                 well_.indexOfWell());
@@ -251,7 +254,8 @@ computeBhpAtThpLimitProd(const std::function<std::vector<Scalar>(const Scalar)>&
                                                                  alq_value,
                                                                  wfr,
                                                                  gfr,
-                                                                 use_vfpexp);
+                                                                 use_vfpexp,
+                                                                 vfp_cache);
         return bhp - dp + getVfpBhpAdjustment(bhp, thp_limit);
     };
 
@@ -42,9 +42,6 @@ class WellConnectionAuxiliaryModule : public BaseAuxiliaryModule<TypeTag>
     using SparseMatrixAdapter = GetPropType<TypeTag, Properties::SparseMatrixAdapter>;
 
 public:
-    using NeighborSet = typename
-        ::Opm::BaseAuxiliaryModule<TypeTag>::NeighborSet;
-
     using Domain = SubDomain<Grid>;
 
     WellConnectionAuxiliaryModule(Model& model, Parallel::Communication comm)
@@ -59,7 +56,7 @@ public:
         return 0;
     }
 
-    void addNeighbors(std::vector<NeighborSet>& neighbors) const override
+    void addNeighbors(Linear::SparsityPattern& sparsityPattern) const override
     {
         if (!model_.addMatrixContributions()) {
             return;
@@ -89,8 +86,7 @@ public:
                 }
             }
             for (int cellIdx : wellCells) {
-                neighbors[cellIdx].insert(wellCells.begin(),
-                                          wellCells.end());
+                sparsityPattern.insert(cellIdx, wellCells.begin(), wellCells.end());
             }
         }
     }
@@ -102,7 +98,7 @@ public:
     {
         OPM_BEGIN_PARALLEL_TRY_CATCH();
         for (const auto& well : model_) {
-            this->linearizeSingleWell(jacobian, res, well);
+            this->linearizeSingleWell(jacobian, res, well, linearize_res_local_);
         }
         OPM_END_PARALLEL_TRY_CATCH("BlackoilWellModel::linearize failed: ", lin_comm_);
     }
@@ -119,16 +115,21 @@ public:
         // Note: no point in trying to do a parallel gathering
         // try/catch here, as this function is not called in
         // parallel but for each individual domain of each rank.
+        // Domains may be linearized concurrently, so use a local
+        // buffer instead of linearize_res_local_.
+        GlobalEqVector res_local;
         for (const auto& well : model_) {
             if (model_.well_domain().at(well->name()) == domain.index) {
-                this->linearizeSingleWell(jacobian, res, well);
+                this->linearizeSingleWell(jacobian, res, well, res_local);
             }
         }
     }
 
-    void postSolveDomain(GlobalEqVector& deltaX, const Domain& domain)
+    void postSolveDomain(GlobalEqVector& deltaX,
+                         const Domain& domain,
+                         DeferredLogger& deferred_logger)
     {
-        model_.recoverWellSolutionAndUpdateWellStateDomain(deltaX, domain);
+        model_.recoverWellSolutionAndUpdateWellStateDomain(deltaX, domain, deferred_logger);
     }
 
     template <class Restarter>
@@ -151,23 +152,24 @@ private:
     template<class WellType>
     void linearizeSingleWell(SparseMatrixAdapter& jacobian,
                              GlobalEqVector& res,
-                             const WellType& well)
+                             const WellType& well,
+                             GlobalEqVector& res_local)
     {
         if (model_.addMatrixContributions()) {
             well->addWellContributions(jacobian);
         }
 
         const auto& cells = well->cells();
-        linearize_res_local_.resize(cells.size());
+        res_local.resize(cells.size());
 
         for (size_t i = 0; i < cells.size(); ++i) {
-           linearize_res_local_[i] = res[cells[i]];
+           res_local[i] = res[cells[i]];
         }
 
-        well->apply(linearize_res_local_);
+        well->apply(res_local);
 
         for (size_t i = 0; i < cells.size(); ++i) {
-            res[cells[i]] = linearize_res_local_[i];
+            res[cells[i]] = res_local[i];
         }
     }
 
@@ -52,39 +52,43 @@ void ParallelStandardWellB<Scalar>::
 mv (const X& x, Y& y) const
 {
 #if !defined(NDEBUG) && HAVE_MPI
-    // We need to make sure that all ranks are actually computing
-    // for the same well. Doing this by checking the name of the well.
-    int cstring_size = parallel_well_info_.name().size()+1;
-    std::vector<int> sizes(parallel_well_info_.communication().size());
-    parallel_well_info_.communication().allgather(&cstring_size, 1, sizes.data());
-    std::vector<int> offsets(sizes.size()+1, 0); //last entry will be accumulated size
-    std::partial_sum(sizes.begin(), sizes.end(), offsets.begin() + 1);
-    std::vector<char> cstrings(offsets[sizes.size()]);
-    bool consistentWells = true;
-    char* send = const_cast<char*>(parallel_well_info_.name().c_str());
-    parallel_well_info_.communication().allgatherv(send, cstring_size,
-                                                   cstrings.data(), sizes.data(),
-                                                   offsets.data());
-    for (std::size_t i = 0; i < sizes.size(); ++i)
-    {
-        std::string name(cstrings.data()+offsets[i]);
-        if (name != parallel_well_info_.name())
+    // The check is trivial for wells on a single process, and would make
+    // the concurrent application of such wells communicate.
+    if (parallel_well_info_.communication().size() > 1) {
+        // We need to make sure that all ranks are actually computing
+        // for the same well. Doing this by checking the name of the well.
+        int cstring_size = parallel_well_info_.name().size()+1;
+        std::vector<int> sizes(parallel_well_info_.communication().size());
+        parallel_well_info_.communication().allgather(&cstring_size, 1, sizes.data());
+        std::vector<int> offsets(sizes.size()+1, 0); //last entry will be accumulated size
+        std::partial_sum(sizes.begin(), sizes.end(), offsets.begin() + 1);
+        std::vector<char> cstrings(offsets[sizes.size()]);
+        bool consistentWells = true;
+        char* send = const_cast<char*>(parallel_well_info_.name().c_str());
+        parallel_well_info_.communication().allgatherv(send, cstring_size,
+                                                       cstrings.data(), sizes.data(),
+                                                       offsets.data());
+        for (std::size_t i = 0; i < sizes.size(); ++i)
         {
-            if (parallel_well_info_.communication().rank() == 0)
+            std::string name(cstrings.data()+offsets[i]);
+            if (name != parallel_well_info_.name())
             {
-                //only one process per well logs, might not be 0 of MPI_COMM_WORLD, though
-                OpmLog::error(fmt::format("Not all ranks are computing for the same well,"
-                                          " should be {} but is {},", parallel_well_info_.name(), name));
+                if (parallel_well_info_.communication().rank() == 0)
+                {
+                    //only one process per well logs, might not be 0 of MPI_COMM_WORLD, though
+                    OpmLog::error(fmt::format("Not all ranks are computing for the same well,"
+                                              " should be {} but is {},", parallel_well_info_.name(), name));
+                }
+                consistentWells = false;
+                break;
             }
-            consistentWells = false;
-            break;
         }
-    }
-    parallel_well_info_.communication().barrier();
-    // As not all processes are involved here we need to use MPI_Abort and hope MPI kills them all
-    if (!consistentWells)
-    {
-        MPI_Abort(MPI_COMM_WORLD, 1);
+        parallel_well_info_.communication().barrier();
+        // As not all processes are involved here we need to use MPI_Abort and hope MPI kills them all
+        if (!consistentWells)
+        {
+            MPI_Abort(MPI_COMM_WORLD, 1);
+        }
     }
 #endif
     B_.mv(x, y);
@@ -161,6 +161,7 @@ public:
 
     void assembleWellEq(const Simulator& simulator,
                         const double dt,
+                        const int iterationIdx,
                         WellState<Scalar>& well_state,
                         const GroupState<Scalar>& group_state,
                         DeferredLogger& deferred_logger);
@@ -174,6 +175,7 @@ public:
     // TODO: better name or further refactoring the function to make it more clear
     void prepareWellBeforeAssembling(const Simulator& simulator,
                                      const double dt,
+                                     const int iterationIdx,
                                      WellState<Scalar>& well_state,
                                      const GroupState<Scalar>& group_state,
                                      DeferredLogger& deferred_logger);
@@ -240,6 +242,7 @@ public:
     enum class IndividualOrGroup { Individual, Group, Both };
     bool updateWellControl(const Simulator& simulator,
                            const IndividualOrGroup iog,
+                           const int iterationIdx,
                            WellState<Scalar>& well_state,
                            const GroupState<Scalar>& group_state,
                            DeferredLogger& deferred_logger) /* const */;
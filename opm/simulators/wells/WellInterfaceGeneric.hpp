@@ -170,6 +170,8 @@ public:
 
     bool changedToOpenThisStep() const { return this->changed_to_open_this_step_; }
 
+    bool hasNegativePotentials() const { return this->operability_status_.has_negative_potentials; }
+
     void updateWellTestState(const SingleWellState<Scalar>& ws,
                              const double& simulationTime,
                              const bool& writeMessageToOPMLog,
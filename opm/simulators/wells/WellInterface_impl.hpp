@@ -196,6 +196,7 @@ namespace Opm
     WellInterface<TypeTag>::
     updateWellControl(const Simulator& simulator,
                       const IndividualOrGroup iog,
+                      const int iterationIdx,
                       WellState<Scalar>& well_state,
                       const GroupState<Scalar>& group_state,
                       DeferredLogger& deferred_logger) /* const */
@@ -216,7 +217,6 @@ namespace Opm
         }
         bool oscillating = std::count(this->well_control_log_.begin(), this->well_control_log_.end(), from) >= this->param_.max_number_of_well_switches_;
         const int episodeIdx = simulator.episodeIndex();
-        const int iterationIdx = simulator.model().newtonMethod().numIterations();
         const int nupcol = schedule[episodeIdx].nupcol();
         if (oscillating && iterationIdx > nupcol) {
             // only output frist time
@@ -794,11 +794,12 @@ namespace Opm
     WellInterface<TypeTag>::
     assembleWellEq(const Simulator& simulator,
                    const double dt,
+                   const int iterationIdx,
                    WellState<Scalar>& well_state,
                    const GroupState<Scalar>& group_state,
                    DeferredLogger& deferred_logger)
     {
-        prepareWellBeforeAssembling(simulator, dt, well_state, group_state, deferred_logger);
+        prepareWellBeforeAssembling(simulator, dt, iterationIdx, well_state, group_state, deferred_logger);
         assembleWellEqWithoutIteration(simulator, dt, well_state, group_state, deferred_logger);
     }
 
@@ -828,6 +829,7 @@ namespace Opm
     WellInterface<TypeTag>::
     prepareWellBeforeAssembling(const Simulator& simulator,
                                 const double dt,
+                                const int iterationIdx,
                                 WellState<Scalar>& well_state,
                                 const GroupState<Scalar>& group_state,
                                 DeferredLogger& deferred_logger)
@@ -838,8 +840,7 @@ namespace Opm
             checkWellOperability(simulator, well_state, deferred_logger);
 
         // only use inner well iterations for the first newton iterations.
-        const int iteration_idx = simulator.model().newtonMethod().numIterations();
-        if (iteration_idx < this->param_.max_niter_inner_well_iter_ || this->well_ecl_.isMultiSegment()) {
+        if (iterationIdx < this->param_.max_niter_inner_well_iter_ || this->well_ecl_.isMultiSegment()) {
             const auto& ws = well_state.well(this->indexOfWell());
             const auto pmode_orig = ws.production_cmode;
             const auto imode_orig = ws.injection_cmode;
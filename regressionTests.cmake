@@ -56,6 +56,14 @@ add_test_compareECLFiles(CASENAME spe1
                          ABS_TOL ${abs_tol}
                          REL_TOL ${rel_tol})
 
+add_test_compareECLFiles(CASENAME spe1_compact_iq
+                         FILENAME SPE1CASE1
+                         SIMULATOR flow
+                         ABS_TOL ${abs_tol}
+                         REL_TOL ${rel_tol}
+                         DIR spe1
+                         TEST_ARGS --enable-compact-intensive-quantities=true)
+
 add_test_compareECLFiles(CASENAME spe1_import
                          FILENAME SPE1CASE1_IMPORT
                          SIMULATOR flow
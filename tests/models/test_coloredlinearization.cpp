@@ -0,0 +1,238 @@
+// -*- mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-
+// vi: set et ts=4 sw=4 sts=4:
+/*
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 2 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+
+  Consult the COPYING file in the top-level source directory of this
+  module for the precise wording of the license and the list of
+  copyright holders.
+*/
+/*!
+ * \file
+ *
+ * \brief Tests that the colored linearization of a vertex-centered model yields
+ *        the same linear system as locking the global system for every element,
+ *        for one and for several threads.
+ */
+#include "config.h"
+
+#define BOOST_TEST_MODULE ColoredLinearization
+
+#include <boost/test/unit_test.hpp>
+
+#include <opm/models/immiscible/immisciblemodel.hh>
+#include <opm/models/parallel/threadmanager.hpp>
+#include <opm/models/utils/start.hh>
+#include <opm/simulators/linalg/parallelbicgstabbackend.hh>
+
+#include "../../examples/problems/lensproblem.hh"
+
+#include <dune/common/parallel/mpihelper.hh>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+#include <algorithm>
+#include <cmath>
+#include <memory>
+#include <string>
+
+namespace Opm::Properties {
+
+namespace TTag {
+struct ColoredLinearizationLensProblem
+{ using InheritsFrom = std::tuple<LensBaseProblem, ImmiscibleTwoPhaseModel>; };
+} // namespace TTag
+
+template<class TypeTag>
+struct LocalLinearizerSplice<TypeTag, TTag::ColoredLinearizationLensProblem>
+{ using type = TTag::AutoDiffLocalLinearizer; };
+
+} // namespace Opm::Properties
+
+namespace {
+
+using TypeTag = Opm::Properties::TTag::ColoredLinearizationLensProblem;
+using Simulator = Opm::GetPropType<TypeTag, Opm::Properties::Simulator>;
+using Indices = Opm::GetPropType<TypeTag, Opm::Properties::Indices>;
+using GlobalEqVector = Opm::GetPropType<TypeTag, Opm::Properties::GlobalEqVector>;
+
+static_assert(Opm::getPropValue<TypeTag, Opm::Properties::UseLinearizationLock>(),
+              "The test must use a discretization with overlapping element stencils.");
+
+std::unique_ptr<Simulator> initSimulator(const bool colored, const int numThreads)
+{
+    const std::string threadsArg = "--threads-per-process=" + std::to_string(numThreads);
+    const char* argv[] = {
+        "test_coloredlinearization",
+        "--cells-x=12",
+        "--cells-y=8",
+        "--enable-storage-cache=false",
+        "--enable-intensive-quantity-cache=false",
+        colored ? "--colored-linearization=true" : "--colored-linearization=false",
+        threadsArg.c_str(),
+    };
+
+    Opm::Parameters::reset();
+    Opm::setupParameters_<TypeTag>(/*argc=*/sizeof(argv) / sizeof(argv[0]), argv);
+    Opm::ThreadManager::init();
+
+    return std::make_unique<Simulator>();
+}
+
+// Linearize at the initial solution with a pressure gradient imposed on top of
+// it, such that the fluxes do not vanish.
+void linearize(Simulator& simulator)
+{
+    simulator.model().applyInitialSolution();
+    simulator.setTimeStepSize(250.0);
+    simulator.model().newtonMethod().setIterationIndex(0);
+
+    auto& solution = simulator.model().solution(/*timeIdx=*/0);
+    for (unsigned globI = 0; globI < solution.size(); ++globI) {
+        solution[globI][Indices::pressure0Idx] += 1.0e3 * globI;
+    }
+
+    simulator.model().linearizer().linearizeDomain();
+}
+
+template <class Matrix>
+double maxAbs(const Matrix& matrix)
+{
+    double result = 0.0;
+    for (auto row = matrix.begin(); row != matrix.end(); ++row) {
+        for (auto col = row->begin(); col != row->end(); ++col) {
+            for (const auto& blockRow : *col) {
+                for (const auto& entry : blockRow) {
+                    result = std::max(result, std::abs(entry));
+                }
+            }
+        }
+    }
+    return result;
+}
+
+double maxAbs(const GlobalEqVector& residual)
+{
+    double result = 0.0;
+    for (const auto& block : residual) {
+        for (const auto& entry : block) {
+            result = std::max(result, std::abs(entry));
+        }
+    }
+    return result;
+}
+
+// Check that two entries agree up to a tolerance, or exactly for a zero one.
+void checkClose(const double expected, const double actual, const double tol)
+{
+    if (tol == 0.0) {
+        BOOST_CHECK_EQUAL(expected, actual);
+    }
+    else {
+        BOOST_CHECK_SMALL(expected - actual, tol);
+    }
+}
+
+// Check that two linear systems agree up to a tolerance relative to the
+// largest entry of the reference system.
+void checkSameSystem(const Simulator& reference, const Simulator& other, const double relTol)
+{
+    const auto& res1 = reference.model().linearizer().residual();
+    const auto& res2 = other.model().linearizer().residual();
+    BOOST_REQUIRE_EQUAL(res1.size(), res2.size());
+    const double resTol = relTol * maxAbs(res1);
+    BOOST_REQUIRE_GT(maxAbs(res1), 0.0);
+    for (std::size_t i = 0; i < res1.size(); ++i) {
+        for (std::size_t eqIdx = 0; eqIdx < res1[i].size(); ++eqIdx) {
+            checkClose(res1[i][eqIdx], res2[i][eqIdx], resTol);
+        }
+    }
+
+    const auto& mat1 = reference.model().linearizer().jacobian().istlMatrix();
+    const auto& mat2 = other.model().linearizer().jacobian().istlMatrix();
+    BOOST_REQUIRE_EQUAL(mat1.N(), mat2.N());
+    BOOST_REQUIRE_EQUAL(mat1.nonzeroes(), mat2.nonzeroes());
+    const double matTol = relTol * maxAbs(mat1);
+    BOOST_REQUIRE_GT(maxAbs(mat1), 0.0);
+    for (auto row1 = mat1.begin(); row1 != mat1.end(); ++row1) {
+        const auto& row2 = mat2[row1.index()];
+        for (auto col1 = row1->begin(); col1 != row1->end(); ++col1) {
+            BOOST_REQUIRE(row2.find(col1.index()) != row2.end());
+            const auto& block1 = *col1;
+            const auto& block2 = row2[col1.index()];
+            for (std::size_t r = 0; r < block1.N(); ++r) {
+                for (std::size_t c = 0; c < block1.M(); ++c) {
+                    checkClose(block1[r][c], block2[r][c], matTol);
+                }
+            }
+        }
+    }
+}
+
+struct MPIFixture
+{
+    MPIFixture()
+    {
+        int argc = boost::unit_test::framework::master_test_suite().argc;
+        char** argv = boost::unit_test::framework::master_test_suite().argv;
+        Dune::MPIHelper::instance(argc, argv);
+    }
+};
+
+} // Anonymous namespace
+
+BOOST_GLOBAL_FIXTURE(MPIFixture);
+
+BOOST_AUTO_TEST_CASE(ColoredMatchesLocked)
+{
+    auto locked = initSimulator(/*colored=*/false, /*numThreads=*/1);
+    linearize(*locked);
+
+    auto colored = initSimulator(/*colored=*/true, /*numThreads=*/1);
+    linearize(*colored);
+
+    // The contributions of the elements are summed up in a different order,
+    // so the systems only agree up to round-off.
+    checkSameSystem(*locked, *colored, /*relTol=*/1.0e-12);
+}
+
+#ifdef _OPENMP
+BOOST_AUTO_TEST_CASE(ThreadedColoredMatchesLocked)
+{
+    const int maxThreads = omp_get_max_threads();
+
+    auto locked = initSimulator(/*colored=*/false, /*numThreads=*/1);
+    linearize(*locked);
+
+    auto serial = initSimulator(/*colored=*/true, /*numThreads=*/1);
+    linearize(*serial);
+
+    auto threaded = initSimulator(/*colored=*/true, /*numThreads=*/4);
+    linearize(*threaded);
+
+    // Restore the number of threads for the remaining tests.
+    omp_set_num_threads(maxThreads);
+
+    checkSameSystem(*locked, *threaded, /*relTol=*/1.0e-12);
+
+    // The colors are linearized one after another and each degree of freedom
+    // gets at most one contribution per color, so the order of the sums does
+    // not depend on the number of threads.
+    checkSameSystem(*serial, *threaded, /*relTol=*/0.0);
+}
+#endif
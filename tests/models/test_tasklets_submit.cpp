@@ -0,0 +1,194 @@
+// -*- mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-
+// vi: set et ts=4 sw=4 sts=4:
+/*
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 2 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+
+  Consult the COPYING file in the top-level source directory of this
+  module for the precise wording of the license and the list of
+  copyright holders.
+*/
+/*!
+ * \file
+ *
+ * \brief Tests the submission of functions with priorities and dependencies to the
+ *        tasklet runner, and measures the dispatch latency and throughput.
+ */
+#include "config.h"
+
+#include <opm/models/parallel/tasklets.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <future>
+#include <iostream>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace {
+
+int numFailures = 0;
+
+void check(bool condition, const std::string& what)
+{
+    if (!condition) {
+        std::cerr << "FAILED: " << what << std::endl;
+        ++numFailures;
+    }
+}
+
+void testResults(unsigned numWorkers)
+{
+    Opm::TaskletRunner runner(numWorkers);
+
+    auto answer = runner.submit([]() { return 42; });
+    check(answer.get() == 42, "result of submitted function");
+
+    auto failing = runner.submit([]() -> int { throw std::runtime_error("intentional"); });
+    bool caught = false;
+    try {
+        failing.get();
+    }
+    catch (const std::runtime_error&) {
+        caught = true;
+    }
+    check(caught, "exception is rethrown by the future");
+    check(!runner.failure(), "exceptions of submitted functions do not fail the runner");
+}
+
+void testDependencies(unsigned numWorkers)
+{
+    Opm::TaskletRunner runner(numWorkers);
+
+    // a -> {b, c} -> d
+    std::atomic<int> counter{0};
+    auto a = runner.submit([&counter]() { return ++counter; });
+    auto b = runner.submit([&counter]() { return ++counter; },
+                           Opm::TaskletPriority::normal, {a});
+    auto c = runner.submit([&counter]() { return ++counter; },
+                           Opm::TaskletPriority::normal, {a});
+    auto d = runner.submit([&counter]() { return ++counter; },
+                           Opm::TaskletPriority::normal, {b, c});
+
+    check(d.get() == 4, "dependent function runs last");
+    check(a.get() == 1, "dependency runs first");
+    check(b.get() + c.get() == 5, "dependent functions run in between");
+
+    // a dependency which has already completed does not delay the function
+    auto e = runner.submit([]() { return 1; }, Opm::TaskletPriority::normal, {a, d});
+    check(e.get() == 1, "function with completed dependencies runs");
+
+    // the barrier waits for functions dispatched when their dependencies complete
+    std::atomic<int> numRun{0};
+    Opm::TaskletDependency last;
+    for (int i = 0; i < 100; ++i) {
+        last = runner.submit([&numRun]() { ++numRun; },
+                             Opm::TaskletPriority::normal, {last});
+    }
+    runner.barrier();
+    check(numRun == 100, "barrier waits for chains of dependent functions");
+}
+
+void testPriorities()
+{
+    Opm::TaskletRunner runner(1);
+
+    // keep the only worker busy until everything is queued
+    std::promise<void> release;
+    auto released = release.get_future().share();
+    runner.submit([released]() { released.wait(); });
+
+    std::mutex orderMutex;
+    std::vector<int> order;
+    auto record = [&order, &orderMutex](int value)
+    {
+        return [&order, &orderMutex, value]()
+        {
+            std::lock_guard<std::mutex> lock(orderMutex);
+            order.push_back(value);
+        };
+    };
+    runner.submit(record(2), Opm::TaskletPriority::low);
+    runner.submit(record(1), Opm::TaskletPriority::normal);
+    runner.submit(record(0), Opm::TaskletPriority::high);
+    release.set_value();
+    runner.barrier();
+
+    check(order == std::vector<int>{0, 1, 2}, "tasklets run in order of priority");
+}
+
+void testTasklets()
+{
+    // the tasklet interface used for asynchronous output keeps working
+    Opm::TaskletRunner runner(3);
+    std::atomic<int> numRun{0};
+    auto fn = [&numRun]() { ++numRun; };
+    runner.dispatchFunction(fn, /*numInvocations=*/10);
+    runner.barrier();
+    check(numRun == 10, "function tasklet runs the requested number of times");
+}
+
+// Measure the time from submitting a function until its result is available,
+// and the number of small functions completed per second.
+void benchmark(unsigned numWorkers)
+{
+    using Clock = std::chrono::steady_clock;
+    using Seconds = std::chrono::duration<double>;
+
+    Opm::TaskletRunner runner(numWorkers);
+
+    const int numLatency = 10000;
+    const auto latencyStart = Clock::now();
+    for (int i = 0; i < numLatency; ++i) {
+        runner.submit([i]() { return i; }).get();
+    }
+    const Seconds latency = (Clock::now() - latencyStart) / numLatency;
+
+    const int numThroughput = 200000;
+    std::atomic<long> sum{0};
+    const auto throughputStart = Clock::now();
+    for (int i = 0; i < numThroughput; ++i) {
+        runner.submit([&sum, i]() { sum += i; });
+    }
+    runner.barrier();
+    const Seconds throughputTime = Clock::now() - throughputStart;
+    check(sum == static_cast<long>(numThroughput) * (numThroughput - 1) / 2,
+          "all functions of the throughput benchmark ran");
+
+    std::cout << numWorkers << " worker threads: dispatch latency "
+              << latency.count() * 1e6 << " us, throughput "
+              << numThroughput / throughputTime.count() << " tasklets/s" << std::endl;
+}
+
+} // anonymous namespace
+
+int main()
+{
+    for (const unsigned numWorkers : {0u, 1u, 4u}) {
+        testResults(numWorkers);
+        testDependencies(numWorkers);
+    }
+    testPriorities();
+    testTasklets();
+
+    for (const unsigned numWorkers : {1u, 2u, 4u}) {
+        benchmark(numWorkers);
+    }
+
+    return numFailures == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
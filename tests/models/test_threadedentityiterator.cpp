@@ -0,0 +1,151 @@
+// -*- mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-
+// vi: set et ts=4 sw=4 sts=4:
+/*
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 2 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+
+  Consult the COPYING file in the top-level source directory of this
+  module for the precise wording of the license and the list of
+  copyright holders.
+*/
+/*!
+ * \file
+ *
+ * \brief Tests the threaded iteration over the elements of a grid view.
+ */
+#include "config.h"
+
+#define BOOST_TEST_MODULE ThreadedEntityIterator
+
+#include <boost/test/unit_test.hpp>
+
+#include <dune/grid/yaspgrid.hh>
+
+#include <opm/models/parallel/threadedentityiterator.hh>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+#include <array>
+#include <stdexcept>
+#include <vector>
+
+namespace {
+
+using Grid = Dune::YaspGrid<2>;
+using GridView = Grid::LeafGridView;
+using Iterator = Opm::ThreadedEntityIterator<GridView, /*codim=*/0>;
+
+// number of times each element is visited by a threaded loop
+std::vector<int> countVisits(const GridView& gridView, Iterator& threadedElemIt)
+{
+    std::vector<int> visits(gridView.size(0), 0);
+#ifdef _OPENMP
+#pragma omp parallel
+#endif
+    {
+        auto elemIt = threadedElemIt.beginParallel();
+        for (; !threadedElemIt.isFinished(elemIt); elemIt = threadedElemIt.increment()) {
+            const auto elemIdx = gridView.indexSet().index(*elemIt);
+#ifdef _OPENMP
+#pragma omp atomic
+#endif
+            ++visits[elemIdx];
+        }
+    }
+    return visits;
+}
+
+void checkVisitedOnce(const std::vector<int>& visits)
+{
+    for (const int count : visits) {
+        BOOST_CHECK_EQUAL(count, 1);
+    }
+}
+
+} // Anonymous namespace
+
+BOOST_AUTO_TEST_CASE(VisitsEveryElementOnce)
+{
+    const Grid grid({1.0, 1.0}, std::array<int, 2>{70, 50});
+    const auto gridView = grid.leafGridView();
+
+    Iterator threadedElemIt(gridView);
+    checkVisitedOnce(countVisits(gridView, threadedElemIt));
+}
+
+BOOST_AUTO_TEST_CASE(ReusesChunks)
+{
+    const Grid grid({1.0, 1.0}, std::array<int, 2>{70, 50});
+    const auto gridView = grid.leafGridView();
+
+    const auto chunks = Iterator::createChunks(gridView);
+    BOOST_REQUIRE(chunks.size() > 1);
+    BOOST_CHECK(chunks.front() == gridView.begin<0>());
+    BOOST_CHECK(chunks.back() == gridView.end<0>());
+
+    for (int loopIdx = 0; loopIdx < 3; ++loopIdx) {
+        Iterator threadedElemIt(gridView, chunks);
+        checkVisitedOnce(countVisits(gridView, threadedElemIt));
+    }
+
+    // the chunks of a small grid have a single element each
+    const Grid smallGrid({1.0, 1.0}, std::array<int, 2>{2, 2});
+    const auto smallGridView = smallGrid.leafGridView();
+    const auto smallChunks = Iterator::createChunks(smallGridView);
+    BOOST_CHECK_EQUAL(smallChunks.size(), 5u);
+    Iterator smallElemIt(smallGridView, smallChunks);
+    checkVisitedOnce(countVisits(smallGridView, smallElemIt));
+}
+
+BOOST_AUTO_TEST_CASE(RejectsEmptyChunks)
+{
+    const Grid grid({1.0, 1.0}, std::array<int, 2>{20, 10});
+    const Iterator::ChunkBoundaries chunks;
+    BOOST_CHECK_THROW(Iterator(grid.leafGridView(), chunks), std::logic_error);
+}
+
+#ifdef _OPENMP
+BOOST_AUTO_TEST_CASE(RejectsAdditionalThreads)
+{
+    const int maxThreads = omp_get_max_threads();
+    const Grid grid({1.0, 1.0}, std::array<int, 2>{70, 50});
+    const auto gridView = grid.leafGridView();
+
+    omp_set_num_threads(1);
+    Iterator threadedElemIt(gridView);
+    omp_set_num_threads(maxThreads);
+
+    int numThreads = 1;
+    int numFailed = 0;
+#pragma omp parallel num_threads(2) reduction(+:numFailed)
+    {
+#pragma omp single
+        numThreads = omp_get_num_threads();
+        try {
+            auto elemIt = threadedElemIt.beginParallel();
+            for (; !threadedElemIt.isFinished(elemIt); elemIt = threadedElemIt.increment()) {
+            }
+        }
+        catch (const std::logic_error&) {
+            ++numFailed;
+        }
+    }
+
+    // the second thread of the team, if any, has no state of its own
+    BOOST_CHECK_EQUAL(numFailed, numThreads - 1);
+}
+#endif
@@ -0,0 +1,73 @@
+#!/bin/bash
+
+# This runs flow on a deck with and without the compact intensive quantities
+# and reports the assembly time per linearization for each run. If perf is
+# available, the cache misses of the whole runs are reported as well, e.g.,
+#
+#   run-compact-iq-benchmark.sh -b build/bin -d opm-tests/norne/NORNE_ATW2013.DATA
+#   run-compact-iq-benchmark.sh -b build/bin -d SPE1CASE1.DATA -r 5 -- --threads-per-process=1
+
+if test $# -eq 0
+then
+  echo -e "Usage:\t$0 <options> -- [additional simulator options]"
+  echo -e "\tMandatory options:"
+  echo -e "\t\t -b <path>     Path to simulator binary"
+  echo -e "\t\t -d <filename> Deck to simulate"
+  echo -e "\tOptional options:"
+  echo -e "\t\t -e <filename> Simulator binary to use (default: flow)"
+  echo -e "\t\t -r <number>   Number of runs per setting, the fastest is reported (default: 3)"
+  exit 1
+fi
+
+OPTIND=1
+EXE_NAME=flow
+RUNS=3
+while getopts "b:d:e:r:" OPT
+do
+  case "${OPT}" in
+    b) BINPATH=${OPTARG} ;;
+    d) DECK=${OPTARG} ;;
+    e) EXE_NAME=${OPTARG} ;;
+    r) RUNS=${OPTARG} ;;
+  esac
+done
+shift $(($OPTIND-1))
+TEST_ARGS="$@"
+
+PERF=""
+if perf stat -e cache-misses true > /dev/null 2>&1
+then
+  PERF="perf stat -x, -e cache-references,cache-misses -o"
+fi
+
+OUTPUT_DIR=$(mktemp -d)
+trap "rm -rf ${OUTPUT_DIR}" EXIT
+
+printf "%8s %14s %18s %18s %16s\n" "compact" "assembly [s]" "linearizations" "per lin. [ms]" "cache misses"
+for COMPACT in false true
+do
+  BEST=""
+  for RUN in $(seq ${RUNS})
+  do
+    PERF_FILE=${OUTPUT_DIR}/perf-${COMPACT}-${RUN}.csv
+    OUTPUT=$(${PERF:+${PERF} ${PERF_FILE}} ${BINPATH}/${EXE_NAME} ${DECK} \
+               --output-dir=${OUTPUT_DIR} --enable-compact-intensive-quantities=${COMPACT} ${TEST_ARGS})
+    test $? -eq 0 || exit 1
+
+    ASM_TIME=$(echo "${OUTPUT}" | sed -n 's/^ *Assembly time: *\([0-9.e+-]*\) s.*/\1/p' | head -n 1)
+    NUM_LINS=$(echo "${OUTPUT}" | sed -n 's/^Overall Linearizations: *\([0-9]*\).*/\1/p' | head -n 1)
+    MISSES="-"
+    if test -n "${PERF}"
+    then
+      MISSES=$(sed -n 's/^\([0-9]*\),,cache-misses.*/\1/p' ${PERF_FILE})
+    fi
+    if test -z "${BEST}" || awk "BEGIN { exit !(${ASM_TIME} < ${BEST}) }"
+    then
+      BEST=${ASM_TIME}
+      BEST_LINS=${NUM_LINS}
+      BEST_MISSES=${MISSES}
+    fi
+  done
+  PER_LIN=$(awk "BEGIN { printf \"%.3f\", 1000 * ${BEST} / ${BEST_LINS} }")
+  printf "%8s %14s %18s %18s %16s\n" ${COMPACT} ${BEST} ${BEST_LINS} ${PER_LIN} ${BEST_MISSES}
+done
@@ -0,0 +1,55 @@
+#!/bin/bash
+
+# This runs a simulator with an increasing number of threads per process and
+# reports the simulation and linearization times for each run, e.g.,
+#
+#   run-thread-scaling-benchmark.sh -b build/bin -e lens_immiscible_ecfv_ad -- --end-time=3000
+#   run-thread-scaling-benchmark.sh -b build/bin -e finger_immiscible_ecfv
+#
+# For the vertex-centered models, the colored linearization can be compared to
+# locking the global system of equations for every element, e.g.,
+#
+#   run-thread-scaling-benchmark.sh -b build/bin -e lens_immiscible_vcfv_ad
+#   run-thread-scaling-benchmark.sh -b build/bin -e lens_immiscible_vcfv_ad -- --colored-linearization=true
+
+if test $# -eq 0
+then
+  echo -e "Usage:\t$0 <options> -- [additional simulator options]"
+  echo -e "\tMandatory options:"
+  echo -e "\t\t -b <path>     Path to simulator binary"
+  echo -e "\t\t -e <filename> Simulator binary to use"
+  echo -e "\tOptional options:"
+  echo -e "\t\t -t <list>     Thread counts to use (default: \"1 2 4 8 16 32 64\")"
+  exit 1
+fi
+
+OPTIND=1
+THREADS="1 2 4 8 16 32 64"
+while getopts "b:e:t:" OPT
+do
+  case "${OPT}" in
+    b) BINPATH=${OPTARG} ;;
+    e) EXE_NAME=${OPTARG} ;;
+    t) THREADS=${OPTARG} ;;
+  esac
+done
+shift $(($OPTIND-1))
+TEST_ARGS="$@"
+
+printf "%8s %18s %18s %10s\n" "threads" "simulation [s]" "linearization [s]" "speedup"
+BASE_TIME=""
+for NUM_THREADS in ${THREADS}
+do
+  OUTPUT=$(OMP_NUM_THREADS=${NUM_THREADS} ${BINPATH}/${EXE_NAME} \
+             --threads-per-process=${NUM_THREADS} --enable-vtk-output=false ${TEST_ARGS})
+  test $? -eq 0 || exit 1
+
+  SIM_TIME=$(echo "${OUTPUT}" | sed -n 's/^Simulation time: \([0-9.e+-]*\) seconds.*/\1/p')
+  LIN_TIME=$(echo "${OUTPUT}" | sed -n 's/^ *Linearization time: \([0-9.e+-]*\) seconds.*/\1/p')
+  if test -z "${BASE_TIME}"
+  then
+    BASE_TIME=${SIM_TIME}
+  fi
+  SPEEDUP=$(awk "BEGIN { printf \"%.2f\", ${BASE_TIME} / ${SIM_TIME} }")
+  printf "%8s %18s %18s %10s\n" ${NUM_THREADS} ${SIM_TIME} ${LIN_TIME} ${SPEEDUP}
+done
@@ -56,6 +56,63 @@ BOOST_AUTO_TEST_CASE(ReadWrite)
     std::filesystem::remove(path);
 }
 
+BOOST_AUTO_TEST_CASE(ReadWriteChunked)
+{
+    auto path = std::filesystem::temp_directory_path() / Opm::unique_path("hdf5test%%%%%");
+    std::filesystem::create_directory(path);
+    auto rwpath = (path / "chunked.hdf5").string();
+#if HAVE_MPI
+    Opm::Parallel::Communication comm{MPI_COMM_SELF};
+#else
+    Opm::Parallel::Communication comm{};
+#endif
+    const std::vector<char> test_data{1,2,3,4,5,6,8,9,10,11};
+    for (const int level : {0, 1, 9}) {
+        Opm::HDF5File::DataSetSettings settings;
+        settings.compressionLevel = level;
+        settings.maxChunkSize = 3;
+        {
+            Opm::HDF5File out_file(rwpath, Opm::HDF5File::OpenMode::OVERWRITE, comm, settings);
+            BOOST_CHECK_NO_THROW(out_file.write("/test_data", "d1", test_data));
+            BOOST_CHECK_NO_THROW(out_file.write("/test_data", "empty", std::vector<char>{}));
+            BOOST_CHECK_NO_THROW(out_file.write("/test_data", "d2", test_data,
+                                                Opm::HDF5File::DataSetMode::ROOT_ONLY));
+        }
+        {
+            Opm::HDF5File in_file(rwpath, Opm::HDF5File::OpenMode::READ, comm);
+            std::vector<char> data;
+            BOOST_CHECK_NO_THROW(in_file.read("/test_data", "d1", data));
+            BOOST_CHECK_EQUAL_COLLECTIONS(data.begin(), data.end(),
+                                          test_data.begin(), test_data.end());
+            BOOST_CHECK_NO_THROW(in_file.read("/test_data", "empty", data));
+            BOOST_CHECK(data.empty());
+            BOOST_CHECK_NO_THROW(in_file.read("/test_data", "d2", data,
+                                              Opm::HDF5File::DataSetMode::ROOT_ONLY));
+            BOOST_CHECK_EQUAL_COLLECTIONS(data.begin(), data.end(),
+                                          test_data.begin(), test_data.end());
+        }
+    }
+    std::filesystem::remove(rwpath);
+    std::filesystem::remove(path);
+}
+
+BOOST_AUTO_TEST_CASE(InvalidSettings)
+{
+#if HAVE_MPI
+    Opm::Parallel::Communication comm{MPI_COMM_SELF};
+#else
+    Opm::Parallel::Communication comm{};
+#endif
+    Opm::HDF5File::DataSetSettings settings;
+    settings.compressionLevel = 10;
+    BOOST_CHECK_THROW(Opm::HDF5File("invalid.hdf5", Opm::HDF5File::OpenMode::OVERWRITE,
+                                    comm, settings), std::invalid_argument);
+    settings.compressionLevel = 1;
+    settings.maxChunkSize = 0;
+    BOOST_CHECK_THROW(Opm::HDF5File("invalid.hdf5", Opm::HDF5File::OpenMode::OVERWRITE,
+                                    comm, settings), std::invalid_argument);
+}
+
 BOOST_AUTO_TEST_CASE(ThrowOpenNonexistent)
 {
 #if HAVE_MPI
@@ -23,6 +23,8 @@
 
 #include <opm/simulators/utils/HDF5Serializer.hpp>
 
+#include <opm/simulators/flow/SimulatorSerializer.hpp>
+
 #include <opm/input/eclipse/Schedule/Group/Group.hpp>
 #include <opm/simulators/utils/ParallelCommunication.hpp>
 
@@ -30,7 +32,9 @@
 #define BOOST_TEST_NO_MAIN
 #include <boost/test/unit_test.hpp>
 
+#include <algorithm>
 #include <filesystem>
+#include <vector>
 
 using namespace Opm;
 
@@ -94,6 +98,126 @@ BOOST_AUTO_TEST_CASE(WriteRead)
     std::filesystem::remove(path);
 }
 
+BOOST_AUTO_TEST_CASE(WriteReadDelta)
+{
+    auto path = std::filesystem::temp_directory_path() / Opm::unique_path("hdf5test%%%%%");
+    std::filesystem::create_directory(path);
+    auto rwpath = (path / "rw.hdf5").string();
+#if HAVE_MPI
+    Parallel::Communication comm(MPI_COMM_SELF);
+#else
+    Parallel::Communication comm{};
+#endif
+    std::vector<double> base(10000);
+    for (std::size_t i = 0; i < base.size(); ++i) {
+        base[i] = 0.5 * i;
+    }
+
+    // one changed value, a grown and a shrunk state
+    auto changed = base;
+    changed[1234] = -1.0;
+    auto grown = changed;
+    grown.resize(12345, 2.0);
+    auto shrunk = base;
+    shrunk.resize(5000);
+
+    {
+        HDF5Serializer ser(rwpath, HDF5File::OpenMode::OVERWRITE, comm);
+        ser.write(base, "/report_step/1", "data");
+        const auto baseBuffer = ser.buffer();
+        ser.setDeltaBase("data", "/report_step/1", baseBuffer);
+        ser.write(changed, "/report_step/2", "data");
+        ser.write(grown, "/report_step/3", "data");
+        ser.write(shrunk, "/report_step/4", "data");
+        // other datasets are written in full
+        ser.write(base, "/report_step/4", "other");
+    }
+    {
+        HDF5File file(rwpath, HDF5File::OpenMode::READ, comm);
+        const auto entries = file.list("/report_step/2");
+        BOOST_REQUIRE_EQUAL(entries.size(), 1u);
+        BOOST_CHECK_EQUAL(entries[0], "data_delta");
+
+        // only the changed block is stored
+        std::vector<char> delta;
+        file.read("/report_step/2", "data_delta", delta);
+        BOOST_CHECK_LT(delta.size(), 2 * HDF5Serializer::deltaBlockSize);
+    }
+    {
+        HDF5Serializer ser(rwpath, HDF5File::OpenMode::READ, comm);
+        std::vector<double> input;
+        ser.read(input, "/report_step/1", "data");
+        BOOST_CHECK(input == base);
+        ser.read(input, "/report_step/2", "data");
+        BOOST_CHECK(input == changed);
+        ser.read(input, "/report_step/3", "data");
+        BOOST_CHECK(input == grown);
+        ser.read(input, "/report_step/4", "data");
+        BOOST_CHECK(input == shrunk);
+        ser.read(input, "/report_step/4", "other");
+        BOOST_CHECK(input == base);
+    }
+
+    std::filesystem::remove(rwpath);
+    std::filesystem::remove(path);
+}
+
+BOOST_AUTO_TEST_CASE(CompactDelta)
+{
+    auto path = std::filesystem::temp_directory_path() / Opm::unique_path("hdf5test%%%%%");
+    std::filesystem::create_directory(path);
+    auto rwpath = (path / "rw.hdf5").string();
+    auto compactpath = (path / "compact.hdf5").string();
+#if HAVE_MPI
+    Parallel::Communication comm(MPI_COMM_SELF);
+#else
+    Parallel::Communication comm{};
+#endif
+    std::vector<double> base(1000, 1.0);
+    auto changed = base;
+    changed[10] = 2.0;
+    double time = 1.0;
+
+    {
+        HDF5Serializer ser(rwpath, HDF5File::OpenMode::OVERWRITE, comm);
+        ser.writeHeader("foo", "bar", "foobar", "bob", "bobbar", 1);
+        ser.write(base, "/report_step/1", "simulator_data");
+        const auto baseBuffer = ser.buffer();
+        ser.write(time, "/report_step/1", "simulator_timer",
+                  HDF5File::DataSetMode::ROOT_ONLY);
+        ser.setDeltaBase("simulator_data", "/report_step/1", baseBuffer);
+        ser.write(changed, "/report_step/2", "simulator_data");
+        ser.write(time, "/report_step/2", "simulator_timer",
+                  HDF5File::DataSetMode::ROOT_ONLY);
+    }
+
+    SimulatorSerializer::compact(rwpath, compactpath, comm);
+
+    {
+        HDF5File file(compactpath, HDF5File::OpenMode::READ, comm);
+        const auto entries = file.list("/report_step/2");
+        BOOST_CHECK(std::find(entries.begin(), entries.end(), "simulator_data") != entries.end());
+        BOOST_CHECK(std::find(entries.begin(), entries.end(), "simulator_data_delta") == entries.end());
+    }
+    {
+        HDF5Serializer ser(compactpath, HDF5File::OpenMode::READ, comm);
+        BOOST_CHECK_EQUAL(ser.lastReportStep(), 2);
+        std::vector<double> input;
+        ser.read(input, "/report_step/1", "simulator_data");
+        BOOST_CHECK(input == base);
+        ser.read(input, "/report_step/2", "simulator_data");
+        BOOST_CHECK(input == changed);
+        double inputTime = 0.0;
+        ser.read(inputTime, "/report_step/2", "simulator_timer",
+                 HDF5File::DataSetMode::ROOT_ONLY);
+        BOOST_CHECK_EQUAL(inputTime, time);
+    }
+
+    std::filesystem::remove(rwpath);
+    std::filesystem::remove(compactpath);
+    std::filesystem::remove(path);
+}
+
 bool init_unit_test_func()
 {
     return true;
@@ -31,8 +31,12 @@
 #define BOOST_TEST_NO_MAIN
 #include <boost/test/unit_test.hpp>
 
+#include <algorithm>
+#include <chrono>
+#include <cmath>
 #include <filesystem>
 #include <string>
+#include <vector>
 
 using namespace Opm;
 
@@ -107,6 +111,76 @@ BOOST_AUTO_TEST_CASE(WriteRead)
     std::filesystem::remove(path);
 }
 
+// Time the writing and reading of a checkpoint with a few doubles per
+// cell on every process, and report the file size, for a selection of
+// compression levels. Run with --log_level=message to see the numbers.
+BOOST_AUTO_TEST_CASE(CheckpointBenchmark)
+{
+    using Clock = std::chrono::steady_clock;
+    using Seconds = std::chrono::duration<double>;
+
+    Parallel::Communication comm;
+    std::string path = std::filesystem::temp_directory_path() / Opm::unique_path("hdf5test%%%%%");
+    std::size_t size = path.size();
+    comm.broadcast(&size, 1, 0);
+    if (comm.rank() != 0) {
+        path.resize(size);
+    }
+    comm.broadcast(path.data(), size, 0);
+    std::filesystem::create_directories(path);
+    auto rwpath = (std::filesystem::path(path) / "rw.hdf5").string();
+
+    // pressure and saturation like fields of a partition of 100k cells
+    const std::size_t numCells = 100000;
+    std::vector<double> output(3 * numCells);
+    for (std::size_t cell = 0; cell < numCells; ++cell) {
+        const double depth = 2000.0 + 0.01 * (cell + numCells * comm.rank());
+        output[3 * cell + 0] = 1.0e5 * (1.0 + 0.1 * depth);
+        output[3 * cell + 1] = cell % 7 == 0 ? 0.2 : 1.0;
+        output[3 * cell + 2] = std::max(0.0, std::sin(0.001 * cell));
+    }
+
+    for (const int level : {0, 1, 6}) {
+        HDF5File::DataSetSettings settings;
+        settings.compressionLevel = level;
+
+        comm.barrier();
+        const auto writeStart = Clock::now();
+        {
+            HDF5Serializer ser(rwpath, HDF5File::OpenMode::OVERWRITE, comm, settings);
+            ser.write(output, "/report_step/1", "state");
+        }
+        comm.barrier();
+        const Seconds writeTime = Clock::now() - writeStart;
+
+        const auto readStart = Clock::now();
+        std::vector<double> input;
+        {
+            HDF5Serializer ser(rwpath, HDF5File::OpenMode::READ, comm);
+            ser.read(input, "/report_step/1", "state");
+        }
+        comm.barrier();
+        const Seconds readTime = Clock::now() - readStart;
+
+        BOOST_CHECK(input == output);
+        if (comm.rank() == 0) {
+            BOOST_TEST_MESSAGE("compression level " << level << ": "
+                               << std::filesystem::file_size(rwpath) << " bytes, write "
+                               << writeTime.count() << " s, read "
+                               << readTime.count() << " s");
+        }
+        comm.barrier();
+        if (comm.rank() == 0) {
+            std::filesystem::remove(rwpath);
+        }
+    }
+
+    comm.barrier();
+    if (comm.rank() == 0) {
+        std::filesystem::remove(path);
+    }
+}
+
 bool init_unit_test_func()
 {
     return true;
@@ -0,0 +1,206 @@
+/*
+  Copyright 2025 Equinor ASA.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#include <config.h>
+
+#define BOOST_TEST_MODULE CollectDataOnIORankTest
+#define BOOST_TEST_NO_MAIN
+
+#include <boost/test/unit_test.hpp>
+
+#include <opm/simulators/flow/CollectDataOnIORank.hpp>
+
+#include <opm/grid/CpGrid.hpp>
+#include <opm/grid/common/CartesianIndexMapper.hpp>
+
+#include <opm/input/eclipse/Schedule/Well/WellTestState.hpp>
+#include <opm/input/eclipse/Units/UnitSystem.hpp>
+
+#include <opm/output/data/Aquifer.hpp>
+#include <opm/output/data/Groups.hpp>
+#include <opm/output/data/Solution.hpp>
+#include <opm/output/data/Wells.hpp>
+
+#include <dune/common/parallel/mpihelper.hh>
+#include <dune/grid/common/mcmgmapper.hh>
+
+#include <array>
+#include <cstddef>
+#include <map>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace {
+
+using Grid = Dune::CpGrid;
+using GridView = Grid::LeafGridView;
+using CartesianIndexMapper = Dune::CartesianIndexMapper<Grid>;
+using Collector = Opm::CollectDataOnIORank<Grid, Grid, GridView>;
+using MessageBufferType = Collector::P2PCommunicatorType::MessageBufferType;
+
+//! \brief A grid distributed over all ranks, with the undistributed
+//!        grid kept on the I/O rank as in the simulator.
+struct DistributedGrid
+{
+    DistributedGrid()
+    {
+        grid.createCartesian({5, 4, 3}, {1.0, 1.0, 1.0});
+        if (grid.comm().rank() == Collector::ioRank) {
+            equilGrid = std::make_unique<Grid>(grid);
+            equilCartMapper = std::make_unique<CartesianIndexMapper>(*equilGrid);
+        }
+        grid.loadBalance();
+        cartMapper = std::make_unique<CartesianIndexMapper>(grid);
+    }
+
+    std::unique_ptr<Collector> collector(bool asynchronous) const
+    {
+        auto result = std::make_unique<Collector>(grid, equilGrid.get(), grid.leafGridView(),
+                                                  *cartMapper, equilCartMapper.get());
+        result->setAsynchronous(asynchronous);
+        return result;
+    }
+
+    Grid grid;
+    std::unique_ptr<Grid> equilGrid;
+    std::unique_ptr<CartesianIndexMapper> cartMapper;
+    std::unique_ptr<CartesianIndexMapper> equilCartMapper;
+};
+
+//! \brief Output data of the local cells and wells, depending on the step.
+struct LocalData
+{
+    LocalData(const DistributedGrid& dgrid, int step)
+    {
+        const auto& gridView = dgrid.grid.leafGridView();
+        Dune::MultipleCodimMultipleGeomTypeMapper<GridView> elemMapper(gridView, Dune::mcmgElementLayout());
+        const int rank = dgrid.grid.comm().rank();
+
+        std::vector<double> pressure(gridView.size(0), -1.0);
+        std::vector<double> swat(gridView.size(0), -1.0);
+        for (const auto& elem : elements(gridView, Dune::Partitions::interior)) {
+            const auto elemIdx = elemMapper.index(elem);
+            const int cartIdx = dgrid.cartMapper->cartesianIndex(elemIdx);
+            pressure[elemIdx] = 1.0e5 + 1.0e3 * cartIdx + 0.125 * step;
+            swat[elemIdx] = 0.01 * ((cartIdx + step) % 100);
+            if (cartIdx % 7 == step % 7) {
+                blockData[{"BPR", cartIdx + 1}] = pressure[elemIdx];
+            }
+        }
+        cellData.insert("PRESSURE", Opm::UnitSystem::measure::pressure,
+                        std::move(pressure), Opm::data::TargetType::RESTART_SOLUTION);
+        cellData.insert("SWAT", Opm::UnitSystem::measure::identity,
+                        std::move(swat), Opm::data::TargetType::RESTART_SOLUTION);
+
+        auto& well = wellData["W" + std::to_string(rank)];
+        well.bhp = 2.0e5 + 1.0e3 * rank + step;
+        well.rates.set(Opm::data::Rates::opt::wat, 0.5 * rank + step);
+    }
+
+    void collect(Collector& collector) const
+    {
+        collector.collect(cellData, blockData, wellData,
+                          Opm::data::WellBlockAveragePressures{},
+                          Opm::data::GroupAndNetworkValues{},
+                          Opm::data::Aquifers{},
+                          Opm::WellTestState{},
+                          Opm::InterRegFlowMap{},
+                          std::array<Opm::FlowsData<double>, 3>{},
+                          std::array<Opm::FlowsData<double>, 3>{});
+    }
+
+    Opm::data::Solution cellData;
+    std::map<std::pair<std::string, int>, double> blockData;
+    Opm::data::Wells wellData;
+};
+
+std::vector<char> serializedWells(const Opm::data::Wells& wells)
+{
+    MessageBufferType buffer;
+    wells.write(buffer);
+    const auto [data, size] = buffer.buffer();
+    return {data, data + size};
+}
+
+void checkSameGlobalData(const Collector& blocking, const Collector& asynchronous)
+{
+    BOOST_REQUIRE(blocking.isIORank());
+    BOOST_REQUIRE_EQUAL(blocking.globalCellData().size(), asynchronous.globalCellData().size());
+    for (const auto& [name, cells] : blocking.globalCellData()) {
+        const auto& expected = cells.data<double>();
+        const auto& actual = asynchronous.globalCellData().data<double>(name);
+        BOOST_CHECK_EQUAL_COLLECTIONS(expected.begin(), expected.end(),
+                                      actual.begin(), actual.end());
+    }
+
+    BOOST_CHECK(blocking.globalBlockData() == asynchronous.globalBlockData());
+
+    const auto expectedWells = serializedWells(blocking.globalWellData());
+    const auto actualWells = serializedWells(asynchronous.globalWellData());
+    BOOST_CHECK_EQUAL_COLLECTIONS(expectedWells.begin(), expectedWells.end(),
+                                  actualWells.begin(), actualWells.end());
+}
+
+bool init_unit_test_func()
+{
+    return true;
+}
+
+} // Anonymous namespace
+
+BOOST_AUTO_TEST_CASE(AsynchronousGatherMatchesBlocking)
+{
+    const DistributedGrid dgrid;
+    auto blocking = dgrid.collector(/*asynchronous=*/false);
+    auto asynchronous = dgrid.collector(/*asynchronous=*/true);
+
+    // Several gathers in a row, such that the sends of one step are
+    // completed while the next step is gathered.
+    for (int step = 0; step < 3; ++step) {
+        const LocalData local(dgrid, step);
+        local.collect(*blocking);
+        local.collect(*asynchronous);
+
+        if (blocking->isIORank() && blocking->isParallel()) {
+            BOOST_REQUIRE_EQUAL(blocking->globalWellData().size(),
+                                static_cast<std::size_t>(dgrid.grid.comm().size()));
+            checkSameGlobalData(*blocking, *asynchronous);
+        }
+    }
+
+    // Consecutive asynchronous gathers without a blocking one in between.
+    for (int step = 3; step < 5; ++step) {
+        const LocalData local(dgrid, step);
+        local.collect(*asynchronous);
+    }
+    const LocalData last(dgrid, 5);
+    last.collect(*asynchronous);
+    last.collect(*blocking);
+    if (blocking->isIORank() && blocking->isParallel()) {
+        checkSameGlobalData(*blocking, *asynchronous);
+    }
+}
+
+int main(int argc, char** argv)
+{
+    Dune::MPIHelper::instance(argc, argv);
+
+    return boost::unit_test::unit_test_main(&init_unit_test_func, argc, argv);
+}
@@ -98,3 +98,25 @@ BOOST_AUTO_TEST_CASE(deferredlogger)
     BOOST_CHECK_EQUAL(log_stream.str(), expected);
 
 }
+
+BOOST_AUTO_TEST_CASE(deferredlogger_append)
+{
+    const std::string expected = Log::prefixMessage(Log::MessageType::Info, "info 1") + "\n"
+        + Log::prefixMessage(Log::MessageType::Warning, "warning 1") + "\n"
+        + Log::prefixMessage(Log::MessageType::Info, "info 2") + "\n";
+
+    std::ostringstream log_stream;
+    initLogger(log_stream);
+    auto first = Opm::DeferredLogger();
+    auto second = Opm::DeferredLogger();
+    second.warning("warning 1");
+    first.info("info 1");
+    second.info("info 2");
+
+    first.append(second);
+    second.logMessages();
+    BOOST_CHECK_EQUAL(log_stream.str(), "");
+
+    first.logMessages();
+    BOOST_CHECK_EQUAL(log_stream.str(), expected);
+}
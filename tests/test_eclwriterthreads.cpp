@@ -0,0 +1,192 @@
+// -*- mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-
+// vi: set et ts=4 sw=4 sts=4:
+/*
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+
+  Consult the COPYING file in the top-level source directory of this
+  module for the precise wording of the license and the list of
+  copyright holders.
+*/
+#include "config.h"
+#include "TestTypeTag.hpp"
+
+#define BOOST_TEST_MODULE EclWriterThreads
+
+#include <opm/models/parallel/threadmanager.hpp>
+#include <opm/models/utils/parametersystem.hpp>
+#include <opm/models/utils/propertysystem.hh>
+#include <opm/models/utils/start.hh>
+
+#include <opm/output/data/Solution.hpp>
+#include <opm/output/eclipse/Inplace.hpp>
+
+#include <opm/simulators/flow/BlackoilModelParameters.hpp>
+#include <opm/simulators/flow/FlowGenericVanguard.hpp>
+
+#if HAVE_DUNE_FEM
+#include <dune/fem/misc/mpimanager.hh>
+#else
+#include <dune/common/parallel/mpihelper.hh>
+#endif
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+#include <map>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <boost/test/unit_test.hpp>
+
+namespace {
+
+using TypeTag = Opm::Properties::TTag::TestTypeTag;
+using Simulator = Opm::GetPropType<TypeTag, Opm::Properties::Simulator>;
+
+constexpr const char* deckName = "TESTECLWRITERTHREADS.DATA";
+
+std::unique_ptr<Simulator>
+initSimulator(const int numThreads)
+{
+    using namespace Opm;
+
+    const std::string filenameArg = std::string {"--ecl-deck-file-name="} + deckName;
+    const std::string threadsArg = "--threads-per-process=" + std::to_string(numThreads);
+
+    const char* argv[] = {
+        "test_eclwriterthreads",
+        filenameArg.c_str(),
+        threadsArg.c_str(),
+        "--check-satfunc-consistency=false",
+    };
+
+    Parameters::reset();
+    registerAllParameters_<TypeTag>(false);
+    registerEclTimeSteppingParameters<double>();
+    BlackoilModelParameters<double>::registerParameters();
+    Parameters::Register<Parameters::EnableTerminalOutput>("Do *NOT* use!");
+    Parameters::endRegistration();
+    setupParameters_<TypeTag>(/*argc=*/sizeof(argv) / sizeof(argv[0]),
+                              argv, /*registerParams=*/false);
+
+    // The output elements are chunked for the number of threads of the
+    // thread manager.
+    ThreadManager::init();
+
+    FlowGenericVanguard::readDeck(deckName);
+    return std::make_unique<Simulator>();
+}
+
+struct LocalCellData
+{
+    Opm::data::Solution solution;
+    std::map<std::pair<std::string, int>, double> blockData;
+    std::map<std::string, double> miscSummaryData;
+    std::map<std::string, std::vector<double>> regionData;
+    Opm::Inplace inplace;
+};
+
+// Prepare the output of the initial solution and return the cell arrays,
+// the block values and the fluid in place sums of the field and regions.
+LocalCellData prepareLocalCellData(const int numThreads)
+{
+    auto simulator = initSimulator(numThreads);
+
+    simulator->model().applyInitialSolution();
+    simulator->setEpisodeIndex(-1);
+    simulator->setEpisodeLength(0.0);
+    simulator->startNextEpisode(/*episodeStartTime=*/0.0, /*episodeLength=*/1e30);
+    simulator->setEpisodeIndex(0);
+    simulator->model().invalidateAndUpdateIntensiveQuantities(/*timeIdx=*/0);
+    simulator->problem().wellModel().beginReportStep(/*time_step=*/0);
+
+    auto& eclWriter = *simulator->problem().eclWriter();
+    auto& outputModule = eclWriter.mutableOutputModule();
+    outputModule.invalidateLocalData();
+    eclWriter.prepareLocalCellData(/*isSubStep=*/false, /*reportStepNum=*/1);
+
+    LocalCellData result;
+    outputModule.assignToSolution(result.solution);
+    result.blockData = outputModule.getBlockData();
+    result.inplace = outputModule.calc_inplace(result.miscSummaryData,
+                                               result.regionData,
+                                               simulator->gridView().comm());
+    return result;
+}
+
+struct EclWriterThreadsFixture
+{
+    EclWriterThreadsFixture()
+    {
+        int argc = boost::unit_test::framework::master_test_suite().argc;
+        char** argv = boost::unit_test::framework::master_test_suite().argv;
+#if HAVE_DUNE_FEM
+        Dune::Fem::MPIManager::initialize(argc, argv);
+#else
+        Dune::MPIHelper::instance(argc, argv);
+#endif
+        Opm::FlowGenericVanguard::setCommunication(std::make_unique<Opm::Parallel::Communication>());
+    }
+};
+
+} // Anonymous namespace
+
+BOOST_GLOBAL_FIXTURE(EclWriterThreadsFixture);
+
+BOOST_AUTO_TEST_CASE(LocalCellDataPrepared)
+{
+    const auto result = prepareLocalCellData(/*numThreads=*/1);
+    BOOST_CHECK(result.solution.has("PRESSURE"));
+    BOOST_CHECK_EQUAL(result.blockData.size(), 5u);
+    BOOST_CHECK_EQUAL(result.regionData.at("ROIP").size(), 2u);
+}
+
+#ifdef _OPENMP
+// The cell arrays are written per cell, and the contributions shared
+// between cells are merged in the order of the elements, so both must be
+// the same bit by bit for any number of threads.  The fluid in place sums
+// are accumulated after the parallel passes and must match as well.
+BOOST_AUTO_TEST_CASE(IndependentOfThreads)
+{
+    const int maxThreads = omp_get_max_threads();
+
+    const auto serial = prepareLocalCellData(/*numThreads=*/1);
+    const auto threaded = prepareLocalCellData(/*numThreads=*/4);
+
+    // Restore the number of threads for the remaining tests.
+    omp_set_num_threads(maxThreads);
+    Opm::ThreadManager::init(/*queryCommandLineParameter=*/false);
+
+    BOOST_REQUIRE_EQUAL(serial.solution.size(), threaded.solution.size());
+    for (const auto& [name, cells] : serial.solution) {
+        BOOST_TEST_CONTEXT("Cell array " << name) {
+            BOOST_REQUIRE(threaded.solution.has(name));
+            const auto& expected = cells.data<double>();
+            const auto& actual = threaded.solution.data<double>(name);
+            BOOST_CHECK_EQUAL_COLLECTIONS(expected.begin(), expected.end(),
+                                          actual.begin(), actual.end());
+        }
+    }
+
+    BOOST_CHECK(serial.blockData == threaded.blockData);
+    BOOST_CHECK(serial.miscSummaryData == threaded.miscSummaryData);
+    BOOST_CHECK(serial.regionData == threaded.regionData);
+    BOOST_CHECK(serial.inplace == threaded.inplace);
+}
+#endif
@@ -59,6 +59,10 @@
 #include <dune/common/parallel/mpihelper.hh>
 #endif
 
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
 #include <array>
 #include <cstdlib>
 #include <cstring>
@@ -1407,3 +1411,54 @@ BOOST_AUTO_TEST_CASE(DeckWithSwatinit)
     }
 #endif
 }
+
+#ifdef _OPENMP
+namespace {
+
+// Equilibrate a deck with the given number of threads and return the
+// phase pressures and saturations, followed by Rs, Rv and Rvw.
+std::vector<std::vector<double>> equilibrate(const char* filename, const int numThreads)
+{
+    using TypeTag = Opm::Properties::TTag::TestEquilTypeTag;
+    auto simulator = initSimulator<TypeTag>(filename);
+
+    const int maxThreads = omp_get_max_threads();
+    omp_set_num_threads(numThreads);
+    EquilFixture::Initializer comp(*simulator->problem().materialLawManager(),
+                                   simulator->vanguard().eclState(),
+                                   simulator->vanguard().grid(),
+                                   simulator->vanguard().gridView(),
+                                   simulator->vanguard().cartesianMapper(), 9.80665);
+    omp_set_num_threads(maxThreads);
+
+    std::vector<std::vector<double>> result(comp.press().begin(), comp.press().end());
+    result.insert(result.end(), comp.saturation().begin(), comp.saturation().end());
+    result.push_back(comp.rs());
+    result.push_back(comp.rv());
+    result.push_back(comp.rvw());
+    return result;
+}
+
+} // Anonymous namespace
+
+// The cells are equilibrated concurrently, each thread with its own copy of
+// the saturation calculator, so the result must not depend on the number
+// of threads. The SWATINIT deck covers the copy of the SWATINIT data.
+BOOST_AUTO_TEST_CASE(IndependentOfThreads)
+{
+    for (const char* filename : {"equil_capillary.DATA",
+                                 "equil_capillary_swatinit.DATA",
+                                 "equil_rsvd_and_rvvd.DATA"}) {
+        BOOST_TEST_MESSAGE("Deck " << filename);
+        const auto serial = equilibrate(filename, 1);
+        const auto threaded = equilibrate(filename, 4);
+        BOOST_REQUIRE_EQUAL(serial.size(), threaded.size());
+        for (std::size_t i = 0; i < serial.size(); ++i) {
+            BOOST_REQUIRE_EQUAL(serial[i].size(), threaded[i].size());
+            for (std::size_t cell = 0; cell < serial[i].size(); ++cell) {
+                BOOST_CHECK_EQUAL(serial[i][cell], threaded[i][cell]);
+            }
+        }
+    }
+}
+#endif
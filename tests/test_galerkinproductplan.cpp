@@ -0,0 +1,147 @@
+/*
+  Copyright 2025 Equinor ASA.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#include <config.h>
+
+#include <dune/common/fmatrix.hh>
+#include <dune/istl/bcrsmatrix.hh>
+#include <dune/istl/bvector.hh>
+#include <dune/istl/paamg/aggregates.hh>
+#include <dune/istl/paamg/galerkin.hh>
+#include <dune/istl/paamg/pinfo.hh>
+
+#include <opm/simulators/linalg/amgcpr.hh>
+
+#define BOOST_TEST_MODULE GalerkinProductPlanTest
+#include <boost/test/unit_test.hpp>
+
+#include <cstddef>
+#include <set>
+#include <vector>
+
+namespace {
+
+using Block = Dune::FieldMatrix<double, 1, 1>;
+using Matrix = Dune::BCRSMatrix<Block>;
+using AggregatesMap = Dune::Amg::AggregatesMap<std::size_t>;
+
+//! \brief Tridiagonal matrix with a couple of longer range couplings.
+Matrix createFineMatrix(std::size_t n)
+{
+    Matrix A(n, n, Matrix::random);
+    for (std::size_t i = 0; i < n; ++i) {
+        A.setrowsize(i, 1 + (i > 0) + (i + 1 < n) + (i + 3 < n) + (i >= 3));
+    }
+    A.endrowsizes();
+    for (std::size_t i = 0; i < n; ++i) {
+        for (std::size_t j = (i >= 3 ? i - 3 : 0); j < n && j <= i + 3; ++j) {
+            if (j + 1 == i || j == i || j == i + 1 || j + 3 == i || j == i + 3) {
+                A.addindex(i, j);
+            }
+        }
+    }
+    A.endindices();
+    for (std::size_t i = 0; i < n; ++i) {
+        for (auto col = A[i].begin(); col != A[i].end(); ++col) {
+            *col = (col.index() == i) ? 4.0 + 0.1*i : -1.0 - 0.01*(i + col.index());
+        }
+    }
+    return A;
+}
+
+//! \brief The coarse matrix with the sparsity pattern of the Galerkin product.
+Matrix createCoarseMatrix(const Matrix& fine, const AggregatesMap& aggregates, std::size_t numAggregates)
+{
+    std::vector<std::set<std::size_t>> pattern(numAggregates);
+    for (auto row = fine.begin(); row != fine.end(); ++row) {
+        if (aggregates[row.index()] == AggregatesMap::ISOLATED) {
+            continue;
+        }
+        for (auto col = row->begin(); col != row->end(); ++col) {
+            if (aggregates[col.index()] != AggregatesMap::ISOLATED) {
+                pattern[aggregates[row.index()]].insert(aggregates[col.index()]);
+            }
+        }
+    }
+    Matrix coarse(numAggregates, numAggregates, Matrix::random);
+    for (std::size_t i = 0; i < numAggregates; ++i) {
+        coarse.setrowsize(i, pattern[i].size());
+    }
+    coarse.endrowsizes();
+    for (std::size_t i = 0; i < numAggregates; ++i) {
+        for (const auto j : pattern[i]) {
+            coarse.addindex(i, j);
+        }
+    }
+    coarse.endindices();
+    coarse = 0.0;
+    return coarse;
+}
+
+void checkEqual(const Matrix& a, const Matrix& b)
+{
+    BOOST_REQUIRE_EQUAL(a.N(), b.N());
+    for (std::size_t i = 0; i < a.N(); ++i) {
+        auto colB = b[i].begin();
+        for (auto colA = a[i].begin(); colA != a[i].end(); ++colA, ++colB) {
+            BOOST_CHECK_EQUAL(colA.index(), colB.index());
+            BOOST_CHECK_CLOSE((*colA)[0][0], (*colB)[0][0], 1e-12);
+        }
+    }
+}
+
+} // anonymous namespace
+
+BOOST_AUTO_TEST_CASE(MatchesGalerkinProduct)
+{
+    const std::size_t n = 20;
+    Matrix fine = createFineMatrix(n);
+
+    // pairs of unknowns, the last unknown is isolated
+    AggregatesMap aggregates(n);
+    for (std::size_t i = 0; i + 1 < n; ++i) {
+        aggregates[i] = i / 2;
+    }
+    aggregates[n - 1] = AggregatesMap::ISOLATED;
+    const std::size_t numAggregates = n / 2;
+
+    const Dune::Amg::SequentialInformation pinfo;
+    const auto copyFlags = Dune::NegateSet<Dune::Amg::SequentialInformation::OwnerSet>();
+    Dune::Amg::BaseGalerkinProduct productBuilder;
+
+    Matrix expected = createCoarseMatrix(fine, aggregates, numAggregates);
+    Matrix coarse = createCoarseMatrix(fine, aggregates, numAggregates);
+    Dune::Amg::GalerkinProductPlan<Matrix> plan;
+    BOOST_CHECK(!plan.isBuilt());
+    plan.build(fine, aggregates, coarse);
+    BOOST_CHECK(plan.isBuilt());
+
+    productBuilder.calculate(fine, aggregates, expected, pinfo, copyFlags);
+    plan.calculate(fine, coarse, pinfo);
+    checkEqual(expected, coarse);
+
+    // new values with the same sparsity pattern reuse the plan
+    for (std::size_t i = 0; i < n; ++i) {
+        for (auto col = fine[i].begin(); col != fine[i].end(); ++col) {
+            *col *= 1.0 + 0.05*((i + 2*col.index()) % 7);
+        }
+    }
+    productBuilder.calculate(fine, aggregates, expected, pinfo, copyFlags);
+    plan.calculate(fine, coarse, pinfo);
+    checkEqual(expected, coarse);
+}
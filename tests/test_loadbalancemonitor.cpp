@@ -0,0 +1,276 @@
+/*
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <config.h>
+
+#define BOOST_TEST_MODULE TestLoadBalanceMonitor
+#define BOOST_TEST_NO_MAIN
+
+#include <boost/test/unit_test.hpp>
+
+#include <dune/common/parallel/mpihelper.hh>
+
+#include <opm/simulators/flow/LoadBalanceMonitor.hpp>
+
+#include <cstddef>
+#include <filesystem>
+#include <fstream>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+namespace {
+
+// Three cells per process, numbered consecutively by rank.
+std::vector<int> localCells(const Opm::Parallel::Communication& comm)
+{
+    return { 3*comm.rank(), 3*comm.rank() + 1, 3*comm.rank() + 2 };
+}
+
+std::filesystem::path weightFile(const Opm::Parallel::Communication& comm)
+{
+    const auto file = std::filesystem::temp_directory_path()
+        / "test_loadbalancemonitor.CELLWEIGHTS";
+
+    if (comm.rank() == 0) {
+        std::filesystem::remove(file);
+    }
+    comm.barrier();
+
+    return file;
+}
+
+// Pairs of Cartesian cell index and weight in the cell weight file.
+std::vector<std::pair<int, double>> readWeights(const std::filesystem::path& file)
+{
+    std::ifstream is { file };
+    BOOST_REQUIRE(is);
+
+    auto result = std::vector<std::pair<int, double>>{};
+    int cell{};
+    double weight{};
+    while (is >> cell >> weight) {
+        result.emplace_back(cell, weight);
+    }
+    return result;
+}
+
+} // Anonymous namespace
+
+BOOST_AUTO_TEST_CASE(Balanced)
+{
+    const auto comm = Opm::Parallel::Communication { Dune::MPIHelper::getCommunicator() };
+    const auto file = weightFile(comm);
+
+    auto monitor = Opm::LoadBalanceMonitor { comm, localCells(comm), 1.1, file };
+
+    BOOST_CHECK_CLOSE(monitor.reportStep(2.0), 1.0, 1.0e-8);
+
+    // No time spent in the report step.
+    BOOST_CHECK_CLOSE(monitor.reportStep(0.0), 1.0, 1.0e-8);
+    BOOST_CHECK(!monitor.imbalanced());
+
+    monitor.finish();
+    BOOST_CHECK(!monitor.weightsWritten());
+    BOOST_CHECK(!std::filesystem::exists(file));
+}
+
+BOOST_AUTO_TEST_CASE(Imbalanced)
+{
+    const auto comm = Opm::Parallel::Communication { Dune::MPIHelper::getCommunicator() };
+    const auto file = weightFile(comm);
+
+    // Process p spends p + 1 seconds, i.e., (p + 1)/3 seconds per cell.  A
+    // threshold below one triggers the output also in sequential runs.
+    auto monitor = Opm::LoadBalanceMonitor { comm, localCells(comm), 0.5, file };
+
+    const auto size = comm.size();
+    const auto expectedImbalance = size / ((size + 1) / 2.0);
+    BOOST_CHECK_CLOSE(monitor.reportStep(comm.rank() + 1.0), expectedImbalance, 1.0e-8);
+    BOOST_CHECK(monitor.imbalanced());
+
+    // The weights are only written at the end of the run.
+    BOOST_CHECK(!monitor.weightsWritten());
+    BOOST_CHECK(!std::filesystem::exists(file));
+
+    monitor.finish();
+    BOOST_CHECK(monitor.weightsWritten());
+
+    if (comm.rank() == 0) {
+        std::ifstream is { file };
+        BOOST_REQUIRE(is);
+
+        int cell{};
+        double weight{};
+        int numCells = 0;
+        while (is >> cell >> weight) {
+            BOOST_CHECK_EQUAL(cell, numCells);
+            BOOST_CHECK_CLOSE(weight, (cell / 3 + 1) / 3.0, 1.0e-4);
+            ++numCells;
+        }
+        BOOST_CHECK_EQUAL(numCells, 3*size);
+
+        std::filesystem::remove(file);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(ThresholdIsExclusive)
+{
+    const auto comm = Opm::Parallel::Communication { Dune::MPIHelper::getCommunicator() };
+    const auto file = weightFile(comm);
+
+    // A perfectly balanced step exactly meets a threshold of one.
+    auto monitor = Opm::LoadBalanceMonitor { comm, localCells(comm), 1.0, file };
+
+    BOOST_CHECK_CLOSE(monitor.reportStep(1.5), 1.0, 1.0e-8);
+    BOOST_CHECK(!monitor.imbalanced());
+
+    monitor.finish();
+    BOOST_CHECK(!monitor.weightsWritten());
+    BOOST_CHECK(!std::filesystem::exists(file));
+}
+
+BOOST_AUTO_TEST_CASE(SingleSlowProcess)
+{
+    const auto comm = Opm::Parallel::Communication { Dune::MPIHelper::getCommunicator() };
+    const auto file = weightFile(comm);
+
+    auto monitor = Opm::LoadBalanceMonitor { comm, localCells(comm), 1.1, file };
+
+    // Process 0 spends 4 seconds, all others 1 second.  The imbalance is
+    // measured against the mean, not against the fastest process.
+    const auto size = comm.size();
+    const auto expectedImbalance = 4.0 * size / (size + 3.0);
+    const auto time = (comm.rank() == 0) ? 4.0 : 1.0;
+    BOOST_CHECK_CLOSE(monitor.reportStep(time), expectedImbalance, 1.0e-8);
+
+    // Sequential runs are balanced by definition.
+    BOOST_CHECK_EQUAL(monitor.imbalanced(), expectedImbalance > 1.1);
+
+    monitor.finish();
+    BOOST_CHECK_EQUAL(monitor.weightsWritten(), monitor.imbalanced());
+
+    if (monitor.weightsWritten() && (comm.rank() == 0)) {
+        const auto weights = readWeights(file);
+        BOOST_CHECK_EQUAL(weights.size(), static_cast<std::size_t>(3*size));
+        for (const auto& [cell, weight] : weights) {
+            BOOST_CHECK_CLOSE(weight, (cell < 3) ? 4.0/3 : 1.0/3, 1.0e-4);
+        }
+
+        std::filesystem::remove(file);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(MeasuredCellCosts)
+{
+    const auto comm = Opm::Parallel::Communication { Dune::MPIHelper::getCommunicator() };
+    const auto file = weightFile(comm);
+
+    auto monitor = Opm::LoadBalanceMonitor { comm, localCells(comm), 0.5, file };
+
+    // The middle cell of each process costs twice as much as the others,
+    // only the ratios of the costs matter.
+    monitor.reportStep(comm.rank() + 1.0, { 0.1, 0.2, 0.1 });
+
+    // A step without measured costs is split evenly.
+    monitor.reportStep(3.0, { 0.0, 0.0, 0.0 });
+
+    BOOST_CHECK_THROW(monitor.reportStep(1.0, { 1.0, 2.0 }), std::invalid_argument);
+
+    monitor.finish();
+    BOOST_CHECK(monitor.weightsWritten());
+
+    if (comm.rank() == 0) {
+        const auto weights = readWeights(file);
+        BOOST_CHECK_EQUAL(weights.size(), static_cast<std::size_t>(3*comm.size()));
+        for (const auto& [cell, weight] : weights) {
+            const auto share = (cell % 3 == 1) ? 0.5 : 0.25;
+            BOOST_CHECK_CLOSE(weight, share * (cell / 3 + 1) + 1.0, 1.0e-4);
+        }
+
+        std::filesystem::remove(file);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(WeightsAreSummedOverSteps)
+{
+    const auto comm = Opm::Parallel::Communication { Dune::MPIHelper::getCommunicator() };
+    const auto file = weightFile(comm);
+
+    auto monitor = Opm::LoadBalanceMonitor { comm, localCells(comm), 0.5, file };
+
+    // The weights are the load of the whole run, including the balanced
+    // steps, rather than the load of the last imbalanced step.
+    const auto size = comm.size();
+    monitor.reportStep(comm.rank() + 1.0);
+    monitor.reportStep(6.0 * (size - comm.rank()));
+    monitor.reportStep(1.5);
+    BOOST_CHECK(monitor.imbalanced());
+
+    monitor.finish();
+    BOOST_CHECK(monitor.weightsWritten());
+
+    if (comm.rank() == 0) {
+        const auto weights = readWeights(file);
+        BOOST_CHECK_EQUAL(weights.size(), static_cast<std::size_t>(3*size));
+        for (const auto& [cell, weight] : weights) {
+            const auto rank = cell / 3;
+            BOOST_CHECK_CLOSE(weight, (rank + 1.0) / 3 + 2.0 * (size - rank) + 0.5, 1.0e-4);
+        }
+
+        std::filesystem::remove(file);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(WrittenOnce)
+{
+    const auto comm = Opm::Parallel::Communication { Dune::MPIHelper::getCommunicator() };
+    const auto file = weightFile(comm);
+
+    auto monitor = Opm::LoadBalanceMonitor { comm, localCells(comm), 0.5, file };
+
+    // Imbalanced steps do not write the file, only the first call of
+    // finish() does.
+    for (int step = 0; step < 3; ++step) {
+        monitor.reportStep(comm.rank() + 1.0);
+        BOOST_CHECK(!std::filesystem::exists(file));
+    }
+
+    monitor.finish();
+    BOOST_CHECK(monitor.weightsWritten());
+    comm.barrier();
+    BOOST_CHECK(std::filesystem::exists(file));
+
+    if (comm.rank() == 0) {
+        std::filesystem::remove(file);
+    }
+    comm.barrier();
+
+    monitor.finish();
+    BOOST_CHECK(!std::filesystem::exists(file));
+}
+
+bool init_unit_test_func()
+{
+    return true;
+}
+
+int main(int argc, char** argv)
+{
+    Dune::MPIHelper::instance(argc, argv);
+    return boost::unit_test::unit_test_main(&init_unit_test_func, argc, argv);
+}
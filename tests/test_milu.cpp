@@ -2,6 +2,7 @@
 
 #define BOOST_TEST_MODULE MILU0Test
 
+#include<chrono>
 #include<vector>
 #include<memory>
 
@@ -10,6 +11,7 @@
 #include<dune/common/version.hh>
 #include<dune/common/fmatrix.hh>
 #include<dune/common/fvector.hh>
+#include<dune/istl/paamg/pinfo.hh>
 #include<opm/simulators/linalg/ParallelOverlappingILU0.hpp>
 
 #include <opm/common/ErrorMacros.hpp>
@@ -200,3 +202,165 @@ BOOST_AUTO_TEST_CASE(MILULaplace4)
 {
     test<4>();
 }
+
+template<int bsize>
+void testThreadedApply(Opm::MILU_VARIANT milu)
+{
+    using Matrix = Dune::BCRSMatrix<Dune::FieldMatrix<double, bsize, bsize>>;
+    using Vector = Dune::BlockVector<Dune::FieldVector<double, bsize>>;
+    using ILU = Opm::ParallelOverlappingILU0<Matrix, Vector, Vector, Dune::Amg::SequentialInformation>;
+    std::size_t N = 32;
+    Matrix A;
+    setupLaplacian(A, N);
+
+    ILU sequential(A, 0, 1.0, milu, false, true, false);
+    ILU threaded(A, 0, 1.0, milu, false, true, true);
+
+    Vector d(A.N()), v1(A.N()), v2(A.N());
+    for (std::size_t i = 0; i < d.size(); ++i) {
+        d[i] = 1.0 + (i % 7);
+    }
+
+    // The level sets are reused when the values of the matrix change.
+    for (int pass = 0; pass < 2; ++pass) {
+        if (pass > 0) {
+            A *= 2.0;
+            sequential.update();
+            threaded.update();
+        }
+        v1 = 0;
+        v2 = 0;
+        sequential.apply(v1, d);
+        threaded.apply(v2, d);
+        for (std::size_t i = 0; i < A.N(); ++i) {
+            for (int j = 0; j < bsize; ++j) {
+                BOOST_CHECK_CLOSE(v1[i][j], v2[i][j], 1e-10);
+            }
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE(ThreadedILU0)
+{
+    testThreadedApply<1>(Opm::MILU_VARIANT::ILU);
+    testThreadedApply<3>(Opm::MILU_VARIANT::ILU);
+}
+
+BOOST_AUTO_TEST_CASE(ThreadedMILU0)
+{
+    testThreadedApply<2>(Opm::MILU_VARIANT::MILU_1);
+    testThreadedApply<2>(Opm::MILU_VARIANT::MILU_2);
+    testThreadedApply<2>(Opm::MILU_VARIANT::MILU_3);
+    testThreadedApply<2>(Opm::MILU_VARIANT::MILU_4);
+}
+
+// Set up a matrix whose graph is a path through all unknowns. If
+// interleaved, the path visits the even unknowns in increasing order and
+// then the odd ones in decreasing order, otherwise the matrix is
+// tridiagonal. Both have the same number of nonzeros and no fill-in.
+template<class Matrix>
+void setupPath(Matrix& A, const std::size_t n, const bool interleaved)
+{
+    std::vector<std::size_t> path(n);
+    for (std::size_t i = 0; i < n; ++i) {
+        path[i] = interleaved ? (2 * i < n ? 2 * i : 2 * (n - i) - 1) : i;
+    }
+    std::vector<std::vector<std::size_t>> neighbors(n);
+    for (std::size_t i = 0; i + 1 < n; ++i) {
+        neighbors[path[i]].push_back(path[i + 1]);
+        neighbors[path[i + 1]].push_back(path[i]);
+    }
+    A.setSize(n, n, 3 * n - 2);
+    A.setBuildMode(Matrix::row_wise);
+    for (auto row = A.createbegin(); row != A.createend(); ++row) {
+        row.insert(row.index());
+        for (const auto nb : neighbors[row.index()]) {
+            row.insert(nb);
+        }
+    }
+    for (auto row = A.begin(); row != A.end(); ++row) {
+        for (auto col = row->begin(); col != row->end(); ++col) {
+            *col = 0.0;
+            for (int k = 0; k < Matrix::block_type::rows; ++k) {
+                (*col)[k][k] = col.index() == row.index() ? 4.0 : -1.0;
+            }
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE(ThreadedILUnPatternChange)
+{
+    using Matrix = Dune::BCRSMatrix<Dune::FieldMatrix<double, 2, 2>>;
+    using Vector = Dune::BlockVector<Dune::FieldVector<double, 2>>;
+    using ILU = Opm::ParallelOverlappingILU0<Matrix, Vector, Vector, Dune::Amg::SequentialInformation>;
+    const std::size_t n = 2000;
+    Matrix A;
+    setupPath(A, n, /*interleaved=*/true);
+
+    // ILU(1) computes the pattern of the decomposition in every update.
+    ILU sequential(A, 1, 1.0, Opm::MILU_VARIANT::ILU, false, true, false);
+    ILU threaded(A, 1, 1.0, Opm::MILU_VARIANT::ILU, false, true, true);
+
+    // The new pattern has the same sizes, but the rows paired up in the
+    // levels of the interleaved pattern now depend on each other, the
+    // level sets must be computed again.
+    Matrix B;
+    setupPath(B, n, /*interleaved=*/false);
+    BOOST_REQUIRE_EQUAL(B.nonzeroes(), A.nonzeroes());
+    A = B;
+    sequential.update();
+    threaded.update();
+
+    Vector d(A.N()), v1(A.N()), v2(A.N());
+    for (std::size_t i = 0; i < d.size(); ++i) {
+        d[i] = 1.0 + (i % 7);
+    }
+    v1 = 0;
+    v2 = 0;
+    sequential.apply(v1, d);
+    threaded.apply(v2, d);
+    for (std::size_t i = 0; i < A.N(); ++i) {
+        for (int j = 0; j < 2; ++j) {
+            BOOST_CHECK_CLOSE(v1[i][j], v2[i][j], 1e-10);
+        }
+    }
+}
+
+// Compare the time of the sequential and the level-scheduled update and
+// apply of ILU0 on a 2D Laplacian with 3x3 blocks. The numbers are reported
+// as test messages, run with --log_level=message to see them.
+BOOST_AUTO_TEST_CASE(ThreadedILU0Benchmark)
+{
+    using Matrix = Dune::BCRSMatrix<Dune::FieldMatrix<double, 3, 3>>;
+    using Vector = Dune::BlockVector<Dune::FieldVector<double, 3>>;
+    using ILU = Opm::ParallelOverlappingILU0<Matrix, Vector, Vector, Dune::Amg::SequentialInformation>;
+    using Clock = std::chrono::steady_clock;
+    using Seconds = std::chrono::duration<double>;
+    const int repeats = 20;
+    Matrix A;
+    setupLaplacian(A, 400);
+
+    Vector d(A.N()), v(A.N());
+    d = 1.0;
+
+    for (const bool threads : {false, true}) {
+        ILU ilu(A, 0, 1.0, Opm::MILU_VARIANT::ILU, false, true, threads);
+
+        const auto updateStart = Clock::now();
+        for (int i = 0; i < repeats; ++i) {
+            ilu.update();
+        }
+        const Seconds updateTime = Clock::now() - updateStart;
+
+        const auto applyStart = Clock::now();
+        for (int i = 0; i < repeats; ++i) {
+            v = 0;
+            ilu.apply(v, d);
+        }
+        const Seconds applyTime = Clock::now() - applyStart;
+
+        BOOST_TEST_MESSAGE("ILU0 of " << A.N() << " rows, " << (threads ? "level-scheduled" : "sequential")
+                           << ": update " << updateTime.count() / repeats << " s, apply "
+                           << applyTime.count() / repeats << " s");
+    }
+}
@@ -0,0 +1,183 @@
+/*
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <config.h>
+
+#define BOOST_TEST_MODULE TestMixedPrecisionPreconditioner
+
+#include <boost/test/unit_test.hpp>
+
+#include <opm/simulators/linalg/MixedPrecisionPreconditioner.hpp>
+
+#include <dune/common/fmatrix.hh>
+#include <dune/common/fvector.hh>
+#include <dune/istl/bcrsmatrix.hh>
+#include <dune/istl/bvector.hh>
+#include <dune/istl/operators.hh>
+
+#include <cstddef>
+#include <memory>
+
+namespace {
+
+constexpr int bs = 2;
+using Matrix = Dune::BCRSMatrix<Dune::FieldMatrix<double, bs, bs>>;
+using Vector = Dune::BlockVector<Dune::FieldVector<double, bs>>;
+using LowMatrix = Dune::BCRSMatrix<Dune::FieldMatrix<float, bs, bs>>;
+using LowVector = Dune::BlockVector<Dune::FieldVector<float, bs>>;
+using LowOperator = Dune::MatrixAdapter<LowMatrix, LowVector, LowVector>;
+using Prec = Opm::MixedPrecisionPreconditioner<Matrix, Vector, LowOperator>;
+
+// A preconditioner which scales the defect by the inverse diagonal, and
+// modifies its arguments in pre() and post() to detect whether they are
+// copied back.
+class ScalingPreconditioner : public Dune::PreconditionerWithUpdate<LowVector, LowVector>
+{
+public:
+    explicit ScalingPreconditioner(const LowMatrix& matrix)
+        : matrix_(matrix)
+    {}
+
+    void pre(LowVector& x, LowVector& b) override
+    {
+        x *= 2.0f;
+        b *= 2.0f;
+    }
+
+    void apply(LowVector& v, const LowVector& d) override
+    {
+        for (std::size_t i = 0; i < d.size(); ++i) {
+            for (int j = 0; j < bs; ++j) {
+                v[i][j] = d[i][j] / matrix_[i][i][j][j];
+            }
+        }
+    }
+
+    void post(LowVector& x) override
+    {
+        x *= 3.0f;
+    }
+
+    Dune::SolverCategory::Category category() const override
+    {
+        return Dune::SolverCategory::sequential;
+    }
+
+    void update() override
+    {}
+
+    bool hasPerfectUpdate() const override
+    {
+        return true;
+    }
+
+private:
+    const LowMatrix& matrix_;
+};
+
+Matrix createMatrix(const std::size_t n)
+{
+    Matrix matrix(n, n, 3 * n, Matrix::row_wise);
+    for (auto row = matrix.createbegin(); row != matrix.createend(); ++row) {
+        if (row.index() > 0) {
+            row.insert(row.index() - 1);
+        }
+        row.insert(row.index());
+        if (row.index() + 1 < n) {
+            row.insert(row.index() + 1);
+        }
+    }
+    for (auto row = matrix.begin(); row != matrix.end(); ++row) {
+        for (auto col = row->begin(); col != row->end(); ++col) {
+            *col = 0.0;
+            for (int j = 0; j < bs; ++j) {
+                (*col)[j][j] = col.index() == row.index() ? 4.1 : -1.3;
+            }
+        }
+    }
+    return matrix;
+}
+
+// Values which are not representable in single precision.
+Vector createVector(const std::size_t n, const double offset)
+{
+    Vector v(n);
+    for (std::size_t i = 0; i < n; ++i) {
+        for (int j = 0; j < bs; ++j) {
+            v[i][j] = offset + 0.1 * (i * bs + j);
+        }
+    }
+    return v;
+}
+
+Prec createPreconditioner(const Matrix& matrix)
+{
+    return Prec(matrix, [](const LowOperator& op)
+                { return std::make_shared<ScalingPreconditioner>(op.getmat()); });
+}
+
+} // Anonymous namespace
+
+BOOST_AUTO_TEST_CASE(PrePostKeepVectors)
+{
+    const std::size_t n = 10;
+    const Matrix matrix = createMatrix(n);
+    Prec prec = createPreconditioner(matrix);
+
+    const Vector x0 = createVector(n, 1.0 / 3.0);
+    const Vector b0 = createVector(n, 2.0 / 7.0);
+    Vector x = x0;
+    Vector b = b0;
+
+    prec.pre(x, b);
+    prec.post(x);
+
+    for (std::size_t i = 0; i < n; ++i) {
+        for (int j = 0; j < bs; ++j) {
+            // Bitwise identical, neither rounded nor modified.
+            BOOST_CHECK_EQUAL(x[i][j], x0[i][j]);
+            BOOST_CHECK_EQUAL(b[i][j], b0[i][j]);
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE(ApplyConvertsCorrection)
+{
+    const std::size_t n = 10;
+    Matrix matrix = createMatrix(n);
+    Prec prec = createPreconditioner(matrix);
+
+    const Vector d = createVector(n, 1.0 / 3.0);
+    Vector v(n);
+    v = 0.0;
+    prec.apply(v, d);
+    for (std::size_t i = 0; i < n; ++i) {
+        for (int j = 0; j < bs; ++j) {
+            BOOST_CHECK_CLOSE(v[i][j], d[i][j] / 4.1, 1e-4);
+        }
+    }
+
+    // The lower precision copy of the matrix follows the matrix on update().
+    matrix *= 2.0;
+    prec.update();
+    prec.apply(v, d);
+    for (std::size_t i = 0; i < n; ++i) {
+        for (int j = 0; j < bs; ++j) {
+            BOOST_CHECK_CLOSE(v[i][j], d[i][j] / 8.2, 1e-4);
+        }
+    }
+}
@@ -0,0 +1,275 @@
+/*
+  Copyright 2025 Equinor ASA.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#include <config.h>
+
+#include <opm/simulators/wells/MSWellTreeSolver.hpp>
+
+#include <opm/common/Exceptions.hpp>
+
+#if HAVE_UMFPACK
+#include <dune/istl/umfpack.hh>
+#endif
+
+#define BOOST_TEST_MODULE MSWellTreeSolverTest
+#include <boost/test/unit_test.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <vector>
+
+namespace {
+
+constexpr int numWellEq = 4;
+using Solver = Opm::mswellhelpers::TreeBlockSolver<double, numWellEq>;
+using Matrix = Solver::Matrix;
+using Vector = Solver::Vector;
+
+//! \brief The outlet of each segment of a well with a main stem and
+//!        laterals branching off every tenth stem segment.
+std::vector<int> branchedOutlets(int numSegments)
+{
+    std::vector<int> outlet(numSegments, -1);
+    const int stem = std::max(1, numSegments / 2);
+    for (int seg = 1; seg < stem; ++seg) {
+        outlet[seg] = seg - 1;
+    }
+    int branchPoint = 0;
+    for (int seg = stem; seg < numSegments; ++seg) {
+        // start a new lateral every tenth segment
+        if ((seg - stem) % 10 == 0) {
+            outlet[seg] = branchPoint;
+            branchPoint = (branchPoint + 10) % stem;
+        } else {
+            outlet[seg] = seg - 1;
+        }
+    }
+    return outlet;
+}
+
+//! \brief A diagonally dominant block matrix coupling each segment to its
+//!        outlet, with the segments numbered in an arbitrary order.
+Matrix segmentMatrix(const std::vector<int>& outlet)
+{
+    const std::size_t size = outlet.size();
+    std::vector<std::vector<int>> neighbours(size);
+    for (std::size_t seg = 0; seg < size; ++seg) {
+        neighbours[seg].push_back(static_cast<int>(seg));
+        if (outlet[seg] >= 0) {
+            neighbours[seg].push_back(outlet[seg]);
+            neighbours[outlet[seg]].push_back(static_cast<int>(seg));
+        }
+    }
+
+    Matrix matrix(size, size, Matrix::row_wise);
+    for (auto row = matrix.createbegin(); row != matrix.createend(); ++row) {
+        for (const int col : neighbours[row.index()]) {
+            row.insert(col);
+        }
+    }
+
+    for (std::size_t row = 0; row < size; ++row) {
+        for (auto col = matrix[row].begin(); col != matrix[row].end(); ++col) {
+            for (int i = 0; i < numWellEq; ++i) {
+                for (int j = 0; j < numWellEq; ++j) {
+                    const double value = std::sin(1.0 + row + 3.0*col.index() + 5.0*i + 7.0*j);
+                    (*col)[i][j] = col.index() == row ? value : 0.1*value;
+                }
+            }
+            if (col.index() == row) {
+                for (int i = 0; i < numWellEq; ++i) {
+                    (*col)[i][i] += 4.0 * numWellEq;
+                }
+            }
+        }
+    }
+    return matrix;
+}
+
+Vector rightHandSide(std::size_t size)
+{
+    Vector rhs(size);
+    for (std::size_t i = 0; i < size; ++i) {
+        for (int j = 0; j < numWellEq; ++j) {
+            rhs[i][j] = std::cos(0.5 + i + 2.0*j);
+        }
+    }
+    return rhs;
+}
+
+double residualNorm(const Matrix& matrix, const Vector& x, const Vector& rhs)
+{
+    Vector r(rhs);
+    matrix.mmv(x, r);
+    return r.infinity_norm();
+}
+
+} // anonymous namespace
+
+BOOST_AUTO_TEST_CASE(SolveBranchedWell)
+{
+    const auto outlet = branchedOutlets(57);
+    const Matrix matrix = segmentMatrix(outlet);
+    const Vector rhs = rightHandSide(matrix.N());
+
+    Solver solver;
+    BOOST_REQUIRE(solver.analyse(matrix));
+    BOOST_CHECK(!solver.isFactorized());
+    solver.factorize(matrix);
+    BOOST_CHECK(solver.isFactorized());
+
+    const Vector x = solver.solve(rhs);
+    BOOST_CHECK_SMALL(residualNorm(matrix, x, rhs), 1e-12);
+
+    solver.reset();
+    BOOST_CHECK(solver.isTree());
+    BOOST_CHECK(!solver.isFactorized());
+}
+
+BOOST_AUTO_TEST_CASE(SolveForest)
+{
+    // two disconnected chains, as after removing a segment connection
+    std::vector<int> outlet{-1, 0, 1, -1, 3, 4, 5};
+    const Matrix matrix = segmentMatrix(outlet);
+    const Vector rhs = rightHandSide(matrix.N());
+
+    Solver solver;
+    BOOST_REQUIRE(solver.analyse(matrix));
+    solver.factorize(matrix);
+    BOOST_CHECK_SMALL(residualNorm(matrix, solver.solve(rhs), rhs), 1e-12);
+}
+
+BOOST_AUTO_TEST_CASE(RejectLoop)
+{
+    const std::size_t size = 4;
+    Matrix matrix(size, size, Matrix::row_wise);
+    for (auto row = matrix.createbegin(); row != matrix.createend(); ++row) {
+        const std::size_t i = row.index();
+        row.insert((i + size - 1) % size);
+        row.insert(i);
+        row.insert((i + 1) % size);
+    }
+    matrix = 1.0;
+
+    Solver solver;
+    BOOST_CHECK(!solver.analyse(matrix));
+    BOOST_CHECK(!solver.isTree());
+}
+
+BOOST_AUTO_TEST_CASE(RejectNonSymmetricPattern)
+{
+    Matrix matrix(2, 2, Matrix::row_wise);
+    for (auto row = matrix.createbegin(); row != matrix.createend(); ++row) {
+        row.insert(row.index());
+        if (row.index() == 0) {
+            row.insert(1);
+        }
+    }
+    matrix = 1.0;
+
+    Solver solver;
+    BOOST_CHECK(!solver.analyse(matrix));
+}
+
+BOOST_AUTO_TEST_CASE(SingularDiagonal)
+{
+    Matrix matrix = segmentMatrix({-1, 0});
+    matrix[1][1] = 0.0;
+    matrix[1][0] = 0.0;
+    matrix[0][1] = 0.0;
+
+    Solver solver;
+    BOOST_REQUIRE(solver.analyse(matrix));
+    BOOST_CHECK_THROW(solver.factorize(matrix), Opm::NumericalProblem);
+}
+
+BOOST_AUTO_TEST_CASE(ZeroPivotBlock)
+{
+    // The diagonal block of the leaf segment is zero, but the matrix is
+    // not singular: it couples the two segments through invertible blocks.
+    Matrix matrix = segmentMatrix({-1, 0});
+    matrix[1][1] = 0.0;
+    for (int i = 0; i < numWellEq; ++i) {
+        matrix[1][0][i][i] += 2.0;
+        matrix[0][1][i][i] += 3.0;
+    }
+    const Vector rhs = rightHandSide(matrix.N());
+
+    Solver solver;
+    BOOST_REQUIRE(solver.analyse(matrix));
+    BOOST_CHECK(!solver.tryFactorize(matrix));
+    BOOST_CHECK(!solver.isFactorized());
+    BOOST_CHECK_THROW(solver.factorize(matrix), Opm::NumericalProblem);
+
+#if HAVE_UMFPACK
+    // the fallback of the multisegment well equations
+    Dune::UMFPack<Matrix> umfpack(matrix, 0);
+    Vector b(rhs);
+    Vector x(rhs.size());
+    Dune::InverseOperatorResult res;
+    umfpack.apply(x, b, res);
+    BOOST_CHECK_SMALL(residualNorm(matrix, x, rhs), 1e-12);
+#endif
+}
+
+// Time the factorization and solve of the segment matrix for wells of
+// increasing size, compared to UMFPACK when available. The numbers are
+// reported as test messages, run with --log_level=message to see them.
+BOOST_AUTO_TEST_CASE(SegmentBenchmark)
+{
+    using Clock = std::chrono::steady_clock;
+    using Seconds = std::chrono::duration<double>;
+    const int repeats = 20;
+
+    for (const int numSegments : {50, 100, 500, 2000}) {
+        const Matrix matrix = segmentMatrix(branchedOutlets(numSegments));
+        const Vector rhs = rightHandSide(matrix.N());
+
+        Solver solver;
+        Vector x;
+        const auto treeStart = Clock::now();
+        for (int rep = 0; rep < repeats; ++rep) {
+            solver.analyse(matrix);
+            solver.factorize(matrix);
+            x = solver.solve(rhs);
+        }
+        const Seconds treeTime = (Clock::now() - treeStart) / repeats;
+        BOOST_CHECK_SMALL(residualNorm(matrix, x, rhs), 1e-10);
+
+        BOOST_TEST_MESSAGE(numSegments << " segments:");
+        BOOST_TEST_MESSAGE("  tree factorization and solve: " << treeTime.count() << " s");
+
+#if HAVE_UMFPACK
+        Vector y;
+        const auto umfStart = Clock::now();
+        for (int rep = 0; rep < repeats; ++rep) {
+            Dune::UMFPack<Matrix> umfpack(matrix, 0);
+            Vector b(rhs);
+            y.resize(rhs.size());
+            Dune::InverseOperatorResult res;
+            umfpack.apply(y, b, res);
+        }
+        const Seconds umfTime = (Clock::now() - umfStart) / repeats;
+        y -= x;
+        BOOST_CHECK_SMALL(y.infinity_norm(), 1e-10);
+        BOOST_TEST_MESSAGE("  UMFPACK factorization and solve: " << umfTime.count() << " s");
+#endif
+    }
+}
@@ -0,0 +1,287 @@
+/*
+  Copyright 2025 Equinor ASA.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#include <config.h>
+
+#define BOOST_TEST_MODULE MultisegmentWellEquationsTest
+#include <boost/test/unit_test.hpp>
+
+#include "MpiFixture.hpp"
+
+#include <dune/common/dynmatrix.hh>
+#include <dune/common/dynvector.hh>
+
+#include <opm/input/eclipse/EclipseState/EclipseState.hpp>
+#include <opm/input/eclipse/Parser/Parser.hpp>
+#include <opm/input/eclipse/Python/Python.hpp>
+#include <opm/input/eclipse/Schedule/MSW/WellSegments.hpp>
+#include <opm/input/eclipse/Schedule/Schedule.hpp>
+#include <opm/input/eclipse/Schedule/Well/Well.hpp>
+#include <opm/input/eclipse/Schedule/Well/WellConnections.hpp>
+
+#include <opm/models/utils/parametersystem.hpp>
+
+#include <opm/simulators/flow/BlackoilModelParameters.hpp>
+#include <opm/simulators/wells/MultisegmentWellEquationAccess.hpp>
+#include <opm/simulators/wells/MultisegmentWellEquations.hpp>
+#include <opm/simulators/wells/MultisegmentWellGeneric.hpp>
+#include <opm/simulators/wells/ParallelWellInfo.hpp>
+#include <opm/simulators/wells/PerforationData.hpp>
+#include <opm/simulators/wells/WellInterfaceGeneric.hpp>
+
+#include <cmath>
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+BOOST_GLOBAL_FIXTURE(MPIFixture);
+
+namespace {
+
+constexpr int numWellEq = 4;
+constexpr int numEq = 3;
+using Equations = Opm::MultisegmentWellEquations<double, numWellEq, numEq>;
+using Access = Opm::MultisegmentWellEquationAccess<double, numWellEq, numEq>;
+using BVector = Equations::BVector;
+using BVectorWell = Equations::BVectorWell;
+
+//! \brief The equations of the multisegment well of msw.data, with the
+//!        sparsity pattern set up as in the simulator and made up values.
+struct MultisegmentWellSetup
+{
+    MultisegmentWellSetup()
+        : deck(Opm::Parser{}.parseFile("msw.data"))
+        , eclState(deck)
+        , schedule(deck, eclState, std::make_shared<Opm::Python>())
+        , well(schedule.getWell("PROD01", 0))
+        , perfData(createPerfData(well))
+        , pwInfo(well.name())
+        , wellIf(well, pwInfo, 0, param(), 0, 3, 3, 0, perfData)
+        , mswGeneric(wellIf)
+        , equations(mswGeneric, pwInfo)
+    {
+        const auto& segments = well.getSegments();
+        const std::size_t numSegments = segments.size();
+        std::vector<std::vector<int>> inlets(numSegments);
+        for (std::size_t seg = 0; seg < numSegments; ++seg) {
+            const int outlet = segments[seg].outletSegment();
+            if (outlet > 0) {
+                inlets[segments.segmentNumberToIndex(outlet)].push_back(static_cast<int>(seg));
+            }
+        }
+        std::vector<std::vector<int>> perforations(numSegments);
+        const auto& connections = well.getConnections();
+        for (std::size_t perf = 0; perf < connections.size(); ++perf) {
+            perforations[segments.segmentNumberToIndex(connections[perf].segment())].push_back(static_cast<int>(perf));
+        }
+        equations.init(static_cast<int>(perfData.size()), wellIf.cells(), inlets, perforations);
+
+        Access access(equations);
+        fill(access.B(), 1.0);
+        fill(access.C(), 2.0);
+        auto& D = access.D();
+        for (auto row = D.begin(); row != D.end(); ++row) {
+            for (auto col = row->begin(); col != row->end(); ++col) {
+                for (int i = 0; i < numWellEq; ++i) {
+                    for (int j = 0; j < numWellEq; ++j) {
+                        (*col)[i][j] = col.index() == row.index()
+                            ? (i == j ? 8.0 : 0.3 * std::sin(1.0 + row.index() + i - j))
+                            : 0.5 * std::cos(2.0 + row.index() + col.index() + i + j);
+                    }
+                }
+            }
+        }
+        auto& residual = access.residual();
+        for (std::size_t seg = 0; seg < residual.size(); ++seg) {
+            for (int i = 0; i < numWellEq; ++i) {
+                residual[seg][i] = std::sin(3.0 + seg + i);
+            }
+        }
+    }
+
+    static const Opm::BlackoilModelParameters<double>& param()
+    {
+        static const Opm::BlackoilModelParameters<double> p;
+        return p;
+    }
+
+    static std::vector<Opm::PerforationData<double>> createPerfData(const Opm::Well& well)
+    {
+        std::vector<Opm::PerforationData<double>> pdata(well.getConnections().size());
+        for (std::size_t c = 0; c < pdata.size(); ++c) {
+            pdata[c].ecl_index = c;
+            pdata[c].cell_index = c;
+        }
+        return pdata;
+    }
+
+    template <class Matrix>
+    static void fill(Matrix& M, double offset)
+    {
+        for (auto row = M.begin(); row != M.end(); ++row) {
+            for (auto col = row->begin(); col != row->end(); ++col) {
+                for (std::size_t i = 0; i < col->N(); ++i) {
+                    for (std::size_t j = 0; j < col->M(); ++j) {
+                        (*col)[i][j] = std::sin(offset + row.index() + 2.0*col.index() + 3.0*i + 5.0*j);
+                    }
+                }
+            }
+        }
+    }
+
+    //! \brief D as a dense scalar matrix.
+    Dune::DynamicMatrix<double> denseD()
+    {
+        Access access(equations);
+        const auto& D = access.D();
+        Dune::DynamicMatrix<double> dense(D.N() * numWellEq, D.M() * numWellEq, 0.0);
+        for (auto row = D.begin(); row != D.end(); ++row) {
+            for (auto col = row->begin(); col != row->end(); ++col) {
+                for (int i = 0; i < numWellEq; ++i) {
+                    for (int j = 0; j < numWellEq; ++j) {
+                        dense[row.index() * numWellEq + i][col.index() * numWellEq + j] = (*col)[i][j];
+                    }
+                }
+            }
+        }
+        return dense;
+    }
+
+    //! \brief Compute r - C^T D^-1 w with dense matrices.
+    BVector reference(const BVectorWell& w, const BVector& r)
+    {
+        const auto D = denseD();
+        Dune::DynamicVector<double> rhs(w.size() * numWellEq);
+        for (std::size_t seg = 0; seg < w.size(); ++seg) {
+            for (int i = 0; i < numWellEq; ++i) {
+                rhs[seg * numWellEq + i] = w[seg][i];
+            }
+        }
+        Dune::DynamicVector<double> sol(rhs.size());
+        D.solve(sol, rhs);
+        BVectorWell invDw(w.size());
+        for (std::size_t seg = 0; seg < w.size(); ++seg) {
+            for (int i = 0; i < numWellEq; ++i) {
+                invDw[seg][i] = sol[seg * numWellEq + i];
+            }
+        }
+        BVector result = r;
+        Access access(equations);
+        access.C().mmtv(invDw, result);
+        return result;
+    }
+
+    //! \brief Check that apply(x, Ax) and apply(r) give the dense results.
+    void checkApply()
+    {
+        equations.createSolver();
+
+        const std::size_t numPerfs = perfData.size();
+        BVector x(numPerfs);
+        BVector Ax(numPerfs);
+        for (std::size_t perf = 0; perf < numPerfs; ++perf) {
+            for (int i = 0; i < numEq; ++i) {
+                x[perf][i] = std::cos(1.0 + perf + 2.0*i);
+                Ax[perf][i] = 0.1 * perf + i;
+            }
+        }
+
+        Access access(equations);
+        BVectorWell Bx(access.B().N());
+        access.B().mv(x, Bx);
+        const BVector expectedAx = reference(Bx, Ax);
+        const BVector expectedR = reference(access.residual(), Ax);
+
+        // Apply twice, the scratch vectors must not keep any state.
+        for (int repeat = 0; repeat < 2; ++repeat) {
+            BVector y = Ax;
+            equations.apply(x, y);
+            BVector r = Ax;
+            equations.apply(r);
+            for (std::size_t perf = 0; perf < numPerfs; ++perf) {
+                for (int i = 0; i < numEq; ++i) {
+                    BOOST_CHECK_CLOSE(y[perf][i], expectedAx[perf][i], 1e-10);
+                    BOOST_CHECK_CLOSE(r[perf][i], expectedR[perf][i], 1e-10);
+                }
+            }
+        }
+    }
+
+    Opm::Deck deck;
+    Opm::EclipseState eclState;
+    Opm::Schedule schedule;
+    Opm::Well well;
+    std::vector<Opm::PerforationData<double>> perfData;
+    Opm::ParallelWellInfo<double> pwInfo;
+    Opm::WellInterfaceGeneric<double> wellIf;
+    Opm::MultisegmentWellGeneric<double> mswGeneric;
+    Equations equations;
+};
+
+struct ParameterFixture
+{
+    ParameterFixture()
+    {
+        Opm::Parameters::reset();
+        Opm::BlackoilModelParameters<double>::registerParameters();
+        Opm::Parameters::endRegistration();
+    }
+};
+
+} // anonymous namespace
+
+BOOST_GLOBAL_FIXTURE(ParameterFixture);
+
+BOOST_AUTO_TEST_CASE(ApplyWithTreeSolver)
+{
+    MultisegmentWellSetup setup;
+    BOOST_REQUIRE_EQUAL(setup.well.getSegments().size(), std::size_t{6});
+    setup.checkApply();
+}
+
+#if HAVE_UMFPACK
+BOOST_AUTO_TEST_CASE(ApplyWithUMFPack)
+{
+    MultisegmentWellSetup setup;
+
+    // A zero diagonal block of a segment without inlets makes the tree
+    // elimination fail, while D stays invertible through the coupling to
+    // the outlet, so D is factorized by UMFPACK.
+    const auto& segments = setup.well.getSegments();
+    std::vector<bool> hasInlet(segments.size(), false);
+    for (std::size_t seg = 0; seg < segments.size(); ++seg) {
+        if (segments[seg].outletSegment() > 0) {
+            hasInlet[segments.segmentNumberToIndex(segments[seg].outletSegment())] = true;
+        }
+    }
+    std::size_t leaf = segments.size() - 1;
+    while (hasInlet[leaf]) {
+        --leaf;
+    }
+    const std::size_t outlet = segments.segmentNumberToIndex(segments[leaf].outletSegment());
+    Access access(setup.equations);
+    auto& D = access.D();
+    D[leaf][leaf] = 0.0;
+    for (int i = 0; i < numWellEq; ++i) {
+        D[leaf][outlet][i][i] += 4.0;
+        D[outlet][leaf][i][i] += 4.0;
+    }
+
+    setup.checkApply();
+}
+#endif
@@ -0,0 +1,267 @@
+// -*- mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-
+// vi: set et ts=4 sw=4 sts=4:
+/*
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+
+  Consult the COPYING file in the top-level source directory of this
+  module for the precise wording of the license and the list of
+  copyright holders.
+*/
+#include "config.h"
+#include "TestTypeTag.hpp"
+
+#define BOOST_TEST_MODULE NlddConcurrent
+
+#include <opm/models/blackoil/blackoillocalresidualtpfa.hh>
+#include <opm/models/discretization/common/tpfalinearizer.hh>
+#include <opm/models/utils/parametersystem.hpp>
+#include <opm/models/utils/propertysystem.hh>
+#include <opm/models/utils/start.hh>
+
+#include <opm/simulators/flow/BlackoilModel.hpp>
+#include <opm/simulators/flow/BlackoilModelParameters.hpp>
+#include <opm/simulators/flow/FlowGenericVanguard.hpp>
+#include <opm/simulators/flow/NonlinearSolver.hpp>
+#include <opm/simulators/timestepping/SimulatorTimer.hpp>
+#include <opm/simulators/wells/BlackoilWellModel.hpp>
+#include <opm/simulators/wells/WellState.hpp>
+
+#if HAVE_DUNE_FEM
+#include <dune/fem/misc/mpimanager.hh>
+#else
+#include <dune/common/parallel/mpihelper.hh>
+#endif
+
+#if HAVE_MPI
+#include <mpi.h>
+#endif
+
+#include <cstddef>
+#include <fstream>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <boost/test/unit_test.hpp>
+
+namespace Opm::Properties {
+
+namespace TTag {
+
+struct TestNlddTypeTag {
+    using InheritsFrom = std::tuple<TestTypeTag>;
+};
+
+} // namespace TTag
+
+// Concurrent subdomain solves require the TPFA linearizer.
+template<class TypeTag>
+struct Linearizer<TypeTag, TTag::TestNlddTypeTag> { using type = TpfaLinearizer<TypeTag>; };
+
+template<class TypeTag>
+struct LocalResidual<TypeTag, TTag::TestNlddTypeTag> { using type = BlackOilLocalResidualTPFA<TypeTag>; };
+
+template<class TypeTag>
+struct EnableDiffusion<TypeTag, TTag::TestNlddTypeTag> { static constexpr bool value = false; };
+
+} // namespace Opm::Properties
+
+namespace {
+
+using TypeTag = Opm::Properties::TTag::TestNlddTypeTag;
+using Simulator = Opm::GetPropType<TypeTag, Opm::Properties::Simulator>;
+using Model = Opm::BlackoilModel<TypeTag>;
+using NonlinearSolver = Opm::NonlinearSolver<TypeTag, Model>;
+
+constexpr const char* deckName = "TESTWELLMODELTHREADS.DATA";
+constexpr const char* partitionName = "test_nlddconcurrent.partition";
+
+// Split the 5x5x4 grid of the deck into four columns of 3x3, 2x3, 3x2 and
+// 2x2 cells, each containing the connections of its wells. The columns
+// are solved in two colours of two domains each.
+void writePartition()
+{
+    std::ofstream os(partitionName);
+    for (int k = 0; k < 4; ++k) {
+        for (int j = 0; j < 5; ++j) {
+            for (int i = 0; i < 5; ++i) {
+                os << (i < 3 ? 0 : 1) + (j < 3 ? 0 : 2) << '\n';
+            }
+        }
+    }
+}
+
+std::unique_ptr<Simulator>
+initSimulator(const std::string& approach, const int numThreads)
+{
+    using namespace Opm;
+
+    const std::string filenameArg = std::string {"--ecl-deck-file-name="} + deckName;
+    const std::string partitionArg = std::string {"--local-domains-partitioning-method="} + partitionName;
+    const std::string approachArg = "--local-solve-approach=" + approach;
+    const std::string threadsArg = "--nldd-num-threads=" + std::to_string(numThreads);
+
+    const char* argv[] = {
+        "test_nlddconcurrent",
+        filenameArg.c_str(),
+        partitionArg.c_str(),
+        approachArg.c_str(),
+        threadsArg.c_str(),
+        "--nonlinear-solver=nldd",
+        "--nldd-num-initial-newton-iter=0",
+        "--threads-per-process=1",
+        "--check-satfunc-consistency=false",
+    };
+
+    Parameters::reset();
+    registerAllParameters_<TypeTag>(false);
+    registerEclTimeSteppingParameters<double>();
+    BlackoilModelParameters<double>::registerParameters();
+    NonlinearSolverParameters<double>::registerParameters();
+    Parameters::Register<Parameters::EnableTerminalOutput>("Do *NOT* use!");
+    Parameters::endRegistration();
+    setupParameters_<TypeTag>(/*argc=*/sizeof(argv) / sizeof(argv[0]),
+                              argv, /*registerParams=*/false);
+
+    FlowGenericVanguard::readDeck(deckName);
+    return std::make_unique<Simulator>();
+}
+
+struct NlddResult
+{
+    std::vector<double> solution;
+    std::vector<double> wells;
+    std::string coloring;
+};
+
+// Do the first NLDD iteration of the first time step and return the
+// resulting primary variables, bottom hole pressures and surface rates.
+NlddResult nlddIteration(const std::string& approach, const int numThreads)
+{
+    auto simulator = initSimulator(approach, numThreads);
+
+    simulator->model().applyInitialSolution();
+    simulator->setEpisodeIndex(-1);
+    simulator->setEpisodeLength(0.0);
+    simulator->startNextEpisode(/*episodeStartTime=*/0.0, /*episodeLength=*/1e30);
+    simulator->setEpisodeIndex(0);
+
+    auto& wellModel = simulator->problem().wellModel();
+    wellModel.beginReportStep(/*time_step=*/0);
+
+    Opm::SimulatorTimer timer;
+    timer.init(simulator->vanguard().schedule());
+
+    Opm::BlackoilModelParameters<double> param;
+    auto model = std::make_unique<Model>(*simulator, param, wellModel,
+                                         /*terminal_output=*/false);
+    auto& nlddModel = *model;
+    NonlinearSolver solver(Opm::NonlinearSolverParameters<double>{}, std::move(model));
+
+    nlddModel.prepareStep(timer);
+    nlddModel.nonlinearIteration(/*iteration=*/0, timer, solver);
+
+    NlddResult result;
+    const auto& solution = simulator->model().solution(/*timeIdx=*/0);
+    for (const auto& priVars : solution) {
+        for (std::size_t eqIdx = 0; eqIdx < priVars.size(); ++eqIdx) {
+            result.solution.push_back(priVars[eqIdx]);
+        }
+        result.solution.push_back(static_cast<double>(priVars.primaryVarsMeaningPressure()));
+        result.solution.push_back(static_cast<double>(priVars.primaryVarsMeaningWater()));
+        result.solution.push_back(static_cast<double>(priVars.primaryVarsMeaningGas()));
+    }
+
+    const auto& wellState = wellModel.wellState();
+    for (std::size_t wellIdx = 0; wellIdx < wellState.size(); ++wellIdx) {
+        const auto& ws = wellState.well(wellState.name(wellIdx));
+        result.wells.push_back(ws.bhp);
+        result.wells.insert(result.wells.end(), ws.surface_rates.begin(), ws.surface_rates.end());
+    }
+
+    std::ostringstream os;
+    nlddModel.reportLocalColoring(os);
+    result.coloring = os.str();
+
+    return result;
+}
+
+// Solving the domains concurrently must give the same result as solving
+// them one after another, bit by bit: the domains solved at the same time
+// are not adjacent and each domain only writes its own state.
+void checkConcurrentMatchesSequential(const std::string& approach)
+{
+    const auto sequential = nlddIteration(approach, /*numThreads=*/1);
+    const auto concurrent = nlddIteration(approach, /*numThreads=*/4);
+
+#ifdef _OPENMP
+    BOOST_CHECK(concurrent.coloring.find("Concurrent solve time") != std::string::npos);
+#endif
+
+    BOOST_REQUIRE_EQUAL(sequential.solution.size(), concurrent.solution.size());
+    for (std::size_t i = 0; i < sequential.solution.size(); ++i) {
+        BOOST_CHECK_EQUAL(sequential.solution[i], concurrent.solution[i]);
+    }
+
+    BOOST_REQUIRE(!sequential.wells.empty());
+    BOOST_REQUIRE_EQUAL(sequential.wells.size(), concurrent.wells.size());
+    for (std::size_t i = 0; i < sequential.wells.size(); ++i) {
+        BOOST_CHECK_EQUAL(sequential.wells[i], concurrent.wells[i]);
+    }
+}
+
+struct NlddConcurrentFixture
+{
+    NlddConcurrentFixture()
+    {
+        int argc = boost::unit_test::framework::master_test_suite().argc;
+        char** argv = boost::unit_test::framework::master_test_suite().argv;
+#if HAVE_MPI
+        // The threads solving the domains call MPI from the well model.
+        int provided = MPI_THREAD_SINGLE;
+        MPI_Init_thread(&argc, &argv, MPI_THREAD_SERIALIZED, &provided);
+#endif
+#if HAVE_DUNE_FEM
+        Dune::Fem::MPIManager::initialize(argc, argv);
+#else
+        Dune::MPIHelper::instance(argc, argv);
+#endif
+        Opm::FlowGenericVanguard::setCommunication(std::make_unique<Opm::Parallel::Communication>());
+        writePartition();
+    }
+
+    ~NlddConcurrentFixture()
+    {
+#if HAVE_MPI
+        MPI_Finalize();
+#endif
+    }
+};
+
+} // Anonymous namespace
+
+BOOST_GLOBAL_FIXTURE(NlddConcurrentFixture);
+
+BOOST_AUTO_TEST_CASE(JacobiConcurrentMatchesSequential)
+{
+    checkConcurrentMatchesSequential("jacobi");
+}
+
+BOOST_AUTO_TEST_CASE(MultiColorGaussSeidelConcurrentMatchesSequential)
+{
+    checkConcurrentMatchesSequential("multicolor-gs");
+}
@@ -0,0 +1,110 @@
+/*
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <config.h>
+
+#define BOOST_TEST_MODULE TestParallelNLDDPartitioningZoltan
+#define BOOST_TEST_NO_MAIN
+
+#include <boost/test/unit_test.hpp>
+
+#include <dune/common/parallel/mpihelper.hh>
+
+#if HAVE_ZOLTAN
+#include <opm/simulators/utils/ParallelNLDDPartitioningZoltan.hpp>
+#include <opm/simulators/utils/SetupPartitioningParams.hpp>
+#endif
+
+#include <algorithm>
+#include <cstddef>
+#include <numeric>
+#include <string>
+#include <vector>
+
+#if HAVE_ZOLTAN
+namespace {
+
+constexpr std::size_t numCells = 100;
+constexpr int numParts = 2;
+
+// Chain of cells in which the first fifth of the cells are four times as
+// costly as the others.
+std::vector<float> cellWeights()
+{
+    auto weights = std::vector<float>(numCells, 1.0f);
+    std::fill(weights.begin(), weights.begin() + numCells / 5, 4.0f);
+    return weights;
+}
+
+std::vector<int> partitionChain()
+{
+    auto partitioner = Opm::ParallelNLDDPartitioningZoltan {
+        Opm::Parallel::Communication { MPI_COMM_SELF },
+        numCells, [](const int c) { return c; }
+    };
+
+    for (auto c = 0*numCells; c + 1 < numCells; ++c) {
+        partitioner.registerConnection(c, c + 1);
+        partitioner.registerConnection(c + 1, c);
+    }
+    partitioner.setVertexWeights(cellWeights());
+
+    auto params = Opm::setupZoltanParams("graph");
+    params.insert_or_assign("NUM_GLOBAL_PARTS", std::to_string(numParts));
+    params.insert_or_assign("IMBALANCE_TOL", "1.05");
+
+    return partitioner.partitionElements(params);
+}
+
+// Total weight of each part.
+std::vector<double> partWeights(const std::vector<int>& parts)
+{
+    const auto weights = cellWeights();
+    auto result = std::vector<double>(numParts, 0.0);
+    for (auto c = 0*numCells; c < numCells; ++c) {
+        BOOST_REQUIRE_GE(parts[c], 0);
+        BOOST_REQUIRE_LT(parts[c], numParts);
+        result[parts[c]] += weights[c];
+    }
+    return result;
+}
+
+} // Anonymous namespace
+
+BOOST_AUTO_TEST_CASE(WeightedPartsBalanceWeight)
+{
+    const auto weights = cellWeights();
+    const auto average = std::accumulate(weights.begin(), weights.end(), 0.0) / numParts;
+
+    // Splitting the chain into equal numbers of cells would give the part
+    // holding the costly cells a weight of 110 out of 160.  The parts have
+    // approximately equal total weights instead.
+    const auto weighted = partWeights(partitionChain());
+    BOOST_CHECK_LE(*std::max_element(weighted.begin(), weighted.end()), 1.1 * average);
+}
+#endif // HAVE_ZOLTAN
+
+bool init_unit_test_func()
+{
+    return true;
+}
+
+int main(int argc, char** argv)
+{
+    Dune::MPIHelper::instance(argc, argv);
+    return boost::unit_test::unit_test_main(&init_unit_test_func, argc, argv);
+}
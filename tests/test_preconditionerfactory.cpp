@@ -159,6 +159,28 @@ BOOST_AUTO_TEST_CASE(TestDefaultPreconditionerFactory)
 }
 
 
+#if FLOW_INSTANTIATE_FLOAT
+BOOST_AUTO_TEST_CASE(TestSinglePrecisionPreconditioner)
+{
+    // Solve accurately with the default CPR setup, and with its fine
+    // smoother and coarse level preconditioner in single precision.
+    Opm::PropertyTree prm("options_flexiblesolver.json");
+    prm.put("tol", 1e-8);
+    prm.put("maxiter", 200);
+    constexpr int bz = 3;
+    const auto reference = testPrec<bz>(prm, "matr33.txt", "rhs3.txt");
+
+    prm.put("preconditioner.finesmoother.single_precision", std::string("true"));
+    prm.put("preconditioner.coarsesolver.preconditioner.single_precision", std::string("true"));
+    auto sol = testPrec<bz>(prm, "matr33.txt", "rhs3.txt");
+
+    BOOST_REQUIRE_EQUAL(sol.size(), reference.size());
+    sol -= reference;
+    BOOST_CHECK_LT(sol.two_norm(), 1e-6 * reference.two_norm());
+}
+#endif
+
+
 template <int bz>
 using M = Dune::BCRSMatrix<Opm::MatrixBlock<double, bz, bz>>;
 template <int bz>
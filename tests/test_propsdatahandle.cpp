@@ -0,0 +1,228 @@
+/*
+  Copyright 2025 Equinor ASA.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#include <config.h>
+
+#define BOOST_TEST_MODULE PropsDataHandleTest
+#define BOOST_TEST_NO_MAIN
+
+#include <boost/test/unit_test.hpp>
+
+#include <opm/simulators/utils/PropsDataHandle.hpp>
+
+#include <opm/grid/CpGrid.hpp>
+
+#include <opm/input/eclipse/Deck/Deck.hpp>
+#include <opm/input/eclipse/Parser/Parser.hpp>
+
+#include <opm/simulators/utils/MPISerializer.hpp>
+#include <opm/simulators/utils/ParallelEclipseState.hpp>
+
+#include <dune/common/parallel/mpihelper.hh>
+#include <dune/grid/common/datahandleif.hh>
+#include <dune/grid/common/mcmgmapper.hh>
+
+#include <cstddef>
+#include <map>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace {
+
+using Grid = Dune::CpGrid;
+using ElementMapper = Dune::MultipleCodimMultipleGeomTypeMapper<Grid::LevelGridView>;
+
+const std::vector<std::string> intKeys { "SATNUM" };
+const std::vector<std::string> doubleKeys { "PORO", "PERMX", "NTG" };
+
+// A 4x5x3 grid with a few inactive cells and different property values in
+// every cell, such that the compressed and the Cartesian indices differ.
+std::string deckString()
+{
+    constexpr int numCells = 4 * 5 * 3;
+    std::ostringstream deck;
+    deck << "RUNSPEC\nDIMENS\n 4 5 3 /\nOIL\nWATER\nTABDIMS\n 3 /\n"
+         << "GRID\nDX\n 60*10 /\nDY\n 60*10 /\nDZ\n 60*1 /\nTOPS\n 20*100 /\n"
+         << "ACTNUM\n 1 0 6*1 0 21*1 0 0 28*1 /\n";
+    deck << "PORO\n";
+    for (int cell = 0; cell < numCells; ++cell) {
+        deck << ' ' << 0.1 + 0.001 * cell;
+    }
+    deck << " /\nPERMX\n";
+    for (int cell = 0; cell < numCells; ++cell) {
+        deck << ' ' << 100 + cell;
+    }
+    deck << " /\nNTG\n";
+    for (int cell = 0; cell < numCells; ++cell) {
+        deck << ' ' << 1.0 - 0.005 * cell;
+    }
+    deck << " /\nREGIONS\nSATNUM\n";
+    for (int cell = 0; cell < numCells; ++cell) {
+        deck << ' ' << 1 + (cell * 7) % 3;
+    }
+    deck << " /\n";
+    return deck.str();
+}
+
+//! \brief Migrates the field properties together with the cells during the
+//!        load balancing, as PropsDataHandle did before the chunked scatter.
+class MigratedProps
+    : public Dune::CommDataHandleIF<MigratedProps, double>
+{
+public:
+    MigratedProps(const Grid& grid, const Opm::ParallelEclipseState& eclState)
+        : grid_(grid)
+    {
+        if (grid.comm().rank() != 0) {
+            return;
+        }
+
+        const auto& globalProps = eclState.globalFieldProps();
+        const auto& gridView = grid.levelGridView(0);
+        const ElementMapper elemMapper(gridView, Dune::mcmgElementLayout());
+        for (const auto& element : elements(gridView)) {
+            const auto index = elemMapper.index(element);
+            auto& data = data_[grid.localIdSet().id(element)];
+            for (const auto& key : intKeys) {
+                data.push_back(globalProps.get_int(key)[index]);
+            }
+            for (const auto& key : doubleKeys) {
+                data.push_back(globalProps.get_double(key)[index]);
+            }
+        }
+    }
+
+    bool contains(int /* dim */, int codim)
+    { return codim == 0; }
+
+    bool fixedSize(int /* dim */, int /* codim */)
+    { return true; }
+
+    template<class EntityType>
+    std::size_t size(const EntityType& /* entity */)
+    { return intKeys.size() + doubleKeys.size(); }
+
+    template<class BufferType, class EntityType>
+    void gather(BufferType& buffer, const EntityType& e) const
+    {
+        for (const auto& value : data_.at(grid_.localIdSet().id(e))) {
+            buffer.write(value);
+        }
+    }
+
+    template<class BufferType, class EntityType>
+    void scatter(BufferType& buffer, const EntityType& e, std::size_t n)
+    {
+        auto& data = data_[grid_.localIdSet().id(e)];
+        data.resize(n);
+        for (auto& value : data) {
+            buffer.read(value);
+        }
+    }
+
+    //! \brief Migrated values of a cell of the distributed grid.
+    const std::vector<double>& values(const Grid::Codim<0>::Entity& element) const
+    { return data_.at(grid_.localIdSet().id(element)); }
+
+private:
+    const Grid& grid_;
+    std::map<int, std::vector<double>> data_;
+};
+
+//! \brief Distribute the grid of the deck and compare the properties of
+//!        scatterProps() to the migrated ones.
+void checkScatterMatchesMigration(std::size_t chunkBytes)
+{
+    const auto comm = Opm::Parallel::Communication { Dune::MPIHelper::getCommunicator() };
+    const bool isRoot = comm.rank() == 0;
+
+    std::unique_ptr<Opm::ParallelEclipseState> eclState;
+    if (isRoot) {
+        const auto deck = Opm::Parser{}.parseString(deckString());
+        eclState = std::make_unique<Opm::ParallelEclipseState>(deck, comm);
+    }
+    else {
+        eclState = std::make_unique<Opm::ParallelEclipseState>(comm);
+    }
+    Opm::Parallel::MpiSerializer ser(comm);
+    ser.broadcast(*eclState);
+
+    Grid grid;
+    grid.processEclipseFormat(isRoot ? &eclState->getInputGrid() : nullptr,
+                              eclState.get(),
+                              /*isPeriodic=*/false,
+                              /*flipNormals=*/false,
+                              /*clipZ=*/false);
+
+    Opm::PropsDataHandle<Grid> handle(grid, *eclState, chunkBytes);
+    MigratedProps migrated(grid, *eclState);
+    grid.loadBalance(migrated);
+    handle.scatterProps();
+    eclState->switchToDistributedProps();
+
+    const auto& props = eclState->fieldProps();
+    const auto& gridView = grid.levelGridView(0);
+    const ElementMapper elemMapper(gridView, Dune::mcmgElementLayout());
+    std::size_t numCells = 0;
+    for (const auto& element : elements(gridView, Dune::Partitions::all)) {
+        const auto index = elemMapper.index(element);
+        const auto& expected = migrated.values(element);
+        std::size_t keyIdx = 0;
+        for (const auto& key : intKeys) {
+            BOOST_CHECK_EQUAL(props.get_int(key)[index], static_cast<int>(expected[keyIdx++]));
+        }
+        for (const auto& key : doubleKeys) {
+            BOOST_CHECK_EQUAL(props.get_double(key)[index], expected[keyIdx++]);
+        }
+        ++numCells;
+    }
+    BOOST_CHECK_EQUAL(numCells, static_cast<std::size_t>(grid.size(0)));
+
+    // the grid has 56 active cells, which are distributed
+    if (comm.size() > 1) {
+        BOOST_CHECK_LT(numCells, std::size_t{56});
+    }
+}
+
+bool init_unit_test_func()
+{
+    return true;
+}
+
+} // Anonymous namespace
+
+BOOST_AUTO_TEST_CASE(ScatterMatchesMigration)
+{
+    checkScatterMatchesMigration(Opm::PropsDataHandle<Grid>::defaultChunkBytes);
+}
+
+// Chunks of a single cell, such that the indices and values of every process
+// are sent in many messages.
+BOOST_AUTO_TEST_CASE(SmallChunksMatchMigration)
+{
+    checkScatterMatchesMigration(/*chunkBytes=*/1);
+}
+
+int main(int argc, char** argv)
+{
+    Dune::MPIHelper::instance(argc, argv);
+
+    return boost::unit_test::unit_test_main(&init_unit_test_func, argc, argv);
+}
@@ -0,0 +1,102 @@
+/*
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <config.h>
+
+#define BOOST_TEST_MODULE TestReadCellWeights
+
+#include <boost/test/unit_test.hpp>
+
+#include <opm/simulators/utils/readCellWeights.hpp>
+
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace {
+
+// Four active cells of a Cartesian grid with inactive cells in between.
+const std::vector<int> globalCell { 0, 2, 3, 7 };
+
+std::vector<float> read(const std::string& input)
+{
+    auto is = std::istringstream { input };
+    return Opm::util::readCellWeights(is, "test", globalCell);
+}
+
+} // Anonymous namespace
+
+BOOST_AUTO_TEST_CASE(OneWeightPerCell)
+{
+    const auto weights = read("1.5\n2\n0\n  4.25  \n\n");
+    const auto expected = std::vector<float> { 1.5f, 2.0f, 0.0f, 4.25f };
+    BOOST_CHECK_EQUAL_COLLECTIONS(weights.begin(), weights.end(),
+                                  expected.begin(), expected.end());
+}
+
+BOOST_AUTO_TEST_CASE(CartesianIndexAndWeight)
+{
+    // Any order of the cells
+    const auto weights = read("7 4.0\n0 1.0\n3 3.0\n2 2.0\n");
+    const auto expected = std::vector<float> { 1.0f, 2.0f, 3.0f, 4.0f };
+    BOOST_CHECK_EQUAL_COLLECTIONS(weights.begin(), weights.end(),
+                                  expected.begin(), expected.end());
+}
+
+BOOST_AUTO_TEST_CASE(WrongNumberOfWeights)
+{
+    BOOST_CHECK_THROW(read("1\n2\n3\n"), std::invalid_argument);
+    BOOST_CHECK_THROW(read("1\n2\n3\n4\n5\n"), std::invalid_argument);
+
+    // Eight values are pairs for the four cells only if given as such
+    BOOST_CHECK_THROW(read("1\n2\n3\n4\n5\n6\n7\n8\n"), std::invalid_argument);
+    BOOST_CHECK_THROW(read(""), std::invalid_argument);
+}
+
+BOOST_AUTO_TEST_CASE(MixedLayouts)
+{
+    BOOST_CHECK_THROW(read("0 1.0\n2 2.0\n3\n7 4.0\n"), std::invalid_argument);
+    BOOST_CHECK_THROW(read("0 1.0 2.0\n"), std::invalid_argument);
+    BOOST_CHECK_THROW(read("1\nfoo\n3\n4\n"), std::invalid_argument);
+}
+
+BOOST_AUTO_TEST_CASE(MissingCell)
+{
+    BOOST_CHECK_THROW(read("0 1.0\n2 2.0\n7 4.0\n"), std::invalid_argument);
+}
+
+BOOST_AUTO_TEST_CASE(UnknownCell)
+{
+    // Inactive cell
+    BOOST_CHECK_THROW(read("0 1.0\n1 2.0\n3 3.0\n7 4.0\n"), std::invalid_argument);
+
+    // Outside of the grid or not an index
+    BOOST_CHECK_THROW(read("0 1.0\n2 2.0\n3 3.0\n-7 4.0\n"), std::invalid_argument);
+    BOOST_CHECK_THROW(read("0 1.0\n2 2.0\n3 3.0\n7.5 4.0\n"), std::invalid_argument);
+}
+
+BOOST_AUTO_TEST_CASE(DuplicateCell)
+{
+    BOOST_CHECK_THROW(read("0 1.0\n2 2.0\n2 3.0\n7 4.0\n"), std::invalid_argument);
+}
+
+BOOST_AUTO_TEST_CASE(InvalidWeight)
+{
+    BOOST_CHECK_THROW(read("1\n-2\n3\n4\n"), std::invalid_argument);
+    BOOST_CHECK_THROW(read("0 1.0\n2 2.0\n3 nan\n7 4.0\n"), std::invalid_argument);
+}
@@ -0,0 +1,248 @@
+/*
+  Copyright 2025 Equinor ASA.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#include <config.h>
+
+#include <dune/common/fmatrix.hh>
+
+#include <opm/simulators/linalg/istlsparsematrixadapter.hh>
+#include <opm/simulators/linalg/sparsitypattern.hh>
+
+#define BOOST_TEST_MODULE SparsityPatternTest
+#include <boost/test/unit_test.hpp>
+
+#include <chrono>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <set>
+#include <vector>
+
+namespace {
+
+//! \brief Allocator counting the number of bytes allocated through it.
+template <class T>
+struct CountingAllocator
+{
+    using value_type = T;
+
+    explicit CountingAllocator(std::size_t& bytes)
+        : bytes_(&bytes)
+    {}
+
+    template <class U>
+    CountingAllocator(const CountingAllocator<U>& other)
+        : bytes_(other.bytes_)
+    {}
+
+    T* allocate(std::size_t n)
+    {
+        *bytes_ += n*sizeof(T);
+        return std::allocator<T>().allocate(n);
+    }
+
+    void deallocate(T* p, std::size_t n)
+    { std::allocator<T>().deallocate(p, n); }
+
+    template <class U>
+    bool operator==(const CountingAllocator<U>& other) const
+    { return bytes_ == other.bytes_; }
+
+    template <class U>
+    bool operator!=(const CountingAllocator<U>& other) const
+    { return bytes_ != other.bytes_; }
+
+    std::size_t* bytes_;
+};
+
+//! \brief Call f(cell, neighbor) for the cell itself and the neighbors of each
+//!        cell of an nx*ny*nz cartesian grid, with a seven-point stencil.
+template <class F>
+void forEachConnection(int nx, int ny, int nz, F&& f)
+{
+    for (int k = 0; k < nz; ++k) {
+        for (int j = 0; j < ny; ++j) {
+            for (int i = 0; i < nx; ++i) {
+                const unsigned cell = i + nx*(j + ny*k);
+                f(cell, cell);
+                if (i > 0)      f(cell, cell - 1);
+                if (i < nx - 1) f(cell, cell + 1);
+                if (j > 0)      f(cell, cell - nx);
+                if (j < ny - 1) f(cell, cell + nx);
+                if (k > 0)      f(cell, cell - nx*ny);
+                if (k < nz - 1) f(cell, cell + nx*ny);
+            }
+        }
+    }
+}
+
+} // anonymous namespace
+
+BOOST_AUTO_TEST_CASE(TwoPassBuild)
+{
+    Opm::Linear::SparsityPattern pattern(4);
+    pattern.incrementRowSize(0, 3);
+    pattern.incrementRowSize(2, 2);
+    pattern.incrementRowSize(3);
+    pattern.allocate();
+
+    // duplicates and unsorted indices
+    pattern.addIndex(0, 2);
+    pattern.addIndex(0, 0);
+    pattern.addIndex(0, 2);
+    const std::vector<unsigned> row2{2, 1};
+    pattern.addIndices(2, row2.begin(), row2.end());
+    // fewer indices than reserved
+    pattern.compress();
+
+    BOOST_CHECK_EQUAL(pattern.rows(), 4);
+    BOOST_CHECK_EQUAL(pattern.nonZeros(), 4);
+    BOOST_CHECK_EQUAL(pattern.rowSize(0), 2);
+    BOOST_CHECK_EQUAL(pattern.rowSize(1), 0);
+    BOOST_CHECK_EQUAL(pattern.rowSize(2), 2);
+    BOOST_CHECK_EQUAL(pattern.rowSize(3), 0);
+
+    const std::vector<unsigned> expected0{0, 2};
+    const std::vector<unsigned> expected2{1, 2};
+    BOOST_CHECK_EQUAL_COLLECTIONS(pattern.rowBegin(0), pattern.rowEnd(0),
+                                  expected0.begin(), expected0.end());
+    BOOST_CHECK_EQUAL_COLLECTIONS(pattern.rowBegin(2), pattern.rowEnd(2),
+                                  expected2.begin(), expected2.end());
+}
+
+BOOST_AUTO_TEST_CASE(InsertExtraEntries)
+{
+    Opm::Linear::SparsityPattern pattern(3);
+    for (unsigned row = 0; row < 3; ++row) {
+        pattern.incrementRowSize(row);
+    }
+    pattern.allocate();
+    for (unsigned row = 0; row < 3; ++row) {
+        pattern.addIndex(row, row);
+    }
+
+    // connect all rows, as a well through all cells would do
+    const std::vector<unsigned> wellCells{2, 0, 1};
+    for (const unsigned cell : wellCells) {
+        pattern.insert(cell, wellCells.begin(), wellCells.end());
+    }
+    pattern.compress();
+
+    BOOST_CHECK_EQUAL(pattern.nonZeros(), 9);
+    const std::vector<unsigned> expected{0, 1, 2};
+    for (unsigned row = 0; row < 3; ++row) {
+        BOOST_CHECK_EQUAL_COLLECTIONS(pattern.rowBegin(row), pattern.rowEnd(row),
+                                      expected.begin(), expected.end());
+    }
+}
+
+BOOST_AUTO_TEST_CASE(InsertOnly)
+{
+    Opm::Linear::SparsityPattern pattern(2);
+    pattern.insert(1, 0);
+    pattern.insert(1, 1);
+    pattern.insert(1, 0);
+    pattern.compress();
+
+    BOOST_CHECK_EQUAL(pattern.rowSize(0), 0);
+    BOOST_CHECK_EQUAL(pattern.rowSize(1), 2);
+    BOOST_CHECK_EQUAL(pattern.nonZeros(), 2);
+}
+
+BOOST_AUTO_TEST_CASE(ReserveMatrix)
+{
+    using Block = Dune::FieldMatrix<double, 2, 2>;
+    using Adapter = Opm::Linear::IstlSparseMatrixAdapter<Block>;
+    const int nx = 5, ny = 4, nz = 3;
+    const std::size_t numCells = nx*ny*nz;
+
+    std::vector<std::set<unsigned>> neighbors(numCells);
+    forEachConnection(nx, ny, nz, [&](unsigned cell, unsigned nb)
+                      { neighbors[cell].insert(nb); });
+
+    Opm::Linear::SparsityPattern pattern(numCells);
+    forEachConnection(nx, ny, nz, [&](unsigned cell, unsigned)
+                      { pattern.incrementRowSize(cell); });
+    pattern.allocate();
+    forEachConnection(nx, ny, nz, [&](unsigned cell, unsigned nb)
+                      { pattern.addIndex(cell, nb); });
+    pattern.compress();
+
+    Adapter fromSets(numCells, numCells);
+    fromSets.reserve(neighbors);
+    Adapter fromPattern(numCells, numCells);
+    fromPattern.reserve(pattern);
+
+    const auto& m1 = fromSets.istlMatrix();
+    const auto& m2 = fromPattern.istlMatrix();
+    BOOST_CHECK_EQUAL(m1.nonzeroes(), m2.nonzeroes());
+    for (std::size_t row = 0; row < numCells; ++row) {
+        BOOST_REQUIRE_EQUAL(m1[row].size(), m2[row].size());
+        auto col2 = m2[row].begin();
+        for (auto col1 = m1[row].begin(); col1 != m1[row].end(); ++col1, ++col2) {
+            BOOST_CHECK_EQUAL(col1.index(), col2.index());
+        }
+    }
+}
+
+// Compare the time and memory needed to build the sparsity pattern of a
+// seven-point stencil on a 64^3 grid using one std::set per row and using
+// the compressed row builder. The numbers are reported as test messages,
+// run with --log_level=message to see them.
+BOOST_AUTO_TEST_CASE(StartupBenchmark)
+{
+    const int n = 64;
+    const std::size_t numCells = n*n*n;
+    using Clock = std::chrono::steady_clock;
+    using Seconds = std::chrono::duration<double>;
+
+    std::size_t setBytes = 0;
+    std::size_t setNonZeros = 0;
+    const auto setStart = Clock::now();
+    {
+        using Set = std::set<unsigned, std::less<unsigned>, CountingAllocator<unsigned>>;
+        std::vector<Set> neighbors(numCells, Set(CountingAllocator<unsigned>(setBytes)));
+        forEachConnection(n, n, n, [&](unsigned cell, unsigned nb)
+                          { neighbors[cell].insert(nb); });
+        setBytes += neighbors.capacity()*sizeof(Set);
+        for (const auto& nb : neighbors) {
+            setNonZeros += nb.size();
+        }
+    }
+    const Seconds setTime = Clock::now() - setStart;
+
+    const auto csrStart = Clock::now();
+    Opm::Linear::SparsityPattern pattern(numCells);
+    forEachConnection(n, n, n, [&](unsigned cell, unsigned)
+                      { pattern.incrementRowSize(cell); });
+    pattern.allocate();
+    forEachConnection(n, n, n, [&](unsigned cell, unsigned nb)
+                      { pattern.addIndex(cell, nb); });
+    pattern.compress();
+    const Seconds csrTime = Clock::now() - csrStart;
+
+    BOOST_CHECK_EQUAL(pattern.nonZeros(), setNonZeros);
+    BOOST_CHECK_LT(pattern.memoryUsage(), setBytes);
+
+    BOOST_TEST_MESSAGE("Sparsity pattern of " << numCells << " cells, "
+                       << setNonZeros << " entries:");
+    BOOST_TEST_MESSAGE("  std::set per row: " << setTime.count() << " s, "
+                       << setBytes / (1024.0*1024.0) << " MiB");
+    BOOST_TEST_MESSAGE("  compressed rows:  " << csrTime.count() << " s, "
+                       << pattern.memoryUsage() / (1024.0*1024.0) << " MiB");
+}
@@ -0,0 +1,310 @@
+// -*- mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-
+// vi: set et ts=4 sw=4 sts=4:
+/*
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+
+  Consult the COPYING file in the top-level source directory of this
+  module for the precise wording of the license and the list of
+  copyright holders.
+*/
+#include "config.h"
+#include "TestTypeTag.hpp"
+
+#define BOOST_TEST_MODULE TpfaLinearizer
+
+#include <opm/models/blackoil/blackoillocalresidualtpfa.hh>
+#include <opm/models/discretization/common/tpfalinearizer.hh>
+#include <opm/models/utils/parametersystem.hpp>
+#include <opm/models/utils/propertysystem.hh>
+#include <opm/models/utils/start.hh>
+
+#include <opm/simulators/flow/BlackoilModelParameters.hpp>
+#include <opm/simulators/flow/FlowGenericVanguard.hpp>
+
+#if HAVE_DUNE_FEM
+#include <dune/fem/misc/mpimanager.hh>
+#else
+#include <dune/common/parallel/mpihelper.hh>
+#endif
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+#include <algorithm>
+#include <cmath>
+#include <memory>
+#include <string>
+
+#include <boost/test/unit_test.hpp>
+
+namespace Opm::Properties {
+
+namespace TTag {
+
+struct TestTpfaTypeTag {
+    using InheritsFrom = std::tuple<TestTypeTag>;
+};
+
+} // namespace TTag
+
+template<class TypeTag>
+struct Linearizer<TypeTag, TTag::TestTpfaTypeTag> { using type = TpfaLinearizer<TypeTag>; };
+
+template<class TypeTag>
+struct LocalResidual<TypeTag, TTag::TestTpfaTypeTag> { using type = BlackOilLocalResidualTPFA<TypeTag>; };
+
+template<class TypeTag>
+struct EnableDiffusion<TypeTag, TTag::TestTpfaTypeTag> { static constexpr bool value = false; };
+
+} // namespace Opm::Properties
+
+namespace {
+
+using TypeTag = Opm::Properties::TTag::TestTpfaTypeTag;
+using Simulator = Opm::GetPropType<TypeTag, Opm::Properties::Simulator>;
+using Indices = Opm::GetPropType<TypeTag, Opm::Properties::Indices>;
+using SparseMatrixAdapter = Opm::GetPropType<TypeTag, Opm::Properties::SparseMatrixAdapter>;
+using GlobalEqVector = Opm::GetPropType<TypeTag, Opm::Properties::GlobalEqVector>;
+using Matrix = typename SparseMatrixAdapter::IstlMatrix;
+
+std::unique_ptr<Simulator>
+initSimulator(const char* filename, const bool faceBased)
+{
+    using namespace Opm;
+
+    const std::string filenameArg = std::string {"--ecl-deck-file-name="} + filename;
+    const std::string faceBasedArg = std::string {"--face-based-linearization="}
+        + (faceBased ? "true" : "false");
+
+    const char* argv[] = {
+        "test_tpfalinearizer",
+        filenameArg.c_str(),
+        faceBasedArg.c_str(),
+        "--check-satfunc-consistency=false",
+    };
+
+    Parameters::reset();
+    registerAllParameters_<TypeTag>(false);
+    registerEclTimeSteppingParameters<double>();
+    BlackoilModelParameters<double>::registerParameters();
+    Parameters::Register<Parameters::EnableTerminalOutput>("Do *NOT* use!");
+    Parameters::endRegistration();
+    setupParameters_<TypeTag>(/*argc=*/sizeof(argv) / sizeof(argv[0]),
+                              argv, /*registerParams=*/false);
+
+    FlowGenericVanguard::readDeck(filename);
+    return std::make_unique<Simulator>();
+}
+
+// Linearize the flow equations at the initial state with a pressure
+// gradient imposed on top of it, such that the fluxes are not close
+// to zero and the upstream directions are unambiguous.
+void linearize(Simulator& simulator)
+{
+    simulator.model().applyInitialSolution();
+    simulator.setEpisodeIndex(-1);
+    simulator.setEpisodeLength(0.0);
+    simulator.startNextEpisode(/*episodeStartTime=*/0.0, /*episodeLength=*/1e30);
+    simulator.setTimeStepSize(86400.0);
+    simulator.model().newtonMethod().setIterationIndex(0);
+
+    auto& solution = simulator.model().solution(/*timeIdx=*/0);
+    for (unsigned globI = 0; globI < solution.size(); ++globI) {
+        solution[globI][Indices::pressureSwitchIdx] += 1.0e5 * globI;
+    }
+    simulator.model().invalidateAndUpdateIntensiveQuantities(/*timeIdx=*/0);
+
+    simulator.model().linearizer().linearizeDomain();
+}
+
+double maxAbs(const GlobalEqVector& residual)
+{
+    double result = 0.0;
+    for (const auto& block : residual) {
+        for (const auto& entry : block) {
+            result = std::max(result, std::abs(entry));
+        }
+    }
+    return result;
+}
+
+double maxAbs(const Matrix& matrix)
+{
+    double result = 0.0;
+    for (auto row = matrix.begin(); row != matrix.end(); ++row) {
+        for (auto col = row->begin(); col != row->end(); ++col) {
+            for (const auto& blockRow : *col) {
+                for (const auto& entry : blockRow) {
+                    result = std::max(result, std::abs(entry));
+                }
+            }
+        }
+    }
+    return result;
+}
+
+// Compare two linear systems entry by entry. A tolerance of zero requires
+// the systems to be bitwise identical.
+void checkEqual(const SparseMatrixAdapter& jac1, const GlobalEqVector& res1,
+                const SparseMatrixAdapter& jac2, const GlobalEqVector& res2,
+                const double relTol)
+{
+    const auto& mat1 = jac1.istlMatrix();
+    const auto& mat2 = jac2.istlMatrix();
+    BOOST_REQUIRE_EQUAL(mat1.N(), mat2.N());
+    BOOST_REQUIRE_EQUAL(mat1.nonzeroes(), mat2.nonzeroes());
+    BOOST_REQUIRE_EQUAL(res1.size(), res2.size());
+
+    const double resTol = relTol * maxAbs(res1);
+    for (std::size_t i = 0; i < res1.size(); ++i) {
+        for (std::size_t eqIdx = 0; eqIdx < res1[i].size(); ++eqIdx) {
+            BOOST_CHECK_SMALL(res1[i][eqIdx] - res2[i][eqIdx], resTol);
+            if (relTol == 0.0) {
+                BOOST_CHECK_EQUAL(res1[i][eqIdx], res2[i][eqIdx]);
+            }
+        }
+    }
+
+    const double matTol = relTol * maxAbs(mat1);
+    for (auto row1 = mat1.begin(); row1 != mat1.end(); ++row1) {
+        const auto& row2 = mat2[row1.index()];
+        for (auto col1 = row1->begin(); col1 != row1->end(); ++col1) {
+            BOOST_REQUIRE(row2.find(col1.index()) != row2.end());
+            const auto& block1 = *col1;
+            const auto& block2 = row2[col1.index()];
+            for (std::size_t r = 0; r < block1.N(); ++r) {
+                for (std::size_t c = 0; c < block1.M(); ++c) {
+                    BOOST_CHECK_SMALL(block1[r][c] - block2[r][c], matTol);
+                    if (relTol == 0.0) {
+                        BOOST_CHECK_EQUAL(block1[r][c], block2[r][c]);
+                    }
+                }
+            }
+        }
+    }
+}
+
+struct TpfaLinearizerFixture
+{
+    TpfaLinearizerFixture()
+    {
+        int argc = boost::unit_test::framework::master_test_suite().argc;
+        char** argv = boost::unit_test::framework::master_test_suite().argv;
+#if HAVE_DUNE_FEM
+        Dune::Fem::MPIManager::initialize(argc, argv);
+#else
+        Dune::MPIHelper::instance(argc, argv);
+#endif
+        Opm::FlowGenericVanguard::setCommunication(std::make_unique<Opm::Parallel::Communication>());
+    }
+};
+
+} // Anonymous namespace
+
+BOOST_GLOBAL_FIXTURE(TpfaLinearizerFixture);
+
+BOOST_AUTO_TEST_CASE(FaceBasedMatchesCellBased)
+{
+    static_assert(Opm::GetPropType<TypeTag, Opm::Properties::LocalResidual>::supportsFaceFlux,
+                  "The test must exercise the single evaluation of the face fluxes.");
+
+    auto cellBased = initSimulator("equil_liveoil.DATA", /*faceBased=*/false);
+    linearize(*cellBased);
+
+    auto faceBased = initSimulator("equil_liveoil.DATA", /*faceBased=*/true);
+    linearize(*faceBased);
+
+    // The flux of the exterior cell of a face is the negated flux of the
+    // interior cell instead of being evaluated separately.
+    checkEqual(cellBased->model().linearizer().jacobian(),
+               cellBased->model().linearizer().residual(),
+               faceBased->model().linearizer().jacobian(),
+               faceBased->model().linearizer().residual(),
+               /*relTol=*/1.0e-12);
+}
+
+BOOST_AUTO_TEST_CASE(FaceFluxMatchesFluxOfInteriorCell)
+{
+    using LocalResidual = Opm::GetPropType<TypeTag, Opm::Properties::LocalResidual>;
+    using RateVector = Opm::GetPropType<TypeTag, Opm::Properties::RateVector>;
+    constexpr int numEq = Indices::numEq;
+
+    auto simulator = initSimulator("equil_liveoil.DATA", /*faceBased=*/false);
+    linearize(*simulator);
+
+    const auto& model = simulator->model();
+    const auto& moduleParams = simulator->problem().moduleParams();
+    const auto& intQuants0 = model.intensiveQuantities(/*globalIdx=*/0, /*timeIdx=*/0);
+    const auto& intQuants1 = model.intensiveQuantities(/*globalIdx=*/1, /*timeIdx=*/0);
+
+    // Both upstream directions, with and without gravity and threshold
+    // pressure. The value and the derivatives w.r.t. the interior cell are
+    // computed by the same operations as the ones of computeFlux().
+    for (const double dZg : { -1.0e5, 0.0, 1.0e5 }) {
+        for (const double thpres : { 0.0, 1.0e3 }) {
+            for (const bool swap : { false, true }) {
+                const auto& intQuantsIn = swap ? intQuants1 : intQuants0;
+                const auto& intQuantsEx = swap ? intQuants0 : intQuants1;
+                const unsigned globalIn = swap ? 1 : 0;
+                const unsigned globalEx = swap ? 0 : 1;
+                const typename LocalResidual::ResidualNBInfo nbInfo {
+                    1.0e-12, 2.0, thpres, dZg, Opm::FaceDir::DirEnum::Unknown,
+                    1.0, 1.0, 0.0, 0.0, 0.0, 0.0
+                };
+
+                RateVector flux;
+                RateVector darcy;
+                LocalResidual::computeFlux(flux, darcy, globalIn, globalEx,
+                                           intQuantsIn, intQuantsEx, nbInfo, moduleParams);
+                typename LocalResidual::FaceRateVector faceFlux;
+                LocalResidual::computeFaceFlux(faceFlux, globalIn, globalEx,
+                                               intQuantsIn, intQuantsEx, nbInfo, moduleParams);
+
+                for (int eqIdx = 0; eqIdx < numEq; ++eqIdx) {
+                    BOOST_CHECK_EQUAL(flux[eqIdx].value(), faceFlux[eqIdx].value());
+                    for (int pvIdx = 0; pvIdx < numEq; ++pvIdx) {
+                        BOOST_CHECK_EQUAL(flux[eqIdx].derivative(pvIdx),
+                                          faceFlux[eqIdx].derivative(pvIdx));
+                    }
+                }
+            }
+        }
+    }
+}
+
+#ifdef _OPENMP
+BOOST_AUTO_TEST_CASE(FaceBasedIndependentOfThreads)
+{
+    const int maxThreads = omp_get_max_threads();
+
+    omp_set_num_threads(1);
+    auto serial = initSimulator("equil_liveoil.DATA", /*faceBased=*/true);
+    linearize(*serial);
+
+    omp_set_num_threads(4);
+    auto threaded = initSimulator("equil_liveoil.DATA", /*faceBased=*/true);
+    linearize(*threaded);
+
+    omp_set_num_threads(maxThreads);
+
+    checkEqual(serial->model().linearizer().jacobian(),
+               serial->model().linearizer().residual(),
+               threaded->model().linearizer().jacobian(),
+               threaded->model().linearizer().residual(),
+               /*relTol=*/0.0);
+}
+#endif
@@ -0,0 +1,228 @@
+/*
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#include <config.h>
+
+#include <dune/common/fvector.hh>
+#include <dune/istl/bcrsmatrix.hh>
+#include <dune/istl/bvector.hh>
+#include <dune/istl/operators.hh>
+#include <dune/istl/preconditioners.hh>
+#include <dune/istl/solvers.hh>
+
+#include <opm/simulators/flow/TracerSweepSolver.hpp>
+#include <opm/simulators/linalg/matrixblock.hh>
+
+#define BOOST_TEST_MODULE TracerSweepSolverTest
+#define BOOST_TEST_MAIN
+
+#include <boost/test/unit_test.hpp>
+
+#include <cmath>
+#include <vector>
+
+namespace {
+
+using Block = Opm::MatrixBlock<double, 2, 2>;
+using Matrix = Dune::BCRSMatrix<Block>;
+using Vector = Dune::BlockVector<Dune::FieldVector<double, 2>>;
+
+// Upwind matrix on an nx x ny grid with the flux going in the positive x
+// and y directions. Like the tracer matrix, it has a symmetric sparsity
+// pattern, but the downstream blocks are zero.
+Matrix createUpwindMatrix(int nx, int ny, bool periodicX = false)
+{
+    const int n = nx * ny;
+    Matrix matrix(n, n, 5, 0.4, Matrix::implicit);
+    for (int j = 0; j < ny; ++j) {
+        for (int i = 0; i < nx; ++i) {
+            const int index = j * nx + i;
+            auto& diag = matrix.entry(index, index);
+            diag = 0.0;
+            diag[0][0] = 4.0 + 0.1 * i;
+            diag[1][1] = 3.0 + 0.1 * j;
+            diag[0][1] = 0.5;
+            diag[1][0] = -0.5;
+
+            const int left = i > 0 ? index - 1 : (periodicX ? index + nx - 1 : -1);
+            const int right = i < nx - 1 ? index + 1 : (periodicX ? index - nx + 1 : -1);
+            if (left >= 0 && left != index) {
+                auto& up = matrix.entry(index, left);
+                up = 0.0;
+                up[0][0] = -1.0;
+                up[1][1] = -0.5;
+            }
+            if (right >= 0 && right != index) {
+                matrix.entry(index, right) = 0.0;
+            }
+            if (j > 0) {
+                auto& up = matrix.entry(index, index - nx);
+                up = 0.0;
+                up[0][0] = -0.5;
+                up[1][1] = -1.0;
+            }
+            if (j < ny - 1) {
+                matrix.entry(index, index + nx) = 0.0;
+            }
+        }
+    }
+    matrix.compress();
+    return matrix;
+}
+
+std::vector<Vector> createRhs(std::size_t n, int numRhs)
+{
+    std::vector<Vector> b(numRhs, Vector(n));
+    for (int k = 0; k < numRhs; ++k) {
+        for (std::size_t i = 0; i < n; ++i) {
+            b[k][i][0] = std::sin(1.0 + i + k);
+            b[k][i][1] = std::cos(2.0 * i - k);
+        }
+    }
+    return b;
+}
+
+double residualNorm(const Matrix& matrix, const Vector& x, const Vector& b)
+{
+    Vector r(b);
+    matrix.mmv(x, r);
+    return r.infinity_norm();
+}
+
+} // anonymous namespace
+
+BOOST_AUTO_TEST_CASE(SolvesAcyclicSystem)
+{
+    const int nx = 7;
+    const int ny = 5;
+    const auto matrix = createUpwindMatrix(nx, ny);
+    const auto b = createRhs(matrix.N(), 3);
+
+    Opm::TracerSweepSolver<Matrix, Vector> solver;
+    BOOST_REQUIRE(solver.update(matrix));
+    BOOST_CHECK_EQUAL(solver.numLevels(), static_cast<std::size_t>(nx + ny - 1));
+
+    std::vector<Vector> x(b.size(), Vector(matrix.N()));
+    solver.apply(x, b);
+    for (std::size_t k = 0; k < b.size(); ++k) {
+        BOOST_CHECK_SMALL(residualNorm(matrix, x[k], b[k]), 1e-12);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(ReusesSolverForNewValues)
+{
+    auto matrix = createUpwindMatrix(4, 4);
+    const auto b = createRhs(matrix.N(), 2);
+
+    Opm::TracerSweepSolver<Matrix, Vector> solver;
+    BOOST_REQUIRE(solver.update(matrix));
+
+    // reverse the flux between the first two cells
+    matrix[1][0] = 0.0;
+    matrix[0][1][0][0] = -2.0;
+    BOOST_REQUIRE(solver.update(matrix));
+
+    std::vector<Vector> x(b.size(), Vector(matrix.N()));
+    solver.apply(x, b);
+    for (std::size_t k = 0; k < b.size(); ++k) {
+        BOOST_CHECK_SMALL(residualNorm(matrix, x[k], b[k]), 1e-12);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(DetectsCycles)
+{
+    const auto matrix = createUpwindMatrix(6, 3, /*periodicX=*/true);
+
+    Opm::TracerSweepSolver<Matrix, Vector> solver;
+    BOOST_CHECK(!solver.update(matrix));
+}
+
+BOOST_AUTO_TEST_CASE(DetectsSingularDiagonal)
+{
+    auto matrix = createUpwindMatrix(3, 3);
+    matrix[4][4] = 0.0;
+
+    Opm::TracerSweepSolver<Matrix, Vector> solver;
+    BOOST_CHECK(!solver.update(matrix));
+}
+
+BOOST_AUTO_TEST_CASE(DetectsIllConditionedDiagonal)
+{
+    auto matrix = createUpwindMatrix(3, 3);
+    // nonzero determinant, but a condition number of about 4e12
+    matrix[4][4] = 0.0;
+    matrix[4][4][0][0] = 1.0;
+    matrix[4][4][0][1] = 1.0;
+    matrix[4][4][1][0] = 1.0;
+    matrix[4][4][1][1] = 1.0 + 1e-12;
+
+    Opm::TracerSweepSolver<Matrix, Vector> solver;
+    BOOST_CHECK(!solver.update(matrix));
+}
+
+BOOST_AUTO_TEST_CASE(MatchesIterativeSolver)
+{
+    // Reverse the flux in the x direction, such that the matrix is not
+    // triangular in the natural ordering and ILU0 is not exact.
+    const int nx = 6;
+    const int ny = 4;
+    auto matrix = createUpwindMatrix(nx, ny);
+    for (int j = 0; j < ny; ++j) {
+        for (int i = 0; i < nx; ++i) {
+            const int index = j * nx + i;
+            if (i > 0) {
+                matrix[index][index - 1] = 0.0;
+            }
+            if (i < nx - 1) {
+                auto& up = matrix[index][index + 1];
+                up[0][0] = -1.0;
+                up[1][1] = -0.5;
+            }
+        }
+    }
+    const auto b = createRhs(matrix.N(), 2);
+
+    Opm::TracerSweepSolver<Matrix, Vector> solver;
+    BOOST_REQUIRE(solver.update(matrix));
+    std::vector<Vector> x(b.size(), Vector(matrix.N()));
+    solver.apply(x, b);
+
+    // The solver previously used for all tracer systems, with the same
+    // settings as GenericTracerModel. The sweep result only differs from
+    // its result by the error the iterative solver is allowed to make.
+    const double tolerance = 1e-2;
+    Dune::MatrixAdapter<Matrix, Vector, Vector> op(matrix);
+    Dune::SeqScalarProduct<Vector> sp;
+    Dune::SeqILU<Matrix, Vector, Vector> ilu(matrix, 0, 1);
+    Dune::BiCGSTABSolver<Vector> bicgstab(op, sp, ilu, tolerance, 100, 0);
+
+    for (std::size_t k = 0; k < b.size(); ++k) {
+        BOOST_CHECK_SMALL(residualNorm(matrix, x[k], b[k]), 1e-12);
+
+        Vector xIter(matrix.N());
+        xIter = 0.0;
+        Vector rhs(b[k]);
+        Dune::InverseOperatorResult result;
+        bicgstab.apply(xIter, rhs, result);
+        BOOST_REQUIRE(result.converged);
+
+        Vector diff(xIter);
+        diff -= x[k];
+        Vector defect(matrix.N());
+        matrix.mv(diff, defect);
+        BOOST_CHECK_LE(defect.two_norm(), (1.0 + 1e-6) * tolerance * b[k].two_norm());
+    }
+}
@@ -23,6 +23,8 @@
 #define BOOST_TEST_MODULE VFPTest
 
 #include <algorithm>
+#include <chrono>
+#include <cmath>
 #include <filesystem>
 #include <memory>
 #include <map>
@@ -100,6 +102,26 @@ BOOST_AUTO_TEST_CASE(findInterpData)
     BOOST_CHECK_EQUAL(eval5.factor_, 1.0);
 }
 
+BOOST_AUTO_TEST_CASE(findInterpDataWithHint)
+{
+    const std::vector<double> values { 1.0, 2.0, 3.0, 3.0, 4.0, 6.0 };
+
+    // Every hint, including the default one, must give the result of the search
+    for (int h = 0; h < 7; ++h) {
+        Opm::detail::InterpData<double> hint;
+        hint.ind_[0] = std::max(h - 1, 0);
+        hint.ind_[1] = h;
+        for (double value = -1.0; value <= 7.0; value += 0.25) {
+            const auto ref = Opm::VFPHelpers<double>::findInterpData(value, values);
+            const auto res = Opm::VFPHelpers<double>::findInterpData(value, values, hint);
+            BOOST_CHECK_EQUAL(res.ind_[0], ref.ind_[0]);
+            BOOST_CHECK_EQUAL(res.ind_[1], ref.ind_[1]);
+            BOOST_CHECK_EQUAL(res.factor_, ref.factor_);
+            BOOST_CHECK_EQUAL(res.inv_dist_, ref.inv_dist_);
+        }
+    }
+}
+
 BOOST_AUTO_TEST_SUITE_END() // HelperTests
 
 
@@ -571,6 +593,117 @@ BOOST_AUTO_TEST_CASE(ExplicitBhpLookup)
     BOOST_CHECK_CLOSE(bhp_val, bhp_val_explicit, max_d_tol);
 }
 
+/**
+ * The cached and batched lookups must give exactly the values and
+ * derivatives of the plain lookups.
+ */
+BOOST_AUTO_TEST_CASE(CachedAndBatchedLookup)
+{
+    fillDataRandom();
+    initProperties();
+
+    const double thp = 0.43;
+    const double wfr = 0.61;
+    const double gfr = 0.37;
+    const double alq = 0.52;
+
+    std::vector<double> flos;
+    for (int i = -5; i < 130; ++i) {
+        flos.push_back(i / 117.0);
+    }
+    // unsorted points as well
+    flos.push_back(0.5);
+    flos.push_back(0.1);
+
+    std::vector<VFPEvaluation> batch;
+    Opm::VFPHelpers<double>::bhpAtFlos(*table, flos, thp, wfr, gfr, alq, batch);
+    BOOST_REQUIRE_EQUAL(batch.size(), flos.size());
+
+    Opm::detail::VFPInterpCache<double> cache;
+    for (std::size_t i = 0; i < flos.size(); ++i) {
+        const auto thp_i = Opm::VFPHelpers<double>::findInterpData(thp, table->getTHPAxis());
+        const auto wfr_i = Opm::VFPHelpers<double>::findInterpData(wfr, table->getWFRAxis());
+        const auto gfr_i = Opm::VFPHelpers<double>::findInterpData(gfr, table->getGFRAxis());
+        const auto alq_i = Opm::VFPHelpers<double>::findInterpData(alq, table->getALQAxis());
+        const auto flo_i = Opm::VFPHelpers<double>::findInterpData(flos[i], table->getFloAxis());
+        const auto ref = Opm::VFPHelpers<double>::interpolate(*table, flo_i, thp_i,
+                                                              wfr_i, gfr_i, alq_i);
+        BOOST_CHECK_EQUAL(batch[i].value, ref.value);
+        BOOST_CHECK_EQUAL(batch[i].dflo, ref.dflo);
+        BOOST_CHECK_EQUAL(batch[i].dthp, ref.dthp);
+        BOOST_CHECK_EQUAL(batch[i].dwfr, ref.dwfr);
+        BOOST_CHECK_EQUAL(batch[i].dgfr, ref.dgfr);
+        BOOST_CHECK_EQUAL(batch[i].dalq, ref.dalq);
+
+        // oil rate with the given ratios, flo is the oil rate for this table
+        const double liquid = -flos[i];
+        const double aqua = wfr * liquid;
+        const double vapour = gfr * liquid;
+        const double plain = properties->bhp(1, aqua, liquid, vapour, thp, alq, 0.0, 0.0, false);
+        const double cached = properties->bhp(1, aqua, liquid, vapour, thp, alq, 0.0, 0.0, false, cache);
+        BOOST_CHECK_EQUAL(cached, plain);
+    }
+}
+
+/**
+ * Compare the time of evaluating the bhp at many rates, as done while
+ * solving for the bhp at a thp limit, with plain lookups, with a lookup
+ * cache and as a batch. The numbers are reported as test messages, run
+ * with --log_level=message to see them.
+ */
+BOOST_AUTO_TEST_CASE(InterpolationBenchmark)
+{
+    using Clock = std::chrono::steady_clock;
+    using Seconds = std::chrono::duration<double>;
+
+    fillDataRandom();
+    initProperties();
+
+    const double thp = 0.43;
+    const double wfr = 0.61;
+    const double gfr = 0.37;
+    const double alq = 0.52;
+    const int n = 200000;
+
+    std::vector<double> flos(n);
+    for (int i = 0; i < n; ++i) {
+        // a slowly varying rate, as in a bisection
+        flos[i] = 0.5 + 0.4 * std::sin(1.0e-3 * i);
+    }
+
+    double sum_plain = 0.0;
+    const auto plain_start = Clock::now();
+    for (const double flo : flos) {
+        sum_plain += properties->bhp(1, wfr * -flo, -flo, gfr * -flo, thp, alq, 0.0, 0.0, false);
+    }
+    const Seconds plain_time = Clock::now() - plain_start;
+
+    double sum_cached = 0.0;
+    Opm::detail::VFPInterpCache<double> cache;
+    const auto cached_start = Clock::now();
+    for (const double flo : flos) {
+        sum_cached += properties->bhp(1, wfr * -flo, -flo, gfr * -flo, thp, alq, 0.0, 0.0, false, cache);
+    }
+    const Seconds cached_time = Clock::now() - cached_start;
+
+    double sum_batch = 0.0;
+    std::vector<VFPEvaluation> batch;
+    const auto batch_start = Clock::now();
+    Opm::VFPHelpers<double>::bhpAtFlos(*table, flos, thp, wfr, gfr, alq, batch);
+    for (const auto& eval : batch) {
+        sum_batch += eval.value;
+    }
+    const Seconds batch_time = Clock::now() - batch_start;
+
+    BOOST_CHECK_EQUAL(sum_cached, sum_plain);
+    BOOST_CHECK_CLOSE(sum_batch, sum_plain, 1.0e-8);
+
+    BOOST_TEST_MESSAGE("VFP bhp at " << n << " rates:");
+    BOOST_TEST_MESSAGE("  plain lookups:  " << plain_time.count() << " s");
+    BOOST_TEST_MESSAGE("  cached lookups: " << cached_time.count() << " s");
+    BOOST_TEST_MESSAGE("  batch:          " << batch_time.count() << " s");
+}
+
 
 BOOST_AUTO_TEST_SUITE_END() // Trivial tests
 
@@ -0,0 +1,194 @@
+// -*- mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-
+// vi: set et ts=4 sw=4 sts=4:
+/*
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+
+  Consult the COPYING file in the top-level source directory of this
+  module for the precise wording of the license and the list of
+  copyright holders.
+*/
+#include "config.h"
+#include "TestTypeTag.hpp"
+
+#define BOOST_TEST_MODULE WellModelThreads
+
+#include <opm/models/parallel/threadmanager.hpp>
+#include <opm/models/utils/parametersystem.hpp>
+#include <opm/models/utils/propertysystem.hh>
+#include <opm/models/utils/start.hh>
+
+#include <opm/simulators/flow/BlackoilModelParameters.hpp>
+#include <opm/simulators/flow/FlowGenericVanguard.hpp>
+#include <opm/simulators/wells/BlackoilWellModel.hpp>
+#include <opm/simulators/wells/WellState.hpp>
+
+#if HAVE_DUNE_FEM
+#include <dune/fem/misc/mpimanager.hh>
+#else
+#include <dune/common/parallel/mpihelper.hh>
+#endif
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+#include <cmath>
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <boost/test/unit_test.hpp>
+
+namespace {
+
+using TypeTag = Opm::Properties::TTag::TestTypeTag;
+using Simulator = Opm::GetPropType<TypeTag, Opm::Properties::Simulator>;
+using Indices = Opm::GetPropType<TypeTag, Opm::Properties::Indices>;
+using WellModel = Opm::BlackoilWellModel<TypeTag>;
+
+std::unique_ptr<Simulator>
+initSimulator(const char* filename, const int numThreads)
+{
+    using namespace Opm;
+
+    const std::string filenameArg = std::string {"--ecl-deck-file-name="} + filename;
+    const std::string threadsArg = "--threads-per-process=" + std::to_string(numThreads);
+
+    const char* argv[] = {
+        "test_wellmodelthreads",
+        filenameArg.c_str(),
+        threadsArg.c_str(),
+        "--check-satfunc-consistency=false",
+    };
+
+    Parameters::reset();
+    registerAllParameters_<TypeTag>(false);
+    registerEclTimeSteppingParameters<double>();
+    BlackoilModelParameters<double>::registerParameters();
+    Parameters::Register<Parameters::EnableTerminalOutput>("Do *NOT* use!");
+    Parameters::endRegistration();
+    setupParameters_<TypeTag>(/*argc=*/sizeof(argv) / sizeof(argv[0]),
+                              argv, /*registerParams=*/false);
+
+    // The well model sizes its per-thread buffers for the number of
+    // threads of the thread manager when it is constructed.
+    ThreadManager::init();
+
+    FlowGenericVanguard::readDeck(filename);
+    return std::make_unique<Simulator>();
+}
+
+// Assemble and solve the well equations of the first iteration of the
+// first time step, update the well state for a reservoir solution update
+// and return the resulting bottom hole pressures and surface rates.
+std::vector<double> solveWells(const char* filename, const int numThreads)
+{
+    auto simulator = initSimulator(filename, numThreads);
+
+    simulator->model().applyInitialSolution();
+    simulator->setEpisodeIndex(-1);
+    simulator->setEpisodeLength(0.0);
+    simulator->startNextEpisode(/*episodeStartTime=*/0.0, /*episodeLength=*/1e30);
+    simulator->setTimeStepSize(86400.0);
+    simulator->model().newtonMethod().setIterationIndex(0);
+
+    WellModel& wellModel = simulator->problem().wellModel();
+    wellModel.beginReportStep(/*time_step=*/0);
+    wellModel.beginTimeStep();
+    wellModel.beginIteration();
+
+    typename WellModel::BVector x(simulator->model().numGridDof());
+    for (std::size_t cellIdx = 0; cellIdx < x.size(); ++cellIdx) {
+        x[cellIdx] = 0.0;
+        x[cellIdx][Indices::pressureSwitchIdx] = 1.0e3 * (static_cast<int>(cellIdx % 7) - 3);
+    }
+    wellModel.recoverWellSolutionAndUpdateWellState(x);
+
+    std::vector<double> result;
+    const auto& wellState = wellModel.wellState();
+    for (std::size_t wellIdx = 0; wellIdx < wellState.size(); ++wellIdx) {
+        const auto& ws = wellState.well(wellState.name(wellIdx));
+        result.push_back(ws.bhp);
+        result.insert(result.end(), ws.surface_rates.begin(), ws.surface_rates.end());
+    }
+    return result;
+}
+
+struct WellModelThreadsFixture
+{
+    WellModelThreadsFixture()
+    {
+        int argc = boost::unit_test::framework::master_test_suite().argc;
+        char** argv = boost::unit_test::framework::master_test_suite().argv;
+#if HAVE_DUNE_FEM
+        Dune::Fem::MPIManager::initialize(argc, argv);
+#else
+        Dune::MPIHelper::instance(argc, argv);
+#endif
+        Opm::FlowGenericVanguard::setCommunication(std::make_unique<Opm::Parallel::Communication>());
+    }
+};
+
+} // Anonymous namespace
+
+BOOST_GLOBAL_FIXTURE(WellModelThreadsFixture);
+
+BOOST_AUTO_TEST_CASE(WellsSolved)
+{
+    const auto result = solveWells("TESTWELLMODELTHREADS.DATA", /*numThreads=*/1);
+    BOOST_REQUIRE(!result.empty());
+    for (const auto value : result) {
+        BOOST_CHECK(std::isfinite(value));
+    }
+}
+
+#ifdef _OPENMP
+namespace {
+
+void checkIndependentOfThreads(const char* filename)
+{
+    const int maxThreads = omp_get_max_threads();
+
+    const auto serial = solveWells(filename, /*numThreads=*/1);
+    const auto threaded = solveWells(filename, /*numThreads=*/4);
+
+    // Restore the number of threads for the remaining tests.
+    omp_set_num_threads(maxThreads);
+    Opm::ThreadManager::init(/*queryCommandLineParameter=*/false);
+
+    // The wells only write their own part of the well state, so the result
+    // must not depend on the order in which they are processed.
+    BOOST_REQUIRE_EQUAL(serial.size(), threaded.size());
+    for (std::size_t i = 0; i < serial.size(); ++i) {
+        BOOST_CHECK_EQUAL(serial[i], threaded[i]);
+    }
+}
+
+} // Anonymous namespace
+
+BOOST_AUTO_TEST_CASE(IndependentOfThreads)
+{
+    checkIndependentOfThreads("TESTWELLMODELTHREADS.DATA");
+}
+
+// Updating the well state does not switch controls, so the wells under
+// group control are processed concurrently as well.
+BOOST_AUTO_TEST_CASE(GroupControlledIndependentOfThreads)
+{
+    checkIndependentOfThreads("TESTWELLMODELTHREADS_GROUP.DATA");
+}
+#endif
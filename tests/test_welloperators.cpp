@@ -0,0 +1,449 @@
+/*
+  Copyright 2025 Equinor ASA.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#include <config.h>
+
+#include <dune/common/fvector.hh>
+#include <dune/istl/bvector.hh>
+
+#include <dune/common/parallel/mpihelper.hh>
+
+#include <opm/simulators/linalg/WellOperators.hpp>
+#include <opm/simulators/wells/MSWellTreeSolver.hpp>
+#include <opm/simulators/wells/ParallelWellInfo.hpp>
+#include <opm/simulators/wells/StandardWellEquationAccess.hpp>
+#include <opm/simulators/wells/StandardWellEquations.hpp>
+
+#define BOOST_TEST_MODULE WellOperatorsTest
+#include <boost/test/unit_test.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <cstdlib>
+#include <memory>
+#include <new>
+#include <vector>
+
+namespace {
+
+//! \brief The number of calls to the global operator new.
+std::atomic<std::size_t> numAllocations{0};
+
+} // anonymous namespace
+
+void* operator new(std::size_t size)
+{
+    ++numAllocations;
+    if (void* ptr = std::malloc(size > 0 ? size : 1)) {
+        return ptr;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void* ptr) noexcept
+{
+    std::free(ptr);
+}
+
+void operator delete(void* ptr, std::size_t) noexcept
+{
+    std::free(ptr);
+}
+
+namespace {
+
+using Vector = Dune::BlockVector<Dune::FieldVector<double, 2>>;
+
+//! \brief A well with the structure of the Schur complement C^T D^-1 B of
+//!        a multisegment well, with one segment per perforation, segments
+//!        coupled in a chain, and diagonal B and C blocks.
+class FakeWell
+{
+public:
+    using Solver = Opm::mswellhelpers::TreeBlockSolver<double, 2>;
+
+    FakeWell(std::vector<int> cells, double scale)
+        : cells_(std::move(cells))
+        , Bx_(cells_.size())
+    {
+        const std::size_t numSegments = cells_.size();
+        Solver::Matrix D(numSegments, numSegments, Solver::Matrix::row_wise);
+        for (auto row = D.createbegin(); row != D.createend(); ++row) {
+            const std::size_t seg = row.index();
+            if (seg > 0) {
+                row.insert(seg - 1);
+            }
+            row.insert(seg);
+            if (seg + 1 < numSegments) {
+                row.insert(seg + 1);
+            }
+        }
+        for (std::size_t seg = 0; seg < numSegments; ++seg) {
+            for (auto col = D[seg].begin(); col != D[seg].end(); ++col) {
+                *col = 0.0;
+                for (int i = 0; i < 2; ++i) {
+                    (*col)[i][i] = col.index() == seg ? 4.0 * scale : -1.0;
+                }
+                (*col)[0][1] = 0.1;
+            }
+        }
+        solver_.analyse(D);
+        solver_.factorize(D);
+    }
+
+    const std::vector<int>& cells() const
+    { return cells_; }
+
+    void apply(const Vector& x, Vector& Ax) const
+    {
+        for (std::size_t i = 0; i < x.size(); ++i) {
+            Bx_[i][0] = (1.0 + 0.1*i) * (x[i][0] + 0.5*x[i][1]);
+            Bx_[i][1] = 0.2 * x[i][1];
+        }
+        solver_.solveInPlace(Bx_);
+        for (std::size_t i = 0; i < Ax.size(); ++i) {
+            Ax[i][0] -= (1.0 - 0.05*i) * Bx_[i][0];
+            Ax[i][1] -= 0.3 * (Bx_[i][0] + Bx_[i][1]);
+        }
+    }
+
+private:
+    std::vector<int> cells_;
+    Solver solver_;
+    mutable Vector Bx_;
+};
+
+//! \brief A standard well with the equations of the simulator, and
+//!        made up values for the B, C and D matrices.
+class EquationsWell
+{
+public:
+    using Equations = Opm::StandardWellEquations<double, 2>;
+    static constexpr int numWellEq = 3;
+
+    EquationsWell(std::vector<int> cells, double scale)
+        : cells_(std::move(cells))
+        , equations_(parallelWellInfo_)
+    {
+        const int numPerfs = static_cast<int>(cells_.size());
+        equations_.init(numWellEq, numPerfs, cells_);
+        Opm::StandardWellEquationAccess<double, 2> access(equations_);
+        for (int perf = 0; perf < numPerfs; ++perf) {
+            for (int i = 0; i < numWellEq; ++i) {
+                for (int j = 0; j < 2; ++j) {
+                    access.B()[0][perf][i][j] = std::sin(1.0 + perf + 2.0*i + 3.0*j);
+                    access.C()[0][perf][i][j] = std::cos(2.0 + perf + 3.0*i + 5.0*j);
+                }
+            }
+        }
+        for (int i = 0; i < numWellEq; ++i) {
+            for (int j = 0; j < numWellEq; ++j) {
+                access.D()[0][0][i][j] = i == j ? 4.0 * scale : 0.3 * (i - j);
+            }
+        }
+        equations_.invert();
+    }
+
+    const std::vector<int>& cells() const
+    { return cells_; }
+
+    void apply(const Vector& x, Vector& Ax) const
+    {
+        equations_.apply(x, Ax);
+    }
+
+private:
+    std::vector<int> cells_;
+    Opm::ParallelWellInfo<double> parallelWellInfo_;
+    Equations equations_;
+};
+
+//! \brief The part of the well model interface used by the operator.
+template <class Well>
+class WellModel
+{
+public:
+    using PressureMatrix = Opm::LinearOperatorExtra<Vector, Vector>::PressureMatrix;
+
+    void addWell(std::vector<int> cells)
+    {
+        wells_.push_back(std::make_shared<Well>(std::move(cells), 1.0 + 0.01*wells_.size()));
+    }
+
+    //! \brief Rebuild a well in place with other cells, as done when the
+    //!        wells are recreated at the same address.
+    void rebuildWell(std::size_t w, std::vector<int> cells)
+    {
+        *wells_[w] = Well(std::move(cells), 1.0 + 0.01*w);
+    }
+
+    auto begin() const { return wells_.begin(); }
+    auto end() const { return wells_.end(); }
+    bool empty() const { return wells_.empty(); }
+
+    void addWellPressureEquations(PressureMatrix&, const Vector&, const bool) const {}
+    void addWellPressureEquationsStruct(PressureMatrix&) const {}
+    int numLocalWellsEnd() const { return static_cast<int>(wells_.size()); }
+
+private:
+    std::vector<std::shared_ptr<Well>> wells_;
+};
+
+using FakeWellModel = WellModel<FakeWell>;
+
+//! \brief An operator which exposes the number of well levels.
+class LevelCountingOperator
+    : public Opm::WellModelAsLinearOperator<FakeWellModel, Vector, Vector>
+{
+public:
+    using Opm::WellModelAsLinearOperator<FakeWellModel, Vector, Vector>::WellModelAsLinearOperator;
+
+    std::size_t numLevels() const
+    { return this->wellLevels_.size(); }
+};
+
+//! \brief Wells with nperf perforations each, the last perforation of every
+//!        fifth well is in the first cell of the previous well.
+template <class Well = FakeWell>
+WellModel<Well> createWellModel(std::size_t numWells, std::size_t nperf, std::size_t numCells)
+{
+    WellModel<Well> model;
+    const std::size_t stride = numCells / numWells;
+    for (std::size_t w = 0; w < numWells; ++w) {
+        std::vector<int> cells;
+        for (std::size_t p = 0; p < nperf; ++p) {
+            cells.push_back(static_cast<int>(w*stride + p));
+        }
+        if (w % 5 == 4) {
+            cells.back() = static_cast<int>((w - 1)*stride);
+        }
+        model.addWell(std::move(cells));
+    }
+    return model;
+}
+
+//! \brief Apply the wells one at a time, in order.
+template <class Well>
+void applySequential(const WellModel<Well>& model, const Vector& x, Vector& y)
+{
+    Vector xLocal, yLocal;
+    for (const auto& well : model) {
+        const auto& cells = well->cells();
+        xLocal.resize(cells.size());
+        yLocal.resize(cells.size());
+        for (std::size_t i = 0; i < cells.size(); ++i) {
+            xLocal[i] = x[cells[i]];
+            yLocal[i] = y[cells[i]];
+        }
+        well->apply(xLocal, yLocal);
+        for (std::size_t i = 0; i < cells.size(); ++i) {
+            y[cells[i]] = yLocal[i];
+        }
+    }
+}
+
+Vector createVector(std::size_t numCells)
+{
+    Vector x(numCells);
+    for (std::size_t i = 0; i < numCells; ++i) {
+        x[i][0] = 1.0 + 0.001*i;
+        x[i][1] = 0.5 - 0.002*(i % 17);
+    }
+    return x;
+}
+
+struct MPIFixture
+{
+    MPIFixture()
+    {
+        int argc = boost::unit_test::framework::master_test_suite().argc;
+        char** argv = boost::unit_test::framework::master_test_suite().argv;
+        Dune::MPIHelper::instance(argc, argv);
+    }
+};
+
+} // anonymous namespace
+
+BOOST_GLOBAL_FIXTURE(MPIFixture);
+
+BOOST_AUTO_TEST_CASE(MatchesSequentialApply)
+{
+    const std::size_t numCells = 2000;
+    const auto model = createWellModel(50, 8, numCells);
+    const Opm::WellModelAsLinearOperator<FakeWellModel, Vector, Vector> op(model);
+
+    const Vector x = createVector(numCells);
+    Vector expected(numCells);
+    expected = 1.0;
+    Vector y = expected;
+    applySequential(model, x, expected);
+
+    // twice, the second time with the cached well levels
+    for (int repeat = 0; repeat < 2; ++repeat) {
+        y = 1.0;
+        op.apply(x, y);
+        for (std::size_t i = 0; i < numCells; ++i) {
+            BOOST_CHECK_EQUAL(y[i][0], expected[i][0]);
+            BOOST_CHECK_EQUAL(y[i][1], expected[i][1]);
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE(StandardWellEquationsApply)
+{
+    // the simulator's well equations, with their scratch vectors, through
+    // the concurrent application of the operator
+    const std::size_t numCells = 1000;
+    const auto model = createWellModel<EquationsWell>(50, 6, numCells);
+    const Opm::WellModelAsLinearOperator<WellModel<EquationsWell>, Vector, Vector> op(model);
+
+    const Vector x = createVector(numCells);
+    Vector expected(numCells);
+    expected = 1.0;
+    Vector y = expected;
+    applySequential(model, x, expected);
+    Vector change = expected;
+    change -= y;
+    BOOST_CHECK_GT(change.infinity_norm(), 0.0);
+
+    for (int repeat = 0; repeat < 2; ++repeat) {
+        y = 1.0;
+        op.apply(x, y);
+        for (std::size_t i = 0; i < numCells; ++i) {
+            BOOST_CHECK_EQUAL(y[i][0], expected[i][0]);
+            BOOST_CHECK_EQUAL(y[i][1], expected[i][1]);
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE(WellsSharingCells)
+{
+    // all wells share cell 0, so they are applied one level at a time
+    const std::size_t numCells = 10;
+    FakeWellModel model;
+    model.addWell({0, 1, 2});
+    model.addWell({3, 0});
+    model.addWell({4, 5});
+    model.addWell({0, 5, 6});
+    const Opm::WellModelAsLinearOperator<FakeWellModel, Vector, Vector> op(model);
+
+    const Vector x = createVector(numCells);
+    Vector expected(numCells);
+    expected = 0.0;
+    Vector y = expected;
+    applySequential(model, x, expected);
+    op.apply(x, y);
+    for (std::size_t i = 0; i < numCells; ++i) {
+        BOOST_CHECK_EQUAL(y[i][0], expected[i][0]);
+        BOOST_CHECK_EQUAL(y[i][1], expected[i][1]);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(WellsRebuiltWithOtherCells)
+{
+    const std::size_t numCells = 10;
+    FakeWellModel model;
+    model.addWell({0, 1});
+    model.addWell({2, 3});
+    const LevelCountingOperator op(model);
+
+    const Vector x = createVector(numCells);
+    Vector y(numCells);
+    y = 0.0;
+    op.apply(x, y);
+    BOOST_CHECK_EQUAL(op.numLevels(), 1u);
+
+    // same well objects with the same number of cells, but the wells now
+    // share cell 0 and must not be applied concurrently
+    model.rebuildWell(1, {0, 4});
+    Vector expected(numCells);
+    expected = 0.0;
+    applySequential(model, x, expected);
+    y = 0.0;
+    op.apply(x, y);
+    BOOST_CHECK_EQUAL(op.numLevels(), 2u);
+    for (std::size_t i = 0; i < numCells; ++i) {
+        BOOST_CHECK_EQUAL(y[i][0], expected[i][0]);
+        BOOST_CHECK_EQUAL(y[i][1], expected[i][1]);
+    }
+}
+
+// Compare the time of one application of the well operator, as done in
+// every Krylov iteration, with applying the wells one at a time, for an
+// increasing number of wells. The numbers are reported as test messages,
+// run with --log_level=message to see them.
+BOOST_AUTO_TEST_CASE(ApplyBenchmark)
+{
+    using Clock = std::chrono::steady_clock;
+    using Seconds = std::chrono::duration<double>;
+    const std::size_t numCells = 400000;
+    const std::size_t nperf = 20;
+    const int repeats = 20;
+    const Vector x = createVector(numCells);
+
+    BOOST_TEST_MESSAGE("Well operator apply, " << nperf << " perforations per well:");
+    for (const std::size_t numWells : {10, 100, 1000, 4000}) {
+        const auto model = createWellModel(numWells, nperf, numCells);
+        const Opm::WellModelAsLinearOperator<FakeWellModel, Vector, Vector> op(model);
+        Vector y(numCells);
+        y = 0.0;
+        op.apply(x, y); // set up the well levels
+
+        const auto seqStart = Clock::now();
+        for (int r = 0; r < repeats; ++r) {
+            applySequential(model, x, y);
+        }
+        const Seconds seqTime = (Clock::now() - seqStart) / repeats;
+
+        const auto opStart = Clock::now();
+        for (int r = 0; r < repeats; ++r) {
+            op.apply(x, y);
+        }
+        const Seconds opTime = (Clock::now() - opStart) / repeats;
+
+        BOOST_CHECK(std::isfinite(y[0][0]));
+        BOOST_TEST_MESSAGE("  " << numWells << " wells: sequential " << seqTime.count()
+                           << " s, operator " << opTime.count() << " s");
+    }
+}
+
+// Applying the well operator is done in every Krylov iteration, so once
+// the local vectors and the well levels are set up it should not allocate.
+BOOST_AUTO_TEST_CASE(ApplyWithoutAllocation)
+{
+    const std::size_t numCells = 4000;
+    auto model = createWellModel(200, 8, numCells);
+    model.addWell({1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16});
+    const Opm::WellModelAsLinearOperator<FakeWellModel, Vector, Vector> op(model);
+
+    const Vector x = createVector(numCells);
+    Vector y(numCells);
+    y = 0.0;
+    op.apply(x, y); // set up the well levels and local vectors
+    op.applyscaleadd(0.5, x, y);
+
+    const std::size_t before = numAllocations;
+    for (int r = 0; r < 10; ++r) {
+        op.apply(x, y);
+        op.applyscaleadd(0.5, x, y);
+    }
+    const std::size_t allocations = numAllocations - before;
+    BOOST_CHECK_EQUAL(allocations, 0u);
+}